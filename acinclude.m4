@@ -61,6 +61,9 @@ AC_DEFUN([AX_LIBEWF_CHECK_LOCAL],
       [1])
   ])
 
+  dnl Monotonic clock function used in libewf/libewf_statistics.c
+  AC_CHECK_FUNCS([clock_gettime])
+
   dnl Check for internationalization functions in libewf/libewf_i18n.c 
   AC_CHECK_FUNCS([bindtextdomain])
 
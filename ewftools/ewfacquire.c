@@ -122,9 +122,9 @@ void ewfacquire_usage_fprint(
 	                 "                  [ -B number_of_bytes ] [ -c compression_values ]\n"
 	                 "                  [ -C case_number ] [ -d digest_type ] [ -D description ]\n"
 	                 "                  [ -e examiner_name ] [ -E evidence_number ] [ -f format ]\n"
-	                 "                  [ -g number_of_sectors ] [ -j jobs ] [ -l log_filename ]\n"
-	                 "                  [ -m media_type ] [ -M media_flags ] [ -N notes ]\n"
-	                 "                  [ -o offset ] [ -p process_buffer_size ]\n"
+	                 "                  [ -g number_of_sectors ] [ -j jobs ] [ -k target_throughput ]\n"
+	                 "                  [ -l log_filename ] [ -m media_type ] [ -M media_flags ]\n"
+	                 "                  [ -N notes ] [ -o offset ] [ -p process_buffer_size ]\n"
 	                 "                  [ -P bytes_per_sector ] [ -r read_error_retries ]\n"
 	                 "                  [ -S segment_file_size ] [ -t target ] [ -T toc_file ]\n"
 	                 "                  [ -2 secondary_target ] [ -hqRsuvVwx ] source\n\n" );
@@ -148,7 +148,8 @@ void ewfacquire_usage_fprint(
 	                 "\t        compression method options: deflate (default)\n"
 #endif
 	                 "\t        compression level options: none (default), empty-block,\n"
-	                 "\t        fast or best\n" );
+	                 "\t        fast, best or adaptive\n"
+	                 "\t        (adaptive is only supported by the deflate compression method)\n" );
 	fprintf( stream, "\t-C:     specify the case number (default is case_number).\n" );
 	fprintf( stream, "\t-d:     calculate additional digest (hash) types besides md5, options:\n"
 	                 "\t        sha1, sha256\n" );
@@ -163,6 +164,8 @@ void ewfacquire_usage_fprint(
 	fprintf( stream, "\t-j:     the number of concurrent processing jobs (threads), where\n"
 	                 "\t        a number of 0 represents single-threaded mode (default is 4\n"
 	                 "\t        if multi-threaded mode is supported)\n" );
+	fprintf( stream, "\t-k:     specify the target throughput in bytes per second for adaptive\n"
+	                 "\t        compression (default is none, which favors the compression ratio)\n" );
 	fprintf( stream, "\t-l:     logs acquiry errors and the digest (hash) to the log_filename\n" );
 	fprintf( stream, "\t-m:     specify the media type, options: fixed (default), removable,\n"
 	                 "\t        optical, memory\n" );
@@ -1587,6 +1590,7 @@ int main( int argc, char * const argv[] )
 	system_character_t *option_sectors_per_chunk         = NULL;
 	system_character_t *option_size                      = NULL;
 	system_character_t *option_target_filename           = NULL;
+	system_character_t *option_target_throughput         = NULL;
 	system_character_t *option_toc_filename              = NULL;
 	system_character_t *program                          = _SYSTEM_STRING( "ewfacquire" );
 	system_character_t *request_string                   = NULL;
@@ -1637,7 +1641,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = ewftools_getopt(
 	                   argc,
 	                   argv,
-	                   _SYSTEM_STRING( "A:b:B:c:C:d:D:e:E:f:g:hj:l:m:M:N:o:p:P:qr:RsS:t:T:uvVwx2:" ) ) ) != (system_integer_t) -1 )
+	                   _SYSTEM_STRING( "A:b:B:c:C:d:D:e:E:f:g:hj:k:l:m:M:N:o:p:P:qr:RsS:t:T:uvVwx2:" ) ) ) != (system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -1727,6 +1731,11 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (system_integer_t) 'k':
+				option_target_throughput = optarg;
+
+				break;
+
 			case (system_integer_t) 'l':
 				log_filename = optarg;
 
@@ -2534,6 +2543,28 @@ int main( int argc, char * const argv[] )
 			 "Unsupported process buffer size defaulting to: chunk size.\n" );
 		}
 	}
+	if( option_target_throughput != NULL )
+	{
+		result = imaging_handle_set_compression_target_throughput(
+			  ewfacquire_imaging_handle,
+			  option_target_throughput,
+			  &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set compression target throughput.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported compression target throughput defaulting to: none.\n" );
+		}
+	}
 	if( option_number_of_jobs != NULL )
 	{
 		result = imaging_handle_set_number_of_threads(
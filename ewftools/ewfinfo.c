@@ -70,7 +70,7 @@ void usage_fprint(
 	                 "Compression Format).\n\n" );
 
 	fprintf( stream, "Usage: ewfinfo [ -A codepage ] [ -d date_format ] [ -f format ]\n"
-	                 "               [ -ehimvVx ] ewf_files\n\n" );
+	                 "               [ -ehimMvVx ] ewf_files\n\n" );
 
 	fprintf( stream, "\tewf_files: the first or the entire set of EWF segment files\n\n" );
 
@@ -87,6 +87,8 @@ void usage_fprint(
 	fprintf( stream, "\t-h:        shows this help\n" );
 	fprintf( stream, "\t-i:        only show EWF acquiry information\n" );
 	fprintf( stream, "\t-m:        only show EWF media information\n" );
+	fprintf( stream, "\t-M:        only read the metadata, which is faster for large images\n"
+	                 "\t           but does not detect corrupted sector tables\n" );
 	fprintf( stream, "\t-v:        verbose output to stderr\n" );
 	fprintf( stream, "\t-V:        print version\n" );
 }
@@ -152,6 +154,7 @@ int main( int argc, char * const argv[] )
 	system_character_t *option_output_format     = NULL;
 	system_character_t *program                  = _SYSTEM_STRING( "ewfinfo" );
 	system_integer_t option                      = 0;
+	uint8_t metadata_only                        = 0;
 	uint8_t verbose                              = 0;
 	int number_of_filenames                      = 0;
 	int print_header                             = 1;
@@ -195,7 +198,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = ewftools_getopt(
 	                   argc,
 	                   argv,
-	                   _SYSTEM_STRING( "A:d:ef:himvV" ) ) ) != (system_integer_t) -1 )
+	                   _SYSTEM_STRING( "A:d:ef:himMvV" ) ) ) != (system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -306,6 +309,11 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (system_integer_t) 'M':
+				metadata_only = 1;
+
+				break;
+
 			case (system_integer_t) 'v':
 				verbose = 1;
 
@@ -362,6 +370,8 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
+	ewfinfo_info_handle->metadata_only = metadata_only;
+
 	if( option_output_format != NULL )
 	{
 		result = info_handle_set_output_format(
@@ -52,11 +52,12 @@ system_character_t *ewfinput_compression_methods[ 1 ] = {
 	_SYSTEM_STRING( "deflate" ) };
 #endif
 
-system_character_t *ewfinput_compression_levels[ 4 ] = {
+system_character_t *ewfinput_compression_levels[ 5 ] = {
 	_SYSTEM_STRING( "none" ),
 	_SYSTEM_STRING( "empty-block" ),
 	_SYSTEM_STRING( "fast" ),
-	_SYSTEM_STRING( "best" ) };
+	_SYSTEM_STRING( "best" ),
+	_SYSTEM_STRING( "adaptive" ) };
 
 system_character_t *ewfinput_format_types[ 15 ] = {
 	_SYSTEM_STRING( "ewf" ),
@@ -577,6 +578,18 @@ int ewfinput_determine_compression_values(
 			result             = 1;
 		}
 	}
+	else if( string_length == 8 )
+	{
+		if( system_string_compare(
+		     string,
+		     _SYSTEM_STRING( "adaptive" ),
+		     8 ) == 0 )
+		{
+			*compression_level = LIBEWF_COMPRESSION_BEST;
+			*compression_flags = LIBEWF_COMPRESS_FLAG_USE_ADAPTIVE_COMPRESSION;
+			result             = 1;
+		}
+	}
 	else if( string_length == 11 )
 	{
 		if( system_string_compare(
@@ -38,7 +38,7 @@ extern "C" {
 #endif
 #define EWFINPUT_COMPRESSION_METHODS_DEFAULT		0
 
-#define EWFINPUT_COMPRESSION_LEVELS_AMOUNT		4
+#define EWFINPUT_COMPRESSION_LEVELS_AMOUNT		5
 #define EWFINPUT_COMPRESSION_LEVELS_DEFAULT		0
 
 #define EWFINPUT_FORMAT_TYPES_AMOUNT			15
@@ -58,7 +58,7 @@ extern system_character_t *ewfinput_compression_methods[ 2 ];
 #else
 extern system_character_t *ewfinput_compression_methods[ 1 ];
 #endif
-extern system_character_t *ewfinput_compression_levels[ 4 ];
+extern system_character_t *ewfinput_compression_levels[ 5 ];
 extern system_character_t *ewfinput_format_types[ 15 ];
 extern system_character_t *ewfinput_media_types[ 4 ];
 extern system_character_t *ewfinput_media_flags[ 2 ];
@@ -72,8 +72,8 @@ void usage_fprint(
 	                 "Compression Format).\n\n" );
 
 	fprintf( stream, "Usage: ewfverify [ -A codepage ] [ -d digest_type ] [ -f format ]\n"
-	                 "                 [ -j jobs ] [ -l log_filename ] [ -p process_buffer_size ]\n"
-	                 "                 [ -hqvVwx ] ewf_files\n\n" );
+	                 "                 [ -i index_filename ] [ -j jobs ] [ -l log_filename ]\n"
+	                 "                 [ -p process_buffer_size ] [ -hqvVwx ] ewf_files\n\n" );
 
 	fprintf( stream, "\tewf_files: the first or the entire set of EWF segment files\n\n" );
 
@@ -87,6 +87,9 @@ void usage_fprint(
 	fprintf( stream, "\t-f:        specify the input format, options: raw (default),\n"
 	                 "\t           files (restricted to logical volume files)\n" );
 	fprintf( stream, "\t-h:        shows this help\n" );
+	fprintf( stream, "\t-i:        use the segment index in index_filename to speed up opening\n"
+	                 "\t           the EWF segment files, the segment index is (re)written\n"
+	                 "\t           when it does not exist or no longer matches the segment files\n" );
 	fprintf( stream, "\t-j:        the number of concurrent processing jobs (threads), where\n"
 	                 "\t           a number of 0 represents single-threaded mode (default is 4\n"
 	                 "\t           if multi-threaded mode is supported)\n" );
@@ -160,6 +163,7 @@ int main( int argc, char * const argv[] )
 	system_character_t * const *source_filenames       = NULL;
 	libcerror_error_t *error                           = NULL;
 	log_handle_t *log_handle                           = NULL;
+	system_character_t *index_filename                 = NULL;
 	system_character_t *log_filename                   = NULL;
 	system_character_t *option_additional_digest_types = NULL;
 	system_character_t *option_format                  = NULL;
@@ -213,7 +217,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = ewftools_getopt(
 	                   argc,
 	                   argv,
-	                   _SYSTEM_STRING( "A:d:f:j:hl:p:qvVwx" ) ) ) != (system_integer_t) -1 )
+	                   _SYSTEM_STRING( "A:d:f:i:j:hl:p:qvVwx" ) ) ) != (system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -250,6 +254,11 @@ int main( int argc, char * const argv[] )
 
 				return( EXIT_SUCCESS );
 
+			case (system_integer_t) 'i':
+				index_filename = optarg;
+
+				break;
+
 			case (system_integer_t) 'j':
 				option_number_of_jobs = optarg;
 
@@ -509,6 +518,20 @@ int main( int argc, char * const argv[] )
 		goto on_error;
 	}
 #endif
+	if( index_filename != NULL )
+	{
+		if( verification_handle_set_index_filename(
+		     ewfverify_verification_handle,
+		     index_filename,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set segment index filename.\n" );
+
+			goto on_error;
+		}
+	}
 	if( ewftools_signal_attach(
 	     ewfverify_signal_handler,
 	     &error ) != 1 )
@@ -3609,6 +3609,58 @@ on_error:
 	return( -1 );
 }
 
+/* Sets the compression target throughput
+ * The target throughput is in bytes per second
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int imaging_handle_set_compression_target_throughput(
+     imaging_handle_t *imaging_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function  = "imaging_handle_set_compression_target_throughput";
+	size_t string_length   = 0;
+	uint64_t size_variable = 0;
+	int result             = 0;
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	result = byte_size_string_convert(
+	          string,
+	          string_length,
+	          &size_variable,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine compression target throughput.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		imaging_handle->compression_target_throughput = size_variable;
+	}
+	return( result );
+}
+
 /* Sets the format
  * Returns 1 if successful, 0 if unsupported value or -1 on error
  */
@@ -4914,6 +4966,20 @@ int imaging_handle_set_output_values(
 
 		return( -1 );
 	}
+	if( libewf_handle_set_compression_target_throughput(
+	     imaging_handle->output_handle,
+	     imaging_handle->compression_target_throughput,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set compression target throughput.",
+		 function );
+
+		return( -1 );
+	}
 	if( libewf_handle_set_maximum_segment_size(
 	     imaging_handle->output_handle,
 	     imaging_handle->maximum_segment_size,
@@ -5078,6 +5144,20 @@ int imaging_handle_set_output_values(
 
 			return( -1 );
 		}
+		if( libewf_handle_set_compression_target_throughput(
+		     imaging_handle->secondary_output_handle,
+		     imaging_handle->compression_target_throughput,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set compression target throughput in secondary output handle.",
+			 function );
+
+			return( -1 );
+		}
 		if( libewf_handle_set_maximum_segment_size(
 		     imaging_handle->secondary_output_handle,
 		     imaging_handle->maximum_segment_size,
@@ -6293,9 +6373,18 @@ int imaging_handle_print_parameters(
 	}
 	else if( imaging_handle->compression_level == LIBEWF_COMPRESSION_BEST )
 	{
-		fprintf(
-		 imaging_handle->notify_stream,
-		 "best" );
+		if( ( imaging_handle->compression_flags & LIBEWF_COMPRESS_FLAG_USE_ADAPTIVE_COMPRESSION ) != 0 )
+		{
+			fprintf(
+			 imaging_handle->notify_stream,
+			 "adaptive" );
+		}
+		else
+		{
+			fprintf(
+			 imaging_handle->notify_stream,
+			 "best" );
+		}
 	}
 	else if( imaging_handle->compression_level == LIBEWF_COMPRESSION_NONE )
 	{
@@ -6316,6 +6405,14 @@ int imaging_handle_print_parameters(
 	 imaging_handle->notify_stream,
 	 "\n" );
 
+	if( ( ( imaging_handle->compression_flags & LIBEWF_COMPRESS_FLAG_USE_ADAPTIVE_COMPRESSION ) != 0 )
+	 && ( imaging_handle->compression_target_throughput != 0 ) )
+	{
+		fprintf(
+		 imaging_handle->notify_stream,
+		 "Compression target throughput:\t\t%" PRIu64 " bytes per second\n",
+		 imaging_handle->compression_target_throughput );
+	}
 	fprintf(
 	 imaging_handle->notify_stream,
 	 "Acquiry start offset:\t\t\t%" PRIi64 "\n",
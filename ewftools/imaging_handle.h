@@ -118,6 +118,10 @@ struct imaging_handle
 	 */
 	uint8_t compression_flags;
 
+	/* The compression target throughput in bytes per second
+	 */
+	uint64_t compression_target_throughput;
+
 	/* The EWF format
 	 */
 	uint8_t ewf_format;
@@ -439,6 +443,11 @@ int imaging_handle_set_compression_values(
      const system_character_t *string,
      libcerror_error_t **error );
 
+int imaging_handle_set_compression_target_throughput(
+     imaging_handle_t *imaging_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
 int imaging_handle_set_format(
      imaging_handle_t *imaging_handle,
      const system_character_t *string,
@@ -265,6 +265,7 @@ int info_handle_set_maximum_number_of_open_handles(
 }
 
 /* Opens the input of the info handle
+ * Only the metadata is read if metadata only is set
  * Returns 1 if successful or -1 on error
  */
 int info_handle_open_input(
@@ -276,6 +277,7 @@ int info_handle_open_input(
 	system_character_t **libewf_filenames = NULL;
 	static char *function                 = "info_handle_open_input";
 	size_t first_filename_length          = 0;
+	int access_flags                      = LIBEWF_OPEN_READ;
 	int filename_index                    = 0;
 
 	if( info_handle == NULL )
@@ -356,19 +358,25 @@ int info_handle_open_input(
 		}
 		filenames = (system_character_t * const *) libewf_filenames;
 	}
+	/* Without the sector tables corrupted sector tables are not detected
+	 */
+	if( info_handle->metadata_only != 0 )
+	{
+		access_flags = LIBEWF_OPEN_READ_METADATA;
+	}
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
 	if( libewf_handle_open_wide(
 	     info_handle->input_handle,
 	     filenames,
 	     number_of_filenames,
-	     LIBEWF_OPEN_READ,
+	     access_flags,
 	     error ) != 1 )
 #else
 	if( libewf_handle_open(
 	     info_handle->input_handle,
 	     filenames,
 	     number_of_filenames,
-	     LIBEWF_OPEN_READ,
+	     access_flags,
 	     error ) != 1 )
 #endif
 	{
@@ -55,6 +55,10 @@ struct info_handle
 	 */
 	int header_codepage;
 
+	/* Value to indicate only the metadata is read
+	 */
+	uint8_t metadata_only;
+
 	/* The libewf input handle
 	 */
 	libewf_handle_t *input_handle;
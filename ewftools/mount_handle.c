@@ -391,14 +391,14 @@ int mount_handle_open_input(
 	     mount_handle->input_handle,
 	     filenames,
 	     number_of_filenames,
-	     LIBEWF_OPEN_READ,
+	     LIBEWF_OPEN_READ_LAZY,
 	     error ) != 1 )
 #else
 	if( libewf_handle_open(
 	     mount_handle->input_handle,
 	     filenames,
 	     number_of_filenames,
-	     LIBEWF_OPEN_READ,
+	     LIBEWF_OPEN_READ_LAZY,
 	     error ) != 1 )
 #endif
 	{
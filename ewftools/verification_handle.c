@@ -454,6 +454,68 @@ int verification_handle_set_maximum_number_of_open_handles(
 	return( 1 );
 }
 
+/* Sets the segment index filename of the input
+ * Returns 1 if successful or -1 on error
+ */
+int verification_handle_set_index_filename(
+     verification_handle_t *verification_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	static char *function  = "verification_handle_set_index_filename";
+	size_t filename_length = 0;
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	filename_length = system_string_length(
+	                   filename );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_handle_set_segment_index_filename_wide(
+	     verification_handle->input_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+#else
+	if( libewf_handle_set_segment_index_filename(
+	     verification_handle->input_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set segment index filename in input handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
 /* Opens the input of the verification handle
  * Returns 1 if successful or -1 on error
  */
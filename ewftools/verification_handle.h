@@ -213,6 +213,11 @@ int verification_handle_set_maximum_number_of_open_handles(
      int maximum_number_of_open_handles,
      libcerror_error_t **error );
 
+int verification_handle_set_index_filename(
+     verification_handle_t *verification_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
 int verification_handle_open_input(
      verification_handle_t *verification_handle,
      system_character_t * const * filenames,
@@ -0,0 +1,1165 @@
+/*
+ * Asynchronous read functions
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_async_read.h"
+#include "libewf_definitions.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcnotify.h"
+#include "libewf_libcthreads.h"
+
+/* Creates an asynchronous read
+ * Make sure the value async_read is referencing, is set to NULL
+ * Reads cannot be submitted until submissions are enabled
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_async_read_initialize(
+     libewf_async_read_t **async_read,
+     int number_of_threads,
+     ssize_t (*read_function)(
+                void *buffer,
+                size_t buffer_size,
+                off64_t offset,
+                void *arguments,
+                libcerror_error_t **error ),
+     void *read_function_arguments,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_async_read_initialize";
+
+	if( async_read == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid asynchronous read.",
+		 function );
+
+		return( -1 );
+	}
+	if( *async_read != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid asynchronous read value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_threads < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of threads value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_function == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read function.",
+		 function );
+
+		return( -1 );
+	}
+	*async_read = memory_allocate_structure(
+	               libewf_async_read_t );
+
+	if( *async_read == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create asynchronous read.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *async_read,
+	     0,
+	     sizeof( libewf_async_read_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear asynchronous read.",
+		 function );
+
+		memory_free(
+		 *async_read );
+
+		*async_read = NULL;
+
+		return( -1 );
+	}
+	( *async_read )->number_of_threads       = number_of_threads;
+	( *async_read )->read_function           = read_function;
+	( *async_read )->read_function_arguments = read_function_arguments;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *async_read )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *async_read )->condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize condition.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( *async_read != NULL )
+	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( ( *async_read )->mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *async_read )->mutex ),
+			 NULL );
+		}
+#endif
+		memory_free(
+		 *async_read );
+
+		*async_read = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees an asynchronous read
+ * Disables the submission of reads and waits for the submitted reads to complete
+ * Completed reads that were not retrieved are discarded
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_async_read_free(
+     libewf_async_read_t **async_read,
+     libcerror_error_t **error )
+{
+	libewf_async_read_request_t *request = NULL;
+	static char *function                = "libewf_async_read_free";
+	int result                           = 1;
+
+	if( async_read == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid asynchronous read.",
+		 function );
+
+		return( -1 );
+	}
+	if( *async_read != NULL )
+	{
+		if( libewf_async_read_disable_submissions(
+		     *async_read,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to disable submissions.",
+			 function );
+
+			result = -1;
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( ( *async_read )->thread_pool != NULL )
+		{
+			if( libcthreads_thread_pool_join(
+			     &( ( *async_read )->thread_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join thread pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
+		while( ( *async_read )->first_completed_request != NULL )
+		{
+			request = ( *async_read )->first_completed_request;
+
+			( *async_read )->first_completed_request = request->next_request;
+
+			if( request->error != NULL )
+			{
+				libcerror_error_free(
+				 &( request->error ) );
+			}
+			memory_free(
+			 request );
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_condition_free(
+		     &( ( *async_read )->condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *async_read )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		memory_free(
+		 *async_read );
+
+		*async_read = NULL;
+	}
+	return( result );
+}
+
+/* Sets the number of threads
+ * Waits for the submitted reads to complete and stops the current threads
+ * Reads cannot be submitted while the number of threads is changed
+ * A value of 0 represents that reads are processed when they are submitted
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_async_read_set_number_of_threads(
+     libewf_async_read_t *async_read,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_async_read_set_number_of_threads";
+	int result            = 1;
+
+	if( async_read == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid asynchronous read.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_threads < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of threads value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     async_read->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	/* Changes of the number of threads are serialized
+	 */
+	while( async_read->is_changing_threads != 0 )
+	{
+		if( libcthreads_condition_wait(
+		     async_read->condition,
+		     async_read->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to wait for condition.",
+			 function );
+
+			libcthreads_mutex_release(
+			 async_read->mutex,
+			 NULL );
+
+			return( -1 );
+		}
+	}
+	/* Submitting a read fails from here on, hence the thread pool is no longer used
+	 * once the submitted reads completed
+	 */
+	async_read->is_changing_threads = 1;
+
+	while( async_read->number_of_pending_requests > 0 )
+	{
+		if( libcthreads_condition_wait(
+		     async_read->condition,
+		     async_read->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to wait for condition.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+	}
+	/* The thread pool is created again when the next read is submitted
+	 */
+	if( ( result == 1 )
+	 && ( async_read->thread_pool != NULL ) )
+	{
+		if( libcthreads_thread_pool_join(
+		     &( async_read->thread_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join thread pool.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( result == 1 )
+	{
+		async_read->number_of_threads = number_of_threads;
+	}
+	async_read->is_changing_threads = 0;
+
+	if( libcthreads_condition_broadcast(
+	     async_read->condition,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to broadcast condition.",
+		 function );
+
+		result = -1;
+	}
+	if( libcthreads_mutex_release(
+	     async_read->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#else
+	async_read->number_of_threads = number_of_threads;
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+	return( result );
+}
+
+/* Enables the submission of reads
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_async_read_enable_submissions(
+     libewf_async_read_t *async_read,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_async_read_enable_submissions";
+
+	if( async_read == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid asynchronous read.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     async_read->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	async_read->submissions_enabled = 1;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     async_read->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Disables the submission of reads and waits for the submitted reads to complete
+ * Submitting a read fails from the moment this function is called
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_async_read_disable_submissions(
+     libewf_async_read_t *async_read,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_async_read_disable_submissions";
+
+	if( async_read == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid asynchronous read.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     async_read->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	async_read->submissions_enabled = 0;
+
+	while( async_read->number_of_pending_requests > 0 )
+	{
+		if( libcthreads_condition_wait(
+		     async_read->condition,
+		     async_read->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to wait for condition.",
+			 function );
+
+			libcthreads_mutex_release(
+			 async_read->mutex,
+			 NULL );
+
+			return( -1 );
+		}
+	}
+	if( libcthreads_mutex_release(
+	     async_read->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#else
+	/* Without multi-thread support the submitted reads complete when they are submitted
+	 */
+	async_read->submissions_enabled = 0;
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+	return( 1 );
+}
+
+/* Submits a read of a buffer at a specific offset
+ * If a completion function is provided it is called when the read completed,
+ * otherwise the completed read is retrieved with libewf_async_read_get_completed_request
+ * The read is processed by the thread pool or, if there are no threads, before this function returns
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_async_read_submit(
+     libewf_async_read_t *async_read,
+     void *buffer,
+     size_t buffer_size,
+     off64_t offset,
+     void (*completion_function)(
+            void *buffer,
+            ssize_t read_count,
+            void *completion_data ),
+     void *completion_data,
+     libcerror_error_t **error )
+{
+	libewf_async_read_request_t *request = NULL;
+	static char *function                = "libewf_async_read_submit";
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_thread_pool_t *thread_pool = NULL;
+#endif
+
+	if( async_read == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid asynchronous read.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	request = memory_allocate_structure(
+	           libewf_async_read_request_t );
+
+	if( request == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create request.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     request,
+	     0,
+	     sizeof( libewf_async_read_request_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear request.",
+		 function );
+
+		goto on_error;
+	}
+	request->async_read          = async_read;
+	request->buffer              = buffer;
+	request->buffer_size         = buffer_size;
+	request->offset              = offset;
+	request->completion_function = completion_function;
+	request->completion_data     = completion_data;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     async_read->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( async_read->submissions_enabled == 0 )
+	 || ( async_read->is_changing_threads != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid asynchronous read - submissions are disabled.",
+		 function );
+
+		libcthreads_mutex_release(
+		 async_read->mutex,
+		 NULL );
+
+		goto on_error;
+	}
+	if( ( async_read->number_of_threads > 0 )
+	 && ( async_read->thread_pool == NULL ) )
+	{
+		if( libcthreads_thread_pool_create(
+		     &( async_read->thread_pool ),
+		     NULL,
+		     async_read->number_of_threads,
+		     LIBEWF_ASYNC_READ_MAXIMUM_NUMBER_OF_QUEUED_READS,
+		     (int (*)(intptr_t *, void *)) &libewf_async_read_process_request,
+		     (void *) async_read,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create thread pool.",
+			 function );
+
+			libcthreads_mutex_release(
+			 async_read->mutex,
+			 NULL );
+
+			goto on_error;
+		}
+	}
+	/* The request is pending from here on and must always be completed
+	 * The thread pool is not joined while a request is pending
+	 */
+	thread_pool = async_read->thread_pool;
+
+	async_read->number_of_pending_requests += 1;
+
+	libcthreads_mutex_release(
+	 async_read->mutex,
+	 NULL );
+
+	if( thread_pool != NULL )
+	{
+		/* The mutex is not held here since pushing blocks while the queue is full
+		 */
+		if( libcthreads_thread_pool_push(
+		     thread_pool,
+		     (intptr_t *) request,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push request onto queue.",
+			 function );
+
+			if( libcthreads_mutex_grab(
+			     async_read->mutex,
+			     NULL ) == 1 )
+			{
+				async_read->number_of_pending_requests -= 1;
+
+				if( async_read->number_of_pending_requests == 0 )
+				{
+					libcthreads_condition_broadcast(
+					 async_read->condition,
+					 NULL );
+				}
+				libcthreads_mutex_release(
+				 async_read->mutex,
+				 NULL );
+			}
+			goto on_error;
+		}
+		return( 1 );
+	}
+#else
+	if( async_read->submissions_enabled == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid asynchronous read - submissions are disabled.",
+		 function );
+
+		goto on_error;
+	}
+	async_read->number_of_pending_requests += 1;
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+	/* Without threads the read completes before this function returns
+	 */
+	libewf_async_read_process_request(
+	 request,
+	 async_read );
+
+	return( 1 );
+
+on_error:
+	if( request != NULL )
+	{
+		memory_free(
+		 request );
+	}
+	return( -1 );
+}
+
+/* Processes a submitted read
+ * Callback function for the thread pool
+ * A failed read completes with a read count of -1, the error of the read is kept
+ * with the completed read when no completion function is provided
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_async_read_process_request(
+     libewf_async_read_request_t *request,
+     libewf_async_read_t *async_read )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "libewf_async_read_process_request";
+	int result               = 1;
+
+	if( request == NULL )
+	{
+		return( -1 );
+	}
+	if( async_read == NULL )
+	{
+		memory_free(
+		 request );
+
+		return( -1 );
+	}
+	request->read_count = async_read->read_function(
+	                       request->buffer,
+	                       request->buffer_size,
+	                       request->offset,
+	                       async_read->read_function_arguments,
+	                       &error );
+
+	if( request->read_count < 0 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 request->offset,
+		 request->offset );
+
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		request->read_count = -1;
+
+		result = -1;
+	}
+	/* The completion function is called before the read is no longer pending
+	 * so that waiting for the submitted reads includes the completion functions
+	 */
+	if( request->completion_function != NULL )
+	{
+		request->completion_function(
+		 request->buffer,
+		 request->read_count,
+		 request->completion_data );
+
+		if( error != NULL )
+		{
+			libcerror_error_free(
+			 &error );
+		}
+		memory_free(
+		 request );
+
+		request = NULL;
+	}
+	else
+	{
+		request->error = error;
+		error          = NULL;
+	}
+	/* The request must always be marked as completed otherwise the waiter waits indefinitely
+	 */
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     async_read->mutex,
+	     &error ) != 1 )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+
+		if( request != NULL )
+		{
+			if( request->error != NULL )
+			{
+				libcerror_error_free(
+				 &( request->error ) );
+			}
+			memory_free(
+			 request );
+		}
+		return( -1 );
+	}
+#endif
+	if( request != NULL )
+	{
+		if( async_read->last_completed_request == NULL )
+		{
+			async_read->first_completed_request = request;
+		}
+		else
+		{
+			async_read->last_completed_request->next_request = request;
+		}
+		async_read->last_completed_request = request;
+	}
+	async_read->number_of_pending_requests -= 1;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( async_read->number_of_pending_requests == 0 )
+	{
+		libcthreads_condition_broadcast(
+		 async_read->condition,
+		 NULL );
+	}
+	libcthreads_mutex_release(
+	 async_read->mutex,
+	 NULL );
+#endif
+	return( result );
+}
+
+/* Retrieves a completed read
+ * The completed read is removed from the completion queue
+ * If read_error is not NULL it is set to the error of a failed read, which must be freed by the caller
+ * Returns 1 if successful, 0 if no completed read is available or -1 on error
+ */
+int libewf_async_read_get_completed_request(
+     libewf_async_read_t *async_read,
+     void **buffer,
+     ssize_t *read_count,
+     void **completion_data,
+     libcerror_error_t **read_error,
+     libcerror_error_t **error )
+{
+	libewf_async_read_request_t *request = NULL;
+	static char *function                = "libewf_async_read_get_completed_request";
+
+	if( async_read == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid asynchronous read.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_count == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read count.",
+		 function );
+
+		return( -1 );
+	}
+	if( completion_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid completion data.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     async_read->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	request = async_read->first_completed_request;
+
+	if( request != NULL )
+	{
+		async_read->first_completed_request = request->next_request;
+
+		if( async_read->first_completed_request == NULL )
+		{
+			async_read->last_completed_request = NULL;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     async_read->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		if( request != NULL )
+		{
+			if( request->error != NULL )
+			{
+				libcerror_error_free(
+				 &( request->error ) );
+			}
+			memory_free(
+			 request );
+		}
+		return( -1 );
+	}
+#endif
+	if( request == NULL )
+	{
+		return( 0 );
+	}
+	*buffer          = request->buffer;
+	*read_count      = request->read_count;
+	*completion_data = request->completion_data;
+
+	if( read_error != NULL )
+	{
+		*read_error    = request->error;
+		request->error = NULL;
+	}
+	else if( request->error != NULL )
+	{
+		libcerror_error_free(
+		 &( request->error ) );
+	}
+	memory_free(
+	 request );
+
+	return( 1 );
+}
+
+/* Waits for the submitted reads to complete
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_async_read_wait(
+     libewf_async_read_t *async_read,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_async_read_wait";
+
+	if( async_read == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid asynchronous read.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     async_read->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	while( async_read->number_of_pending_requests > 0 )
+	{
+		if( libcthreads_condition_wait(
+		     async_read->condition,
+		     async_read->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to wait for condition.",
+			 function );
+
+			libcthreads_mutex_release(
+			 async_read->mutex,
+			 NULL );
+
+			return( -1 );
+		}
+	}
+	if( libcthreads_mutex_release(
+	     async_read->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	/* Without multi-thread support the submitted reads complete when they are submitted
+	 */
+	return( 1 );
+}
+
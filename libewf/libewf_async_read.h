@@ -0,0 +1,197 @@
+/*
+ * Asynchronous read functions
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_ASYNC_READ_H )
+#define _LIBEWF_ASYNC_READ_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_async_read libewf_async_read_t;
+
+typedef struct libewf_async_read_request libewf_async_read_request_t;
+
+struct libewf_async_read_request
+{
+	/* The asynchronous read
+	 */
+	libewf_async_read_t *async_read;
+
+	/* The buffer
+	 */
+	void *buffer;
+
+	/* The buffer size
+	 */
+	size_t buffer_size;
+
+	/* The offset
+	 */
+	off64_t offset;
+
+	/* The number of bytes read or -1 on error
+	 */
+	ssize_t read_count;
+
+	/* The error of a failed read
+	 */
+	libcerror_error_t *error;
+
+	/* The function that is called when the read completed
+	 */
+	void (*completion_function)(
+	       void *buffer,
+	       ssize_t read_count,
+	       void *completion_data );
+
+	/* The data passed to the completion function
+	 */
+	void *completion_data;
+
+	/* The next completed request
+	 */
+	libewf_async_read_request_t *next_request;
+};
+
+struct libewf_async_read
+{
+	/* The number of threads
+	 */
+	int number_of_threads;
+
+	/* The number of submitted reads that did not complete
+	 */
+	int number_of_pending_requests;
+
+	/* Value to indicate reads can be submitted
+	 */
+	uint8_t submissions_enabled;
+
+	/* Value to indicate the number of threads is being changed
+	 */
+	uint8_t is_changing_threads;
+
+	/* The first completed request that was not retrieved
+	 */
+	libewf_async_read_request_t *first_completed_request;
+
+	/* The last completed request that was not retrieved
+	 */
+	libewf_async_read_request_t *last_completed_request;
+
+	/* The function that reads a buffer at an offset
+	 */
+	ssize_t (*read_function)(
+	           void *buffer,
+	           size_t buffer_size,
+	           off64_t offset,
+	           void *arguments,
+	           libcerror_error_t **error );
+
+	/* The arguments of the function that reads a buffer at an offset
+	 */
+	void *read_function_arguments;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The thread pool, which is created when the first read is submitted
+	 */
+	libcthreads_thread_pool_t *thread_pool;
+
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The condition that is signalled when all submitted reads completed
+	 */
+	libcthreads_condition_t *condition;
+#endif
+};
+
+int libewf_async_read_initialize(
+     libewf_async_read_t **async_read,
+     int number_of_threads,
+     ssize_t (*read_function)(
+                void *buffer,
+                size_t buffer_size,
+                off64_t offset,
+                void *arguments,
+                libcerror_error_t **error ),
+     void *read_function_arguments,
+     libcerror_error_t **error );
+
+int libewf_async_read_free(
+     libewf_async_read_t **async_read,
+     libcerror_error_t **error );
+
+int libewf_async_read_set_number_of_threads(
+     libewf_async_read_t *async_read,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+int libewf_async_read_enable_submissions(
+     libewf_async_read_t *async_read,
+     libcerror_error_t **error );
+
+int libewf_async_read_disable_submissions(
+     libewf_async_read_t *async_read,
+     libcerror_error_t **error );
+
+int libewf_async_read_submit(
+     libewf_async_read_t *async_read,
+     void *buffer,
+     size_t buffer_size,
+     off64_t offset,
+     void (*completion_function)(
+            void *buffer,
+            ssize_t read_count,
+            void *completion_data ),
+     void *completion_data,
+     libcerror_error_t **error );
+
+int libewf_async_read_process_request(
+     libewf_async_read_request_t *request,
+     libewf_async_read_t *async_read );
+
+int libewf_async_read_get_completed_request(
+     libewf_async_read_t *async_read,
+     void **buffer,
+     ssize_t *read_count,
+     void **completion_data,
+     libcerror_error_t **read_error,
+     libcerror_error_t **error );
+
+int libewf_async_read_wait(
+     libewf_async_read_t *async_read,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_ASYNC_READ_H ) */
+
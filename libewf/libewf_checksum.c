@@ -27,24 +27,583 @@
 #include <zlib.h>
 #endif
 
+#if defined( __x86_64__ ) || defined( __i386__ ) || defined( _M_X64 ) || defined( _M_IX86 )
+#if defined( _MSC_VER )
+#include <intrin.h>
+#endif
+#include <immintrin.h>
+
+#elif defined( __ARM_NEON ) || defined( __ARM_NEON__ )
+#include <arm_neon.h>
+#endif
+
 #include "libewf_checksum.h"
+#include "libewf_deflate.h"
 #include "libewf_libcerror.h"
 #include "libewf_types.h"
 
-#if defined( HAVE_ADLER32 ) && ( defined( HAVE_ZLIB ) || defined( ZLIB_DLL ) )
+/* The largest number of bytes that can be added to the Adler-32 sums
+ * before they need to be reduced modulo 65521 to prevent overflow
+ * of the 32-bit upper word
+ */
+#define LIBEWF_CHECKSUM_ADLER32_MAXIMUM_BLOCK_SIZE	5552
 
-/* Calculates the little-endian Adler-32 of a buffer
+#if defined( __GNUC__ ) || defined( __clang__ )
+#define LIBEWF_CHECKSUM_TARGET_SSE2	__attribute__((target("sse2")))
+#define LIBEWF_CHECKSUM_TARGET_AVX2	__attribute__((target("avx2")))
+#else
+#define LIBEWF_CHECKSUM_TARGET_SSE2
+#define LIBEWF_CHECKSUM_TARGET_AVX2
+#endif
+
+#if defined( _MSC_VER ) && defined( LIBEWF_CHECKSUM_HAVE_ADLER32_SSE2 )
+
+/* The cached x86 CPU features, -1 if not determined yet
+ */
+static int libewf_checksum_x86_cpu_features = -1;
+
+#define LIBEWF_CHECKSUM_X86_CPU_FEATURE_SSE2	0x00000001UL
+#define LIBEWF_CHECKSUM_X86_CPU_FEATURE_AVX2	0x00000002UL
+
+/* Determines the x86 CPU features used by the Adler-32 implementations
+ * Returns the CPU features
+ */
+static int libewf_checksum_get_x86_cpu_features(
+            void )
+{
+	int cpu_information[ 4 ];
+
+	unsigned __int64 xcr0   = 0;
+	int cpu_features        = 0;
+	int maximum_function_id = 0;
+
+	if( libewf_checksum_x86_cpu_features != -1 )
+	{
+		return( libewf_checksum_x86_cpu_features );
+	}
+	__cpuid(
+	 cpu_information,
+	 0 );
+
+	maximum_function_id = cpu_information[ 0 ];
+
+	if( maximum_function_id >= 1 )
+	{
+		__cpuid(
+		 cpu_information,
+		 1 );
+
+		if( ( cpu_information[ 3 ] & ( 1 << 26 ) ) != 0 )
+		{
+			cpu_features |= LIBEWF_CHECKSUM_X86_CPU_FEATURE_SSE2;
+		}
+		/* AVX2 requires the operating system to save the YMM registers
+		 * which is indicated by OSXSAVE and the XCR0 register
+		 */
+		if( ( maximum_function_id >= 7 )
+		 && ( ( cpu_information[ 2 ] & ( 1 << 27 ) ) != 0 )
+		 && ( ( cpu_information[ 2 ] & ( 1 << 28 ) ) != 0 ) )
+		{
+			xcr0 = _xgetbv(
+			        0 );
+
+			if( ( xcr0 & 0x06 ) == 0x06 )
+			{
+				__cpuidex(
+				 cpu_information,
+				 7,
+				 0 );
+
+				if( ( cpu_information[ 1 ] & ( 1 << 5 ) ) != 0 )
+				{
+					cpu_features |= LIBEWF_CHECKSUM_X86_CPU_FEATURE_AVX2;
+				}
+			}
+		}
+	}
+	libewf_checksum_x86_cpu_features = cpu_features;
+
+	return( cpu_features );
+}
+
+#endif /* defined( _MSC_VER ) && defined( LIBEWF_CHECKSUM_HAVE_ADLER32_SSE2 ) */
+
+#if defined( LIBEWF_CHECKSUM_HAVE_ADLER32_SSE2 )
+
+/* Calculates the horizontal sum of the 32-bit integers in a SSE2 vector
+ */
+LIBEWF_CHECKSUM_TARGET_SSE2
+static uint32_t libewf_checksum_sum_vector_sse2(
+                 __m128i vector )
+{
+	vector = _mm_add_epi32(
+	          vector,
+	          _mm_shuffle_epi32(
+	           vector,
+	           _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+
+	vector = _mm_add_epi32(
+	          vector,
+	          _mm_shuffle_epi32(
+	           vector,
+	           _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+
+	return( (uint32_t) _mm_cvtsi128_si32(
+	                    vector ) );
+}
+
+/* Updates an Adler-32 with the bytes of a buffer using SSE2
+ * The buffer is processed in vectors of 16 bytes where for every vector:
+ * the lower word is increased with the sum of the bytes and
+ * the upper word with 16 times the preceding lower word and the sum of the bytes weighted 16 to 1
+ * Returns the updated Adler-32
+ */
+LIBEWF_CHECKSUM_TARGET_SSE2
+uint32_t libewf_checksum_update_adler32_sse2(
+          uint32_t adler32,
+          const uint8_t *buffer,
+          size_t size )
+{
+	__m128i bytes_vector         = _mm_setzero_si128();
+	__m128i lower_sums_vector    = _mm_setzero_si128();
+	__m128i previous_sums_vector = _mm_setzero_si128();
+	__m128i upper_sums_vector    = _mm_setzero_si128();
+	__m128i weights_high_vector  = _mm_set_epi16( 1, 2, 3, 4, 5, 6, 7, 8 );
+	__m128i weights_low_vector   = _mm_set_epi16( 9, 10, 11, 12, 13, 14, 15, 16 );
+	__m128i zero_vector          = _mm_setzero_si128();
+	size_t block_size            = 0;
+	size_t vector_index          = 0;
+	uint32_t lower_word          = 0;
+	uint32_t upper_word          = 0;
+
+	lower_word = adler32 & 0xffff;
+	upper_word = ( adler32 >> 16 ) & 0xffff;
+
+	if( size == 0 )
+	{
+		return( adler32 );
+	}
+	while( size >= 16 )
+	{
+		block_size = size & ~( (size_t) 15 );
+
+		if( block_size > LIBEWF_CHECKSUM_ADLER32_MAXIMUM_BLOCK_SIZE )
+		{
+			block_size = LIBEWF_CHECKSUM_ADLER32_MAXIMUM_BLOCK_SIZE;
+		}
+		size -= block_size;
+
+		upper_word += lower_word * (uint32_t) block_size;
+
+		lower_sums_vector    = _mm_setzero_si128();
+		previous_sums_vector = _mm_setzero_si128();
+		upper_sums_vector    = _mm_setzero_si128();
+
+		for( vector_index = block_size / 16;
+		     vector_index > 0;
+		     vector_index-- )
+		{
+			bytes_vector = _mm_loadu_si128(
+			                (const __m128i *) buffer );
+
+			previous_sums_vector = _mm_add_epi32(
+			                        previous_sums_vector,
+			                        lower_sums_vector );
+
+			lower_sums_vector = _mm_add_epi32(
+			                     lower_sums_vector,
+			                     _mm_sad_epu8(
+			                      bytes_vector,
+			                      zero_vector ) );
+
+			upper_sums_vector = _mm_add_epi32(
+			                     upper_sums_vector,
+			                     _mm_madd_epi16(
+			                      _mm_unpacklo_epi8(
+			                       bytes_vector,
+			                       zero_vector ),
+			                      weights_low_vector ) );
+
+			upper_sums_vector = _mm_add_epi32(
+			                     upper_sums_vector,
+			                     _mm_madd_epi16(
+			                      _mm_unpackhi_epi8(
+			                       bytes_vector,
+			                       zero_vector ),
+			                      weights_high_vector ) );
+
+			buffer += 16;
+		}
+		upper_word += libewf_checksum_sum_vector_sse2(
+		               previous_sums_vector ) << 4;
+
+		upper_word += libewf_checksum_sum_vector_sse2(
+		               upper_sums_vector );
+
+		lower_word += libewf_checksum_sum_vector_sse2(
+		               lower_sums_vector );
+
+		lower_word %= 65521;
+		upper_word %= 65521;
+	}
+	while( size > 0 )
+	{
+		lower_word += *buffer;
+		upper_word += lower_word;
+
+		buffer++;
+		size--;
+	}
+
+	lower_word %= 65521;
+	upper_word %= 65521;
+
+	return( ( upper_word << 16 ) | lower_word );
+}
+
+#endif /* defined( LIBEWF_CHECKSUM_HAVE_ADLER32_SSE2 ) */
+
+#if defined( LIBEWF_CHECKSUM_HAVE_ADLER32_AVX2 )
+
+/* Calculates the horizontal sum of the 32-bit integers in an AVX2 vector
+ */
+LIBEWF_CHECKSUM_TARGET_AVX2
+static uint32_t libewf_checksum_sum_vector_avx2(
+                 __m256i vector )
+{
+	__m128i sum_vector = _mm_setzero_si128();
+
+	sum_vector = _mm_add_epi32(
+	              _mm256_castsi256_si128(
+	               vector ),
+	              _mm256_extracti128_si256(
+	               vector,
+	               1 ) );
+
+	sum_vector = _mm_add_epi32(
+	              sum_vector,
+	              _mm_shuffle_epi32(
+	               sum_vector,
+	               _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+
+	sum_vector = _mm_add_epi32(
+	              sum_vector,
+	              _mm_shuffle_epi32(
+	               sum_vector,
+	               _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+
+	return( (uint32_t) _mm_cvtsi128_si32(
+	                    sum_vector ) );
+}
+
+/* Updates an Adler-32 with the bytes of a buffer using AVX2
+ * The buffer is processed in vectors of 32 bytes where for every vector:
+ * the lower word is increased with the sum of the bytes and
+ * the upper word with 32 times the preceding lower word and the sum of the bytes weighted 32 to 1
+ * Returns the updated Adler-32
+ */
+LIBEWF_CHECKSUM_TARGET_AVX2
+uint32_t libewf_checksum_update_adler32_avx2(
+          uint32_t adler32,
+          const uint8_t *buffer,
+          size_t size )
+{
+	__m256i bytes_vector         = _mm256_setzero_si256();
+	__m256i lower_sums_vector    = _mm256_setzero_si256();
+	__m256i ones_vector          = _mm256_set1_epi16( 1 );
+	__m256i previous_sums_vector = _mm256_setzero_si256();
+	__m256i upper_sums_vector    = _mm256_setzero_si256();
+	__m256i weights_vector       = _mm256_set_epi8(
+	                                1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16,
+	                                17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32 );
+	__m256i zero_vector          = _mm256_setzero_si256();
+	size_t block_size            = 0;
+	size_t vector_index          = 0;
+	uint32_t lower_word          = 0;
+	uint32_t upper_word          = 0;
+
+	lower_word = adler32 & 0xffff;
+	upper_word = ( adler32 >> 16 ) & 0xffff;
+
+	if( size == 0 )
+	{
+		return( adler32 );
+	}
+	while( size >= 32 )
+	{
+		block_size = size & ~( (size_t) 31 );
+
+		if( block_size > ( LIBEWF_CHECKSUM_ADLER32_MAXIMUM_BLOCK_SIZE & ~31 ) )
+		{
+			block_size = LIBEWF_CHECKSUM_ADLER32_MAXIMUM_BLOCK_SIZE & ~31;
+		}
+		size -= block_size;
+
+		upper_word += lower_word * (uint32_t) block_size;
+
+		lower_sums_vector    = _mm256_setzero_si256();
+		previous_sums_vector = _mm256_setzero_si256();
+		upper_sums_vector    = _mm256_setzero_si256();
+
+		for( vector_index = block_size / 32;
+		     vector_index > 0;
+		     vector_index-- )
+		{
+			bytes_vector = _mm256_loadu_si256(
+			                (const __m256i *) buffer );
+
+			previous_sums_vector = _mm256_add_epi32(
+			                        previous_sums_vector,
+			                        lower_sums_vector );
+
+			lower_sums_vector = _mm256_add_epi32(
+			                     lower_sums_vector,
+			                     _mm256_sad_epu8(
+			                      bytes_vector,
+			                      zero_vector ) );
+
+			/* The weighted pair sums are at most 255 * ( 32 + 31 )
+			 * and therefore do not saturate
+			 */
+			upper_sums_vector = _mm256_add_epi32(
+			                     upper_sums_vector,
+			                     _mm256_madd_epi16(
+			                      _mm256_maddubs_epi16(
+			                       bytes_vector,
+			                       weights_vector ),
+			                      ones_vector ) );
+
+			buffer += 32;
+		}
+		upper_word += libewf_checksum_sum_vector_avx2(
+		               previous_sums_vector ) << 5;
+
+		upper_word += libewf_checksum_sum_vector_avx2(
+		               upper_sums_vector );
+
+		lower_word += libewf_checksum_sum_vector_avx2(
+		               lower_sums_vector );
+
+		lower_word %= 65521;
+		upper_word %= 65521;
+	}
+	while( size > 0 )
+	{
+		lower_word += *buffer;
+		upper_word += lower_word;
+
+		buffer++;
+		size--;
+	}
+
+	lower_word %= 65521;
+	upper_word %= 65521;
+
+	return( ( upper_word << 16 ) | lower_word );
+}
+
+#endif /* defined( LIBEWF_CHECKSUM_HAVE_ADLER32_AVX2 ) */
+
+#if defined( LIBEWF_CHECKSUM_HAVE_ADLER32_NEON )
+
+/* Calculates the horizontal sum of the 32-bit integers in a NEON vector
+ */
+static uint32_t libewf_checksum_sum_vector_neon(
+                 uint32x4_t vector )
+{
+	return( vgetq_lane_u32( vector, 0 )
+	      + vgetq_lane_u32( vector, 1 )
+	      + vgetq_lane_u32( vector, 2 )
+	      + vgetq_lane_u32( vector, 3 ) );
+}
+
+/* Updates an Adler-32 with the bytes of a buffer using NEON
+ * The buffer is processed in vectors of 16 bytes where for every vector:
+ * the lower word is increased with the sum of the bytes and
+ * the upper word with 16 times the preceding lower word and the sum of the bytes weighted 16 to 1
+ * Returns the updated Adler-32
+ */
+uint32_t libewf_checksum_update_adler32_neon(
+          uint32_t adler32,
+          const uint8_t *buffer,
+          size_t size )
+{
+	static const uint8_t weights[ 16 ] = {
+		16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1 };
+
+	uint8x16_t bytes_vector         = vdupq_n_u8( 0 );
+	uint8x8_t weights_high_vector   = vld1_u8( &( weights[ 8 ] ) );
+	uint8x8_t weights_low_vector    = vld1_u8( &( weights[ 0 ] ) );
+	uint32x4_t lower_sums_vector    = vdupq_n_u32( 0 );
+	uint32x4_t previous_sums_vector = vdupq_n_u32( 0 );
+	uint32x4_t upper_sums_vector    = vdupq_n_u32( 0 );
+	size_t block_size               = 0;
+	size_t vector_index             = 0;
+	uint32_t lower_word             = 0;
+	uint32_t upper_word             = 0;
+
+	lower_word = adler32 & 0xffff;
+	upper_word = ( adler32 >> 16 ) & 0xffff;
+
+	if( size == 0 )
+	{
+		return( adler32 );
+	}
+	while( size >= 16 )
+	{
+		block_size = size & ~( (size_t) 15 );
+
+		if( block_size > LIBEWF_CHECKSUM_ADLER32_MAXIMUM_BLOCK_SIZE )
+		{
+			block_size = LIBEWF_CHECKSUM_ADLER32_MAXIMUM_BLOCK_SIZE;
+		}
+		size -= block_size;
+
+		upper_word += lower_word * (uint32_t) block_size;
+
+		lower_sums_vector    = vdupq_n_u32( 0 );
+		previous_sums_vector = vdupq_n_u32( 0 );
+		upper_sums_vector    = vdupq_n_u32( 0 );
+
+		for( vector_index = block_size / 16;
+		     vector_index > 0;
+		     vector_index-- )
+		{
+			bytes_vector = vld1q_u8(
+			                buffer );
+
+			previous_sums_vector = vaddq_u32(
+			                        previous_sums_vector,
+			                        lower_sums_vector );
+
+			lower_sums_vector = vpadalq_u16(
+			                     lower_sums_vector,
+			                     vpaddlq_u8(
+			                      bytes_vector ) );
+
+			upper_sums_vector = vpadalq_u16(
+			                     upper_sums_vector,
+			                     vmull_u8(
+			                      vget_low_u8(
+			                       bytes_vector ),
+			                      weights_low_vector ) );
+
+			upper_sums_vector = vpadalq_u16(
+			                     upper_sums_vector,
+			                     vmull_u8(
+			                      vget_high_u8(
+			                       bytes_vector ),
+			                      weights_high_vector ) );
+
+			buffer += 16;
+		}
+		upper_word += libewf_checksum_sum_vector_neon(
+		               previous_sums_vector ) << 4;
+
+		upper_word += libewf_checksum_sum_vector_neon(
+		               upper_sums_vector );
+
+		lower_word += libewf_checksum_sum_vector_neon(
+		               lower_sums_vector );
+
+		lower_word %= 65521;
+		upper_word %= 65521;
+	}
+	while( size > 0 )
+	{
+		lower_word += *buffer;
+		upper_word += lower_word;
+
+		buffer++;
+		size--;
+	}
+
+	lower_word %= 65521;
+	upper_word %= 65521;
+
+	return( ( upper_word << 16 ) | lower_word );
+}
+
+#endif /* defined( LIBEWF_CHECKSUM_HAVE_ADLER32_NEON ) */
+
+/* Determines if an Adler-32 implementation is supported by the CPU
+ * Returns 1 if supported or 0 if not
+ */
+int libewf_checksum_adler32_implementation_is_supported(
+     int implementation )
+{
+	switch( implementation )
+	{
+		case LIBEWF_CHECKSUM_ADLER32_IMPLEMENTATION_SCALAR:
+			return( 1 );
+
+#if defined( LIBEWF_CHECKSUM_HAVE_ADLER32_SSE2 )
+		case LIBEWF_CHECKSUM_ADLER32_IMPLEMENTATION_SSE2:
+#if defined( _MSC_VER )
+			return( ( libewf_checksum_get_x86_cpu_features() & LIBEWF_CHECKSUM_X86_CPU_FEATURE_SSE2 ) != 0 );
+#else
+			return( __builtin_cpu_supports( "sse2" ) != 0 );
+#endif
+#endif /* defined( LIBEWF_CHECKSUM_HAVE_ADLER32_SSE2 ) */
+
+#if defined( LIBEWF_CHECKSUM_HAVE_ADLER32_AVX2 )
+		case LIBEWF_CHECKSUM_ADLER32_IMPLEMENTATION_AVX2:
+#if defined( _MSC_VER )
+			return( ( libewf_checksum_get_x86_cpu_features() & LIBEWF_CHECKSUM_X86_CPU_FEATURE_AVX2 ) != 0 );
+#else
+			return( __builtin_cpu_supports( "avx2" ) != 0 );
+#endif
+#endif /* defined( LIBEWF_CHECKSUM_HAVE_ADLER32_AVX2 ) */
+
+#if defined( LIBEWF_CHECKSUM_HAVE_ADLER32_NEON )
+		case LIBEWF_CHECKSUM_ADLER32_IMPLEMENTATION_NEON:
+			return( 1 );
+#endif
+
+		default:
+			break;
+	}
+	return( 0 );
+}
+
+/* Retrieves the fastest Adler-32 implementation supported by the CPU
+ * Returns the Adler-32 implementation
+ */
+int libewf_checksum_get_adler32_implementation(
+     void )
+{
+	if( libewf_checksum_adler32_implementation_is_supported(
+	     LIBEWF_CHECKSUM_ADLER32_IMPLEMENTATION_AVX2 ) != 0 )
+	{
+		return( LIBEWF_CHECKSUM_ADLER32_IMPLEMENTATION_AVX2 );
+	}
+	if( libewf_checksum_adler32_implementation_is_supported(
+	     LIBEWF_CHECKSUM_ADLER32_IMPLEMENTATION_SSE2 ) != 0 )
+	{
+		return( LIBEWF_CHECKSUM_ADLER32_IMPLEMENTATION_SSE2 );
+	}
+	if( libewf_checksum_adler32_implementation_is_supported(
+	     LIBEWF_CHECKSUM_ADLER32_IMPLEMENTATION_NEON ) != 0 )
+	{
+		return( LIBEWF_CHECKSUM_ADLER32_IMPLEMENTATION_NEON );
+	}
+	return( LIBEWF_CHECKSUM_ADLER32_IMPLEMENTATION_SCALAR );
+}
+
+/* Calculates the little-endian Adler-32 of a buffer using a specific implementation
  * It uses the initial value to calculate a new Adler-32
+ * The scalar implementation uses zlib when available
  * Returns 1 if successful or -1 on error
  */
-int libewf_checksum_calculate_adler32(
+int libewf_checksum_calculate_adler32_with_implementation(
      uint32_t *checksum_value,
      const uint8_t *buffer,
      size_t size,
      uint32_t initial_value,
+     int implementation,
      libcerror_error_t **error )
 {
-	static char *function = "libewf_checksum_calculate_adler32";
+	static char *function = "libewf_checksum_calculate_adler32_with_implementation";
 
 	if( checksum_value == NULL )
 	{
@@ -68,7 +627,7 @@ int libewf_checksum_calculate_adler32(
 
 		return( -1 );
 	}
-	if( size > (size_t) UINT_MAX )
+	if( size > (size_t) SSIZE_MAX )
 	{
 		libcerror_error_set(
 		 error,
@@ -79,13 +638,119 @@ int libewf_checksum_calculate_adler32(
 
 		return( -1 );
 	}
-	*checksum_value = adler32(
-	                   (uLong) initial_value,
-	                   (const Bytef *) buffer,
-	                   (uInt) size );
+	if( libewf_checksum_adler32_implementation_is_supported(
+	     implementation ) == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported implementation: %d.",
+		 function,
+		 implementation );
+
+		return( -1 );
+	}
+	switch( implementation )
+	{
+#if defined( LIBEWF_CHECKSUM_HAVE_ADLER32_SSE2 )
+		case LIBEWF_CHECKSUM_ADLER32_IMPLEMENTATION_SSE2:
+			*checksum_value = libewf_checksum_update_adler32_sse2(
+			                   initial_value,
+			                   buffer,
+			                   size );
+			break;
+#endif
+
+#if defined( LIBEWF_CHECKSUM_HAVE_ADLER32_AVX2 )
+		case LIBEWF_CHECKSUM_ADLER32_IMPLEMENTATION_AVX2:
+			*checksum_value = libewf_checksum_update_adler32_avx2(
+			                   initial_value,
+			                   buffer,
+			                   size );
+			break;
+#endif
+
+#if defined( LIBEWF_CHECKSUM_HAVE_ADLER32_NEON )
+		case LIBEWF_CHECKSUM_ADLER32_IMPLEMENTATION_NEON:
+			*checksum_value = libewf_checksum_update_adler32_neon(
+			                   initial_value,
+			                   buffer,
+			                   size );
+			break;
+#endif
+
+		default:
+#if defined( HAVE_ADLER32 ) && ( defined( HAVE_ZLIB ) || defined( ZLIB_DLL ) )
+			if( size > (size_t) UINT_MAX )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+				 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+				 "%s: invalid size value exceeds maximum.",
+				 function );
+
+				return( -1 );
+			}
+			*checksum_value = adler32(
+			                   (uLong) initial_value,
+			                   (const Bytef *) buffer,
+			                   (uInt) size );
+#else
+			if( libewf_deflate_calculate_adler32(
+			     checksum_value,
+			     buffer,
+			     size,
+			     initial_value,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to calculate Adler-32.",
+				 function );
 
+				return( -1 );
+			}
+#endif /* defined( HAVE_ADLER32 ) && ( defined( HAVE_ZLIB ) || defined( ZLIB_DLL ) ) */
+			break;
+	}
 	return( 1 );
 }
 
-#endif /* defined( HAVE_ADLER32 ) && ( defined( HAVE_ZLIB ) || defined( ZLIB_DLL ) ) */
+/* Calculates the little-endian Adler-32 of a buffer
+ * It uses the initial value to calculate a new Adler-32
+ * The fastest implementation supported by the CPU is used
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_checksum_calculate_adler32(
+     uint32_t *checksum_value,
+     const uint8_t *buffer,
+     size_t size,
+     uint32_t initial_value,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_checksum_calculate_adler32";
+
+	if( libewf_checksum_calculate_adler32_with_implementation(
+	     checksum_value,
+	     buffer,
+	     size,
+	     initial_value,
+	     libewf_checksum_get_adler32_implementation(),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate Adler-32.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
 
@@ -32,20 +32,77 @@
 extern "C" {
 #endif
 
-#if defined( HAVE_ADLER32 ) && ( defined( HAVE_ZLIB ) || defined( ZLIB_DLL ) )
+/* The SIMD Adler-32 implementations are only available on platforms
+ * where the compiler supports the corresponding intrinsics
+ */
+#if ( defined( __GNUC__ ) || defined( __clang__ ) ) && ( defined( __x86_64__ ) || defined( __i386__ ) )
+#define LIBEWF_CHECKSUM_HAVE_ADLER32_SSE2	1
+#define LIBEWF_CHECKSUM_HAVE_ADLER32_AVX2	1
 
-int libewf_checksum_calculate_adler32(
+#elif defined( _MSC_VER ) && ( _MSC_VER >= 1700 ) && ( defined( _M_X64 ) || defined( _M_IX86 ) )
+#define LIBEWF_CHECKSUM_HAVE_ADLER32_SSE2	1
+#define LIBEWF_CHECKSUM_HAVE_ADLER32_AVX2	1
+
+#elif defined( __ARM_NEON ) || defined( __ARM_NEON__ )
+#define LIBEWF_CHECKSUM_HAVE_ADLER32_NEON	1
+
+#endif
+
+enum LIBEWF_CHECKSUM_ADLER32_IMPLEMENTATIONS
+{
+	LIBEWF_CHECKSUM_ADLER32_IMPLEMENTATION_SCALAR	= 0,
+	LIBEWF_CHECKSUM_ADLER32_IMPLEMENTATION_SSE2	= 1,
+	LIBEWF_CHECKSUM_ADLER32_IMPLEMENTATION_AVX2	= 2,
+	LIBEWF_CHECKSUM_ADLER32_IMPLEMENTATION_NEON	= 3
+};
+
+#if defined( LIBEWF_CHECKSUM_HAVE_ADLER32_SSE2 )
+
+uint32_t libewf_checksum_update_adler32_sse2(
+          uint32_t adler32,
+          const uint8_t *buffer,
+          size_t size );
+
+#endif /* defined( LIBEWF_CHECKSUM_HAVE_ADLER32_SSE2 ) */
+
+#if defined( LIBEWF_CHECKSUM_HAVE_ADLER32_AVX2 )
+
+uint32_t libewf_checksum_update_adler32_avx2(
+          uint32_t adler32,
+          const uint8_t *buffer,
+          size_t size );
+
+#endif /* defined( LIBEWF_CHECKSUM_HAVE_ADLER32_AVX2 ) */
+
+#if defined( LIBEWF_CHECKSUM_HAVE_ADLER32_NEON )
+
+uint32_t libewf_checksum_update_adler32_neon(
+          uint32_t adler32,
+          const uint8_t *buffer,
+          size_t size );
+
+#endif /* defined( LIBEWF_CHECKSUM_HAVE_ADLER32_NEON ) */
+
+int libewf_checksum_adler32_implementation_is_supported(
+     int implementation );
+
+int libewf_checksum_get_adler32_implementation(
+     void );
+
+int libewf_checksum_calculate_adler32_with_implementation(
      uint32_t *checksum_value,
      const uint8_t *buffer,
      size_t size,
      uint32_t initial_value,
+     int implementation,
      libcerror_error_t **error );
 
-#else
-#define libewf_checksum_calculate_adler32( checksum_value, buffer, size, initial_value, error ) \
-	libewf_deflate_calculate_adler32( checksum_value, buffer, size, initial_value, error )
-
-#endif /* defined( HAVE_ADLER32 ) && ( defined( HAVE_ZLIB ) || defined( ZLIB_DLL ) ) */
+int libewf_checksum_calculate_adler32(
+     uint32_t *checksum_value,
+     const uint8_t *buffer,
+     size_t size,
+     uint32_t initial_value,
+     libcerror_error_t **error );
 
 #if defined( __cplusplus )
 }
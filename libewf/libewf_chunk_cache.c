@@ -0,0 +1,1405 @@
+/*
+ * Chunk cache functions
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_chunk_cache.h"
+#include "libewf_chunk_data.h"
+#include "libewf_definitions.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+
+/* Frees a chunk cache value
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_value_free(
+     libewf_chunk_cache_value_t **chunk_cache_value,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_cache_value_free";
+	int result            = 1;
+
+	if( chunk_cache_value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache value.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_cache_value != NULL )
+	{
+		if( ( *chunk_cache_value )->chunk_data != NULL )
+		{
+			if( libewf_chunk_data_free(
+			     &( ( *chunk_cache_value )->chunk_data ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free chunk data.",
+				 function );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 *chunk_cache_value );
+
+		*chunk_cache_value = NULL;
+	}
+	return( result );
+}
+
+/* Creates a chunk cache
+ * Make sure the value chunk_cache is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_initialize(
+     libewf_chunk_cache_t **chunk_cache,
+     size64_t maximum_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_cache_initialize";
+	size_t buckets_size   = 0;
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_cache != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid chunk cache value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_size > (size64_t) INT64_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid maximum size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	*chunk_cache = memory_allocate_structure(
+	                libewf_chunk_cache_t );
+
+	if( *chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create chunk cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *chunk_cache,
+	     0,
+	     sizeof( libewf_chunk_cache_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear chunk cache.",
+		 function );
+
+		memory_free(
+		 *chunk_cache );
+
+		*chunk_cache = NULL;
+
+		return( -1 );
+	}
+	buckets_size = sizeof( libewf_chunk_cache_value_t * ) * LIBEWF_CHUNK_CACHE_NUMBER_OF_BUCKETS;
+
+	( *chunk_cache )->buckets = (libewf_chunk_cache_value_t **) memory_allocate(
+	                                                              buckets_size );
+
+	if( ( *chunk_cache )->buckets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buckets.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *chunk_cache )->buckets,
+	     0,
+	     buckets_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear buckets.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *chunk_cache )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	( *chunk_cache )->maximum_size         = maximum_size;
+	( *chunk_cache )->number_of_buckets    = LIBEWF_CHUNK_CACHE_NUMBER_OF_BUCKETS;
+	( *chunk_cache )->number_of_references = 1;
+
+	return( 1 );
+
+on_error:
+	if( *chunk_cache != NULL )
+	{
+		if( ( *chunk_cache )->buckets != NULL )
+		{
+			memory_free(
+			 ( *chunk_cache )->buckets );
+		}
+		memory_free(
+		 *chunk_cache );
+
+		*chunk_cache = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a chunk cache
+ * The chunk cache is only freed when its last reference is released
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_free(
+     libewf_chunk_cache_t **chunk_cache,
+     libcerror_error_t **error )
+{
+	static char *function    = "libewf_chunk_cache_free";
+	int number_of_references = 0;
+	int result               = 1;
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_cache != NULL )
+	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_grab(
+		     ( *chunk_cache )->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+		( *chunk_cache )->number_of_references -= 1;
+
+		number_of_references = ( *chunk_cache )->number_of_references;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_release(
+		     ( *chunk_cache )->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+		if( number_of_references > 0 )
+		{
+			*chunk_cache = NULL;
+
+			return( 1 );
+		}
+		if( libewf_chunk_cache_empty(
+		     *chunk_cache,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to empty chunk cache.",
+			 function );
+
+			result = -1;
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_free(
+		     &( ( *chunk_cache )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		memory_free(
+		 ( *chunk_cache )->buckets );
+
+		memory_free(
+		 *chunk_cache );
+
+		*chunk_cache = NULL;
+	}
+	return( result );
+}
+
+/* Adds a reference to a chunk cache
+ * The reference is released with libewf_chunk_cache_free
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_reference(
+     libewf_chunk_cache_t *chunk_cache,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_cache_reference";
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     chunk_cache->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	chunk_cache->number_of_references += 1;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     chunk_cache->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Empties a chunk cache
+ * Values that are still referenced are freed when their last reference is released
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_empty(
+     libewf_chunk_cache_t *chunk_cache,
+     libcerror_error_t **error )
+{
+	libewf_chunk_cache_value_t *freed_values = NULL;
+	static char *function                    = "libewf_chunk_cache_empty";
+	int bucket_index                         = 0;
+	int result                               = 1;
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     chunk_cache->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	for( bucket_index = 0;
+	     bucket_index < chunk_cache->number_of_buckets;
+	     bucket_index++ )
+	{
+		while( chunk_cache->buckets[ bucket_index ] != NULL )
+		{
+			libewf_chunk_cache_remove_value(
+			 chunk_cache,
+			 chunk_cache->buckets[ bucket_index ],
+			 &freed_values );
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     chunk_cache->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		result = -1;
+	}
+#endif
+	if( libewf_chunk_cache_free_values(
+	     &freed_values,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free values.",
+		 function );
+
+		result = -1;
+	}
+	return( result );
+}
+
+/* Frees a list of values that were removed from the cache
+ * The values are linked by their next value
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_free_values(
+     libewf_chunk_cache_value_t **first_value,
+     libcerror_error_t **error )
+{
+	libewf_chunk_cache_value_t *chunk_cache_value = NULL;
+	static char *function                         = "libewf_chunk_cache_free_values";
+	int result                                    = 1;
+
+	if( first_value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid first value.",
+		 function );
+
+		return( -1 );
+	}
+	while( *first_value != NULL )
+	{
+		chunk_cache_value = *first_value;
+		*first_value      = chunk_cache_value->next_value;
+
+		if( libewf_chunk_cache_value_free(
+		     &chunk_cache_value,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk cache value.",
+			 function );
+
+			result = -1;
+		}
+	}
+	return( result );
+}
+
+/* Removes a value from its segment
+ * This function needs to be called with the mutex grabbed
+ */
+void libewf_chunk_cache_segment_remove_value(
+      libewf_chunk_cache_t *chunk_cache,
+      libewf_chunk_cache_value_t *chunk_cache_value )
+{
+	libewf_chunk_cache_segment_t *segment = NULL;
+
+	segment = &( chunk_cache->segments[ chunk_cache_value->segment_index ] );
+
+	if( chunk_cache_value->previous_value != NULL )
+	{
+		chunk_cache_value->previous_value->next_value = chunk_cache_value->next_value;
+	}
+	else
+	{
+		segment->first_value = chunk_cache_value->next_value;
+	}
+	if( chunk_cache_value->next_value != NULL )
+	{
+		chunk_cache_value->next_value->previous_value = chunk_cache_value->previous_value;
+	}
+	else
+	{
+		segment->last_value = chunk_cache_value->previous_value;
+	}
+	segment->size -= chunk_cache_value->size;
+
+	chunk_cache_value->previous_value = NULL;
+	chunk_cache_value->next_value     = NULL;
+}
+
+/* Prepends a value to a segment, as the most recently used value
+ * This function needs to be called with the mutex grabbed
+ */
+void libewf_chunk_cache_segment_prepend_value(
+      libewf_chunk_cache_t *chunk_cache,
+      uint8_t segment_index,
+      libewf_chunk_cache_value_t *chunk_cache_value )
+{
+	libewf_chunk_cache_segment_t *segment = NULL;
+
+	segment = &( chunk_cache->segments[ segment_index ] );
+
+	chunk_cache_value->segment_index  = segment_index;
+	chunk_cache_value->previous_value = NULL;
+	chunk_cache_value->next_value     = segment->first_value;
+
+	if( segment->first_value != NULL )
+	{
+		segment->first_value->previous_value = chunk_cache_value;
+	}
+	else
+	{
+		segment->last_value = chunk_cache_value;
+	}
+	segment->first_value = chunk_cache_value;
+	segment->size       += chunk_cache_value->size;
+}
+
+/* Removes a value from the cache
+ * Values that are no longer referenced are prepended to the freed values
+ * This function needs to be called with the mutex grabbed
+ */
+void libewf_chunk_cache_remove_value(
+      libewf_chunk_cache_t *chunk_cache,
+      libewf_chunk_cache_value_t *chunk_cache_value,
+      libewf_chunk_cache_value_t **freed_values )
+{
+	libewf_chunk_cache_value_t **bucket_value = NULL;
+
+	bucket_value = &( chunk_cache->buckets[ chunk_cache_value->chunk_index % chunk_cache->number_of_buckets ] );
+
+	while( ( *bucket_value != NULL )
+	    && ( *bucket_value != chunk_cache_value ) )
+	{
+		bucket_value = &( ( *bucket_value )->next_bucket_value );
+	}
+	if( *bucket_value == chunk_cache_value )
+	{
+		*bucket_value = chunk_cache_value->next_bucket_value;
+	}
+	chunk_cache_value->next_bucket_value = NULL;
+
+	libewf_chunk_cache_segment_remove_value(
+	 chunk_cache,
+	 chunk_cache_value );
+
+	chunk_cache->size             -= chunk_cache_value->size;
+	chunk_cache->number_of_values -= 1;
+
+	chunk_cache_value->is_cached = 0;
+
+	/* The last reference frees a value that is still in use
+	 */
+	if( chunk_cache_value->number_of_references == 0 )
+	{
+		chunk_cache_value->next_value = *freed_values;
+		*freed_values                 = chunk_cache_value;
+	}
+}
+
+/* Evicts values until the cache no longer exceeds its maximum size
+ * Values are evicted from the probationary segment before the protected segment
+ * This function needs to be called with the mutex grabbed
+ */
+void libewf_chunk_cache_evict_values(
+      libewf_chunk_cache_t *chunk_cache,
+      libewf_chunk_cache_value_t **freed_values )
+{
+	libewf_chunk_cache_value_t *chunk_cache_value = NULL;
+
+	while( chunk_cache->size > chunk_cache->maximum_size )
+	{
+		chunk_cache_value = chunk_cache->segments[ LIBEWF_CHUNK_CACHE_SEGMENT_PROBATIONARY ].last_value;
+
+		if( chunk_cache_value == NULL )
+		{
+			chunk_cache_value = chunk_cache->segments[ LIBEWF_CHUNK_CACHE_SEGMENT_PROTECTED ].last_value;
+		}
+		if( chunk_cache_value == NULL )
+		{
+			break;
+		}
+		libewf_chunk_cache_remove_value(
+		 chunk_cache,
+		 chunk_cache_value,
+		 freed_values );
+	}
+}
+
+/* Retrieves the maximum size
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_get_maximum_size(
+     libewf_chunk_cache_t *chunk_cache,
+     size64_t *maximum_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_cache_get_maximum_size";
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid maximum size.",
+		 function );
+
+		return( -1 );
+	}
+	*maximum_size = chunk_cache->maximum_size;
+
+	return( 1 );
+}
+
+/* Sets the maximum size
+ * Values are evicted when the cache exceeds the new maximum size
+ * A maximum size of 0 disables caching
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_set_maximum_size(
+     libewf_chunk_cache_t *chunk_cache,
+     size64_t maximum_size,
+     libcerror_error_t **error )
+{
+	libewf_chunk_cache_value_t *freed_values = NULL;
+	static char *function                    = "libewf_chunk_cache_set_maximum_size";
+	int result                               = 1;
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_size > (size64_t) INT64_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid maximum size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     chunk_cache->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	chunk_cache->maximum_size = maximum_size;
+
+	libewf_chunk_cache_evict_values(
+	 chunk_cache,
+	 &freed_values );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     chunk_cache->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		result = -1;
+	}
+#endif
+	if( libewf_chunk_cache_free_values(
+	     &freed_values,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free evicted values.",
+		 function );
+
+		result = -1;
+	}
+	return( result );
+}
+
+/* Retrieves the number of cache hits and misses
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_get_statistics(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_cache_get_statistics";
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_hits == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of hits.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_misses == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of misses.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     chunk_cache->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*number_of_hits   = chunk_cache->number_of_hits;
+	*number_of_misses = chunk_cache->number_of_misses;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     chunk_cache->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Resets the number of cache hits and misses
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_reset_statistics(
+     libewf_chunk_cache_t *chunk_cache,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_cache_reset_statistics";
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     chunk_cache->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	chunk_cache->number_of_hits   = 0;
+	chunk_cache->number_of_misses = 0;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     chunk_cache->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Determines if the cache contains a value of a specific chunk
+ * This function does not take a reference, access the value or count as a hit or miss
+ * Returns 1 if the cache contains the value, 0 if not or -1 on error
+ */
+int libewf_chunk_cache_has_value_by_index(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t chunk_index,
+     libcerror_error_t **error )
+{
+	libewf_chunk_cache_value_t *chunk_cache_value = NULL;
+	static char *function                         = "libewf_chunk_cache_has_value_by_index";
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     chunk_cache->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	chunk_cache_value = chunk_cache->buckets[ chunk_index % chunk_cache->number_of_buckets ];
+
+	while( ( chunk_cache_value != NULL )
+	    && ( chunk_cache_value->chunk_index != chunk_index ) )
+	{
+		chunk_cache_value = chunk_cache_value->next_bucket_value;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     chunk_cache->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( chunk_cache_value == NULL )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the value of a specific chunk
+ * A value that is accessed again is moved to the protected segment
+ * The first access of a value that was read ahead does not count as accessed again
+ * A reference is taken on the value that must be released with libewf_chunk_cache_release_value
+ * Returns 1 if successful, 0 if no such value or -1 on error
+ */
+int libewf_chunk_cache_get_value_by_index(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t chunk_index,
+     libewf_chunk_cache_value_t **chunk_cache_value,
+     libcerror_error_t **error )
+{
+	libewf_chunk_cache_segment_t *protected_segment       = NULL;
+	libewf_chunk_cache_value_t *demoted_chunk_cache_value = NULL;
+	libewf_chunk_cache_value_t *safe_chunk_cache_value    = NULL;
+	static char *function                                 = "libewf_chunk_cache_get_value_by_index";
+	size64_t maximum_protected_size                       = 0;
+	int result                                            = 0;
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_cache_value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache value.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     chunk_cache->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	safe_chunk_cache_value = chunk_cache->buckets[ chunk_index % chunk_cache->number_of_buckets ];
+
+	while( ( safe_chunk_cache_value != NULL )
+	    && ( safe_chunk_cache_value->chunk_index != chunk_index ) )
+	{
+		safe_chunk_cache_value = safe_chunk_cache_value->next_bucket_value;
+	}
+	if( safe_chunk_cache_value == NULL )
+	{
+		chunk_cache->number_of_misses += 1;
+	}
+	else
+	{
+		chunk_cache->number_of_hits += 1;
+
+		safe_chunk_cache_value->number_of_references += 1;
+
+		libewf_chunk_cache_segment_remove_value(
+		 chunk_cache,
+		 safe_chunk_cache_value );
+
+		if( safe_chunk_cache_value->is_read_ahead != 0 )
+		{
+			safe_chunk_cache_value->is_read_ahead = 0;
+
+			libewf_chunk_cache_segment_prepend_value(
+			 chunk_cache,
+			 LIBEWF_CHUNK_CACHE_SEGMENT_PROBATIONARY,
+			 safe_chunk_cache_value );
+		}
+		else
+		{
+			libewf_chunk_cache_segment_prepend_value(
+			 chunk_cache,
+			 LIBEWF_CHUNK_CACHE_SEGMENT_PROTECTED,
+			 safe_chunk_cache_value );
+		}
+
+		/* Demote the least recently used protected values when the protected segment
+		 * exceeds 3/4 of the maximum cache size
+		 */
+		protected_segment      = &( chunk_cache->segments[ LIBEWF_CHUNK_CACHE_SEGMENT_PROTECTED ] );
+		maximum_protected_size = chunk_cache->maximum_size - ( chunk_cache->maximum_size / 4 );
+
+		while( ( protected_segment->size > maximum_protected_size )
+		    && ( protected_segment->last_value != NULL ) )
+		{
+			demoted_chunk_cache_value = protected_segment->last_value;
+
+			libewf_chunk_cache_segment_remove_value(
+			 chunk_cache,
+			 demoted_chunk_cache_value );
+
+			libewf_chunk_cache_segment_prepend_value(
+			 chunk_cache,
+			 LIBEWF_CHUNK_CACHE_SEGMENT_PROBATIONARY,
+			 demoted_chunk_cache_value );
+		}
+		result = 1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     chunk_cache->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( result != 0 )
+	{
+		*chunk_cache_value = safe_chunk_cache_value;
+	}
+	return( result );
+}
+
+/* Sets the value of a specific chunk
+ * The cache takes over management of the chunk data and sets it to NULL
+ * If another value was set for the chunk in the mean time the chunk data is freed
+ * and the existing value is returned instead
+ * Values that are read ahead are not considered accessed until retrieved
+ * A reference is taken on the value that must be released with libewf_chunk_cache_release_value
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_set_value_by_index(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t chunk_index,
+     libewf_chunk_data_t **chunk_data,
+     uint8_t is_read_ahead,
+     libewf_chunk_cache_value_t **chunk_cache_value,
+     libcerror_error_t **error )
+{
+	libewf_chunk_cache_value_t *existing_chunk_cache_value = NULL;
+	libewf_chunk_cache_value_t *freed_values               = NULL;
+	libewf_chunk_cache_value_t *safe_chunk_cache_value     = NULL;
+	static char *function                                  = "libewf_chunk_cache_set_value_by_index";
+	int bucket_index                                       = 0;
+	int result                                             = 1;
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: missing chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_cache_value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache value.",
+		 function );
+
+		return( -1 );
+	}
+	safe_chunk_cache_value = memory_allocate_structure(
+	                          libewf_chunk_cache_value_t );
+
+	if( safe_chunk_cache_value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create chunk cache value.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     safe_chunk_cache_value,
+	     0,
+	     sizeof( libewf_chunk_cache_value_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear chunk cache value.",
+		 function );
+
+		memory_free(
+		 safe_chunk_cache_value );
+
+		return( -1 );
+	}
+	safe_chunk_cache_value->chunk_index          = chunk_index;
+	safe_chunk_cache_value->chunk_data           = *chunk_data;
+	safe_chunk_cache_value->size                 = sizeof( libewf_chunk_cache_value_t )
+	                                             + sizeof( libewf_chunk_data_t )
+	                                             + ( *chunk_data )->allocated_data_size;
+	safe_chunk_cache_value->number_of_references = 1;
+	safe_chunk_cache_value->is_read_ahead        = is_read_ahead;
+
+	*chunk_data = NULL;
+
+	bucket_index = (int) ( chunk_index % chunk_cache->number_of_buckets );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     chunk_cache->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		libewf_chunk_cache_value_free(
+		 &safe_chunk_cache_value,
+		 NULL );
+
+		return( -1 );
+	}
+#endif
+	existing_chunk_cache_value = chunk_cache->buckets[ bucket_index ];
+
+	while( ( existing_chunk_cache_value != NULL )
+	    && ( existing_chunk_cache_value->chunk_index != chunk_index ) )
+	{
+		existing_chunk_cache_value = existing_chunk_cache_value->next_bucket_value;
+	}
+	if( existing_chunk_cache_value != NULL )
+	{
+		/* Another thread unpacked the same chunk first
+		 */
+		existing_chunk_cache_value->number_of_references += 1;
+
+		*chunk_cache_value = existing_chunk_cache_value;
+
+		freed_values = safe_chunk_cache_value;
+	}
+	else
+	{
+		safe_chunk_cache_value->is_cached         = 1;
+		safe_chunk_cache_value->next_bucket_value = chunk_cache->buckets[ bucket_index ];
+
+		chunk_cache->buckets[ bucket_index ] = safe_chunk_cache_value;
+
+		libewf_chunk_cache_segment_prepend_value(
+		 chunk_cache,
+		 LIBEWF_CHUNK_CACHE_SEGMENT_PROBATIONARY,
+		 safe_chunk_cache_value );
+
+		chunk_cache->size             += safe_chunk_cache_value->size;
+		chunk_cache->number_of_values += 1;
+
+		*chunk_cache_value = safe_chunk_cache_value;
+
+		libewf_chunk_cache_evict_values(
+		 chunk_cache,
+		 &freed_values );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     chunk_cache->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		result = -1;
+	}
+#endif
+	if( libewf_chunk_cache_free_values(
+	     &freed_values,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free evicted values.",
+		 function );
+
+		result = -1;
+	}
+	return( result );
+}
+
+/* Releases a reference on a value
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_release_value(
+     libewf_chunk_cache_t *chunk_cache,
+     libewf_chunk_cache_value_t **chunk_cache_value,
+     libcerror_error_t **error )
+{
+	libewf_chunk_cache_value_t *safe_chunk_cache_value = NULL;
+	static char *function                              = "libewf_chunk_cache_release_value";
+	int result                                         = 1;
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_cache_value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache value.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_cache_value == NULL )
+	{
+		return( 1 );
+	}
+	safe_chunk_cache_value = *chunk_cache_value;
+	*chunk_cache_value     = NULL;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     chunk_cache->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( safe_chunk_cache_value->number_of_references > 0 )
+	{
+		safe_chunk_cache_value->number_of_references -= 1;
+	}
+	if( ( safe_chunk_cache_value->number_of_references > 0 )
+	 || ( safe_chunk_cache_value->is_cached != 0 ) )
+	{
+		safe_chunk_cache_value = NULL;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     chunk_cache->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		result = -1;
+	}
+#endif
+	if( safe_chunk_cache_value != NULL )
+	{
+		if( libewf_chunk_cache_value_free(
+		     &safe_chunk_cache_value,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk cache value.",
+			 function );
+
+			result = -1;
+		}
+	}
+	return( result );
+}
+
@@ -0,0 +1,244 @@
+/*
+ * Chunk cache functions
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_CHUNK_CACHE_H )
+#define _LIBEWF_CHUNK_CACHE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_chunk_data.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_chunk_cache_value libewf_chunk_cache_value_t;
+
+struct libewf_chunk_cache_value
+{
+	/* The chunk index
+	 */
+	uint64_t chunk_index;
+
+	/* The (unpacked) chunk data
+	 */
+	libewf_chunk_data_t *chunk_data;
+
+	/* The size of the value accounted for in the cache
+	 */
+	size_t size;
+
+	/* The number of references
+	 */
+	int number_of_references;
+
+	/* Value to indicate the value is stored in the cache
+	 */
+	uint8_t is_cached;
+
+	/* Value to indicate the value was read ahead and not yet accessed
+	 */
+	uint8_t is_read_ahead;
+
+	/* The segment that contains the value
+	 */
+	uint8_t segment_index;
+
+	/* The previous value in the segment
+	 */
+	libewf_chunk_cache_value_t *previous_value;
+
+	/* The next value in the segment
+	 */
+	libewf_chunk_cache_value_t *next_value;
+
+	/* The next value in the bucket
+	 */
+	libewf_chunk_cache_value_t *next_bucket_value;
+};
+
+typedef struct libewf_chunk_cache_segment libewf_chunk_cache_segment_t;
+
+struct libewf_chunk_cache_segment
+{
+	/* The most recently used value
+	 */
+	libewf_chunk_cache_value_t *first_value;
+
+	/* The least recently used value
+	 */
+	libewf_chunk_cache_value_t *last_value;
+
+	/* The size of the values in the segment
+	 */
+	size64_t size;
+};
+
+typedef struct libewf_chunk_cache libewf_chunk_cache_t;
+
+/* The chunk cache is a segmented LRU cache with a memory budget
+ * Values are first stored in the probationary segment and are moved to
+ * the protected segment when accessed again. Values are evicted from the
+ * probationary segment first, hence a single sequential scan cannot flush
+ * frequently used chunks out of the cache
+ */
+struct libewf_chunk_cache
+{
+	/* The maximum size
+	 */
+	size64_t maximum_size;
+
+	/* The size of the cached values
+	 */
+	size64_t size;
+
+	/* The number of cached values
+	 */
+	int number_of_values;
+
+	/* The number of buckets
+	 */
+	int number_of_buckets;
+
+	/* The buckets
+	 */
+	libewf_chunk_cache_value_t **buckets;
+
+	/* The probationary and protected segments
+	 */
+	libewf_chunk_cache_segment_t segments[ 2 ];
+
+	/* The number of cache hits
+	 */
+	uint64_t number_of_hits;
+
+	/* The number of cache misses
+	 */
+	uint64_t number_of_misses;
+
+	/* The number of references
+	 * The chunk cache can be shared between cloned handles
+	 */
+	int number_of_references;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+#endif
+};
+
+int libewf_chunk_cache_value_free(
+     libewf_chunk_cache_value_t **chunk_cache_value,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_initialize(
+     libewf_chunk_cache_t **chunk_cache,
+     size64_t maximum_size,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_free(
+     libewf_chunk_cache_t **chunk_cache,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_reference(
+     libewf_chunk_cache_t *chunk_cache,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_empty(
+     libewf_chunk_cache_t *chunk_cache,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_free_values(
+     libewf_chunk_cache_value_t **first_value,
+     libcerror_error_t **error );
+
+void libewf_chunk_cache_segment_remove_value(
+      libewf_chunk_cache_t *chunk_cache,
+      libewf_chunk_cache_value_t *chunk_cache_value );
+
+void libewf_chunk_cache_segment_prepend_value(
+      libewf_chunk_cache_t *chunk_cache,
+      uint8_t segment_index,
+      libewf_chunk_cache_value_t *chunk_cache_value );
+
+void libewf_chunk_cache_remove_value(
+      libewf_chunk_cache_t *chunk_cache,
+      libewf_chunk_cache_value_t *chunk_cache_value,
+      libewf_chunk_cache_value_t **freed_values );
+
+void libewf_chunk_cache_evict_values(
+      libewf_chunk_cache_t *chunk_cache,
+      libewf_chunk_cache_value_t **freed_values );
+
+int libewf_chunk_cache_get_maximum_size(
+     libewf_chunk_cache_t *chunk_cache,
+     size64_t *maximum_size,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_set_maximum_size(
+     libewf_chunk_cache_t *chunk_cache,
+     size64_t maximum_size,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_get_statistics(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_reset_statistics(
+     libewf_chunk_cache_t *chunk_cache,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_has_value_by_index(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t chunk_index,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_get_value_by_index(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t chunk_index,
+     libewf_chunk_cache_value_t **chunk_cache_value,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_set_value_by_index(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t chunk_index,
+     libewf_chunk_data_t **chunk_data,
+     uint8_t is_read_ahead,
+     libewf_chunk_cache_value_t **chunk_cache_value,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_release_value(
+     libewf_chunk_cache_t *chunk_cache,
+     libewf_chunk_cache_value_t **chunk_cache_value,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_CHUNK_CACHE_H ) */
+
@@ -24,15 +24,18 @@
 #include <memory.h>
 #include <types.h>
 
+#include "libewf_buffer_pool.h"
 #include "libewf_checksum.h"
 #include "libewf_chunk_data.h"
 #include "libewf_compression.h"
+#include "libewf_compression_controller.h"
 #include "libewf_definitions.h"
 #include "libewf_libbfio.h"
 #include "libewf_libcerror.h"
 #include "libewf_libcnotify.h"
 #include "libewf_libfcache.h"
 #include "libewf_libfdata.h"
+#include "libewf_statistics.h"
 #include "libewf_types.h"
 #include "libewf_unused.h"
 
@@ -46,8 +49,30 @@ int libewf_chunk_data_initialize(
      uint8_t clear_data,
      libcerror_error_t **error )
 {
-	static char *function      = "libewf_chunk_data_initialize";
+	return( libewf_chunk_data_initialize_with_buffer_pool(
+	         chunk_data,
+	         NULL,
+	         chunk_size,
+	         clear_data,
+	         error ) );
+}
+
+/* Creates chunk data that retrieves its buffers from a buffer pool
+ * Make sure the value chunk_data is referencing, is set to NULL
+ * The buffer pool is optional and must outlive the chunk data
+ * or be detached with libewf_chunk_data_detach_buffer_pool
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_data_initialize_with_buffer_pool(
+     libewf_chunk_data_t **chunk_data,
+     libewf_buffer_pool_t *buffer_pool,
+     size32_t chunk_size,
+     uint8_t clear_data,
+     libcerror_error_t **error )
+{
+	static char *function      = "libewf_chunk_data_initialize_with_buffer_pool";
 	size_t allocated_data_size = 0;
+	int result                 = 0;
 
 	if( chunk_data == NULL )
 	{
@@ -128,10 +153,15 @@ int libewf_chunk_data_initialize(
 	}
 	allocated_data_size = ( allocated_data_size / 16 ) * 16;
 
-	( *chunk_data )->data = (uint8_t *) memory_allocate(
-					     sizeof( uint8_t ) * allocated_data_size );
+	( *chunk_data )->buffer_pool = buffer_pool;
+
+	result = libewf_chunk_data_allocate_buffer(
+	          *chunk_data,
+	          allocated_data_size,
+	          &( ( *chunk_data )->data ),
+	          error );
 
-	if( ( *chunk_data )->data == NULL )
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
@@ -142,6 +172,10 @@ int libewf_chunk_data_initialize(
 
 		goto on_error;
 	}
+	else if( result != 0 )
+	{
+		( *chunk_data )->flags = LIBEWF_CHUNK_DATA_ITEM_FLAG_POOLED_DATA;
+	}
 	if( clear_data != 0 )
 	{
 		if( memory_set(
@@ -161,7 +195,7 @@ int libewf_chunk_data_initialize(
 	}
 	( *chunk_data )->chunk_size          = chunk_size;
 	( *chunk_data )->allocated_data_size = allocated_data_size;
-	( *chunk_data )->flags               = LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA;
+	( *chunk_data )->flags              |= LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA;
 
 	return( 1 );
 
@@ -170,8 +204,11 @@ on_error:
 	{
 		if( ( *chunk_data )->data != NULL )
 		{
-			memory_free(
-			 ( *chunk_data )->data );
+			libewf_chunk_data_free_buffer(
+			 *chunk_data,
+			 &( ( *chunk_data )->data ),
+			 ( *chunk_data )->flags & LIBEWF_CHUNK_DATA_ITEM_FLAG_POOLED_DATA,
+			 NULL );
 		}
 		memory_free(
 		 *chunk_data );
@@ -189,6 +226,7 @@ int libewf_chunk_data_free(
      libcerror_error_t **error )
 {
 	static char *function = "libewf_chunk_data_free";
+	int result            = 1;
 
 	if( chunk_data == NULL )
 	{
@@ -205,22 +243,227 @@ int libewf_chunk_data_free(
 	{
 		if( ( ( *chunk_data )->flags & LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA ) != 0 )
 		{
-			if( ( *chunk_data )->data != NULL )
+			if( libewf_chunk_data_free_buffer(
+			     *chunk_data,
+			     &( ( *chunk_data )->data ),
+			     ( *chunk_data )->flags & LIBEWF_CHUNK_DATA_ITEM_FLAG_POOLED_DATA,
+			     error ) != 1 )
 			{
-				memory_free(
-				 ( *chunk_data )->data );
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free data.",
+				 function );
+
+				result = -1;
 			}
 		}
-		if( ( *chunk_data )->compressed_data != NULL )
+		if( libewf_chunk_data_free_buffer(
+		     *chunk_data,
+		     &( ( *chunk_data )->compressed_data ),
+		     ( *chunk_data )->flags & LIBEWF_CHUNK_DATA_ITEM_FLAG_POOLED_COMPRESSED_DATA,
+		     error ) != 1 )
 		{
-			memory_free(
-			 ( *chunk_data )->compressed_data );
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free compressed data.",
+			 function );
+
+			result = -1;
 		}
 		memory_free(
 		 *chunk_data );
 
 		*chunk_data = NULL;
 	}
+	return( result );
+}
+
+/* Allocates a buffer for the chunk data
+ * The buffer is retrieved from the buffer pool of the chunk data if available and large enough
+ * Returns 1 if the buffer was retrieved from the buffer pool, 0 if the buffer was allocated or -1 on error
+ */
+int libewf_chunk_data_allocate_buffer(
+     libewf_chunk_data_t *chunk_data,
+     size_t buffer_size,
+     uint8_t **buffer,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_data_allocate_buffer";
+	int result            = 0;
+
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( buffer_size == 0 )
+	 || ( buffer_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data->buffer_pool != NULL )
+	{
+		result = libewf_buffer_pool_get_buffer(
+		          chunk_data->buffer_pool,
+		          buffer_size,
+		          buffer,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve buffer from buffer pool.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result != 0 )
+		{
+			return( 1 );
+		}
+	}
+	*buffer = (uint8_t *) memory_allocate(
+	                       sizeof( uint8_t ) * buffer_size );
+
+	if( *buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffer.",
+		 function );
+
+		return( -1 );
+	}
+	return( 0 );
+}
+
+/* Frees a buffer of the chunk data
+ * A buffer that was retrieved from the buffer pool is released to the buffer pool
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_data_free_buffer(
+     libewf_chunk_data_t *chunk_data,
+     uint8_t **buffer,
+     uint8_t is_pooled,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_data_free_buffer";
+
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( *buffer == NULL )
+	{
+		return( 1 );
+	}
+	if( ( is_pooled != 0 )
+	 && ( chunk_data->buffer_pool != NULL ) )
+	{
+		if( libewf_buffer_pool_release_buffer(
+		     chunk_data->buffer_pool,
+		     buffer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release buffer to buffer pool.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	else
+	{
+		/* The buffers of the buffer pool are allocated with memory_allocate
+		 * hence they can be freed after the buffer pool was detached
+		 */
+		memory_free(
+		 *buffer );
+
+		*buffer = NULL;
+	}
+	return( 1 );
+}
+
+/* Detaches the chunk data from its buffer pool
+ * The buffers retrieved from the buffer pool are freed with the chunk data instead,
+ * which is needed when the chunk data can outlive the buffer pool
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_data_detach_buffer_pool(
+     libewf_chunk_data_t *chunk_data,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_data_detach_buffer_pool";
+
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_data->buffer_pool = NULL;
+	chunk_data->flags      &= ~( LIBEWF_CHUNK_DATA_ITEM_FLAG_POOLED_DATA | LIBEWF_CHUNK_DATA_ITEM_FLAG_POOLED_COMPRESSED_DATA );
+
 	return( 1 );
 }
 
@@ -297,6 +540,8 @@ int libewf_chunk_data_clone(
 	}
 	( *destination_chunk_data )->data            = NULL;
 	( *destination_chunk_data )->compressed_data = NULL;
+	( *destination_chunk_data )->buffer_pool     = NULL;
+	( *destination_chunk_data )->flags          &= ~( LIBEWF_CHUNK_DATA_ITEM_FLAG_POOLED_DATA | LIBEWF_CHUNK_DATA_ITEM_FLAG_POOLED_COMPRESSED_DATA );
 
 	if( source_chunk_data->data != NULL )
 	{
@@ -553,6 +798,7 @@ ssize_t libewf_chunk_data_write_buffer(
 
 /* Packs the chunk data
  * This function either adds the checksum or compresses the chunk data
+ * The deflate encoder is reused by subsequent calls, refer to libewf_compress_data_with_level
  * Returns 1 if successful or -1 on error
  */
 int libewf_chunk_data_pack(
@@ -561,11 +807,17 @@ int libewf_chunk_data_pack(
      const uint8_t *compressed_zero_byte_empty_block,
      size_t compressed_zero_byte_empty_block_size,
      uint8_t pack_flags,
+     libewf_deflate_encoder_t **deflate_encoder,
      libcerror_error_t **error )
 {
 	static char *function            = "libewf_chunk_data_pack";
 	size_t safe_compressed_data_size = 0;
 	uint64_t fill_pattern            = 0;
+	uint64_t compression_time        = 0;
+	uint64_t start_timestamp         = 0;
+	uint8_t skip_compression         = 0;
+	int8_t compression_level         = 0;
+	int adaptive_compression_level   = 0;
 	int result                       = 0;
 
 	if( chunk_data == NULL )
@@ -695,8 +947,42 @@ int libewf_chunk_data_pack(
 	 */
 	chunk_data->range_flags = 0;
 
+	/* Store chunk data that is estimated to be incompressible, such as encrypted
+	 * or already compressed data, without trying to compress it first
+	 */
 	if( ( io_handle->compression_level != LIBEWF_COMPRESSION_NONE )
-	 || ( ( pack_flags & LIBEWF_PACK_FLAG_FORCE_COMPRESSION ) != 0 ) )
+	 && ( io_handle->compression_entropy_threshold != 0 )
+	 && ( ( pack_flags & LIBEWF_PACK_FLAG_FORCE_COMPRESSION ) == 0 ) )
+	{
+		result = libewf_chunk_data_check_for_incompressible_data(
+			  chunk_data->data,
+			  chunk_data->data_size,
+			  io_handle->compression_entropy_threshold,
+			  error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if chunk data is incompressible.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result != 0 )
+		{
+			LIBEWF_STATISTICS_ADD(
+			 io_handle->statistics.number_of_skipped_compressions,
+			 1 );
+
+			skip_compression = 1;
+		}
+	}
+	if( ( skip_compression == 0 )
+	 && ( ( io_handle->compression_level != LIBEWF_COMPRESSION_NONE )
+	  || ( ( pack_flags & LIBEWF_PACK_FLAG_FORCE_COMPRESSION ) != 0 ) ) )
 	{
 		if( ( pack_flags & LIBEWF_PACK_FLAG_FORCE_COMPRESSION ) == 0 )
 		{
@@ -723,10 +1009,13 @@ int libewf_chunk_data_pack(
 		{
 			chunk_data->compressed_data_size = 2 * chunk_data->chunk_size;
 		}
-		chunk_data->compressed_data = (uint8_t *) memory_allocate(
-		                                           sizeof( uint8_t ) * chunk_data->compressed_data_size );
+		result = libewf_chunk_data_allocate_buffer(
+		          chunk_data,
+		          chunk_data->compressed_data_size,
+		          &( chunk_data->compressed_data ),
+		          error );
 
-		if( chunk_data->compressed_data == NULL )
+		if( result == -1 )
 		{
 			libcerror_error_set(
 			 error,
@@ -737,6 +1026,10 @@ int libewf_chunk_data_pack(
 
 			goto on_error;
 		}
+		else if( result != 0 )
+		{
+			chunk_data->flags |= LIBEWF_CHUNK_DATA_ITEM_FLAG_POOLED_COMPRESSED_DATA;
+		}
 		if( ( ( pack_flags & LIBEWF_PACK_FLAG_USE_PATTERN_FILL_COMPRESSION ) != 0 )
 		 && ( chunk_data->data_size == (size_t) chunk_data->chunk_size ) )
 		{
@@ -801,22 +1094,70 @@ int libewf_chunk_data_pack(
 		else
 		{
 			/* If compression was forced but no compression level provided use the default
+			 * The IO handle is shared by the pack threads hence it is not changed
 			 */
-			if( io_handle->compression_level == LIBEWF_COMPRESSION_NONE )
+			compression_level = io_handle->compression_level;
+
+			if( compression_level == LIBEWF_COMPRESSION_NONE )
 			{
-				io_handle->compression_level = LIBEWF_COMPRESSION_DEFAULT;
+				compression_level = LIBEWF_COMPRESSION_DEFAULT;
+			}
+			/* Adaptive compression chooses the deflate compression level per chunk
+			 */
+			if( ( ( io_handle->compression_flags & LIBEWF_COMPRESS_FLAG_USE_ADAPTIVE_COMPRESSION ) != 0 )
+			 && ( io_handle->compression_method == LIBEWF_COMPRESSION_METHOD_DEFLATE )
+			 && ( io_handle->compression_controller != NULL ) )
+			{
+				if( libewf_compression_controller_get_compression_level(
+				     io_handle->compression_controller,
+				     &adaptive_compression_level,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve adaptive compression level.",
+					 function );
+
+					goto on_error;
+				}
 			}
 			safe_compressed_data_size = chunk_data->compressed_data_size;
 
-/* TODO add a light weight entropy test */
-			result = libewf_compress_data(
-				  chunk_data->compressed_data,
-				  &safe_compressed_data_size,
-				  io_handle->compression_method,
-				  io_handle->compression_level,
-				  chunk_data->data,
-				  chunk_data->data_size,
-				  error );
+			start_timestamp = libewf_statistics_get_timestamp();
+
+			if( adaptive_compression_level != 0 )
+			{
+				result = libewf_compress_data_with_level(
+					  chunk_data->compressed_data,
+					  &safe_compressed_data_size,
+					  io_handle->compression_method,
+					  adaptive_compression_level,
+					  io_handle->compression_flags,
+					  chunk_data->data,
+					  chunk_data->data_size,
+					  deflate_encoder,
+					  error );
+			}
+			else
+			{
+				result = libewf_compress_data(
+					  chunk_data->compressed_data,
+					  &safe_compressed_data_size,
+					  io_handle->compression_method,
+					  compression_level,
+					  io_handle->compression_flags,
+					  chunk_data->data,
+					  chunk_data->data_size,
+					  deflate_encoder,
+					  error );
+			}
+			compression_time = libewf_statistics_get_timestamp() - start_timestamp;
+
+			LIBEWF_STATISTICS_ADD(
+			 io_handle->statistics.compression_time,
+			 compression_time );
 
 			if( result == -1 )
 			{
@@ -852,6 +1193,26 @@ int libewf_chunk_data_pack(
 					goto on_error;
 				}
 			}
+			if( adaptive_compression_level != 0 )
+			{
+				if( libewf_compression_controller_update(
+				     io_handle->compression_controller,
+				     adaptive_compression_level,
+				     chunk_data->data_size,
+				     safe_compressed_data_size,
+				     compression_time,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to update compression controller.",
+					 function );
+
+					goto on_error;
+				}
+			}
 		}
 		if( ( ( pack_flags & LIBEWF_PACK_FLAG_FORCE_COMPRESSION ) != 0 )
 		 || ( safe_compressed_data_size < chunk_data->data_size ) )
@@ -1006,15 +1367,61 @@ int libewf_chunk_data_pack(
 	{
 		if( ( chunk_data->flags & LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA ) != 0 )
 		{
-			memory_free(
-			 chunk_data->data );
+			if( libewf_chunk_data_free_buffer(
+			     chunk_data,
+			     &( chunk_data->data ),
+			     chunk_data->flags & LIBEWF_CHUNK_DATA_ITEM_FLAG_POOLED_DATA,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free data.",
+				 function );
+
+				goto on_error;
+			}
 		}
-		chunk_data->data  = chunk_data->compressed_data;
-		chunk_data->flags = LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA;
+		chunk_data->data = chunk_data->compressed_data;
 
+		if( ( chunk_data->flags & LIBEWF_CHUNK_DATA_ITEM_FLAG_POOLED_COMPRESSED_DATA ) != 0 )
+		{
+			chunk_data->flags = LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA | LIBEWF_CHUNK_DATA_ITEM_FLAG_POOLED_DATA;
+		}
+		else
+		{
+			chunk_data->flags = LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA;
+		}
 		chunk_data->compressed_data      = NULL;
 		chunk_data->compressed_data_size = 0;
 	}
+	else if( chunk_data->compressed_data != NULL )
+	{
+		LIBEWF_STATISTICS_ADD(
+		 io_handle->statistics.number_of_discarded_compressions,
+		 1 );
+
+		/* The compressed data is not used when the chunk is stored uncompressed
+		 * hence it is freed now so that its buffer can be reused
+		 */
+		if( libewf_chunk_data_free_buffer(
+		     chunk_data,
+		     &( chunk_data->compressed_data ),
+		     chunk_data->flags & LIBEWF_CHUNK_DATA_ITEM_FLAG_POOLED_COMPRESSED_DATA,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free compressed data.",
+			 function );
+
+			goto on_error;
+		}
+		chunk_data->flags &= ~( LIBEWF_CHUNK_DATA_ITEM_FLAG_POOLED_COMPRESSED_DATA );
+	}
 	chunk_data->range_flags |= LIBEWF_RANGE_FLAG_IS_PACKED;
 
 	return( 1 );
@@ -1022,11 +1429,13 @@ int libewf_chunk_data_pack(
 on_error:
 	if( chunk_data->compressed_data != NULL )
 	{
-		memory_free(
-		 chunk_data->compressed_data );
-
-		chunk_data->compressed_data = NULL;
+		libewf_chunk_data_free_buffer(
+		 chunk_data,
+		 &( chunk_data->compressed_data ),
+		 chunk_data->flags & LIBEWF_CHUNK_DATA_ITEM_FLAG_POOLED_COMPRESSED_DATA,
+		 NULL );
 	}
+	chunk_data->flags               &= ~( LIBEWF_CHUNK_DATA_ITEM_FLAG_POOLED_COMPRESSED_DATA );
 	chunk_data->compressed_data_size = 0;
 
 	return( -1 );
@@ -1043,7 +1452,9 @@ int libewf_chunk_data_unpack(
 {
 	static char *function        = "libewf_chunk_data_unpack";
 	size_t remaining_chunk_size  = 0;
+	uint64_t start_timestamp     = 0;
 	uint32_t calculated_checksum = 0;
+	int result                   = 0;
 
 	if( chunk_data == NULL )
 	{
@@ -1112,6 +1523,12 @@ int libewf_chunk_data_unpack(
 			chunk_data->compressed_data      = chunk_data->data;
 			chunk_data->compressed_data_size = chunk_data->data_size;
 
+			if( ( chunk_data->flags & LIBEWF_CHUNK_DATA_ITEM_FLAG_POOLED_DATA ) != 0 )
+			{
+				chunk_data->flags &= ~( LIBEWF_CHUNK_DATA_ITEM_FLAG_POOLED_DATA );
+				chunk_data->flags |= LIBEWF_CHUNK_DATA_ITEM_FLAG_POOLED_COMPRESSED_DATA;
+			}
+
 			/* Reserve 4 bytes for the checksum
 			 */
 			chunk_data->allocated_data_size = (size_t) ( chunk_data->chunk_size + 4 );
@@ -1201,13 +1618,27 @@ int libewf_chunk_data_unpack(
 			}
 			else
 			{
-				if( libewf_decompress_data(
-				     chunk_data->compressed_data,
-				     chunk_data->compressed_data_size,
-				     io_handle->compression_method,
-				     chunk_data->data,
-				     &( chunk_data->data_size ),
-				     error ) != 1 )
+				start_timestamp = libewf_statistics_get_timestamp();
+
+				result = libewf_decompress_data(
+				          chunk_data->compressed_data,
+				          chunk_data->compressed_data_size,
+				          io_handle->compression_method,
+				          chunk_data->data,
+				          &( chunk_data->data_size ),
+				          error );
+
+				LIBEWF_STATISTICS_ADD(
+				 io_handle->statistics.decompression_time,
+				 libewf_statistics_get_timestamp() - start_timestamp );
+
+				if( result == 1 )
+				{
+					LIBEWF_STATISTICS_ADD(
+					 io_handle->statistics.bytes_decompressed,
+					 chunk_data->data_size );
+				}
+				else
 				{
 					libcerror_error_set(
 					 error,
@@ -1272,6 +1703,10 @@ int libewf_chunk_data_unpack(
 
 				goto on_error;
 			}
+			LIBEWF_STATISTICS_ADD(
+			 io_handle->statistics.number_of_checksum_verifications,
+			 1 );
+
 			if( chunk_data->checksum != calculated_checksum )
 			{
 				libcerror_error_set(
@@ -1334,6 +1769,11 @@ on_error:
 		chunk_data->data      = chunk_data->compressed_data;
 		chunk_data->data_size = chunk_data->compressed_data_size;
 
+		if( ( chunk_data->flags & LIBEWF_CHUNK_DATA_ITEM_FLAG_POOLED_COMPRESSED_DATA ) != 0 )
+		{
+			chunk_data->flags &= ~( LIBEWF_CHUNK_DATA_ITEM_FLAG_POOLED_COMPRESSED_DATA );
+			chunk_data->flags |= LIBEWF_CHUNK_DATA_ITEM_FLAG_POOLED_DATA;
+		}
 		chunk_data->compressed_data      = NULL;
 		chunk_data->compressed_data_size = 0;
 	}
@@ -1557,6 +1997,175 @@ int libewf_chunk_data_check_for_64_bit_pattern_fill(
 	return( 1 );
 }
 
+/* Determines the base 2 logarithm of a non-zero value
+ * Returns the logarithm as a fixed-point value with 16 fractional bits
+ */
+static uint32_t libewf_chunk_data_get_fixed_point_log2(
+                 uint32_t value )
+{
+	uint64_t fraction   = 0;
+	uint32_t log2_value = 0;
+	int bit_index       = 0;
+
+	while( ( value >> log2_value ) > 1 )
+	{
+		log2_value++;
+	}
+	/* Normalize the value into the range [1, 2) and determine the fractional bits
+	 * by repeatedly squaring it
+	 */
+	fraction   = ( (uint64_t) value << 16 ) >> log2_value;
+	log2_value = log2_value << 16;
+
+	for( bit_index = 15;
+	     bit_index >= 0;
+	     bit_index-- )
+	{
+		fraction = ( fraction * fraction ) >> 16;
+
+		if( fraction >= ( (uint64_t) 2 << 16 ) )
+		{
+			fraction   >>= 1;
+			log2_value  |= (uint32_t) 1 << bit_index;
+		}
+	}
+	return( log2_value );
+}
+
+/* Checks if a buffer containing the chunk data is estimated to be incompressible
+ * The estimate is based on the Shannon entropy of the byte values in blocks sampled across the data
+ * The entropy threshold is a percentage of 8 bits per byte, where 0 disables the check
+ * Returns 1 if the data is estimated to be incompressible, 0 if not or -1 on error
+ */
+int libewf_chunk_data_check_for_incompressible_data(
+     const uint8_t *data,
+     size_t data_size,
+     uint8_t entropy_threshold,
+     libcerror_error_t **error )
+{
+	uint32_t byte_value_counts[ 256 ];
+
+	static char *function      = "libewf_chunk_data_check_for_incompressible_data";
+	size_t block_end_offset    = 0;
+	size_t block_stride        = 0;
+	size_t data_offset         = 0;
+	uint64_t entropy           = 0;
+	uint64_t entropy_sum       = 0;
+	uint32_t number_of_samples = 0;
+	int block_index            = 0;
+	int byte_value             = 0;
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( entropy_threshold > 100 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid entropy threshold value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( entropy_threshold == 0 )
+	 || ( data_size == 0 ) )
+	{
+		return( 0 );
+	}
+	if( memory_set(
+	     byte_value_counts,
+	     0,
+	     sizeof( uint32_t ) * 256 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear byte value counts.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size <= (size_t) ( LIBEWF_ENTROPY_NUMBER_OF_SAMPLE_BLOCKS * LIBEWF_ENTROPY_SAMPLE_BLOCK_SIZE ) )
+	{
+		for( data_offset = 0;
+		     data_offset < data_size;
+		     data_offset++ )
+		{
+			byte_value_counts[ data[ data_offset ] ] += 1;
+		}
+		number_of_samples = (uint32_t) data_size;
+	}
+	else
+	{
+		/* Sample blocks that are spread evenly across the data
+		 */
+		block_stride = data_size / LIBEWF_ENTROPY_NUMBER_OF_SAMPLE_BLOCKS;
+
+		for( block_index = 0;
+		     block_index < LIBEWF_ENTROPY_NUMBER_OF_SAMPLE_BLOCKS;
+		     block_index++ )
+		{
+			data_offset      = (size_t) block_index * block_stride;
+			block_end_offset = data_offset + LIBEWF_ENTROPY_SAMPLE_BLOCK_SIZE;
+
+			while( data_offset < block_end_offset )
+			{
+				byte_value_counts[ data[ data_offset ] ] += 1;
+
+				data_offset++;
+			}
+		}
+		number_of_samples = LIBEWF_ENTROPY_NUMBER_OF_SAMPLE_BLOCKS * LIBEWF_ENTROPY_SAMPLE_BLOCK_SIZE;
+	}
+	/* The entropy is: log2( N ) - ( sum( count * log2( count ) ) / N )
+	 */
+	for( byte_value = 0;
+	     byte_value < 256;
+	     byte_value++ )
+	{
+		if( byte_value_counts[ byte_value ] > 1 )
+		{
+			entropy_sum += (uint64_t) byte_value_counts[ byte_value ]
+			             * libewf_chunk_data_get_fixed_point_log2(
+			                byte_value_counts[ byte_value ] );
+		}
+	}
+	entropy = libewf_chunk_data_get_fixed_point_log2(
+	           number_of_samples );
+
+	entropy -= entropy_sum / number_of_samples;
+
+	/* Compare the entropy against the threshold as a percentage of 8 bits per byte
+	 */
+	if( ( entropy * 100 ) >= ( (uint64_t) entropy_threshold * ( 8 << 16 ) ) )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
 /* Writes a chunk
  * Returns 1 if successful or -1 on error
  */
@@ -1935,6 +2544,86 @@ ssize_t libewf_chunk_data_read_from_file_io_pool(
 	return( read_count );
 }
 
+/* Reads (packed) chunk data from a buffer
+ * The buffer contains the chunk data as stored in the segment file
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libewf_chunk_data_read_from_buffer(
+         libewf_chunk_data_t *chunk_data,
+         const uint8_t *buffer,
+         size_t buffer_size,
+         uint32_t chunk_data_flags,
+         libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_data_read_from_buffer";
+
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data->data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid chunk data - missing data.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( buffer_size == 0 )
+	 || ( buffer_size > chunk_data->allocated_data_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     chunk_data->data,
+	     buffer,
+	     buffer_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy buffer to chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_data->data_size = buffer_size;
+
+	chunk_data->range_flags = ( chunk_data_flags | LIBEWF_RANGE_FLAG_IS_PACKED )
+	                        & ~( LIBEWF_RANGE_FLAG_IS_TAINTED | LIBEWF_RANGE_FLAG_IS_CORRUPTED );
+
+	return( (ssize_t) buffer_size );
+}
+
 /* Reads chunk data
  * Callback function for the chunks list
  * Returns 1 if successful or -1 on error
@@ -25,6 +25,8 @@
 #include <common.h>
 #include <types.h>
 
+#include "libewf_buffer_pool.h"
+#include "libewf_deflate.h"
 #include "libewf_io_handle.h"
 #include "libewf_libbfio.h"
 #include "libewf_libcerror.h"
@@ -79,6 +81,10 @@ struct libewf_chunk_data
 	 */
 	uint32_t checksum;
 
+	/* The buffer pool
+	 */
+	libewf_buffer_pool_t *buffer_pool;
+
 	/* The flags
 	 */
 	uint8_t flags;
@@ -94,10 +100,33 @@ int libewf_chunk_data_initialize(
      uint8_t clear_data,
      libcerror_error_t **error );
 
+int libewf_chunk_data_initialize_with_buffer_pool(
+     libewf_chunk_data_t **chunk_data,
+     libewf_buffer_pool_t *buffer_pool,
+     size32_t chunk_size,
+     uint8_t clear_data,
+     libcerror_error_t **error );
+
 int libewf_chunk_data_free(
      libewf_chunk_data_t **chunk_data,
      libcerror_error_t **error );
 
+int libewf_chunk_data_allocate_buffer(
+     libewf_chunk_data_t *chunk_data,
+     size_t buffer_size,
+     uint8_t **buffer,
+     libcerror_error_t **error );
+
+int libewf_chunk_data_free_buffer(
+     libewf_chunk_data_t *chunk_data,
+     uint8_t **buffer,
+     uint8_t is_pooled,
+     libcerror_error_t **error );
+
+int libewf_chunk_data_detach_buffer_pool(
+     libewf_chunk_data_t *chunk_data,
+     libcerror_error_t **error );
+
 int libewf_chunk_data_clone(
      libewf_chunk_data_t **destination_chunk_data,
      libewf_chunk_data_t *source_chunk_data,
@@ -121,6 +150,7 @@ int libewf_chunk_data_pack(
      const uint8_t *compressed_zero_byte_empty_block,
      size_t compressed_zero_byte_empty_block_size,
      uint8_t pack_flags,
+     libewf_deflate_encoder_t **deflate_encoder,
      libcerror_error_t **error );
 
 int libewf_chunk_data_unpack(
@@ -139,6 +169,12 @@ int libewf_chunk_data_check_for_64_bit_pattern_fill(
      uint64_t *pattern,
      libcerror_error_t **error );
 
+int libewf_chunk_data_check_for_incompressible_data(
+     const uint8_t *data,
+     size_t data_size,
+     uint8_t entropy_threshold,
+     libcerror_error_t **error );
+
 ssize_t libewf_chunk_data_write(
          libewf_chunk_data_t *chunk_data,
          libbfio_pool_t *file_io_pool,
@@ -165,6 +201,13 @@ ssize_t libewf_chunk_data_read_from_file_io_pool(
          uint32_t chunk_data_flags,
          libcerror_error_t **error );
 
+ssize_t libewf_chunk_data_read_from_buffer(
+         libewf_chunk_data_t *chunk_data,
+         const uint8_t *buffer,
+         size_t buffer_size,
+         uint32_t chunk_data_flags,
+         libcerror_error_t **error );
+
 int libewf_chunk_data_read_element_data(
      libewf_io_handle_t *io_handle,
      libbfio_pool_t *file_io_pool,
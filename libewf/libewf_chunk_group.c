@@ -31,8 +31,8 @@
 #include "libewf_libcerror.h"
 #include "libewf_libcnotify.h"
 #include "libewf_libfcache.h"
-#include "libewf_libfdata.h"
 #include "libewf_section.h"
+#include "libewf_statistics.h"
 
 #include "ewf_table.h"
 
@@ -113,47 +113,1043 @@ int libewf_chunk_group_initialize(
 
 		return( -1 );
 	}
-	if( libfdata_list_initialize(
-	     &( ( *chunk_group )->chunks_list ),
-	     (intptr_t *) io_handle,
-	     NULL,
-	     NULL,
-	     (int (*)(intptr_t *, intptr_t *, libfdata_list_element_t *, libfcache_cache_t *, int, off64_t, size64_t, uint32_t, uint8_t, libcerror_error_t **)) &libewf_chunk_data_read_element_data,
-	     NULL,
-	     LIBFDATA_DATA_HANDLE_FLAG_NON_MANAGED,
+	( *chunk_group )->chunk_size         = io_handle->chunk_size;
+	( *chunk_group )->file_io_pool_entry = -1;
+
+	if( libfcache_date_time_get_timestamp(
+	     &( ( *chunk_group )->timestamp ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve cache timestamp.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *chunk_group != NULL )
+	{
+		memory_free(
+		 *chunk_group );
+
+		*chunk_group = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a chunk group
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_group_free(
+     libewf_chunk_group_t **chunk_group,
+     libcerror_error_t **error )
+{
+        static char *function = "libewf_chunk_group_free";
+
+	if( chunk_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk group.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_group != NULL )
+	{
+		if( ( *chunk_group )->data_offsets != NULL )
+		{
+			memory_free(
+			 ( *chunk_group )->data_offsets );
+		}
+		if( ( *chunk_group )->large_data_offsets != NULL )
+		{
+			memory_free(
+			 ( *chunk_group )->large_data_offsets );
+		}
+		if( ( *chunk_group )->data_sizes != NULL )
+		{
+			memory_free(
+			 ( *chunk_group )->data_sizes );
+		}
+		if( ( *chunk_group )->range_flags != NULL )
+		{
+			memory_free(
+			 ( *chunk_group )->range_flags );
+		}
+		memory_free(
+		 *chunk_group );
+
+		*chunk_group = NULL;
+	}
+	return( 1 );
+}
+
+/* Clones the chunk group
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_group_clone(
+     libewf_chunk_group_t **destination_chunk_group,
+     libewf_chunk_group_t *source_chunk_group,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_group_clone";
+
+	if( destination_chunk_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid destination chunk group.",
+		 function );
+
+		return( -1 );
+	}
+	if( *destination_chunk_group != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid destination chunk group already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_chunk_group == NULL )
+	{
+		*destination_chunk_group = NULL;
+
+		return( 1 );
+	}
+	*destination_chunk_group = memory_allocate_structure(
+		                    libewf_chunk_group_t );
+
+	if( *destination_chunk_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create destination chunk group.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_copy(
+	     *destination_chunk_group,
+	     source_chunk_group,
+	     sizeof( libewf_chunk_group_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy source to destination chunk group.",
+		 function );
+
+		memory_free(
+		 *destination_chunk_group );
+
+		*destination_chunk_group = NULL;
+
+		return( -1 );
+	}
+	( *destination_chunk_group )->data_offsets               = NULL;
+	( *destination_chunk_group )->large_data_offsets         = NULL;
+	( *destination_chunk_group )->data_sizes                 = NULL;
+	( *destination_chunk_group )->range_flags                = NULL;
+	( *destination_chunk_group )->number_of_chunks           = 0;
+	( *destination_chunk_group )->number_of_allocated_chunks = 0;
+
+	if( source_chunk_group->number_of_allocated_chunks > 0 )
+	{
+		if( libewf_chunk_group_resize(
+		     *destination_chunk_group,
+		     source_chunk_group->number_of_allocated_chunks,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+			 "%s: unable to resize destination chunk group.",
+			 function );
+
+			goto on_error;
+		}
+		if( source_chunk_group->large_data_offsets != NULL )
+		{
+			/* Resize allocates relative data offsets, replace them by absolute data offsets
+			 */
+			( *destination_chunk_group )->large_data_offsets = (off64_t *) memory_allocate(
+			                                                    sizeof( off64_t ) * source_chunk_group->number_of_allocated_chunks );
+
+			if( ( *destination_chunk_group )->large_data_offsets == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to create destination large data offsets.",
+				 function );
+
+				goto on_error;
+			}
+			memory_free(
+			 ( *destination_chunk_group )->data_offsets );
+
+			( *destination_chunk_group )->data_offsets = NULL;
+
+			if( memory_copy(
+			     ( *destination_chunk_group )->large_data_offsets,
+			     source_chunk_group->large_data_offsets,
+			     sizeof( off64_t ) * source_chunk_group->number_of_chunks ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy large data offsets.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		else if( memory_copy(
+		          ( *destination_chunk_group )->data_offsets,
+		          source_chunk_group->data_offsets,
+		          sizeof( uint32_t ) * source_chunk_group->number_of_chunks ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy data offsets.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_copy(
+		     ( *destination_chunk_group )->data_sizes,
+		     source_chunk_group->data_sizes,
+		     sizeof( uint32_t ) * source_chunk_group->number_of_chunks ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy data sizes.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_copy(
+		     ( *destination_chunk_group )->range_flags,
+		     source_chunk_group->range_flags,
+		     sizeof( uint16_t ) * source_chunk_group->number_of_chunks ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy range flags.",
+			 function );
+
+			goto on_error;
+		}
+		( *destination_chunk_group )->number_of_chunks = source_chunk_group->number_of_chunks;
+	}
+	return( 1 );
+
+on_error:
+	if( *destination_chunk_group != NULL )
+	{
+		libewf_chunk_group_free(
+		 destination_chunk_group,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Empties a chunk group
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_group_empty(
+     libewf_chunk_group_t *chunk_group,
+     libcerror_error_t **error )
+{
+        static char *function = "libewf_chunk_group_empty";
+
+	if( chunk_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk group.",
+		 function );
+
+		return( -1 );
+	}
+	/* The allocated arrays are kept for reuse, only the absolute data offsets are
+	 * replaced by relative data offsets
+	 */
+	if( chunk_group->large_data_offsets != NULL )
+	{
+		chunk_group->data_offsets = (uint32_t *) memory_allocate(
+		                                          sizeof( uint32_t ) * chunk_group->number_of_allocated_chunks );
+
+		if( chunk_group->data_offsets == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create data offsets.",
+			 function );
+
+			return( -1 );
+		}
+		memory_free(
+		 chunk_group->large_data_offsets );
+
+		chunk_group->large_data_offsets = NULL;
+	}
+	chunk_group->file_io_pool_entry = -1;
+	chunk_group->base_offset        = 0;
+	chunk_group->number_of_chunks   = 0;
+
+	if( libfcache_date_time_get_timestamp(
+	     &( chunk_group->timestamp ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve cache timestamp.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Resizes the chunk group to hold at least a specific number of chunks
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_group_resize(
+     libewf_chunk_group_t *chunk_group,
+     int number_of_chunks,
+     libcerror_error_t **error )
+{
+	void *reallocation    = NULL;
+	static char *function = "libewf_chunk_group_resize";
+
+	if( chunk_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk group.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_chunks < 0 )
+	 || ( (size_t) number_of_chunks > ( (size_t) SSIZE_MAX / sizeof( off64_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of chunks value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_chunks <= chunk_group->number_of_allocated_chunks )
+	{
+		return( 1 );
+	}
+	if( chunk_group->large_data_offsets != NULL )
+	{
+		reallocation = memory_reallocate(
+		                chunk_group->large_data_offsets,
+		                sizeof( off64_t ) * number_of_chunks );
+
+		if( reallocation == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize large data offsets.",
+			 function );
+
+			return( -1 );
+		}
+		chunk_group->large_data_offsets = (off64_t *) reallocation;
+	}
+	else
+	{
+		reallocation = memory_reallocate(
+		                chunk_group->data_offsets,
+		                sizeof( uint32_t ) * number_of_chunks );
+
+		if( reallocation == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize data offsets.",
+			 function );
+
+			return( -1 );
+		}
+		chunk_group->data_offsets = (uint32_t *) reallocation;
+	}
+	reallocation = memory_reallocate(
+	                chunk_group->data_sizes,
+	                sizeof( uint32_t ) * number_of_chunks );
+
+	if( reallocation == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to resize data sizes.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_group->data_sizes = (uint32_t *) reallocation;
+
+	reallocation = memory_reallocate(
+	                chunk_group->range_flags,
+	                sizeof( uint16_t ) * number_of_chunks );
+
+	if( reallocation == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to resize range flags.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_group->range_flags                = (uint16_t *) reallocation;
+	chunk_group->number_of_allocated_chunks = number_of_chunks;
+
+	return( 1 );
+}
+
+/* Replaces the relative data offsets by absolute data offsets
+ * This is needed when a chunk data offset cannot be stored relative to the base offset
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_group_set_large_data_offsets(
+     libewf_chunk_group_t *chunk_group,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_group_set_large_data_offsets";
+	int chunk_group_index = 0;
+
+	if( chunk_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk group.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_group->large_data_offsets != NULL )
+	{
+		return( 1 );
+	}
+	if( chunk_group->number_of_allocated_chunks > 0 )
+	{
+		chunk_group->large_data_offsets = (off64_t *) memory_allocate(
+		                                               sizeof( off64_t ) * chunk_group->number_of_allocated_chunks );
+
+		if( chunk_group->large_data_offsets == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create large data offsets.",
+			 function );
+
+			return( -1 );
+		}
+		for( chunk_group_index = 0;
+		     chunk_group_index < chunk_group->number_of_chunks;
+		     chunk_group_index++ )
+		{
+			chunk_group->large_data_offsets[ chunk_group_index ] = chunk_group->base_offset
+			                                                     + chunk_group->data_offsets[ chunk_group_index ];
+		}
+		memory_free(
+		 chunk_group->data_offsets );
+
+		chunk_group->data_offsets = NULL;
+	}
+	return( 1 );
+}
+
+/* Retrieves the number of chunks
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_group_get_number_of_chunks(
+     libewf_chunk_group_t *chunk_group,
+     int *number_of_chunks,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_group_get_number_of_chunks";
+
+	if( chunk_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk group.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_chunks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of chunks.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_chunks = chunk_group->number_of_chunks;
+
+	return( 1 );
+}
+
+/* Retrieves the range of the (packed) chunk data of a specific chunk
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_group_get_chunk_range_by_index(
+     libewf_chunk_group_t *chunk_group,
+     int chunk_group_index,
+     int *file_io_pool_entry,
+     off64_t *chunk_data_offset,
+     size64_t *chunk_data_size,
+     uint32_t *range_flags,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_group_get_chunk_range_by_index";
+
+	if( chunk_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk group.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chunk_group_index < 0 )
+	 || ( chunk_group_index >= chunk_group->number_of_chunks ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk group index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_pool_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO pool entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range flags.",
+		 function );
+
+		return( -1 );
+	}
+	*file_io_pool_entry = chunk_group->file_io_pool_entry;
+
+	if( chunk_group->large_data_offsets != NULL )
+	{
+		*chunk_data_offset = chunk_group->large_data_offsets[ chunk_group_index ];
+	}
+	else
+	{
+		*chunk_data_offset = chunk_group->base_offset + chunk_group->data_offsets[ chunk_group_index ];
+	}
+	*chunk_data_size = (size64_t) chunk_group->data_sizes[ chunk_group_index ];
+	*range_flags     = (uint32_t) chunk_group->range_flags[ chunk_group_index ];
+
+	return( 1 );
+}
+
+/* Sets the range of the (packed) chunk data of a specific chunk
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_group_set_chunk_range_by_index(
+     libewf_chunk_group_t *chunk_group,
+     int chunk_group_index,
+     int file_io_pool_entry,
+     off64_t chunk_data_offset,
+     size64_t chunk_data_size,
+     uint32_t range_flags,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_group_set_chunk_range_by_index";
+
+	if( chunk_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk group.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chunk_group_index < 0 )
+	 || ( chunk_group_index >= chunk_group->number_of_chunks ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk group index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_pool_entry != chunk_group->file_io_pool_entry )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported file IO pool entry: %d.",
+		 function,
+		 file_io_pool_entry );
+
+		return( -1 );
+	}
+	if( chunk_data_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid chunk data offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data_size > (size64_t) UINT32_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid chunk data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_flags > (uint32_t) UINT16_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported range flags.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_group->large_data_offsets == NULL )
+	{
+		if( ( chunk_data_offset < chunk_group->base_offset )
+		 || ( ( chunk_data_offset - chunk_group->base_offset ) > (off64_t) UINT32_MAX ) )
+		{
+			if( libewf_chunk_group_set_large_data_offsets(
+			     chunk_group,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set large data offsets.",
+				 function );
+
+				return( -1 );
+			}
+		}
+	}
+	if( chunk_group->large_data_offsets != NULL )
+	{
+		chunk_group->large_data_offsets[ chunk_group_index ] = chunk_data_offset;
+	}
+	else
+	{
+		chunk_group->data_offsets[ chunk_group_index ] = (uint32_t) ( chunk_data_offset - chunk_group->base_offset );
+	}
+	chunk_group->data_sizes[ chunk_group_index ]  = (uint32_t) chunk_data_size;
+	chunk_group->range_flags[ chunk_group_index ] = (uint16_t) range_flags;
+
+	/* Make sure chunk data cached for the previous range is not reused
+	 */
+	if( libfcache_date_time_get_timestamp(
+	     &( chunk_group->timestamp ),
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create chunks list.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve cache timestamp.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Appends the range of the (packed) chunk data of a chunk
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_group_append_chunk_range(
+     libewf_chunk_group_t *chunk_group,
+     int *chunk_group_index,
+     int file_io_pool_entry,
+     off64_t chunk_data_offset,
+     size64_t chunk_data_size,
+     uint32_t range_flags,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_group_append_chunk_range";
+	int number_of_chunks  = 0;
+
+	if( chunk_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk group.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_group->number_of_chunks == INT_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk group - number of chunks value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_group_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk group index.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chunk_group->number_of_chunks > 0 )
+	 && ( file_io_pool_entry != chunk_group->file_io_pool_entry ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported file IO pool entry: %d.",
+		 function,
+		 file_io_pool_entry );
+
+		return( -1 );
+	}
+	if( chunk_data_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid chunk data offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data_size > (size64_t) UINT32_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid chunk data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_flags > (uint32_t) UINT16_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported range flags.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_group->number_of_chunks >= chunk_group->number_of_allocated_chunks )
+	{
+		number_of_chunks = chunk_group->number_of_allocated_chunks;
+
+		if( number_of_chunks < ( INT_MAX / 2 ) )
+		{
+			number_of_chunks *= 2;
+		}
+		else
+		{
+			number_of_chunks = INT_MAX;
+		}
+		if( number_of_chunks < 64 )
+		{
+			number_of_chunks = 64;
+		}
+		if( libewf_chunk_group_resize(
+		     chunk_group,
+		     number_of_chunks,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+			 "%s: unable to resize chunk group.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( chunk_group->number_of_chunks == 0 )
+	{
+		chunk_group->file_io_pool_entry = file_io_pool_entry;
+		chunk_group->base_offset        = chunk_data_offset;
+	}
+	if( chunk_group->large_data_offsets == NULL )
+	{
+		if( ( chunk_data_offset < chunk_group->base_offset )
+		 || ( ( chunk_data_offset - chunk_group->base_offset ) > (off64_t) UINT32_MAX ) )
+		{
+			if( libewf_chunk_group_set_large_data_offsets(
+			     chunk_group,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set large data offsets.",
+				 function );
+
+				return( -1 );
+			}
+		}
+	}
+	*chunk_group_index = chunk_group->number_of_chunks;
+
+	if( chunk_group->large_data_offsets != NULL )
+	{
+		chunk_group->large_data_offsets[ *chunk_group_index ] = chunk_data_offset;
+	}
+	else
+	{
+		chunk_group->data_offsets[ *chunk_group_index ] = (uint32_t) ( chunk_data_offset - chunk_group->base_offset );
+	}
+	chunk_group->data_sizes[ *chunk_group_index ]  = (uint32_t) chunk_data_size;
+	chunk_group->range_flags[ *chunk_group_index ] = (uint16_t) range_flags;
+
+	chunk_group->number_of_chunks += 1;
+
+	return( 1 );
+}
+
+/* Retrieves the index of the chunk at a specific offset relative to the start of the chunk group
+ * The chunk data offset is set to the offset relative to the start of the chunk
+ * Returns 1 if successful, 0 if no such chunk or -1 on error
+ */
+int libewf_chunk_group_get_chunk_index_at_offset(
+     libewf_chunk_group_t *chunk_group,
+     off64_t offset,
+     int *chunk_group_index,
+     off64_t *chunk_data_offset,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_group_get_chunk_index_at_offset";
+	uint64_t index        = 0;
+
+	if( chunk_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk group.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_group->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid chunk group - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_group_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk group index.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	return( 1 );
+	if( chunk_data_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data offset.",
+		 function );
 
-on_error:
-	if( *chunk_group != NULL )
+		return( -1 );
+	}
+	if( offset < 0 )
 	{
-		memory_free(
-		 *chunk_group );
+		return( 0 );
+	}
+	/* Every chunk maps to chunk size bytes of media data
+	 */
+	index = (uint64_t) offset / chunk_group->chunk_size;
 
-		*chunk_group = NULL;
+	if( index >= (uint64_t) chunk_group->number_of_chunks )
+	{
+		return( 0 );
 	}
-	return( -1 );
+	*chunk_group_index = (int) index;
+	*chunk_data_offset = offset - (off64_t) ( index * chunk_group->chunk_size );
+
+	return( 1 );
 }
 
-/* Frees a chunk group
+/* Retrieves the chunk data of a specific chunk
+ * The chunk data is read if not available in the chunks cache
  * Returns 1 if successful or -1 on error
  */
-int libewf_chunk_group_free(
-     libewf_chunk_group_t **chunk_group,
+int libewf_chunk_group_get_chunk_data_by_index(
+     libewf_chunk_group_t *chunk_group,
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     libfcache_cache_t *chunks_cache,
+     int chunk_group_index,
+     libewf_chunk_data_t **chunk_data,
      libcerror_error_t **error )
 {
-        static char *function = "libewf_chunk_group_free";
-	int result            = 1;
+	libewf_chunk_data_t *safe_chunk_data = NULL;
+	libfcache_cache_value_t *cache_value = NULL;
+	static char *function                = "libewf_chunk_group_get_chunk_data_by_index";
+	off64_t cache_value_offset           = 0;
+	off64_t chunk_data_offset            = 0;
+	size64_t chunk_data_size             = 0;
+	ssize_t read_count                   = 0;
+	int64_t cache_value_timestamp        = 0;
+	uint32_t range_flags                 = 0;
+	int cache_entry_index                = 0;
+	int cache_value_file_index           = 0;
+	int file_io_pool_entry               = 0;
+	int number_of_cache_entries          = 0;
 
 	if( chunk_group == NULL )
 	{
@@ -166,124 +1162,251 @@ int libewf_chunk_group_free(
 
 		return( -1 );
 	}
-	if( *chunk_group != NULL )
+	if( io_handle == NULL )
 	{
-		if( libfdata_list_free(
-		     &( ( *chunk_group )->chunks_list ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free chunkse list.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
 
-			result = -1;
-		}
-		memory_free(
-		 *chunk_group );
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
 
-		*chunk_group = NULL;
+		return( -1 );
 	}
-	return( result );
-}
+	if( libewf_chunk_group_get_chunk_range_by_index(
+	     chunk_group,
+	     chunk_group_index,
+	     &file_io_pool_entry,
+	     &chunk_data_offset,
+	     &chunk_data_size,
+	     &range_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk: %d range.",
+		 function,
+		 chunk_group_index );
 
-/* Clones the chunk group
- * Returns 1 if successful or -1 on error
- */
-int libewf_chunk_group_clone(
-     libewf_chunk_group_t **destination_chunk_group,
-     libewf_chunk_group_t *source_chunk_group,
-     libcerror_error_t **error )
-{
-	static char *function = "libewf_chunk_group_clone";
+		return( -1 );
+	}
+	if( ( range_flags & LIBEWF_RANGE_FLAG_IS_SPARSE ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported range flags.",
+		 function );
 
-	if( destination_chunk_group == NULL )
+		return( -1 );
+	}
+	if( libfcache_cache_get_number_of_entries(
+	     chunks_cache,
+	     &number_of_cache_entries,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid destination chunk group.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of cache entries.",
 		 function );
 
 		return( -1 );
 	}
-	if( *destination_chunk_group != NULL )
+	if( number_of_cache_entries <= 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid destination chunk group already set.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of cache entries value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-	if( source_chunk_group == NULL )
+	/* Use the chunk index to determine the cache entry so that chunks of
+	 * different chunk groups are spread over the cache
+	 */
+	cache_entry_index = (int) ( ( chunk_group->chunk_index + (uint64_t) chunk_group_index ) % (uint64_t) number_of_cache_entries );
+
+	if( libfcache_cache_get_value_by_index(
+	     chunks_cache,
+	     cache_entry_index,
+	     &cache_value,
+	     error ) != 1 )
 	{
-		*destination_chunk_group = NULL;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve cache entry: %d value.",
+		 function,
+		 cache_entry_index );
 
-		return( 1 );
+		return( -1 );
 	}
-	*destination_chunk_group = memory_allocate_structure(
-		                    libewf_chunk_group_t );
+	if( cache_value != NULL )
+	{
+		if( libfcache_cache_value_get_identifier(
+		     cache_value,
+		     &cache_value_file_index,
+		     &cache_value_offset,
+		     &cache_value_timestamp,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve cache value identifier.",
+			 function );
 
-	if( *destination_chunk_group == NULL )
+			return( -1 );
+		}
+		if( ( cache_value_file_index == file_io_pool_entry )
+		 && ( cache_value_offset == chunk_data_offset )
+		 && ( cache_value_timestamp == chunk_group->timestamp ) )
+		{
+			if( libfcache_cache_value_get_value(
+			     cache_value,
+			     (intptr_t **) chunk_data,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve chunk data from cache value.",
+				 function );
+
+				return( -1 );
+			}
+			LIBEWF_STATISTICS_ADD(
+			 io_handle->statistics.packed_chunk_cache_hits,
+			 1 );
+
+			return( 1 );
+		}
+	}
+	LIBEWF_STATISTICS_ADD(
+	 io_handle->statistics.packed_chunk_cache_misses,
+	 1 );
+
+	if( libewf_chunk_data_initialize(
+	     &safe_chunk_data,
+	     chunk_group->chunk_size,
+	     0,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-		 "%s: unable to create destination chunk group.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create chunk data.",
 		 function );
 
 		goto on_error;
 	}
-	if( memory_copy(
-	     *destination_chunk_group,
-	     source_chunk_group,
-	     sizeof( libewf_chunk_group_t ) ) == NULL )
+	read_count = libewf_chunk_data_read_from_file_io_pool(
+	              safe_chunk_data,
+	              file_io_pool,
+	              file_io_pool_entry,
+	              chunk_data_offset,
+	              chunk_data_size,
+	              range_flags,
+	              error );
+
+	if( read_count < 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-		 "%s: unable to copy source to destination chunk group.",
-		 function );
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read chunk: %d data.",
+		 function,
+		 chunk_group_index );
 
-		memory_free(
-		 *destination_chunk_group );
+		goto on_error;
+	}
+	LIBEWF_STATISTICS_ADD(
+	 io_handle->statistics.bytes_read,
+	 read_count );
 
-		*destination_chunk_group = NULL;
+	LIBEWF_STATISTICS_ADD(
+	 io_handle->statistics.number_of_reads,
+	 1 );
 
-		return( -1 );
+	if( libfcache_cache_set_value_by_index(
+	     chunks_cache,
+	     cache_entry_index,
+	     file_io_pool_entry,
+	     chunk_data_offset,
+	     chunk_group->timestamp,
+	     (intptr_t *) safe_chunk_data,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_chunk_data_free,
+	     LIBFCACHE_CACHE_VALUE_FLAG_MANAGED,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set chunk: %d data in cache entry: %d.",
+		 function,
+		 chunk_group_index,
+		 cache_entry_index );
+
+		goto on_error;
 	}
-/* TODO clone chunks_list */
-	( *destination_chunk_group )->chunks_list = NULL;
+	/* The chunks cache takes over management of the chunk data
+	 */
+	*chunk_data = safe_chunk_data;
 
 	return( 1 );
 
 on_error:
-	if( *destination_chunk_group != NULL )
+	if( safe_chunk_data != NULL )
 	{
-		memory_free(
-		 *destination_chunk_group );
-
-		*destination_chunk_group = NULL;
+		libewf_chunk_data_free(
+		 &safe_chunk_data,
+		 NULL );
 	}
 	return( -1 );
 }
 
-/* Empties a chunk group
+/* Sets the chunk data of a specific chunk in the chunks cache
+ * The chunks cache takes over management of the chunk data
  * Returns 1 if successful or -1 on error
  */
-int libewf_chunk_group_empty(
+int libewf_chunk_group_set_chunk_data_by_index(
      libewf_chunk_group_t *chunk_group,
+     libfcache_cache_t *chunks_cache,
+     int chunk_group_index,
+     libewf_chunk_data_t *chunk_data,
      libcerror_error_t **error )
 {
-        static char *function = "libewf_chunk_group_empty";
+	static char *function       = "libewf_chunk_group_set_chunk_data_by_index";
+	off64_t chunk_data_offset   = 0;
+	size64_t chunk_data_size    = 0;
+	uint32_t range_flags        = 0;
+	int cache_entry_index       = 0;
+	int file_io_pool_entry      = 0;
+	int number_of_cache_entries = 0;
 
 	if( chunk_group == NULL )
 	{
@@ -296,23 +1419,89 @@ int libewf_chunk_group_empty(
 
 		return( -1 );
 	}
-	if( libfdata_list_empty(
-	     chunk_group->chunks_list,
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_chunk_group_get_chunk_range_by_index(
+	     chunk_group,
+	     chunk_group_index,
+	     &file_io_pool_entry,
+	     &chunk_data_offset,
+	     &chunk_data_size,
+	     &range_flags,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
-		 "%s: unable to empty chunks list.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk: %d range.",
+		 function,
+		 chunk_group_index );
+
+		return( -1 );
+	}
+	if( libfcache_cache_get_number_of_entries(
+	     chunks_cache,
+	     &number_of_cache_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of cache entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_cache_entries <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of cache entries value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
+	cache_entry_index = (int) ( ( chunk_group->chunk_index + (uint64_t) chunk_group_index ) % (uint64_t) number_of_cache_entries );
+
+	if( libfcache_cache_set_value_by_index(
+	     chunks_cache,
+	     cache_entry_index,
+	     file_io_pool_entry,
+	     chunk_data_offset,
+	     chunk_group->timestamp,
+	     (intptr_t *) chunk_data,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_chunk_data_free,
+	     LIBFCACHE_CACHE_VALUE_FLAG_MANAGED,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set chunk: %d data in cache entry: %d.",
+		 function,
+		 chunk_group_index,
+		 cache_entry_index );
+
+		return( -1 );
+	}
 	return( 1 );
 }
 
-/* Fills the chunks list from the EWF version 1 sector table entries
+/* Fills the chunk group from the EWF version 1 sector table entries
  * Returns 1 if successful or -1 on error
  */
 int libewf_chunk_group_fill_v1(
@@ -398,6 +1587,36 @@ int libewf_chunk_group_fill_v1(
 
 		return( -1 );
 	}
+	if( chunk_group->number_of_chunks == 0 )
+	{
+		chunk_group->chunk_index = chunk_index;
+		chunk_group->chunk_size  = chunk_size;
+	}
+	if( number_of_entries > (uint32_t) ( INT_MAX - chunk_group->number_of_chunks ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_chunk_group_resize(
+	     chunk_group,
+	     chunk_group->number_of_chunks + (int) number_of_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to resize chunk group.",
+		 function );
+
+		return( -1 );
+	}
 	byte_stream_copy_to_uint32_little_endian(
 	 ( ( (ewf_table_entry_v1_t *) table_entries_data )[ table_entry_index ] ).chunk_data_offset,
 	 stored_offset );
@@ -558,21 +1777,20 @@ int libewf_chunk_group_fill_v1(
 			 "\n" );
 		}
 #endif
-		if( libfdata_list_append_element_with_mapped_size(
-		     chunk_group->chunks_list,
+		if( libewf_chunk_group_append_chunk_range(
+		     chunk_group,
 		     &element_index,
 		     file_io_pool_entry,
 		     base_offset + current_offset,
 		     (size64_t) chunk_data_size,
 		     range_flags,
-		     chunk_size,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-			 "%s: unable to append element: %" PRIu32 " with mapped size to chunks list.",
+			 "%s: unable to append chunk: %" PRIu32 " range.",
 			 function,
 			 table_entry_index );
 
@@ -773,21 +1991,20 @@ int libewf_chunk_group_fill_v1(
 		 "\n" );
 	}
 #endif
-	if( libfdata_list_append_element_with_mapped_size(
-	     chunk_group->chunks_list,
+	if( libewf_chunk_group_append_chunk_range(
+	     chunk_group,
 	     &element_index,
 	     file_io_pool_entry,
 	     last_chunk_data_offset,
 	     (size64_t) last_chunk_data_size,
 	     range_flags,
-	     chunk_size,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-		 "%s: unable to append element: %" PRIu32 " with mapped size to chunks list.",
+		 "%s: unable to append chunk: %" PRIu32 " range.",
 		 function,
 		 table_entry_index );
 
@@ -803,7 +2020,7 @@ int libewf_chunk_group_fill_v1(
 	return( 1 );
 }
 
-/* Fills the chunks list from the EWF version 2 sector table entries
+/* Fills the chunk group from the EWF version 2 sector table entries
  * Returns 1 if successful or -1 on error
  */
 int libewf_chunk_group_fill_v2(
@@ -871,6 +2088,36 @@ int libewf_chunk_group_fill_v2(
 
 		return( -1 );
 	}
+	if( chunk_group->number_of_chunks == 0 )
+	{
+		chunk_group->chunk_index = chunk_index;
+		chunk_group->chunk_size  = chunk_size;
+	}
+	if( number_of_offsets > (uint32_t) ( INT_MAX - chunk_group->number_of_chunks ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_chunk_group_resize(
+	     chunk_group,
+	     chunk_group->number_of_chunks + (int) number_of_offsets,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to resize chunk group.",
+		 function );
+
+		return( -1 );
+	}
 	table_entry_offset = table_section->start_offset + sizeof( ewf_table_header_v2_t );
 
 	while( table_entries_data_size >= sizeof( ewf_table_entry_v2_t ) )
@@ -975,21 +2222,20 @@ int libewf_chunk_group_fill_v2(
 		}
 		table_entry_offset += sizeof( ewf_table_entry_v2_t );
 
-		if( libfdata_list_append_element_with_mapped_size(
-		     chunk_group->chunks_list,
+		if( libewf_chunk_group_append_chunk_range(
+		     chunk_group,
 		     &element_index,
 		     file_io_pool_entry,
 		     chunk_data_offset,
 		     (size64_t) chunk_data_size,
 		     range_flags,
-		     chunk_size,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-			 "%s: unable to append element: %" PRIu32 " with mapped size to chunks list.",
+			 "%s: unable to append chunk: %" PRIu32 " range.",
 			 function,
 			 table_entry_index );
 
@@ -1009,7 +2255,7 @@ int libewf_chunk_group_fill_v2(
 	return( 1 );
 }
 
-/* Corrects the chunks list from the offsets
+/* Corrects the chunk group from the EWF version 1 sector table entries
  * Returns 1 if successful or -1 on error
  */
 int libewf_chunk_group_correct_v1(
@@ -1256,8 +2502,8 @@ int libewf_chunk_group_correct_v1(
 			 "\n" );
 		}
 #endif
-		if( libfdata_list_get_element_by_index(
-		     chunk_group->chunks_list,
+		if( libewf_chunk_group_get_chunk_range_by_index(
+		     chunk_group,
 		     table_entry_index,
 		     &previous_file_io_pool_entry,
 		     &previous_chunk_data_offset,
@@ -1269,7 +2515,7 @@ int libewf_chunk_group_correct_v1(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve element: %" PRIu32 " from chunks list.",
+			 "%s: unable to retrieve chunk: %" PRIu32 " range.",
 			 function,
 			 table_entry_index );
 
@@ -1340,8 +2586,8 @@ int libewf_chunk_group_correct_v1(
 		}
 		if( update_data_range != 0 )
 		{
-			if( libfdata_list_set_element_by_index(
-			     chunk_group->chunks_list,
+			if( libewf_chunk_group_set_chunk_range_by_index(
+			     chunk_group,
 			     table_entry_index,
 			     file_io_pool_entry,
 			     base_offset + current_offset,
@@ -1353,7 +2599,7 @@ int libewf_chunk_group_correct_v1(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-				 "%s: unable to set element: %" PRIu32 " in chunks list.",
+				 "%s: unable to set chunk: %" PRIu32 " range.",
 				 function,
 				 table_entry_index );
 
@@ -1533,8 +2779,8 @@ int libewf_chunk_group_correct_v1(
 		 "\n" );
 	}
 #endif
-	if( libfdata_list_get_element_by_index(
-	     chunk_group->chunks_list,
+	if( libewf_chunk_group_get_chunk_range_by_index(
+	     chunk_group,
 	     table_entry_index,
 	     &previous_file_io_pool_entry,
 	     &previous_chunk_data_offset,
@@ -1546,7 +2792,7 @@ int libewf_chunk_group_correct_v1(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve element: %" PRIu32 " from chunks list.",
+		 "%s: unable to retrieve chunk: %" PRIu32 " range.",
 		 function,
 		 table_entry_index );
 
@@ -1617,8 +2863,8 @@ int libewf_chunk_group_correct_v1(
 	}
 	if( update_data_range != 0 )
 	{
-		if( libfdata_list_set_element_by_index(
-		     chunk_group->chunks_list,
+		if( libewf_chunk_group_set_chunk_range_by_index(
+		     chunk_group,
 		     table_entry_index,
 		     file_io_pool_entry,
 		     base_offset + current_offset,
@@ -1630,7 +2876,7 @@ int libewf_chunk_group_correct_v1(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set element: %" PRIu32 " in chunks list.",
+			 "%s: unable to set chunk: %" PRIu32 " range.",
 			 function,
 			 table_entry_index );
 
@@ -1647,7 +2893,7 @@ int libewf_chunk_group_correct_v1(
 	return( 1 );
 }
 
-/* Generates the table entries data from the chunks list
+/* Generates the table entries data from the chunk group
  * Returns 1 if successful or -1 on error
  */
 int libewf_chunk_group_generate_table_entries_data(
@@ -1748,8 +2994,8 @@ int libewf_chunk_group_generate_table_entries_data(
 	     table_entry_index < number_of_entries;
 	     table_entry_index++ )
 	{
-		if( libfdata_list_get_element_by_index(
-		     chunk_group->chunks_list,
+		if( libewf_chunk_group_get_chunk_range_by_index(
+		     chunk_group,
 		     table_entry_index,
 		     &file_io_pool_entry,
 		     &chunk_data_offset,
@@ -1761,7 +3007,7 @@ int libewf_chunk_group_generate_table_entries_data(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve element: %" PRIu32 " from chunks list.",
+			 "%s: unable to retrieve chunk: %" PRIu32 " range.",
 			 function,
 			 table_entry_index );
 
@@ -25,9 +25,11 @@
 #include <common.h>
 #include <types.h>
 
+#include "libewf_chunk_data.h"
 #include "libewf_io_handle.h"
+#include "libewf_libbfio.h"
 #include "libewf_libcerror.h"
-#include "libewf_libfdata.h"
+#include "libewf_libfcache.h"
 #include "libewf_section.h"
 
 #if defined( __cplusplus )
@@ -38,9 +40,50 @@ typedef struct libewf_chunk_group libewf_chunk_group_t;
 
 struct libewf_chunk_group
 {
-	/* The chunks list
+	/* The index of the first chunk
 	 */
-	libfdata_list_t *chunks_list;
+	uint64_t chunk_index;
+
+	/* The chunk size
+	 */
+	size32_t chunk_size;
+
+	/* The file IO pool entry that contains the chunk data
+	 */
+	int file_io_pool_entry;
+
+	/* The base offset of the chunk data
+	 */
+	off64_t base_offset;
+
+	/* The chunk data offsets relative to the base offset
+	 */
+	uint32_t *data_offsets;
+
+	/* The absolute chunk data offsets
+	 * These are only used if a chunk data offset cannot be stored relative to the base offset
+	 */
+	off64_t *large_data_offsets;
+
+	/* The chunk data sizes
+	 */
+	uint32_t *data_sizes;
+
+	/* The chunk range flags
+	 */
+	uint16_t *range_flags;
+
+	/* The number of chunks
+	 */
+	int number_of_chunks;
+
+	/* The number of allocated chunks
+	 */
+	int number_of_allocated_chunks;
+
+	/* The timestamp, used to identify cached chunk data
+	 */
+	int64_t timestamp;
 };
 
 int libewf_chunk_group_initialize(
@@ -61,6 +104,70 @@ int libewf_chunk_group_empty(
      libewf_chunk_group_t *chunk_group,
      libcerror_error_t **error );
 
+int libewf_chunk_group_resize(
+     libewf_chunk_group_t *chunk_group,
+     int number_of_chunks,
+     libcerror_error_t **error );
+
+int libewf_chunk_group_set_large_data_offsets(
+     libewf_chunk_group_t *chunk_group,
+     libcerror_error_t **error );
+
+int libewf_chunk_group_get_number_of_chunks(
+     libewf_chunk_group_t *chunk_group,
+     int *number_of_chunks,
+     libcerror_error_t **error );
+
+int libewf_chunk_group_get_chunk_range_by_index(
+     libewf_chunk_group_t *chunk_group,
+     int chunk_group_index,
+     int *file_io_pool_entry,
+     off64_t *chunk_data_offset,
+     size64_t *chunk_data_size,
+     uint32_t *range_flags,
+     libcerror_error_t **error );
+
+int libewf_chunk_group_set_chunk_range_by_index(
+     libewf_chunk_group_t *chunk_group,
+     int chunk_group_index,
+     int file_io_pool_entry,
+     off64_t chunk_data_offset,
+     size64_t chunk_data_size,
+     uint32_t range_flags,
+     libcerror_error_t **error );
+
+int libewf_chunk_group_append_chunk_range(
+     libewf_chunk_group_t *chunk_group,
+     int *chunk_group_index,
+     int file_io_pool_entry,
+     off64_t chunk_data_offset,
+     size64_t chunk_data_size,
+     uint32_t range_flags,
+     libcerror_error_t **error );
+
+int libewf_chunk_group_get_chunk_index_at_offset(
+     libewf_chunk_group_t *chunk_group,
+     off64_t offset,
+     int *chunk_group_index,
+     off64_t *chunk_data_offset,
+     libcerror_error_t **error );
+
+int libewf_chunk_group_get_chunk_data_by_index(
+     libewf_chunk_group_t *chunk_group,
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     libfcache_cache_t *chunks_cache,
+     int chunk_group_index,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error );
+
+int libewf_chunk_group_set_chunk_data_by_index(
+     libewf_chunk_group_t *chunk_group,
+     libfcache_cache_t *chunks_cache,
+     int chunk_group_index,
+     libewf_chunk_data_t *chunk_data,
+     libcerror_error_t **error );
+
 int libewf_chunk_group_fill_v1(
      libewf_chunk_group_t *chunk_group,
      uint64_t chunk_index,
@@ -35,6 +35,7 @@
 #include "libewf_libfdata.h"
 #include "libewf_segment_file.h"
 #include "libewf_segment_table.h"
+#include "libewf_statistics.h"
 
 /* Creates a chunk table
  * Make sure the value chunk_table is referencing, is set to NULL
@@ -216,6 +217,11 @@ int libewf_chunk_table_free(
 
 			result = -1;
 		}
+		if( ( *chunk_table )->lookup_entries != NULL )
+		{
+			memory_free(
+			 ( *chunk_table )->lookup_entries );
+		}
 		memory_free(
 		 *chunk_table );
 
@@ -299,6 +305,14 @@ int libewf_chunk_table_clone(
 	( *destination_chunk_table )->corrupted_chunks_list = NULL;
 	( *destination_chunk_table )->checksum_errors       = NULL;
 
+	/* The chunk group lookup entries are rebuilt on demand
+	 */
+	( *destination_chunk_table )->lookup_entries                     = NULL;
+	( *destination_chunk_table )->number_of_lookup_entries           = 0;
+	( *destination_chunk_table )->number_of_allocated_lookup_entries = 0;
+	( *destination_chunk_table )->last_lookup_entry_index            = 0;
+
+
 	if( libcdata_range_list_clone(
 	     &( ( *destination_chunk_table )->checksum_errors ),
 	     source_chunk_table->checksum_errors,
@@ -480,6 +494,240 @@ int libewf_chunk_table_append_checksum_error(
 	return( 1 );
 }
 
+/* Retrieves the index of the chunk group lookup entry that contains a specific offset
+ * If no lookup entry contains the offset the index is set to where such an entry should be inserted
+ * Returns 1 if successful, 0 if no such lookup entry or -1 on error
+ */
+int libewf_chunk_table_get_lookup_entry_index_by_offset(
+     libewf_chunk_table_t *chunk_table,
+     off64_t offset,
+     int *lookup_entry_index,
+     libcerror_error_t **error )
+{
+	libewf_chunk_table_lookup_entry_t *lookup_entry = NULL;
+	static char *function                           = "libewf_chunk_table_get_lookup_entry_index_by_offset";
+	int lower_index                                 = 0;
+	int middle_index                                = 0;
+	int upper_index                                 = 0;
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( lookup_entry_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid lookup entry index.",
+		 function );
+
+		return( -1 );
+	}
+	/* Check the most recently used lookup entry and its successor first
+	 * since most reads are sequential
+	 */
+	for( middle_index = chunk_table->last_lookup_entry_index;
+	     middle_index < ( chunk_table->last_lookup_entry_index + 2 );
+	     middle_index++ )
+	{
+		if( middle_index >= chunk_table->number_of_lookup_entries )
+		{
+			break;
+		}
+		lookup_entry = &( chunk_table->lookup_entries[ middle_index ] );
+
+		if( ( offset >= lookup_entry->chunk_group_offset )
+		 && ( (size64_t) ( offset - lookup_entry->chunk_group_offset ) < lookup_entry->chunk_group_size ) )
+		{
+			chunk_table->last_lookup_entry_index = middle_index;
+
+			*lookup_entry_index = middle_index;
+
+			return( 1 );
+		}
+	}
+	upper_index = chunk_table->number_of_lookup_entries;
+
+	while( lower_index < upper_index )
+	{
+		middle_index = lower_index + ( ( upper_index - lower_index ) / 2 );
+		lookup_entry = &( chunk_table->lookup_entries[ middle_index ] );
+
+		if( offset < lookup_entry->chunk_group_offset )
+		{
+			upper_index = middle_index;
+		}
+		else if( (size64_t) ( offset - lookup_entry->chunk_group_offset ) >= lookup_entry->chunk_group_size )
+		{
+			lower_index = middle_index + 1;
+		}
+		else
+		{
+			chunk_table->last_lookup_entry_index = middle_index;
+
+			*lookup_entry_index = middle_index;
+
+			return( 1 );
+		}
+	}
+	*lookup_entry_index = lower_index;
+
+	return( 0 );
+}
+
+/* Inserts a chunk group lookup entry
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_table_insert_lookup_entry(
+     libewf_chunk_table_t *chunk_table,
+     off64_t chunk_group_offset,
+     size64_t chunk_group_size,
+     off64_t segment_file_offset,
+     uint32_t segment_number,
+     int chunk_groups_list_index,
+     libcerror_error_t **error )
+{
+	libewf_chunk_table_lookup_entry_t *lookup_entry = NULL;
+	void *reallocation                              = NULL;
+	static char *function                           = "libewf_chunk_table_insert_lookup_entry";
+	int entry_index                                 = 0;
+	int lookup_entry_index                          = 0;
+	int number_of_lookup_entries                    = 0;
+	int result                                      = 0;
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_group_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid chunk group offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chunk_group_size == 0 )
+	 || ( chunk_group_size > (size64_t) ( INT64_MAX - chunk_group_offset ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk group size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_chunk_table_get_lookup_entry_index_by_offset(
+	          chunk_table,
+	          chunk_group_offset,
+	          &lookup_entry_index,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve lookup entry index for offset: 0x%08" PRIx64 ".",
+		 function,
+		 chunk_group_offset );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		return( 1 );
+	}
+	/* Do not insert lookup entries that overlap with the next entry
+	 */
+	if( lookup_entry_index < chunk_table->number_of_lookup_entries )
+	{
+		lookup_entry = &( chunk_table->lookup_entries[ lookup_entry_index ] );
+
+		if( (size64_t) ( lookup_entry->chunk_group_offset - chunk_group_offset ) < chunk_group_size )
+		{
+			return( 1 );
+		}
+	}
+	if( chunk_table->number_of_lookup_entries >= chunk_table->number_of_allocated_lookup_entries )
+	{
+		number_of_lookup_entries = chunk_table->number_of_allocated_lookup_entries * 2;
+
+		if( number_of_lookup_entries < 16 )
+		{
+			number_of_lookup_entries = 16;
+		}
+		if( (size_t) number_of_lookup_entries > ( (size_t) SSIZE_MAX / sizeof( libewf_chunk_table_lookup_entry_t ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid number of lookup entries value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		reallocation = memory_reallocate(
+		                chunk_table->lookup_entries,
+		                sizeof( libewf_chunk_table_lookup_entry_t ) * number_of_lookup_entries );
+
+		if( reallocation == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize lookup entries.",
+			 function );
+
+			return( -1 );
+		}
+		chunk_table->lookup_entries                     = (libewf_chunk_table_lookup_entry_t *) reallocation;
+		chunk_table->number_of_allocated_lookup_entries = number_of_lookup_entries;
+	}
+	for( entry_index = chunk_table->number_of_lookup_entries;
+	     entry_index > lookup_entry_index;
+	     entry_index-- )
+	{
+		chunk_table->lookup_entries[ entry_index ] = chunk_table->lookup_entries[ entry_index - 1 ];
+	}
+	lookup_entry = &( chunk_table->lookup_entries[ lookup_entry_index ] );
+
+	lookup_entry->chunk_group_offset      = chunk_group_offset;
+	lookup_entry->chunk_group_size        = chunk_group_size;
+	lookup_entry->segment_file_offset     = segment_file_offset;
+	lookup_entry->segment_number          = segment_number;
+	lookup_entry->chunk_groups_list_index = chunk_groups_list_index;
+
+	chunk_table->number_of_lookup_entries += 1;
+	chunk_table->last_lookup_entry_index   = lookup_entry_index;
+
+	return( 1 );
+}
+
 /* Retrieves the chunks group in a segment file at a specific offset
  * Returns 1 if successful, 0 if not or -1 on error
  */
@@ -497,8 +745,11 @@ int libewf_chunk_table_get_segment_file_chunk_group_by_offset(
      libewf_chunk_group_t **chunk_group,
      libcerror_error_t **error )
 {
-	static char *function = "libewf_chunk_table_get_segment_file_chunk_group_by_offset";
-	int result            = 0;
+	libewf_chunk_table_lookup_entry_t *lookup_entry = NULL;
+	static char *function                           = "libewf_chunk_table_get_segment_file_chunk_group_by_offset";
+	size64_t chunk_group_size                       = 0;
+	int lookup_entry_index                          = 0;
+	int result                                      = 0;
 
 	if( chunk_table == NULL )
 	{
@@ -577,13 +828,10 @@ int libewf_chunk_table_get_segment_file_chunk_group_by_offset(
 
 		return( -1 );
 	}
-	result = libewf_segment_table_get_segment_file_at_offset(
-	          segment_table,
+	result = libewf_chunk_table_get_lookup_entry_index_by_offset(
+	          chunk_table,
 	          offset,
-	          file_io_pool,
-	          segment_number,
-	          segment_file_data_offset,
-	          segment_file,
+	          &lookup_entry_index,
 	          error );
 
 	if( result == -1 )
@@ -592,23 +840,67 @@ int libewf_chunk_table_get_segment_file_chunk_group_by_offset(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve segment file at 0x%08" PRIx64 " from segment files list.",
+		 "%s: unable to retrieve lookup entry index for offset: 0x%08" PRIx64 ".",
 		 function,
 		 offset );
 
 		return( -1 );
 	}
-	if( result != 0 )
+	else if( result != 0 )
 	{
-		result = libewf_segment_file_get_chunk_group_by_offset(
-			  *segment_file,
-			  file_io_pool,
-			  chunk_groups_cache,
-			  *segment_file_data_offset,
-			  chunk_groups_list_index,
-			  chunk_group_data_offset,
-			  chunk_group,
-			  error );
+		lookup_entry = &( chunk_table->lookup_entries[ lookup_entry_index ] );
+
+		if( libewf_segment_table_get_segment_file_by_index(
+		     segment_table,
+		     lookup_entry->segment_number,
+		     file_io_pool,
+		     segment_file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment file: %" PRIu32 " from segment table.",
+			 function,
+			 lookup_entry->segment_number );
+
+			return( -1 );
+		}
+		if( libewf_segment_file_get_chunk_group_by_index(
+		     *segment_file,
+		     file_io_pool,
+		     chunk_groups_cache,
+		     lookup_entry->chunk_groups_list_index,
+		     chunk_group,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk group: %d from segment file: %" PRIu32 ".",
+			 function,
+			 lookup_entry->chunk_groups_list_index,
+			 lookup_entry->segment_number );
+
+			return( -1 );
+		}
+		*segment_number           = lookup_entry->segment_number;
+		*segment_file_data_offset = offset - lookup_entry->segment_file_offset;
+		*chunk_groups_list_index  = lookup_entry->chunk_groups_list_index;
+		*chunk_group_data_offset  = offset - lookup_entry->chunk_group_offset;
+	}
+	else
+	{
+		result = libewf_segment_table_get_segment_file_at_offset(
+		          segment_table,
+		          offset,
+		          file_io_pool,
+		          segment_number,
+		          segment_file_data_offset,
+		          segment_file,
+		          error );
 
 		if( result == -1 )
 		{
@@ -616,13 +908,80 @@ int libewf_chunk_table_get_segment_file_chunk_group_by_offset(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve chunk group from segment file: %" PRIu32 " at 0x%08" PRIx64 ".",
+			 "%s: unable to retrieve segment file at 0x%08" PRIx64 " from segment files list.",
 			 function,
-			 *segment_number,
-			 *segment_file_data_offset );
+			 offset );
 
 			return( -1 );
 		}
+		if( result != 0 )
+		{
+			result = libewf_segment_file_get_chunk_group_by_offset(
+				  *segment_file,
+				  file_io_pool,
+				  chunk_groups_cache,
+				  *segment_file_data_offset,
+				  chunk_groups_list_index,
+				  chunk_group_data_offset,
+				  chunk_group,
+				  error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve chunk group from segment file: %" PRIu32 " at 0x%08" PRIx64 ".",
+				 function,
+				 *segment_number,
+				 *segment_file_data_offset );
+
+				return( -1 );
+			}
+		}
+		if( result != 0 )
+		{
+			if( libewf_segment_file_get_chunk_group_storage_media_size_by_index(
+			     *segment_file,
+			     *chunk_groups_list_index,
+			     &chunk_group_size,
+			     error ) == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve chunk group: %d storage media size from segment file: %" PRIu32 ".",
+				 function,
+				 *chunk_groups_list_index,
+				 *segment_number );
+
+				return( -1 );
+			}
+			if( chunk_group_size > 0 )
+			{
+				if( libewf_chunk_table_insert_lookup_entry(
+				     chunk_table,
+				     offset - *chunk_group_data_offset,
+				     chunk_group_size,
+				     offset - *segment_file_data_offset,
+				     *segment_number,
+				     *chunk_groups_list_index,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+					 "%s: unable to insert chunk group: %d lookup entry.",
+					 function,
+					 *chunk_groups_list_index );
+
+					return( -1 );
+				}
+			}
+		}
 	}
 	if( result != 0 )
 	{
@@ -638,6 +997,12 @@ int libewf_chunk_table_get_segment_file_chunk_group_by_offset(
 
 			return( -1 );
 		}
+		if( chunk_table->io_handle != NULL )
+		{
+			LIBEWF_STATISTICS_ADD(
+			 chunk_table->io_handle->statistics.chunk_group_lookups,
+			 1 );
+		}
 	}
 	return( result );
 }
@@ -654,17 +1019,16 @@ int libewf_chunk_table_chunk_exists_for_offset(
      off64_t offset,
      libcerror_error_t **error )
 {
-	libewf_chunk_group_t *chunk_group           = NULL;
-	libewf_segment_file_t *segment_file         = NULL;
-	libfdata_list_element_t *chunk_list_element = NULL;
-	static char *function                       = "libewf_chunk_table_chunk_exists_for_offset";
-	off64_t chunk_data_offset                   = 0;
-	off64_t chunk_group_data_offset             = 0;
-	off64_t segment_file_data_offset            = 0;
-	uint32_t segment_number                     = 0;
-	int chunk_groups_list_index                 = 0;
-	int chunks_list_index                       = 0;
-	int result                                  = 0;
+	libewf_chunk_group_t *chunk_group   = NULL;
+	libewf_segment_file_t *segment_file = NULL;
+	static char *function               = "libewf_chunk_table_chunk_exists_for_offset";
+	off64_t chunk_data_offset           = 0;
+	off64_t chunk_group_data_offset     = 0;
+	off64_t segment_file_data_offset    = 0;
+	uint32_t segment_number             = 0;
+	int chunk_groups_list_index         = 0;
+	int chunk_group_index               = 0;
+	int result                          = 0;
 
 	if( chunk_table == NULL )
 	{
@@ -717,12 +1081,11 @@ int libewf_chunk_table_chunk_exists_for_offset(
 
 			return( -1 );
 		}
-		result = libfdata_list_get_list_element_at_offset(
-			  chunk_group->chunks_list,
+		result = libewf_chunk_group_get_chunk_index_at_offset(
+			  chunk_group,
 			  chunk_group_data_offset,
-			  &chunks_list_index,
+			  &chunk_group_index,
 			  &chunk_data_offset,
-			  &chunk_list_element,
 			  error );
 
 		if( result == -1 )
@@ -744,38 +1107,33 @@ int libewf_chunk_table_chunk_exists_for_offset(
 	return( result );
 }
 
-/* Retrieves the chunk data of a chunk at a specific offset
- * Adds a checksum error if the data is corrupted
- * Returns 1 if successful or -1 on error
+/* Retrieves the range of the (packed) chunk data of a chunk at a specific offset
+ * This function is not multi-thread safe acquire the handle IO lock before call
+ * Returns 1 if successful, 0 if the chunk is missing or -1 on error
  */
-int libewf_chunk_table_get_chunk_data_by_offset(
+int libewf_chunk_table_get_chunk_data_range_by_offset(
      libewf_chunk_table_t *chunk_table,
      uint64_t chunk_index,
-     libewf_io_handle_t *io_handle,
      libbfio_pool_t *file_io_pool,
-     libewf_media_values_t *media_values,
      libewf_segment_table_t *segment_table,
      libfcache_cache_t *chunk_groups_cache,
-     libfcache_cache_t *chunks_cache,
      off64_t offset,
-     libewf_chunk_data_t **chunk_data,
+     int *file_io_pool_entry,
      off64_t *chunk_data_offset,
+     size64_t *chunk_data_size,
+     uint32_t *range_flags,
      libcerror_error_t **error )
 {
-	libewf_chunk_data_t *corrupted_chunk_data = NULL;
-	libewf_chunk_group_t *chunk_group         = NULL;
-	libewf_segment_file_t *segment_file       = NULL;
-	static char *function                     = "libewf_chunk_table_get_chunk_data_by_offset";
-	off64_t chunk_offset                      = 0;
-	off64_t chunk_group_data_offset           = 0;
-	off64_t segment_file_data_offset          = 0;
-	size_t chunk_data_size                    = 0;
-	uint64_t start_sector                     = 0;
-	uint64_t number_of_sectors                = 0;
-	uint32_t segment_number                   = 0;
-	int chunk_groups_list_index               = 0;
-	int chunks_list_index                     = 0;
-	int result                                = 0;
+	libewf_chunk_group_t *chunk_group   = NULL;
+	libewf_segment_file_t *segment_file = NULL;
+	static char *function               = "libewf_chunk_table_get_chunk_data_range_by_offset";
+	off64_t chunk_group_data_offset     = 0;
+	off64_t element_data_offset         = 0;
+	off64_t segment_file_data_offset    = 0;
+	uint32_t segment_number             = 0;
+	int chunk_groups_list_index         = 0;
+	int chunk_group_index               = 0;
+	int result                          = 0;
 
 	if( chunk_table == NULL )
 	{
@@ -788,46 +1146,46 @@ int libewf_chunk_table_get_chunk_data_by_offset(
 
 		return( -1 );
 	}
-	if( io_handle == NULL )
+	if( file_io_pool_entry == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid IO handle.",
+		 "%s: invalid file IO pool entry.",
 		 function );
 
 		return( -1 );
 	}
-	if( media_values == NULL )
+	if( chunk_data_offset == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid media values.",
+		 "%s: invalid chunk data offset.",
 		 function );
 
 		return( -1 );
 	}
-	if( chunk_data == NULL )
+	if( chunk_data_size == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid chunk data.",
+		 "%s: invalid chunk data size.",
 		 function );
 
 		return( -1 );
 	}
-	if( chunk_data_offset == NULL )
+	if( range_flags == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid chunk data offset.",
+		 "%s: invalid range flags.",
 		 function );
 
 		return( -1 );
@@ -856,7 +1214,7 @@ int libewf_chunk_table_get_chunk_data_by_offset(
 		 function,
 		 offset );
 
-		goto on_error;
+		return( -1 );
 	}
 	if( result != 0 )
 	{
@@ -870,17 +1228,13 @@ int libewf_chunk_table_get_chunk_data_by_offset(
 			 function,
 			 chunk_groups_list_index );
 
-			goto on_error;
+			return( -1 );
 		}
-		result = libfdata_list_get_element_value_at_offset(
-			  chunk_group->chunks_list,
-			  (intptr_t *) file_io_pool,
-			  chunks_cache,
+		result = libewf_chunk_group_get_chunk_index_at_offset(
+			  chunk_group,
 			  chunk_group_data_offset,
-			  &chunks_list_index,
-			  chunk_data_offset,
-			  (intptr_t **) chunk_data,
-			  0,
+			  &chunk_group_index,
+			  &element_data_offset,
 			  error );
 
 		if( result == -1 )
@@ -889,47 +1243,237 @@ int libewf_chunk_table_get_chunk_data_by_offset(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve chunk: %" PRIu64 " data from chunk group: %d in segment file: %" PRIu32 " at 0x%08" PRIx64 ".",
+			 "%s: unable to retrieve chunk: %" PRIu64 " from chunk group: %d in segment file: %" PRIu32 " at 0x%08" PRIx64 ".",
 			 function,
 			 chunk_index,
 			 chunk_groups_list_index,
 			 segment_number,
 			 segment_file_data_offset );
 
-			goto on_error;
+			return( -1 );
 		}
 	}
 	if( result != 0 )
 	{
-		if( *chunk_data == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing chunk: %" PRIu64 " data.",
-			 function,
-			 chunk_index );
-
-			goto on_error;
-		}
-		if( libewf_chunk_data_unpack(
-		     *chunk_data,
-		     io_handle,
+		if( libewf_chunk_group_get_chunk_range_by_index(
+		     chunk_group,
+		     chunk_group_index,
+		     file_io_pool_entry,
+		     chunk_data_offset,
+		     chunk_data_size,
+		     range_flags,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GENERIC,
-			 "%s: unable to unpack chunk: %" PRIu64 " data.",
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk: %" PRIu64 " data range.",
 			 function,
 			 chunk_index );
 
-			goto on_error;
+			return( -1 );
 		}
-		if( ( ( *chunk_data )->range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED ) != 0 )
-		{
+	}
+	return( result );
+}
+
+/* Retrieves the chunk data of a chunk at a specific offset
+ * Adds a checksum error if the data is corrupted
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_table_get_chunk_data_by_offset(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t chunk_index,
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     libewf_segment_table_t *segment_table,
+     libfcache_cache_t *chunk_groups_cache,
+     libfcache_cache_t *chunks_cache,
+     off64_t offset,
+     libewf_chunk_data_t **chunk_data,
+     off64_t *chunk_data_offset,
+     libcerror_error_t **error )
+{
+	libewf_chunk_data_t *corrupted_chunk_data = NULL;
+	libewf_chunk_group_t *chunk_group         = NULL;
+	libewf_segment_file_t *segment_file       = NULL;
+	static char *function                     = "libewf_chunk_table_get_chunk_data_by_offset";
+	off64_t chunk_offset                      = 0;
+	off64_t chunk_group_data_offset           = 0;
+	off64_t segment_file_data_offset          = 0;
+	size_t chunk_data_size                    = 0;
+	uint64_t start_sector                     = 0;
+	uint64_t number_of_sectors                = 0;
+	uint32_t segment_number                   = 0;
+	int chunk_groups_list_index               = 0;
+	int chunk_group_index                     = 0;
+	int result                                = 0;
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data offset.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_chunk_table_get_segment_file_chunk_group_by_offset(
+		  chunk_table,
+		  file_io_pool,
+		  segment_table,
+		  chunk_groups_cache,
+		  offset,
+		  &segment_number,
+		  &segment_file_data_offset,
+		  &segment_file,
+		  &chunk_groups_list_index,
+		  &chunk_group_data_offset,
+		  &chunk_group,
+		  error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment file chunk group at 0x%08" PRIx64 ".",
+		 function,
+		 offset );
+
+		goto on_error;
+	}
+	if( result != 0 )
+	{
+		if( chunk_group == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing chunk group: %d.",
+			 function,
+			 chunk_groups_list_index );
+
+			goto on_error;
+		}
+		result = libewf_chunk_group_get_chunk_index_at_offset(
+			  chunk_group,
+			  chunk_group_data_offset,
+			  &chunk_group_index,
+			  chunk_data_offset,
+			  error );
+
+		if( result == 1 )
+		{
+			if( libewf_chunk_group_get_chunk_data_by_index(
+			     chunk_group,
+			     io_handle,
+			     file_io_pool,
+			     chunks_cache,
+			     chunk_group_index,
+			     chunk_data,
+			     error ) != 1 )
+			{
+				result = -1;
+			}
+		}
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk: %" PRIu64 " data from chunk group: %d in segment file: %" PRIu32 " at 0x%08" PRIx64 ".",
+			 function,
+			 chunk_index,
+			 chunk_groups_list_index,
+			 segment_number,
+			 segment_file_data_offset );
+
+			goto on_error;
+		}
+	}
+	if( result != 0 )
+	{
+		if( *chunk_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		if( libewf_chunk_data_unpack(
+		     *chunk_data,
+		     io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to unpack chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		if( ( ( *chunk_data )->range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED ) != 0 )
+		{
 			chunk_offset = offset - *chunk_data_offset;
 		}
 	}
@@ -1051,29 +1595,33 @@ on_error:
 	return( -1 );
 }
 
-/* Sets the chunk data of a chunk at a specific offset
- * Adds a checksum error if the data is corrupted
+/* Reads the (packed) chunk data of a chunk at a specific offset
+ * The chunk data is not stored in a cache and must be freed by the caller
+ * If the chunk is missing zero-ed chunk data is created that is marked as corrupted
+ * This function is not multi-thread safe acquire the handle IO lock before call
  * Returns 1 if successful or -1 on error
  */
-int libewf_chunk_table_set_chunk_data_by_offset(
+int libewf_chunk_table_read_chunk_data_by_offset(
      libewf_chunk_table_t *chunk_table,
      uint64_t chunk_index,
+     libewf_io_handle_t *io_handle,
      libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
      libewf_segment_table_t *segment_table,
      libfcache_cache_t *chunk_groups_cache,
-     libfcache_cache_t *chunks_cache,
      off64_t offset,
-     libewf_chunk_data_t *chunk_data,
+     libewf_chunk_data_t **chunk_data,
      libcerror_error_t **error )
 {
-	libewf_chunk_group_t *chunk_group   = NULL;
-	libewf_segment_file_t *segment_file = NULL;
-	static char *function               = "libewf_chunk_table_set_chunk_data_by_offset";
-	off64_t chunk_group_data_offset     = 0;
-	off64_t segment_file_data_offset    = 0;
-	uint32_t segment_number             = 0;
-	int chunk_groups_list_index         = 0;
-	int result                          = 0;
+	libewf_chunk_data_t *safe_chunk_data = NULL;
+	static char *function                = "libewf_chunk_table_read_chunk_data_by_offset";
+	off64_t chunk_data_offset            = 0;
+	off64_t chunk_offset                 = 0;
+	size64_t chunk_data_size             = 0;
+	ssize_t read_count                   = 0;
+	uint32_t range_flags                 = 0;
+	int file_io_pool_entry               = 0;
+	int result                           = 0;
 
 	if( chunk_table == NULL )
 	{
@@ -1086,6 +1634,28 @@ int libewf_chunk_table_set_chunk_data_by_offset(
 
 		return( -1 );
 	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media values.",
+		 function );
+
+		return( -1 );
+	}
 	if( chunk_data == NULL )
 	{
 		libcerror_error_set(
@@ -1097,54 +1667,662 @@ int libewf_chunk_table_set_chunk_data_by_offset(
 
 		return( -1 );
 	}
-	result = libewf_chunk_table_get_segment_file_chunk_group_by_offset(
+	result = libewf_chunk_table_get_chunk_data_range_by_offset(
 		  chunk_table,
+		  chunk_index,
 		  file_io_pool,
 		  segment_table,
 		  chunk_groups_cache,
 		  offset,
-		  &segment_number,
-		  &segment_file_data_offset,
-		  &segment_file,
-		  &chunk_groups_list_index,
-		  &chunk_group_data_offset,
-		  &chunk_group,
+		  &file_io_pool_entry,
+		  &chunk_data_offset,
+		  &chunk_data_size,
+		  &range_flags,
 		  error );
 
-	if( result != 1 )
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve segment file chunk group at 0x%08" PRIx64 ".",
+		 "%s: unable to retrieve chunk: %" PRIu64 " data range.",
 		 function,
-		 offset );
+		 chunk_index );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( chunk_group == NULL )
+	else if( result != 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: missing chunk group: %d.",
-		 function,
-		 chunk_groups_list_index );
-
-		return( -1 );
-	}
-	result = libfdata_list_set_element_value_at_offset(
-		  chunk_group->chunks_list,
-		  (intptr_t *) file_io_pool,
-		  chunks_cache,
-		  chunk_group_data_offset,
-		  (intptr_t *) chunk_data,
-		  (int (*)(intptr_t **, libcerror_error_t **)) &libewf_chunk_data_free,
-		  LIBFDATA_LIST_ELEMENT_VALUE_FLAG_MANAGED,
-		  error );
+		if( ( range_flags & LIBEWF_RANGE_FLAG_IS_SPARSE ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported chunk: %" PRIu64 " range flags.",
+			 function,
+			 chunk_index );
 
+			goto on_error;
+		}
+		if( libewf_chunk_data_initialize(
+		     &safe_chunk_data,
+		     media_values->chunk_size,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		if( chunk_data_size > (size64_t) safe_chunk_data->allocated_data_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid chunk: %" PRIu64 " data size value out of bounds.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		read_count = libewf_chunk_data_read_from_file_io_pool(
+			      safe_chunk_data,
+			      file_io_pool,
+			      file_io_pool_entry,
+			      chunk_data_offset,
+			      chunk_data_size,
+			      range_flags,
+			      error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		LIBEWF_STATISTICS_ADD(
+		 io_handle->statistics.bytes_read,
+		 read_count );
+
+		LIBEWF_STATISTICS_ADD(
+		 io_handle->statistics.number_of_reads,
+		 1 );
+	}
+	else
+	{
+		chunk_offset    = (off64_t) chunk_index * media_values->chunk_size;
+		chunk_data_size = media_values->chunk_size;
+
+		if( (size64_t) ( chunk_offset + chunk_data_size ) > media_values->media_size )
+		{
+			chunk_data_size = media_values->media_size - chunk_offset;
+		}
+		if( libewf_chunk_data_initialize(
+		     &safe_chunk_data,
+		     media_values->chunk_size,
+		     1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		safe_chunk_data->data_size    = (size_t) chunk_data_size;
+		safe_chunk_data->range_flags |= LIBEWF_RANGE_FLAG_IS_CORRUPTED;
+	}
+	*chunk_data = safe_chunk_data;
+
+	return( 1 );
+
+on_error:
+	if( safe_chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &safe_chunk_data,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads the (packed) chunk data of consecutive chunks starting at a specific offset
+ * The chunk data of chunks that are stored adjacent to each other in the same
+ * chunk group and segment file is read with a single read of at most maximum read size
+ * At least the chunk data of the first chunk is read, chunks that cannot be combined are not read
+ * The chunk data is not stored in a cache and must be freed by the caller
+ * This function is not multi-thread safe acquire the handle IO lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_table_read_chunks_data_by_offset(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t chunk_index,
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     libewf_segment_table_t *segment_table,
+     libfcache_cache_t *chunk_groups_cache,
+     off64_t offset,
+     size_t maximum_read_size,
+     libewf_chunk_data_t **chunks_data,
+     int maximum_number_of_chunks,
+     int *number_of_chunks,
+     libcerror_error_t **error )
+{
+	libewf_chunk_group_t *chunk_group   = NULL;
+	libewf_segment_file_t *segment_file = NULL;
+	uint8_t *read_buffer                = NULL;
+	static char *function               = "libewf_chunk_table_read_chunks_data_by_offset";
+	size_t read_buffer_offset           = 0;
+	size_t read_size                    = 0;
+	ssize_t read_count                  = 0;
+	off64_t chunk_data_offset           = 0;
+	off64_t chunk_group_data_offset     = 0;
+	off64_t element_data_offset         = 0;
+	off64_t next_chunk_data_offset      = 0;
+	off64_t read_offset                 = 0;
+	off64_t segment_file_data_offset    = 0;
+	size64_t chunk_data_size            = 0;
+	uint32_t range_flags                = 0;
+	uint32_t segment_number             = 0;
+	int chunk_groups_list_index         = 0;
+	int chunk_group_index               = 0;
+	int file_io_pool_entry              = 0;
+	int next_file_io_pool_entry         = 0;
+	int number_of_chunks_in_group       = 0;
+	int read_number_of_chunks           = 0;
+	int result                          = 0;
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_read_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid maximum read size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunks_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunks data.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_chunks <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid maximum number of chunks value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_chunks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of chunks.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_chunks > 1 )
+	{
+		result = libewf_chunk_table_get_segment_file_chunk_group_by_offset(
+			  chunk_table,
+			  file_io_pool,
+			  segment_table,
+			  chunk_groups_cache,
+			  offset,
+			  &segment_number,
+			  &segment_file_data_offset,
+			  &segment_file,
+			  &chunk_groups_list_index,
+			  &chunk_group_data_offset,
+			  &chunk_group,
+			  error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment file chunk group at 0x%08" PRIx64 ".",
+			 function,
+			 offset );
+
+			goto on_error;
+		}
+		else if( result != 0 )
+		{
+			if( chunk_group == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+				 "%s: missing chunk group: %d.",
+				 function,
+				 chunk_groups_list_index );
+
+				goto on_error;
+			}
+			result = libewf_chunk_group_get_chunk_index_at_offset(
+				  chunk_group,
+				  chunk_group_data_offset,
+				  &chunk_group_index,
+				  &element_data_offset,
+				  error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve chunk: %" PRIu64 " from chunk group: %d in segment file: %" PRIu32 " at 0x%08" PRIx64 ".",
+				 function,
+				 chunk_index,
+				 chunk_groups_list_index,
+				 segment_number,
+				 segment_file_data_offset );
+
+				goto on_error;
+			}
+		}
+		if( result != 0 )
+		{
+			if( libewf_chunk_group_get_number_of_chunks(
+			     chunk_group,
+			     &number_of_chunks_in_group,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve number of chunks from chunk group.",
+				 function );
+
+				goto on_error;
+			}
+			if( maximum_number_of_chunks > ( number_of_chunks_in_group - chunk_group_index ) )
+			{
+				maximum_number_of_chunks = number_of_chunks_in_group - chunk_group_index;
+			}
+			/* Determine the number of chunks that are stored adjacent to each other
+			 */
+			while( read_number_of_chunks < maximum_number_of_chunks )
+			{
+				if( libewf_chunk_group_get_chunk_range_by_index(
+				     chunk_group,
+				     chunk_group_index + read_number_of_chunks,
+				     &file_io_pool_entry,
+				     &chunk_data_offset,
+				     &chunk_data_size,
+				     &range_flags,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve chunk: %" PRIu64 " data range.",
+					 function,
+					 chunk_index + read_number_of_chunks );
+
+					goto on_error;
+				}
+				if( ( range_flags & LIBEWF_RANGE_FLAG_IS_SPARSE ) != 0 )
+				{
+					break;
+				}
+				if( ( chunk_data_size == 0 )
+				 || ( chunk_data_size > (size64_t) ( media_values->chunk_size + 4 ) ) )
+				{
+					break;
+				}
+				if( read_number_of_chunks == 0 )
+				{
+					read_offset             = chunk_data_offset;
+					next_file_io_pool_entry = file_io_pool_entry;
+				}
+				else if( ( file_io_pool_entry != next_file_io_pool_entry )
+				      || ( chunk_data_offset != next_chunk_data_offset ) )
+				{
+					break;
+				}
+				if( chunk_data_size > (size64_t) ( maximum_read_size - read_size ) )
+				{
+					break;
+				}
+				read_size             += (size_t) chunk_data_size;
+				next_chunk_data_offset = chunk_data_offset + (off64_t) chunk_data_size;
+
+				read_number_of_chunks++;
+			}
+		}
+	}
+	/* Fall back to reading a single chunk if no chunks can be combined
+	 */
+	if( read_number_of_chunks <= 1 )
+	{
+		if( libewf_chunk_table_read_chunk_data_by_offset(
+		     chunk_table,
+		     chunk_index,
+		     io_handle,
+		     file_io_pool,
+		     media_values,
+		     segment_table,
+		     chunk_groups_cache,
+		     offset,
+		     &( chunks_data[ 0 ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		*number_of_chunks = 1;
+
+		return( 1 );
+	}
+	read_buffer = (uint8_t *) memory_allocate(
+	                           sizeof( uint8_t ) * read_size );
+
+	if( read_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create read buffer.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_pool_seek_offset(
+	     file_io_pool,
+	     file_io_pool_entry,
+	     read_offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset: %" PRIi64 " in file IO pool entry: %d.",
+		 function,
+		 read_offset,
+		 file_io_pool_entry );
+
+		goto on_error;
+	}
+	read_count = libbfio_pool_read_buffer(
+		      file_io_pool,
+		      file_io_pool_entry,
+		      read_buffer,
+		      read_size,
+		      error );
+
+	if( read_count != (ssize_t) read_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read chunks data.",
+		 function );
+
+		goto on_error;
+	}
+	for( *number_of_chunks = 0;
+	     *number_of_chunks < read_number_of_chunks;
+	     *number_of_chunks += 1 )
+	{
+		if( libewf_chunk_group_get_chunk_range_by_index(
+		     chunk_group,
+		     chunk_group_index + *number_of_chunks,
+		     &file_io_pool_entry,
+		     &chunk_data_offset,
+		     &chunk_data_size,
+		     &range_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk: %" PRIu64 " data range.",
+			 function,
+			 chunk_index + *number_of_chunks );
+
+			goto on_error;
+		}
+		if( libewf_chunk_data_initialize(
+		     &( chunks_data[ *number_of_chunks ] ),
+		     media_values->chunk_size,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index + *number_of_chunks );
+
+			goto on_error;
+		}
+		read_count = libewf_chunk_data_read_from_buffer(
+			      chunks_data[ *number_of_chunks ],
+			      &( read_buffer[ read_buffer_offset ] ),
+			      (size_t) chunk_data_size,
+			      range_flags,
+			      error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index + *number_of_chunks );
+
+			goto on_error;
+		}
+		read_buffer_offset += (size_t) chunk_data_size;
+	}
+	memory_free(
+	 read_buffer );
+
+	return( 1 );
+
+on_error:
+	if( read_buffer != NULL )
+	{
+		memory_free(
+		 read_buffer );
+	}
+	while( read_number_of_chunks > 0 )
+	{
+		read_number_of_chunks--;
+
+		if( chunks_data[ read_number_of_chunks ] != NULL )
+		{
+			libewf_chunk_data_free(
+			 &( chunks_data[ read_number_of_chunks ] ),
+			 NULL );
+		}
+	}
+	return( -1 );
+}
+
+/* Sets the chunk data of a chunk at a specific offset
+ * Adds a checksum error if the data is corrupted
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_table_set_chunk_data_by_offset(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t chunk_index,
+     libbfio_pool_t *file_io_pool,
+     libewf_segment_table_t *segment_table,
+     libfcache_cache_t *chunk_groups_cache,
+     libfcache_cache_t *chunks_cache,
+     off64_t offset,
+     libewf_chunk_data_t *chunk_data,
+     libcerror_error_t **error )
+{
+	libewf_chunk_group_t *chunk_group   = NULL;
+	libewf_segment_file_t *segment_file = NULL;
+	static char *function               = "libewf_chunk_table_set_chunk_data_by_offset";
+	off64_t chunk_data_offset           = 0;
+	off64_t chunk_group_data_offset     = 0;
+	off64_t segment_file_data_offset    = 0;
+	uint32_t segment_number             = 0;
+	int chunk_group_index               = 0;
+	int chunk_groups_list_index         = 0;
+	int result                          = 0;
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_chunk_table_get_segment_file_chunk_group_by_offset(
+		  chunk_table,
+		  file_io_pool,
+		  segment_table,
+		  chunk_groups_cache,
+		  offset,
+		  &segment_number,
+		  &segment_file_data_offset,
+		  &segment_file,
+		  &chunk_groups_list_index,
+		  &chunk_group_data_offset,
+		  &chunk_group,
+		  error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment file chunk group at 0x%08" PRIx64 ".",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	if( chunk_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing chunk group: %d.",
+		 function,
+		 chunk_groups_list_index );
+
+		return( -1 );
+	}
+	result = libewf_chunk_group_get_chunk_index_at_offset(
+		  chunk_group,
+		  chunk_group_data_offset,
+		  &chunk_group_index,
+		  &chunk_data_offset,
+		  error );
+
+	if( result == 1 )
+	{
+		result = libewf_chunk_group_set_chunk_data_by_index(
+			  chunk_group,
+			  chunks_cache,
+			  chunk_group_index,
+			  chunk_data,
+			  error );
+	}
 	if( result != 1 )
 	{
 		libcerror_error_set(
@@ -38,6 +38,31 @@
 extern "C" {
 #endif
 
+typedef struct libewf_chunk_table_lookup_entry libewf_chunk_table_lookup_entry_t;
+
+struct libewf_chunk_table_lookup_entry
+{
+	/* The storage media offset of the chunk group
+	 */
+	off64_t chunk_group_offset;
+
+	/* The storage media size of the chunk group
+	 */
+	size64_t chunk_group_size;
+
+	/* The storage media offset of the segment file
+	 */
+	off64_t segment_file_offset;
+
+	/* The segment number
+	 */
+	uint32_t segment_number;
+
+	/* The index of the chunk group in the segment file
+	 */
+	int chunk_groups_list_index;
+};
+
 typedef struct libewf_chunk_table libewf_chunk_table_t;
 
 struct libewf_chunk_table
@@ -61,6 +86,22 @@ struct libewf_chunk_table
 	/* The sectors with checksum errors
 	 */
 	libcdata_range_list_t *checksum_errors;
+
+	/* The chunk group lookup entries, sorted by storage media offset
+	 */
+	libewf_chunk_table_lookup_entry_t *lookup_entries;
+
+	/* The number of chunk group lookup entries
+	 */
+	int number_of_lookup_entries;
+
+	/* The number of allocated chunk group lookup entries
+	 */
+	int number_of_allocated_lookup_entries;
+
+	/* The index of the most recently used chunk group lookup entry
+	 */
+	int last_lookup_entry_index;
 };
 
 int libewf_chunk_table_initialize(
@@ -95,6 +136,21 @@ int libewf_chunk_table_append_checksum_error(
      uint64_t number_of_sectors,
      libcerror_error_t **error );
 
+int libewf_chunk_table_get_lookup_entry_index_by_offset(
+     libewf_chunk_table_t *chunk_table,
+     off64_t offset,
+     int *lookup_entry_index,
+     libcerror_error_t **error );
+
+int libewf_chunk_table_insert_lookup_entry(
+     libewf_chunk_table_t *chunk_table,
+     off64_t chunk_group_offset,
+     size64_t chunk_group_size,
+     off64_t segment_file_offset,
+     uint32_t segment_number,
+     int chunk_groups_list_index,
+     libcerror_error_t **error );
+
 int libewf_chunk_table_get_segment_file_chunk_group_by_offset(
      libewf_chunk_table_t *chunk_table,
      libbfio_pool_t *file_io_pool,
@@ -118,6 +174,19 @@ int libewf_chunk_table_chunk_exists_for_offset(
      off64_t offset,
      libcerror_error_t **error );
 
+int libewf_chunk_table_get_chunk_data_range_by_offset(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t chunk_index,
+     libbfio_pool_t *file_io_pool,
+     libewf_segment_table_t *segment_table,
+     libfcache_cache_t *chunk_groups_cache,
+     off64_t offset,
+     int *file_io_pool_entry,
+     off64_t *chunk_data_offset,
+     size64_t *chunk_data_size,
+     uint32_t *range_flags,
+     libcerror_error_t **error );
+
 int libewf_chunk_table_get_chunk_data_by_offset(
      libewf_chunk_table_t *chunk_table,
      uint64_t chunk_index,
@@ -132,6 +201,33 @@ int libewf_chunk_table_get_chunk_data_by_offset(
      off64_t *chunk_data_offset,
      libcerror_error_t **error );
 
+int libewf_chunk_table_read_chunk_data_by_offset(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t chunk_index,
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     libewf_segment_table_t *segment_table,
+     libfcache_cache_t *chunk_groups_cache,
+     off64_t offset,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error );
+
+int libewf_chunk_table_read_chunks_data_by_offset(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t chunk_index,
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     libewf_segment_table_t *segment_table,
+     libfcache_cache_t *chunk_groups_cache,
+     off64_t offset,
+     size_t maximum_read_size,
+     libewf_chunk_data_t **chunks_data,
+     int maximum_number_of_chunks,
+     int *number_of_chunks,
+     libcerror_error_t **error );
+
 int libewf_chunk_table_set_chunk_data_by_offset(
      libewf_chunk_table_t *chunk_table,
      uint64_t chunk_index,
@@ -0,0 +1,320 @@
+/*
+ * Chunk view functions
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_chunk_cache.h"
+#include "libewf_chunk_data.h"
+#include "libewf_chunk_view.h"
+#include "libewf_libcerror.h"
+#include "libewf_types.h"
+
+/* Creates a chunk view
+ * Make sure the value chunk_view is referencing, is set to NULL
+ * The chunk view takes over the reference on the chunk cache value
+ * The data of the chunk view starts at the chunk data offset and is limited to the maximum data size
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_view_initialize(
+     libewf_chunk_view_t **chunk_view,
+     libewf_chunk_cache_t *chunk_cache,
+     libewf_chunk_cache_value_t **chunk_cache_value,
+     size_t chunk_data_offset,
+     size_t maximum_data_size,
+     off64_t offset,
+     libcerror_error_t **error )
+{
+	libewf_chunk_data_t *chunk_data                   = NULL;
+	libewf_internal_chunk_view_t *internal_chunk_view = NULL;
+	static char *function                             = "libewf_chunk_view_initialize";
+
+	if( chunk_view == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk view.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_view != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid chunk view value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chunk_cache_value == NULL )
+	 || ( *chunk_cache_value == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache value.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_data = ( *chunk_cache_value )->chunk_data;
+
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid chunk cache value - missing chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data_offset >= chunk_data->data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk data offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	internal_chunk_view = memory_allocate_structure(
+	                       libewf_internal_chunk_view_t );
+
+	if( internal_chunk_view == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create chunk view.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     internal_chunk_view,
+	     0,
+	     sizeof( libewf_internal_chunk_view_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear chunk view.",
+		 function );
+
+		memory_free(
+		 internal_chunk_view );
+
+		return( -1 );
+	}
+	internal_chunk_view->offset            = offset;
+	internal_chunk_view->data              = &( ( chunk_data->data )[ chunk_data_offset ] );
+	internal_chunk_view->data_size         = chunk_data->data_size - chunk_data_offset;
+	internal_chunk_view->chunk_cache       = chunk_cache;
+	internal_chunk_view->chunk_cache_value = *chunk_cache_value;
+
+	if( internal_chunk_view->data_size > maximum_data_size )
+	{
+		internal_chunk_view->data_size = maximum_data_size;
+	}
+	*chunk_cache_value = NULL;
+
+	*chunk_view = (libewf_chunk_view_t *) internal_chunk_view;
+
+	return( 1 );
+}
+
+/* Frees a chunk view
+ * Releases the reference on the chunk cache value, which unpins the data
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_view_free(
+     libewf_chunk_view_t **chunk_view,
+     libcerror_error_t **error )
+{
+	libewf_internal_chunk_view_t *internal_chunk_view = NULL;
+	static char *function                             = "libewf_chunk_view_free";
+	int result                                        = 1;
+
+	if( chunk_view == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk view.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_view != NULL )
+	{
+		internal_chunk_view = (libewf_internal_chunk_view_t *) *chunk_view;
+		*chunk_view         = NULL;
+
+		if( libewf_chunk_cache_release_value(
+		     internal_chunk_view->chunk_cache,
+		     &( internal_chunk_view->chunk_cache_value ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to release chunk cache value.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 internal_chunk_view );
+	}
+	return( result );
+}
+
+/* Retrieves the data of the chunk view
+ * The data is read-only and remains valid until the chunk view is unpinned
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_view_get_data(
+     libewf_chunk_view_t *chunk_view,
+     const uint8_t **data,
+     size_t *data_size,
+     libcerror_error_t **error )
+{
+	libewf_internal_chunk_view_t *internal_chunk_view = NULL;
+	static char *function                             = "libewf_chunk_view_get_data";
+
+	if( chunk_view == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk view.",
+		 function );
+
+		return( -1 );
+	}
+	internal_chunk_view = (libewf_internal_chunk_view_t *) chunk_view;
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data size.",
+		 function );
+
+		return( -1 );
+	}
+	*data      = internal_chunk_view->data;
+	*data_size = internal_chunk_view->data_size;
+
+	return( 1 );
+}
+
+/* Retrieves the (media) offset of the data of the chunk view
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_view_get_offset(
+     libewf_chunk_view_t *chunk_view,
+     off64_t *offset,
+     libcerror_error_t **error )
+{
+	libewf_internal_chunk_view_t *internal_chunk_view = NULL;
+	static char *function                             = "libewf_chunk_view_get_offset";
+
+	if( chunk_view == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk view.",
+		 function );
+
+		return( -1 );
+	}
+	internal_chunk_view = (libewf_internal_chunk_view_t *) chunk_view;
+
+	if( offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offset.",
+		 function );
+
+		return( -1 );
+	}
+	*offset = internal_chunk_view->offset;
+
+	return( 1 );
+}
+
@@ -39,8 +39,10 @@
 #include "libewf_deflate.h"
 #include "libewf_libcerror.h"
 #include "libewf_libcnotify.h"
+#include "libewf_unused.h"
 
 /* Compresses data using the compression method
+ * The compression flags and deflate encoder are optional, refer to libewf_compress_data_with_level
  * Returns 1 on success, 0 if buffer is too small or -1 on error
  */
 int libewf_compress_data(
@@ -48,11 +50,88 @@ int libewf_compress_data(
      size_t *compressed_data_size,
      uint16_t compression_method,
      int8_t compression_level,
+     uint8_t compression_flags,
      const uint8_t *uncompressed_data,
      size_t uncompressed_data_size,
+     libewf_deflate_encoder_t **deflate_encoder,
      libcerror_error_t **error )
 {
-	static char *function                   = "libewf_compress_data";
+	static char *function        = "libewf_compress_data";
+	int method_compression_level = 0;
+	int result                   = 0;
+
+	if( compression_level == LIBEWF_COMPRESSION_DEFAULT )
+	{
+		method_compression_level = -1;
+	}
+	else if( compression_level == LIBEWF_COMPRESSION_NONE )
+	{
+		method_compression_level = 0;
+	}
+	else if( compression_level == LIBEWF_COMPRESSION_FAST )
+	{
+		method_compression_level = 1;
+	}
+	else if( compression_level == LIBEWF_COMPRESSION_BEST )
+	{
+		method_compression_level = 9;
+	}
+	else
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported compression level.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_compress_data_with_level(
+	          compressed_data,
+	          compressed_data_size,
+	          compression_method,
+	          method_compression_level,
+	          compression_flags,
+	          uncompressed_data,
+	          uncompressed_data_size,
+	          deflate_encoder,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+		 LIBCERROR_COMPRESSION_ERROR_COMPRESS_FAILED,
+		 "%s: unable to compress data.",
+		 function );
+	}
+	return( result );
+}
+
+/* Compresses data using the compression method with a method specific compression level
+ * The compression level is either -1 for the default level of the compression method,
+ * 0 for no compression (deflate only) or a value from 1 (fast) to 9 (best)
+ * The built-in deflate encoder is used if zlib is not available or, for the fast
+ * compression level (1), if the compression flags contain LIBEWF_COMPRESS_FLAG_USE_BUILTIN_DEFLATE
+ * If deflate encoder is not NULL the encoder it references is reused, or created
+ * on first use, and must be freed by the caller, otherwise a temporary encoder is used
+ * Returns 1 on success, 0 if buffer is too small or -1 on error
+ */
+int libewf_compress_data_with_level(
+     uint8_t *compressed_data,
+     size_t *compressed_data_size,
+     uint16_t compression_method,
+     int compression_level,
+     uint8_t compression_flags,
+     const uint8_t *uncompressed_data,
+     size_t uncompressed_data_size,
+     libewf_deflate_encoder_t **deflate_encoder,
+     libcerror_error_t **error )
+{
+	static char *function                   = "libewf_compress_data_with_level";
+	uint8_t use_builtin_deflate             = 0;
 	int result                              = 0;
 
 #if defined( HAVE_LIBBZ2 ) || defined( BZIP2_DLL )
@@ -110,24 +189,8 @@ int libewf_compress_data(
 	}
 	if( compression_method == LIBEWF_COMPRESSION_METHOD_DEFLATE )
 	{
-#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) ) || defined( ZLIB_DLL )
-		if( compression_level == LIBEWF_COMPRESSION_DEFAULT )
-		{
-			zlib_compression_level = Z_DEFAULT_COMPRESSION;
-		}
-		else if( compression_level == LIBEWF_COMPRESSION_FAST )
-		{
-			zlib_compression_level = Z_BEST_SPEED;
-		}
-		else if( compression_level == LIBEWF_COMPRESSION_BEST )
-		{
-			zlib_compression_level = Z_BEST_COMPRESSION;
-		}
-		else if( compression_level == LIBEWF_COMPRESSION_NONE )
-		{
-			zlib_compression_level = Z_NO_COMPRESSION;
-		}
-		else
+		if( ( compression_level < -1 )
+		 || ( compression_level > 9 ) )
 		{
 			libcerror_error_set(
 			 error,
@@ -138,114 +201,177 @@ int libewf_compress_data(
 
 			return( -1 );
 		}
-		if( *compressed_data_size > (size_t) ULONG_MAX )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-			 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-			 "%s: invalid compressed data size value exceeds maximum.",
-			 function );
-
-			return( -1 );
-		}
-		if( uncompressed_data_size > (size_t) ULONG_MAX )
+#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) ) || defined( ZLIB_DLL )
+		if( ( compression_level == 1 )
+		 && ( ( compression_flags & LIBEWF_COMPRESS_FLAG_USE_BUILTIN_DEFLATE ) != 0 ) )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-			 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-			 "%s: invalid uncompressed data size value exceeds maximum.",
-			 function );
-
-			return( -1 );
+			use_builtin_deflate = 1;
 		}
-		zlib_compressed_data_size = (uLongf) *compressed_data_size;
-
-		result = compress2(
-			  (Bytef *) compressed_data,
-			  &zlib_compressed_data_size,
-			  (Bytef *) uncompressed_data,
-			  (uLong) uncompressed_data_size,
-			  zlib_compression_level );
+#else
+		LIBEWF_UNREFERENCED_PARAMETER( compression_flags )
 
-		if( result == Z_OK )
+		use_builtin_deflate = 1;
+#endif
+		if( use_builtin_deflate != 0 )
 		{
-			*compressed_data_size = (size_t) zlib_compressed_data_size;
+			if( deflate_encoder == NULL )
+			{
+				result = libewf_deflate_compress(
+				          uncompressed_data,
+				          uncompressed_data_size,
+				          compressed_data,
+				          compressed_data_size,
+				          error );
+			}
+			else
+			{
+				if( *deflate_encoder == NULL )
+				{
+					if( libewf_deflate_encoder_initialize(
+					     deflate_encoder,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+						 "%s: unable to create deflate encoder.",
+						 function );
+
+						return( -1 );
+					}
+				}
+				result = libewf_deflate_encoder_compress(
+				          *deflate_encoder,
+				          uncompressed_data,
+				          uncompressed_data_size,
+				          compressed_data,
+				          compressed_data_size,
+				          error );
+			}
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+				 LIBCERROR_COMPRESSION_ERROR_COMPRESS_FAILED,
+				 "%s: unable to compress data.",
+				 function );
 
-			result = 1;
+				*compressed_data_size = 0;
+			}
 		}
-		else if( result == Z_BUF_ERROR )
+#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) ) || defined( ZLIB_DLL )
+		else
 		{
-#if defined( HAVE_DEBUG_OUTPUT )
-			if( libcnotify_verbose != 0 )
+			if( compression_level == -1 )
 			{
-				libcnotify_printf(
-			 	"%s: unable to write compressed data: target buffer too small.\n",
+				zlib_compression_level = Z_DEFAULT_COMPRESSION;
+			}
+			else
+			{
+				zlib_compression_level = compression_level;
+			}
+			if( *compressed_data_size > (size_t) ULONG_MAX )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+				 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+				 "%s: invalid compressed data size value exceeds maximum.",
+				 function );
+
+				return( -1 );
+			}
+			if( uncompressed_data_size > (size_t) ULONG_MAX )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+				 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+				 "%s: invalid uncompressed data size value exceeds maximum.",
 				 function );
+
+				return( -1 );
+			}
+			zlib_compressed_data_size = (uLongf) *compressed_data_size;
+
+			result = compress2(
+				  (Bytef *) compressed_data,
+				  &zlib_compressed_data_size,
+				  (Bytef *) uncompressed_data,
+				  (uLong) uncompressed_data_size,
+				  zlib_compression_level );
+
+			if( result == Z_OK )
+			{
+				*compressed_data_size = (size_t) zlib_compressed_data_size;
+
+				result = 1;
 			}
+			else if( result == Z_BUF_ERROR )
+			{
+#if defined( HAVE_DEBUG_OUTPUT )
+				if( libcnotify_verbose != 0 )
+				{
+					libcnotify_printf(
+				 	"%s: unable to write compressed data: target buffer too small.\n",
+					 function );
+				}
 #endif
 #if defined( HAVE_COMPRESS_BOUND ) || defined( WINAPI )
-			/* Use compressBound to determine the size of the uncompressed buffer
-			 */
-			zlib_compressed_data_size = compressBound( (uLong) uncompressed_data_size );
-			*compressed_data_size     = (size_t) zlib_compressed_data_size;
+				/* Use compressBound to determine the size of the uncompressed buffer
+				 */
+				zlib_compressed_data_size = compressBound( (uLong) uncompressed_data_size );
+				*compressed_data_size     = (size_t) zlib_compressed_data_size;
 #else
-			/* Estimate that a factor 2 enlargement should suffice
-			 */
-			*compressed_data_size *= 2;
+				/* Estimate that a factor 2 enlargement should suffice
+				 */
+				*compressed_data_size *= 2;
 #endif
-			result = 0;
-		}
-		else if( result == Z_MEM_ERROR )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-			 "%s: unable to write compressed data: insufficient memory.",
-			 function );
+				result = 0;
+			}
+			else if( result == Z_MEM_ERROR )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to write compressed data: insufficient memory.",
+				 function );
 
-			*compressed_data_size = 0;
+				*compressed_data_size = 0;
 
-			result = -1;
-		}
-		else
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
-			 LIBCERROR_COMPRESSION_ERROR_COMPRESS_FAILED,
-			 "%s: zlib returned undefined error: %d.",
-			 function,
-			 result );
+				result = -1;
+			}
+			else
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+				 LIBCERROR_COMPRESSION_ERROR_COMPRESS_FAILED,
+				 "%s: zlib returned undefined error: %d.",
+				 function,
+				 result );
 
-			*compressed_data_size = 0;
+				*compressed_data_size = 0;
 
-			result = -1;
+				result = -1;
+			}
 		}
-#else
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
-		 "%s: missing support for deflate compression.",
-		 function );
-
-		return( -1 );
 #endif /* ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) ) || defined( ZLIB_DLL ) */
 	}
 	else if( compression_method == LIBEWF_COMPRESSION_METHOD_BZIP2 )
 	{
 #if defined( HAVE_LIBBZ2 ) || defined( BZIP2_DLL )
-		if( ( compression_level == LIBEWF_COMPRESSION_DEFAULT )
-		 || ( compression_level == LIBEWF_COMPRESSION_FAST ) )
+		if( compression_level == -1 )
 		{
 			bzip2_compression_level = 1;
 		}
-		else if( compression_level == LIBEWF_COMPRESSION_BEST )
+		else if( ( compression_level >= 1 )
+		      && ( compression_level <= 9 ) )
 		{
-			bzip2_compression_level = 9;
+			bzip2_compression_level = compression_level;
 		}
 		else
 		{
@@ -25,6 +25,7 @@
 #include <common.h>
 #include <types.h>
 
+#include "libewf_deflate.h"
 #include "libewf_libcerror.h"
 
 #if defined( __cplusplus )
@@ -36,8 +37,21 @@ int libewf_compress_data(
      size_t *compressed_data_size,
      uint16_t compression_method,
      int8_t compression_level,
+     uint8_t compression_flags,
      const uint8_t *uncompressed_data,
      size_t uncompressed_data_size,
+     libewf_deflate_encoder_t **deflate_encoder,
+     libcerror_error_t **error );
+
+int libewf_compress_data_with_level(
+     uint8_t *compressed_data,
+     size_t *compressed_data_size,
+     uint16_t compression_method,
+     int compression_level,
+     uint8_t compression_flags,
+     const uint8_t *uncompressed_data,
+     size_t uncompressed_data_size,
+     libewf_deflate_encoder_t **deflate_encoder,
      libcerror_error_t **error );
 
 int libewf_decompress_data(
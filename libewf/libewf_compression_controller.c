@@ -0,0 +1,628 @@
+/*
+ * Compression controller functions
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_compression_controller.h"
+#include "libewf_definitions.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcnotify.h"
+#include "libewf_libcthreads.h"
+
+/* Creates a compression controller
+ * Make sure the value compression_controller is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_controller_initialize(
+     libewf_compression_controller_t **compression_controller,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compression_controller_initialize";
+
+	if( compression_controller == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression controller.",
+		 function );
+
+		return( -1 );
+	}
+	if( *compression_controller != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid compression controller value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*compression_controller = memory_allocate_structure(
+	                           libewf_compression_controller_t );
+
+	if( *compression_controller == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create compression controller.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *compression_controller,
+	     0,
+	     sizeof( libewf_compression_controller_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear compression controller.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *compression_controller )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	( *compression_controller )->number_of_threads = 1;
+	( *compression_controller )->compression_level = LIBEWF_ADAPTIVE_COMPRESSION_INITIAL_LEVEL;
+
+	return( 1 );
+
+on_error:
+	if( *compression_controller != NULL )
+	{
+		memory_free(
+		 *compression_controller );
+
+		*compression_controller = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a compression controller
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_controller_free(
+     libewf_compression_controller_t **compression_controller,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compression_controller_free";
+	int result            = 1;
+
+	if( compression_controller == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression controller.",
+		 function );
+
+		return( -1 );
+	}
+	if( *compression_controller != NULL )
+	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_free(
+		     &( ( *compression_controller )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		memory_free(
+		 *compression_controller );
+
+		*compression_controller = NULL;
+	}
+	return( result );
+}
+
+/* Resets the compression controller
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_controller_reset(
+     libewf_compression_controller_t *compression_controller,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compression_controller_reset";
+
+	if( compression_controller == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression controller.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     compression_controller->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	compression_controller->target_throughput        = 0;
+	compression_controller->number_of_threads        = 1;
+	compression_controller->compression_level        = LIBEWF_ADAPTIVE_COMPRESSION_INITIAL_LEVEL;
+	compression_controller->window_uncompressed_size = 0;
+	compression_controller->window_compressed_size   = 0;
+	compression_controller->window_compression_time  = 0;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     compression_controller->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the target input throughput
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_controller_get_target_throughput(
+     libewf_compression_controller_t *compression_controller,
+     uint64_t *target_throughput,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compression_controller_get_target_throughput";
+
+	if( compression_controller == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression controller.",
+		 function );
+
+		return( -1 );
+	}
+	if( target_throughput == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid target throughput.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     compression_controller->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*target_throughput = compression_controller->target_throughput;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     compression_controller->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the target input throughput
+ * The target throughput is in bytes per second, where 0 represents no target
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_controller_set_target_throughput(
+     libewf_compression_controller_t *compression_controller,
+     uint64_t target_throughput,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compression_controller_set_target_throughput";
+
+	if( compression_controller == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression controller.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     compression_controller->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	compression_controller->target_throughput = target_throughput;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     compression_controller->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the number of threads that compress concurrently
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_controller_set_number_of_threads(
+     libewf_compression_controller_t *compression_controller,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compression_controller_set_number_of_threads";
+
+	if( compression_controller == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression controller.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_threads <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid number of threads value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     compression_controller->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	compression_controller->number_of_threads = number_of_threads;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     compression_controller->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the (deflate) compression level to compress the next chunk with
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_controller_get_compression_level(
+     libewf_compression_controller_t *compression_controller,
+     int *compression_level,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compression_controller_get_compression_level";
+
+	if( compression_controller == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression controller.",
+		 function );
+
+		return( -1 );
+	}
+	if( compression_level == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression level.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     compression_controller->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*compression_level = compression_controller->compression_level;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     compression_controller->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Updates the compression controller with the result of compressing a chunk
+ * Once a window of data was compressed the compression level is reconsidered:
+ * - it is lowered when the compression cannot keep up with the target throughput
+ *   or when the data barely compresses, since higher levels then mostly cost time
+ * - it is raised when the data compresses well and there is enough headroom
+ *   to the target throughput
+ * Results of chunks compressed with a previous compression level are ignored
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_controller_update(
+     libewf_compression_controller_t *compression_controller,
+     int compression_level,
+     size_t uncompressed_data_size,
+     size_t compressed_data_size,
+     uint64_t compression_time,
+     libcerror_error_t **error )
+{
+	static char *function      = "libewf_compression_controller_update";
+	uint64_t compression_ratio = 0;
+	uint64_t throughput        = 0;
+	int safe_compression_level = 0;
+
+	if( compression_controller == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression controller.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     compression_controller->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( compression_level == compression_controller->compression_level )
+	{
+		/* Data that did not compress is accounted as its uncompressed size
+		 */
+		if( compressed_data_size > uncompressed_data_size )
+		{
+			compressed_data_size = uncompressed_data_size;
+		}
+		compression_controller->window_uncompressed_size += uncompressed_data_size;
+		compression_controller->window_compressed_size   += compressed_data_size;
+		compression_controller->window_compression_time  += compression_time;
+
+		if( compression_controller->window_uncompressed_size >= LIBEWF_ADAPTIVE_COMPRESSION_WINDOW_SIZE )
+		{
+			compression_ratio = ( compression_controller->window_compressed_size * 100 )
+			                  / compression_controller->window_uncompressed_size;
+
+			/* The throughput is estimated from the time spent compressing,
+			 * which is 0 if no timestamps are available
+			 */
+			if( compression_controller->window_compression_time > 0 )
+			{
+				throughput = ( compression_controller->window_uncompressed_size * 1000000000UL * (uint64_t) compression_controller->number_of_threads )
+				           / compression_controller->window_compression_time;
+			}
+			safe_compression_level = compression_controller->compression_level;
+
+			if( ( compression_controller->target_throughput != 0 )
+			 && ( throughput != 0 )
+			 && ( throughput < compression_controller->target_throughput ) )
+			{
+				if( throughput < ( compression_controller->target_throughput / 2 ) )
+				{
+					safe_compression_level -= 2;
+				}
+				else
+				{
+					safe_compression_level -= 1;
+				}
+			}
+			else if( compression_ratio >= LIBEWF_ADAPTIVE_COMPRESSION_POOR_RATIO )
+			{
+				safe_compression_level -= 1;
+			}
+			else if( ( compression_controller->target_throughput == 0 )
+			      || ( throughput == 0 )
+			      || ( throughput >= ( compression_controller->target_throughput + ( compression_controller->target_throughput / 2 ) ) ) )
+			{
+				safe_compression_level += 1;
+			}
+			if( safe_compression_level < LIBEWF_ADAPTIVE_COMPRESSION_MINIMUM_LEVEL )
+			{
+				safe_compression_level = LIBEWF_ADAPTIVE_COMPRESSION_MINIMUM_LEVEL;
+			}
+			else if( safe_compression_level > LIBEWF_ADAPTIVE_COMPRESSION_MAXIMUM_LEVEL )
+			{
+				safe_compression_level = LIBEWF_ADAPTIVE_COMPRESSION_MAXIMUM_LEVEL;
+			}
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: compression ratio: %" PRIu64 "%%, throughput: %" PRIu64 " bytes per second, compression level: %d -> %d.\n",
+				 function,
+				 compression_ratio,
+				 throughput,
+				 compression_controller->compression_level,
+				 safe_compression_level );
+			}
+#endif
+			compression_controller->compression_level        = safe_compression_level;
+			compression_controller->window_uncompressed_size = 0;
+			compression_controller->window_compressed_size   = 0;
+			compression_controller->window_compression_time  = 0;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     compression_controller->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
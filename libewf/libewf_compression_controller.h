@@ -0,0 +1,116 @@
+/*
+ * Compression controller functions
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_COMPRESSION_CONTROLLER_H )
+#define _LIBEWF_COMPRESSION_CONTROLLER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_compression_controller libewf_compression_controller_t;
+
+struct libewf_compression_controller
+{
+	/* The target input throughput in bytes per second
+	 * where 0 represents that there is no target
+	 */
+	uint64_t target_throughput;
+
+	/* The number of threads that compress concurrently
+	 */
+	int number_of_threads;
+
+	/* The current (deflate) compression level
+	 */
+	int compression_level;
+
+	/* The size of the uncompressed data of the current window
+	 */
+	uint64_t window_uncompressed_size;
+
+	/* The size of the compressed data of the current window
+	 */
+	uint64_t window_compressed_size;
+
+	/* The time spent compressing the data of the current window in nano seconds
+	 */
+	uint64_t window_compression_time;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+#endif
+};
+
+int libewf_compression_controller_initialize(
+     libewf_compression_controller_t **compression_controller,
+     libcerror_error_t **error );
+
+int libewf_compression_controller_free(
+     libewf_compression_controller_t **compression_controller,
+     libcerror_error_t **error );
+
+int libewf_compression_controller_reset(
+     libewf_compression_controller_t *compression_controller,
+     libcerror_error_t **error );
+
+int libewf_compression_controller_get_target_throughput(
+     libewf_compression_controller_t *compression_controller,
+     uint64_t *target_throughput,
+     libcerror_error_t **error );
+
+int libewf_compression_controller_set_target_throughput(
+     libewf_compression_controller_t *compression_controller,
+     uint64_t target_throughput,
+     libcerror_error_t **error );
+
+int libewf_compression_controller_set_number_of_threads(
+     libewf_compression_controller_t *compression_controller,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+int libewf_compression_controller_get_compression_level(
+     libewf_compression_controller_t *compression_controller,
+     int *compression_level,
+     libcerror_error_t **error );
+
+int libewf_compression_controller_update(
+     libewf_compression_controller_t *compression_controller,
+     int compression_level,
+     size_t uncompressed_data_size,
+     size_t compressed_data_size,
+     uint64_t compression_time,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_COMPRESSION_CONTROLLER_H ) */
+
@@ -25,6 +25,7 @@
 
 #include "libewf_data_chunk.h"
 #include "libewf_definitions.h"
+#include "libewf_deflate.h"
 #include "libewf_io_handle.h"
 #include "libewf_libcerror.h"
 #include "libewf_libcthreads.h"
@@ -194,6 +195,22 @@ int libewf_data_chunk_free(
 
 			result = -1;
 		}
+		if( internal_data_chunk->deflate_encoder != NULL )
+		{
+			if( libewf_deflate_encoder_free(
+			     &( internal_data_chunk->deflate_encoder ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free deflate encoder.",
+				 function );
+
+				result = -1;
+			}
+		}
 		/* The io_handle and write_io_handle references are freed elsewhere
 		 */
 		memory_free(
@@ -546,6 +563,7 @@ ssize_t libewf_data_chunk_write_buffer(
 	     internal_data_chunk->write_io_handle->compressed_zero_byte_empty_block,
 	     internal_data_chunk->write_io_handle->compressed_zero_byte_empty_block_size,
 	     internal_data_chunk->write_io_handle->pack_flags,
+	     &( internal_data_chunk->deflate_encoder ),
 	     error ) != 1 )
 	{
 		libcerror_error_set(
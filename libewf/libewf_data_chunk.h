@@ -26,6 +26,7 @@
 #include <types.h>
 
 #include "libewf_chunk_data.h"
+#include "libewf_deflate.h"
 #include "libewf_extern.h"
 #include "libewf_io_handle.h"
 #include "libewf_libcerror.h"
@@ -61,6 +62,10 @@ struct libewf_internal_data_chunk
 	 */
 	libewf_chunk_data_t *chunk_data;
 
+	/* The deflate encoder used to pack the chunk data
+	 */
+	libewf_deflate_encoder_t *deflate_encoder;
+
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	/* The read/write lock
 	 */
@@ -24,9 +24,54 @@
 #include <memory.h>
 #include <types.h>
 
+#include "libewf_checksum.h"
 #include "libewf_deflate.h"
 #include "libewf_libcerror.h"
 
+/* Fills the bit buffer with as many whole bytes from the byte stream as fit
+ * When at least 8 bytes remain in the byte stream the bit buffer contains
+ * at least 56 bits afterwards
+ */
+void libewf_deflate_bit_stream_fill_bit_buffer(
+      libewf_deflate_bit_stream_t *bit_stream )
+{
+	uint64_t value_64bit    = 0;
+	uint8_t number_of_bytes = 0;
+
+	if( ( bit_stream->byte_stream_size - bit_stream->byte_stream_offset ) >= 8 )
+	{
+		number_of_bytes = (uint8_t) ( 63 - bit_stream->bit_buffer_size ) >> 3;
+
+		if( number_of_bytes > 0 )
+		{
+			byte_stream_copy_to_uint64_little_endian(
+			 &( bit_stream->byte_stream[ bit_stream->byte_stream_offset ] ),
+			 value_64bit );
+
+			/* The bits of the bytes that are not consumed are masked
+			 * to keep the unused part of the bit buffer empty
+			 */
+			value_64bit &= 0xffffffffffffffffULL >> ( 64 - ( number_of_bytes * 8 ) );
+
+			bit_stream->bit_buffer         |= value_64bit << bit_stream->bit_buffer_size;
+			bit_stream->bit_buffer_size    += number_of_bytes * 8;
+			bit_stream->byte_stream_offset += number_of_bytes;
+		}
+	}
+	else
+	{
+		while( ( bit_stream->bit_buffer_size < 56 )
+		    && ( bit_stream->byte_stream_offset < bit_stream->byte_stream_size ) )
+		{
+			value_64bit   = bit_stream->byte_stream[ bit_stream->byte_stream_offset++ ];
+			value_64bit <<= bit_stream->bit_buffer_size;
+
+			bit_stream->bit_buffer      |= value_64bit;
+			bit_stream->bit_buffer_size += 8;
+		}
+	}
+}
+
 /* Retrieves a value from the bit stream
  * Returns 1 on success or -1 on error
  */
@@ -77,9 +122,12 @@ int libewf_deflate_bit_stream_get_value(
 
 		return( 1 );
 	}
-	while( bit_stream->bit_buffer_size < number_of_bits )
+	if( bit_stream->bit_buffer_size < number_of_bits )
 	{
-		if( bit_stream->byte_stream_offset >= bit_stream->byte_stream_size )
+		libewf_deflate_bit_stream_fill_bit_buffer(
+		 bit_stream );
+
+		if( bit_stream->bit_buffer_size < number_of_bits )
 		{
 			libcerror_error_set(
 			 error,
@@ -90,13 +138,8 @@ int libewf_deflate_bit_stream_get_value(
 
 			return( -1 );
 		}
-		*value_32bit   = bit_stream->byte_stream[ bit_stream->byte_stream_offset++ ];
-		*value_32bit <<= bit_stream->bit_buffer_size;
-
-		bit_stream->bit_buffer      |= *value_32bit;
-		bit_stream->bit_buffer_size += 8;
 	}
-	*value_32bit = bit_stream->bit_buffer & ~( 0xffffffffUL << number_of_bits );
+	*value_32bit = (uint32_t) ( bit_stream->bit_buffer & ~( 0xffffffffffffffffULL << number_of_bits ) );
 
 	bit_stream->bit_buffer     >>= number_of_bits;
 	bit_stream->bit_buffer_size -= number_of_bits;
@@ -114,13 +157,25 @@ int libewf_deflate_huffman_table_construct(
      libcerror_error_t **error )
 {
 	int code_offsets_array[ 16 ];
-
-	static char *function = "libewf_deflate_huffman_table_construct";
-	uint16_t code_size    = 0;
-	uint8_t bit_index     = 0;
-	int code_offset       = 0;
-	int left_value        = 0;
-	int symbol            = 0;
+	int remaining_code_counts_array[ 16 ];
+
+	static char *function     = "libewf_deflate_huffman_table_construct";
+	uint32_t huffman_code     = 0;
+	uint32_t reversed_code    = 0;
+	uint16_t code_size        = 0;
+	uint16_t lookup_value     = 0;
+	uint8_t bit_index         = 0;
+	uint8_t sub_table_bits    = 0;
+	int code_index            = 0;
+	int code_offset           = 0;
+	int code_size_count       = 0;
+	int left_value            = 0;
+	int lookup_index          = 0;
+	int next_sub_table_offset = 0;
+	int number_of_free_codes  = 0;
+	int sub_table_offset      = 0;
+	int sub_table_prefix      = 0;
+	int symbol                = 0;
 
 	if( table == NULL )
 	{
@@ -199,6 +254,20 @@ int libewf_deflate_huffman_table_construct(
 
 		return( -1 );
 	}
+	if( memory_set(
+	     &( table->lookup_table ),
+	     0,
+	     ( 1 << LIBEWF_DEFLATE_HUFFMAN_LOOKUP_TABLE_BITS ) * sizeof( uint16_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear lookup table.",
+		 function );
+
+		return( -1 );
+	}
 	for( symbol = 0;
 	     symbol < number_of_code_sizes;
 	     symbol++ )
@@ -290,6 +359,115 @@ int libewf_deflate_huffman_table_construct(
 		code_offsets_array[ code_size ]  += 1;
 		table->codes_array[ code_offset ] = symbol;
 	}
+	/* Fill the lookup table with the canonical Huffman codes, where the bits of
+	 * the codes are reversed since the bit stream stores them in reverse order.
+	 * Codes that do not fit in the first level table are stored in a second level
+	 * table per first level prefix. The codes that share a prefix are consecutive
+	 * in canonical order hence the size of the second level table can be determined
+	 * from the number of codes per code size that remain.
+	 */
+	for( bit_index = 0;
+	     bit_index < 16;
+	     bit_index++ )
+	{
+		remaining_code_counts_array[ bit_index ] = table->code_counts_array[ bit_index ];
+	}
+	next_sub_table_offset = 1 << LIBEWF_DEFLATE_HUFFMAN_LOOKUP_TABLE_BITS;
+	sub_table_prefix      = -1;
+
+	for( code_size = 1;
+	     code_size <= (uint16_t) table->maximum_number_of_bits;
+	     code_size++ )
+	{
+		for( code_size_count = 0;
+		     code_size_count < table->code_counts_array[ code_size ];
+		     code_size_count++ )
+		{
+			symbol        = table->codes_array[ code_index++ ];
+			lookup_value  = (uint16_t) ( ( symbol << 4 ) | code_size );
+			reversed_code = 0;
+
+			for( bit_index = 0;
+			     bit_index < code_size;
+			     bit_index++ )
+			{
+				reversed_code <<= 1;
+				reversed_code  |= ( huffman_code >> bit_index ) & 0x00000001UL;
+			}
+			if( code_size <= LIBEWF_DEFLATE_HUFFMAN_LOOKUP_TABLE_BITS )
+			{
+				for( lookup_index = (int) reversed_code;
+				     lookup_index < ( 1 << LIBEWF_DEFLATE_HUFFMAN_LOOKUP_TABLE_BITS );
+				     lookup_index += 1 << code_size )
+				{
+					table->lookup_table[ lookup_index ] = lookup_value;
+				}
+			}
+			else
+			{
+				if( (int) ( reversed_code & ( ( 1 << LIBEWF_DEFLATE_HUFFMAN_LOOKUP_TABLE_BITS ) - 1 ) ) != sub_table_prefix )
+				{
+					sub_table_prefix     = (int) ( reversed_code & ( ( 1 << LIBEWF_DEFLATE_HUFFMAN_LOOKUP_TABLE_BITS ) - 1 ) );
+					sub_table_bits       = (uint8_t) ( code_size - LIBEWF_DEFLATE_HUFFMAN_LOOKUP_TABLE_BITS );
+					number_of_free_codes = 1 << sub_table_bits;
+
+					while( ( LIBEWF_DEFLATE_HUFFMAN_LOOKUP_TABLE_BITS + sub_table_bits ) < table->maximum_number_of_bits )
+					{
+						number_of_free_codes -= remaining_code_counts_array[ LIBEWF_DEFLATE_HUFFMAN_LOOKUP_TABLE_BITS + sub_table_bits ];
+
+						if( number_of_free_codes <= 0 )
+						{
+							break;
+						}
+						sub_table_bits++;
+
+						number_of_free_codes <<= 1;
+					}
+					/* If the second level table does not fit the codes of the prefix
+					 * are decoded from the code counts array
+					 */
+					sub_table_offset = 0;
+
+					if( ( next_sub_table_offset + ( 1 << sub_table_bits ) ) <= LIBEWF_DEFLATE_HUFFMAN_LOOKUP_TABLE_SIZE )
+					{
+						sub_table_offset       = next_sub_table_offset;
+						next_sub_table_offset += 1 << sub_table_bits;
+
+						if( memory_set(
+						     &( table->lookup_table[ sub_table_offset ] ),
+						     0,
+						     ( 1 << sub_table_bits ) * sizeof( uint16_t ) ) == NULL )
+						{
+							libcerror_error_set(
+							 error,
+							 LIBCERROR_ERROR_DOMAIN_MEMORY,
+							 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+							 "%s: unable to clear lookup sub table.",
+							 function );
+
+							return( -1 );
+						}
+						table->lookup_table[ sub_table_prefix ] = (uint16_t) ( LIBEWF_DEFLATE_HUFFMAN_LOOKUP_FLAG_SUB_TABLE
+						                                        | ( sub_table_offset << 3 )
+						                                        | sub_table_bits );
+					}
+				}
+				if( sub_table_offset != 0 )
+				{
+					for( lookup_index = (int) ( reversed_code >> LIBEWF_DEFLATE_HUFFMAN_LOOKUP_TABLE_BITS );
+					     lookup_index < ( 1 << sub_table_bits );
+					     lookup_index += 1 << ( code_size - LIBEWF_DEFLATE_HUFFMAN_LOOKUP_TABLE_BITS ) )
+					{
+						table->lookup_table[ sub_table_offset + lookup_index ] = lookup_value;
+					}
+				}
+			}
+			remaining_code_counts_array[ code_size ] -= 1;
+
+			huffman_code++;
+		}
+		huffman_code <<= 1;
+	}
 /* TODO only used by dynamic Huffman
 	if( left_value > 0 )
 	{
@@ -306,6 +484,26 @@ int libewf_deflate_huffman_table_construct(
 	return( 1 );
 }
 
+/* Retrieves the lookup table value of the Huffman code at the start of the bit buffer
+ * Returns the lookup table value, which is 0 if the code is not in the lookup table
+ */
+uint16_t libewf_deflate_huffman_table_get_lookup_value(
+          const libewf_deflate_huffman_table_t *table,
+          uint64_t bit_buffer )
+{
+	uint16_t lookup_value = 0;
+
+	lookup_value = table->lookup_table[ bit_buffer & ( ( 1 << LIBEWF_DEFLATE_HUFFMAN_LOOKUP_TABLE_BITS ) - 1 ) ];
+
+	if( ( lookup_value & LIBEWF_DEFLATE_HUFFMAN_LOOKUP_FLAG_SUB_TABLE ) != 0 )
+	{
+		bit_buffer >>= LIBEWF_DEFLATE_HUFFMAN_LOOKUP_TABLE_BITS;
+
+		lookup_value = table->lookup_table[ ( ( lookup_value >> 3 ) & 0x0fff ) + ( bit_buffer & ( ( 1 << ( lookup_value & 0x0007 ) ) - 1 ) ) ];
+	}
+	return( lookup_value );
+}
+
 /* Retrieves a Huffman encoded value from the bit stream
  * Returns 1 on success or -1 on error
  */
@@ -316,7 +514,8 @@ int libewf_deflate_bit_stream_get_huffman_encoded_value(
      libcerror_error_t **error )
 {
 	static char *function  = "libewf_deflate_bit_stream_get_huffman_encoded_value";
-	uint32_t bit_buffer    = 0;
+	uint64_t bit_buffer    = 0;
+	uint16_t lookup_value  = 0;
 	uint8_t bit_index      = 0;
 	uint8_t number_of_bits = 0;
 	int code_size_count    = 0;
@@ -360,18 +559,29 @@ int libewf_deflate_bit_stream_get_huffman_encoded_value(
 	}
 	/* Try to fill the bit buffer with the maximum number of bits
 	 */
-	while( bit_stream->bit_buffer_size < table->maximum_number_of_bits )
+	if( bit_stream->bit_buffer_size < table->maximum_number_of_bits )
 	{
-		if( bit_stream->byte_stream_offset >= bit_stream->byte_stream_size )
-		{
-			break;
-		}
-		*value_32bit   = bit_stream->byte_stream[ bit_stream->byte_stream_offset++ ];
-		*value_32bit <<= bit_stream->bit_buffer_size;
+		libewf_deflate_bit_stream_fill_bit_buffer(
+		 bit_stream );
+	}
+	lookup_value = libewf_deflate_huffman_table_get_lookup_value(
+	                table,
+	                bit_stream->bit_buffer );
+
+	number_of_bits = (uint8_t) ( lookup_value & 0x000f );
 
-		bit_stream->bit_buffer      |= *value_32bit;
-		bit_stream->bit_buffer_size += 8;
+	if( ( number_of_bits > 0 )
+	 && ( number_of_bits <= bit_stream->bit_buffer_size ) )
+	{
+		*value_32bit = (uint32_t) ( lookup_value >> 4 );
+
+		bit_stream->bit_buffer     >>= number_of_bits;
+		bit_stream->bit_buffer_size -= number_of_bits;
+
+		return( 1 );
 	}
+	/* Codes that are not in the lookup table are decoded one bit at a time
+	 */
 	if( table->maximum_number_of_bits < bit_stream->bit_buffer_size )
 	{
 		number_of_bits = table->maximum_number_of_bits;
@@ -809,7 +1019,9 @@ int libewf_deflate_decode_huffman(
 	uint32_t extra_bits           = 0;
 	uint16_t compression_offset   = 0;
 	uint16_t compression_size     = 0;
+	uint16_t lookup_value         = 0;
 	uint16_t number_of_extra_bits = 0;
+	uint8_t number_of_bits        = 0;
 
 	if( uncompressed_data == NULL )
 	{
@@ -846,13 +1058,38 @@ int libewf_deflate_decode_huffman(
 	}
 	data_offset = *uncompressed_data_offset;
 
+	/* The bit buffer is filled once per literal or length and distance pair.
+	 * If at least 8 bytes of the byte stream remain, the bit buffer contains
+	 * at least 56 bits, which is sufficient for a literal or length code of
+	 * 15 bits with 5 extra bits and a distance code of 15 bits with 13 extra
+	 * bits. The values are then decoded from the bit buffer directly and the
+	 * slower functions that validate the number of bits in the bit buffer are
+	 * only used near the end of the byte stream.
+	 */
 	do
 	{
-		if( libewf_deflate_bit_stream_get_huffman_encoded_value(
-		     bit_stream,
-		     literals_table,
-		     &code_value,
-		     error ) != 1 )
+		libewf_deflate_bit_stream_fill_bit_buffer(
+		 bit_stream );
+
+		lookup_value = libewf_deflate_huffman_table_get_lookup_value(
+		                literals_table,
+		                bit_stream->bit_buffer );
+
+		number_of_bits = (uint8_t) ( lookup_value & 0x000f );
+
+		if( ( number_of_bits > 0 )
+		 && ( number_of_bits <= bit_stream->bit_buffer_size ) )
+		{
+			code_value = (uint32_t) ( lookup_value >> 4 );
+
+			bit_stream->bit_buffer     >>= number_of_bits;
+			bit_stream->bit_buffer_size -= number_of_bits;
+		}
+		else if( libewf_deflate_bit_stream_get_huffman_encoded_value(
+		          bit_stream,
+		          literals_table,
+		          &code_value,
+		          error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
@@ -885,11 +1122,18 @@ int libewf_deflate_decode_huffman(
 
 			number_of_extra_bits = literal_codes_number_of_extra_bits[ code_value ];
 
-			if( libewf_deflate_bit_stream_get_value(
-			     bit_stream,
-			     (uint8_t) number_of_extra_bits,
-			     &extra_bits,
-			     error ) != 1 )
+			if( number_of_extra_bits <= bit_stream->bit_buffer_size )
+			{
+				extra_bits = (uint32_t) ( bit_stream->bit_buffer & ~( 0xffffffffffffffffULL << number_of_extra_bits ) );
+
+				bit_stream->bit_buffer     >>= number_of_extra_bits;
+				bit_stream->bit_buffer_size -= (uint8_t) number_of_extra_bits;
+			}
+			else if( libewf_deflate_bit_stream_get_value(
+			          bit_stream,
+			          (uint8_t) number_of_extra_bits,
+			          &extra_bits,
+			          error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
@@ -902,11 +1146,25 @@ int libewf_deflate_decode_huffman(
 			}
 			compression_size = literal_codes_base[ code_value ] + (uint16_t) extra_bits;
 
-			if( libewf_deflate_bit_stream_get_huffman_encoded_value(
-			     bit_stream,
-			     distances_table,
-			     &code_value,
-			     error ) != 1 )
+			lookup_value = libewf_deflate_huffman_table_get_lookup_value(
+			                distances_table,
+			                bit_stream->bit_buffer );
+
+			number_of_bits = (uint8_t) ( lookup_value & 0x000f );
+
+			if( ( number_of_bits > 0 )
+			 && ( number_of_bits <= bit_stream->bit_buffer_size ) )
+			{
+				code_value = (uint32_t) ( lookup_value >> 4 );
+
+				bit_stream->bit_buffer     >>= number_of_bits;
+				bit_stream->bit_buffer_size -= number_of_bits;
+			}
+			else if( libewf_deflate_bit_stream_get_huffman_encoded_value(
+			          bit_stream,
+			          distances_table,
+			          &code_value,
+			          error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
@@ -919,11 +1177,18 @@ int libewf_deflate_decode_huffman(
 			}
 			number_of_extra_bits = distance_codes_number_of_extra_bits[ code_value ];
 
-			if( libewf_deflate_bit_stream_get_value(
-			     bit_stream,
-			     (uint8_t) number_of_extra_bits,
-			     &extra_bits,
-			     error ) != 1 )
+			if( number_of_extra_bits <= bit_stream->bit_buffer_size )
+			{
+				extra_bits = (uint32_t) ( bit_stream->bit_buffer & ~( 0xffffffffffffffffULL << number_of_extra_bits ) );
+
+				bit_stream->bit_buffer     >>= number_of_extra_bits;
+				bit_stream->bit_buffer_size -= (uint8_t) number_of_extra_bits;
+			}
+			else if( libewf_deflate_bit_stream_get_value(
+			          bit_stream,
+			          (uint8_t) number_of_extra_bits,
+			          &extra_bits,
+			          error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
@@ -1355,10 +1620,8 @@ int libewf_deflate_decompress(
 		 preset_dictionary_identifier );
 
 		compressed_data_offset += 4;
-		compressed_data_size   -= 4;
 	}
 	compressed_data_offset += 2;
-	compressed_data_size   -= 2;
 
 	if( compression_method != 8 )
 	{
@@ -1419,8 +1682,8 @@ int libewf_deflate_decompress(
 		return( -1 );
 	}
 
-/* TODO find optimized solution to read bit stream from bytes */
-	while( bit_stream.byte_stream_offset < bit_stream.byte_stream_size )
+	while( ( bit_stream.byte_stream_offset < bit_stream.byte_stream_size )
+	    || ( bit_stream.bit_buffer_size >= 3 ) )
 	{
 		if( libewf_deflate_bit_stream_get_value(
 		     &bit_stream,
@@ -1481,6 +1744,14 @@ int libewf_deflate_decompress(
 
 					return( -1 );
 				}
+				/* The block data starts at the byte following the block size
+				 * hence the bytes remaining in the bit buffer are returned to
+				 * the byte stream
+				 */
+				bit_stream.byte_stream_offset -= bit_stream.bit_buffer_size >> 3;
+				bit_stream.bit_buffer          = 0;
+				bit_stream.bit_buffer_size     = 0;
+
 				block_size_copy = ( block_size >> 16 ) ^ 0x0000ffffUL;
 				block_size     &= 0x0000ffffUL;
 
@@ -1615,13 +1886,19 @@ int libewf_deflate_decompress(
 			break;
 		}
 	}
+	/* The checksum starts at the byte following the last block
+	 * hence the bytes remaining in the bit buffer are returned to
+	 * the byte stream
+	 */
+	bit_stream.byte_stream_offset -= bit_stream.bit_buffer_size >> 3;
+
 	if( ( bit_stream.byte_stream_size - bit_stream.byte_stream_offset ) >= 4 )
 	{
 		byte_stream_copy_to_uint32_big_endian(
 		 &( bit_stream.byte_stream[ bit_stream.byte_stream_offset ] ),
 		 stored_checksum );
 
-		if( libewf_deflate_calculate_adler32(
+		if( libewf_checksum_calculate_adler32(
 		     &calculated_checksum,
 		     uncompressed_data,
 		     uncompressed_data_offset,
@@ -1656,3 +1933,1669 @@ int libewf_deflate_decompress(
 	return( 1 );
 }
 
+/* The literal and length symbols of the match sizes 3 to 258 relative to symbol 257
+ */
+static const uint8_t libewf_deflate_encoder_length_symbols[ 256 ] = {
+	0, 1, 2, 3, 4, 5, 6, 7, 8, 8, 9, 9, 10, 10, 11, 11,
+	12, 12, 12, 12, 13, 13, 13, 13, 14, 14, 14, 14, 15, 15, 15, 15,
+	16, 16, 16, 16, 16, 16, 16, 16, 17, 17, 17, 17, 17, 17, 17, 17,
+	18, 18, 18, 18, 18, 18, 18, 18, 19, 19, 19, 19, 19, 19, 19, 19,
+	20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20,
+	21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21,
+	22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22,
+	23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23,
+	24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24,
+	24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24,
+	25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25,
+	25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25,
+	26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26,
+	26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26,
+	27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27,
+	27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 28 };
+
+/* The distance symbols of the distances 1 to 256 followed by the distance
+ * symbols of the distances 257 to 32768 in steps of 128
+ */
+static const uint8_t libewf_deflate_encoder_distance_symbols[ 512 ] = {
+	0, 1, 2, 3, 4, 4, 5, 5, 6, 6, 6, 6, 7, 7, 7, 7,
+	8, 8, 8, 8, 8, 8, 8, 8, 9, 9, 9, 9, 9, 9, 9, 9,
+	10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10,
+	11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11,
+	12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+	12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+	13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13,
+	13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13,
+	14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14,
+	14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14,
+	14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14,
+	14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14,
+	15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+	15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+	15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+	15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+	0, 14, 16, 17, 18, 18, 19, 19, 20, 20, 20, 20, 21, 21, 21, 21,
+	22, 22, 22, 22, 22, 22, 22, 22, 23, 23, 23, 23, 23, 23, 23, 23,
+	24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24,
+	25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25,
+	26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26,
+	26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26,
+	27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27,
+	27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27,
+	28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28,
+	28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28,
+	28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28,
+	28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28,
+	29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29,
+	29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29,
+	29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29,
+	29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29 };
+
+static const uint16_t libewf_deflate_encoder_length_bases[ 29 ] = {
+	3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+	35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+
+static const uint8_t libewf_deflate_encoder_length_number_of_extra_bits[ 29 ] = {
+	0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+	3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+
+static const uint16_t libewf_deflate_encoder_distance_bases[ 30 ] = {
+	1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+	257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193,
+	12289, 16385, 24577 };
+
+static const uint8_t libewf_deflate_encoder_distance_number_of_extra_bits[ 30 ] = {
+	0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+	7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+/* The order in which the code sizes of the code sizes Huffman code are stored
+ */
+static const uint8_t libewf_deflate_encoder_code_sizes_order[ 19 ] = {
+	16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+/* Retrieves the distance symbol of a distance
+ */
+#define libewf_deflate_encoder_get_distance_symbol( distance ) \
+	( ( ( distance ) <= 256 ) ? libewf_deflate_encoder_distance_symbols[ ( distance ) - 1 ] : libewf_deflate_encoder_distance_symbols[ 256 + ( ( ( distance ) - 1 ) >> 7 ) ] )
+
+/* Creates a deflate encoder
+ * Make sure the value encoder is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_deflate_encoder_initialize(
+     libewf_deflate_encoder_t **encoder,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_deflate_encoder_initialize";
+	int symbol            = 0;
+
+	if( encoder == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid encoder.",
+		 function );
+
+		return( -1 );
+	}
+	if( *encoder != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid encoder value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*encoder = memory_allocate_structure(
+	            libewf_deflate_encoder_t );
+
+	if( *encoder == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create encoder.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *encoder,
+	     0,
+	     sizeof( libewf_deflate_encoder_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear encoder.",
+		 function );
+
+		goto on_error;
+	}
+	for( symbol = 0;
+	     symbol < 288;
+	     symbol++ )
+	{
+		if( symbol < 144 )
+		{
+			( *encoder )->fixed_literal_code_sizes[ symbol ] = 8;
+		}
+		else if( symbol < 256 )
+		{
+			( *encoder )->fixed_literal_code_sizes[ symbol ] = 9;
+		}
+		else if( symbol < 280 )
+		{
+			( *encoder )->fixed_literal_code_sizes[ symbol ] = 7;
+		}
+		else
+		{
+			( *encoder )->fixed_literal_code_sizes[ symbol ] = 8;
+		}
+	}
+	for( symbol = 0;
+	     symbol < 32;
+	     symbol++ )
+	{
+		( *encoder )->fixed_distance_code_sizes[ symbol ] = 5;
+	}
+	if( libewf_deflate_encoder_build_codes(
+	     ( *encoder )->fixed_literal_code_sizes,
+	     288,
+	     ( *encoder )->fixed_literal_codes,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to build fixed literal codes.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_deflate_encoder_build_codes(
+	     ( *encoder )->fixed_distance_code_sizes,
+	     32,
+	     ( *encoder )->fixed_distance_codes,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to build fixed distance codes.",
+		 function );
+
+		goto on_error;
+	}
+	/* A position of 0 in the hash table is never valid
+	 */
+	( *encoder )->position_base = 1;
+
+	return( 1 );
+
+on_error:
+	if( *encoder != NULL )
+	{
+		memory_free(
+		 *encoder );
+
+		*encoder = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a deflate encoder
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_deflate_encoder_free(
+     libewf_deflate_encoder_t **encoder,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_deflate_encoder_free";
+
+	if( encoder == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid encoder.",
+		 function );
+
+		return( -1 );
+	}
+	if( *encoder != NULL )
+	{
+		memory_free(
+		 *encoder );
+
+		*encoder = NULL;
+	}
+	return( 1 );
+}
+
+/* Flushes the bits in the bit buffer to the byte stream of the encoder
+ * The unused bits of the last byte are set to 0
+ * If the byte stream is too small the byte stream overflow value is set
+ */
+void libewf_deflate_encoder_flush_bits(
+      libewf_deflate_encoder_t *encoder )
+{
+	while( encoder->bit_buffer_size > 0 )
+	{
+		if( encoder->byte_stream_offset < encoder->byte_stream_size )
+		{
+			encoder->byte_stream[ encoder->byte_stream_offset++ ] = (uint8_t) ( encoder->bit_buffer & 0xff );
+		}
+		else
+		{
+			encoder->byte_stream_overflow = 1;
+		}
+		encoder->bit_buffer >>= 8;
+
+		if( encoder->bit_buffer_size < 8 )
+		{
+			encoder->bit_buffer_size = 0;
+		}
+		else
+		{
+			encoder->bit_buffer_size -= 8;
+		}
+	}
+}
+
+/* Builds the code sizes of a length-limited Huffman code from the symbol frequencies
+ * The resulting code is complete and contains at least 2 codes
+ * Returns 1 on success or -1 on error
+ */
+int libewf_deflate_encoder_build_code_sizes(
+     const uint32_t *frequencies,
+     int number_of_symbols,
+     uint8_t maximum_code_size,
+     uint8_t *code_sizes,
+     libcerror_error_t **error )
+{
+	uint32_t weights[ 2 * 288 ];
+	uint16_t depths[ 2 * 288 ];
+	uint16_t parents[ 2 * 288 ];
+	uint16_t symbols[ 288 ];
+	int code_size_counts[ 33 ];
+
+	static char *function   = "libewf_deflate_encoder_build_code_sizes";
+	uint32_t frequency      = 0;
+	uint32_t kraft_sum      = 0;
+	uint16_t symbol         = 0;
+	int code_size           = 0;
+	int code_size_index     = 0;
+	int leaf_index          = 0;
+	int node                = 0;
+	int node_index          = 0;
+	int number_of_leaves    = 0;
+	int number_of_nodes     = 0;
+	int parent_node         = 0;
+	int symbol_index        = 0;
+
+	if( frequencies == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid frequencies.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_symbols < 2 )
+	 || ( number_of_symbols > 288 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of symbols value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( maximum_code_size < 1 )
+	 || ( maximum_code_size > 15 )
+	 || ( number_of_symbols > ( 1 << maximum_code_size ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum code size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( code_sizes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid code sizes.",
+		 function );
+
+		return( -1 );
+	}
+	for( symbol_index = 0;
+	     symbol_index < number_of_symbols;
+	     symbol_index++ )
+	{
+		code_sizes[ symbol_index ] = 0;
+
+		if( frequencies[ symbol_index ] > 0 )
+		{
+			symbols[ number_of_leaves++ ] = (uint16_t) symbol_index;
+		}
+	}
+	/* A code of fewer than 2 symbols is incomplete, hence unused symbols
+	 * are added to create a complete code
+	 */
+	for( symbol_index = 0;
+	     ( number_of_leaves < 2 ) && ( symbol_index < number_of_symbols );
+	     symbol_index++ )
+	{
+		if( ( frequencies[ symbol_index ] == 0 )
+		 && ( ( number_of_leaves == 0 )
+		  || ( symbols[ 0 ] != (uint16_t) symbol_index ) ) )
+		{
+			symbols[ number_of_leaves++ ] = (uint16_t) symbol_index;
+		}
+	}
+	/* Sort the symbols by ascending frequency
+	 */
+	for( leaf_index = 1;
+	     leaf_index < number_of_leaves;
+	     leaf_index++ )
+	{
+		symbol    = symbols[ leaf_index ];
+		frequency = frequencies[ symbol ];
+
+		for( symbol_index = leaf_index;
+		     symbol_index > 0;
+		     symbol_index-- )
+		{
+			if( frequencies[ symbols[ symbol_index - 1 ] ] <= frequency )
+			{
+				break;
+			}
+			symbols[ symbol_index ] = symbols[ symbol_index - 1 ];
+		}
+		symbols[ symbol_index ] = symbol;
+	}
+	for( leaf_index = 0;
+	     leaf_index < number_of_leaves;
+	     leaf_index++ )
+	{
+		weights[ leaf_index ] = frequencies[ symbols[ leaf_index ] ];
+	}
+	/* Build the Huffman tree using the sorted leaves and a queue of nodes,
+	 * where the nodes are created in order of ascending weight
+	 */
+	number_of_nodes = ( 2 * number_of_leaves ) - 1;
+	leaf_index      = 0;
+	node_index      = number_of_leaves;
+
+	for( parent_node = number_of_leaves;
+	     parent_node < number_of_nodes;
+	     parent_node++ )
+	{
+		weights[ parent_node ] = 0;
+
+		for( symbol_index = 0;
+		     symbol_index < 2;
+		     symbol_index++ )
+		{
+			if( ( leaf_index < number_of_leaves )
+			 && ( ( node_index >= parent_node )
+			  || ( weights[ leaf_index ] <= weights[ node_index ] ) ) )
+			{
+				node = leaf_index++;
+			}
+			else
+			{
+				node = node_index++;
+			}
+			parents[ node ]         = (uint16_t) parent_node;
+			weights[ parent_node ] += weights[ node ];
+		}
+	}
+	depths[ number_of_nodes - 1 ] = 0;
+
+	for( node = number_of_nodes - 2;
+	     node >= 0;
+	     node-- )
+	{
+		depths[ node ] = depths[ parents[ node ] ] + 1;
+	}
+	for( code_size = 0;
+	     code_size <= 32;
+	     code_size++ )
+	{
+		code_size_counts[ code_size ] = 0;
+	}
+	for( leaf_index = 0;
+	     leaf_index < number_of_leaves;
+	     leaf_index++ )
+	{
+		code_size = (int) depths[ leaf_index ];
+
+		if( code_size > 32 )
+		{
+			code_size = 32;
+		}
+		code_size_counts[ code_size ] += 1;
+	}
+	/* Limit the code sizes to the maximum code size by moving the codes
+	 * that are too long to the maximum code size and then lengthening
+	 * shorter codes until the code is complete again
+	 */
+	for( code_size = (int) maximum_code_size + 1;
+	     code_size <= 32;
+	     code_size++ )
+	{
+		code_size_counts[ maximum_code_size ] += code_size_counts[ code_size ];
+		code_size_counts[ code_size ]          = 0;
+	}
+	for( code_size = 1;
+	     code_size <= (int) maximum_code_size;
+	     code_size++ )
+	{
+		kraft_sum += (uint32_t) code_size_counts[ code_size ] << ( maximum_code_size - code_size );
+	}
+	while( kraft_sum > ( (uint32_t) 1 << maximum_code_size ) )
+	{
+		code_size_counts[ maximum_code_size ] -= 1;
+
+		for( code_size = (int) maximum_code_size - 1;
+		     code_size > 0;
+		     code_size-- )
+		{
+			if( code_size_counts[ code_size ] > 0 )
+			{
+				code_size_counts[ code_size ]     -= 1;
+				code_size_counts[ code_size + 1 ] += 2;
+
+				break;
+			}
+		}
+		kraft_sum -= 1;
+	}
+	/* The least frequent symbols are assigned the largest code sizes
+	 */
+	leaf_index = 0;
+
+	for( code_size = (int) maximum_code_size;
+	     code_size > 0;
+	     code_size-- )
+	{
+		for( code_size_index = 0;
+		     code_size_index < code_size_counts[ code_size ];
+		     code_size_index++ )
+		{
+			code_sizes[ symbols[ leaf_index++ ] ] = (uint8_t) code_size;
+		}
+	}
+	return( 1 );
+}
+
+/* Builds the canonical Huffman codes from the code sizes
+ * The codes are bit reversed so they can be written to the bit stream directly
+ * Returns 1 on success or -1 on error
+ */
+int libewf_deflate_encoder_build_codes(
+     const uint8_t *code_sizes,
+     int number_of_symbols,
+     uint16_t *codes,
+     libcerror_error_t **error )
+{
+	int code_size_counts[ 16 ];
+	uint32_t next_codes[ 16 ];
+
+	static char *function = "libewf_deflate_encoder_build_codes";
+	uint32_t code         = 0;
+	uint32_t reversed     = 0;
+	uint8_t bit_index     = 0;
+	uint8_t code_size     = 0;
+	int symbol            = 0;
+
+	if( code_sizes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid code sizes.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_symbols < 0 )
+	 || ( number_of_symbols > 288 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of symbols value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( codes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid codes.",
+		 function );
+
+		return( -1 );
+	}
+	for( code_size = 0;
+	     code_size < 16;
+	     code_size++ )
+	{
+		code_size_counts[ code_size ] = 0;
+	}
+	for( symbol = 0;
+	     symbol < number_of_symbols;
+	     symbol++ )
+	{
+		if( code_sizes[ symbol ] > 15 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid code size: %d value out of bounds.",
+			 function,
+			 symbol );
+
+			return( -1 );
+		}
+		code_size_counts[ code_sizes[ symbol ] ] += 1;
+	}
+	code_size_counts[ 0 ] = 0;
+	next_codes[ 0 ]       = 0;
+
+	for( code_size = 1;
+	     code_size < 16;
+	     code_size++ )
+	{
+		code                    = ( code + (uint32_t) code_size_counts[ code_size - 1 ] ) << 1;
+		next_codes[ code_size ] = code;
+	}
+	for( symbol = 0;
+	     symbol < number_of_symbols;
+	     symbol++ )
+	{
+		code_size = code_sizes[ symbol ];
+
+		if( code_size == 0 )
+		{
+			codes[ symbol ] = 0;
+
+			continue;
+		}
+		code     = next_codes[ code_size ]++;
+		reversed = 0;
+
+		for( bit_index = 0;
+		     bit_index < code_size;
+		     bit_index++ )
+		{
+			reversed = ( reversed << 1 ) | ( code & 0x00000001UL );
+			code   >>= 1;
+		}
+		codes[ symbol ] = (uint16_t) reversed;
+	}
+	return( 1 );
+}
+
+/* Writes the sequences of the current block to the byte stream of the encoder
+ * The block is stored uncompressed or with fixed or dynamic Huffman codes,
+ * whichever is the smallest
+ * Returns 1 on success or -1 on error
+ */
+int libewf_deflate_encoder_write_block(
+     libewf_deflate_encoder_t *encoder,
+     const uint8_t *block_data,
+     size_t block_data_size,
+     uint8_t last_block_flag,
+     libcerror_error_t **error )
+{
+	uint32_t code_sizes_frequencies[ 19 ];
+	uint32_t distance_frequencies[ 32 ];
+	uint32_t literal_frequencies[ 288 ];
+	uint16_t code_sizes_codes[ 19 ];
+	uint16_t code_sizes_sequences[ 288 + 32 ];
+	uint16_t distance_codes[ 32 ];
+	uint16_t literal_codes[ 288 ];
+	uint8_t code_sizes[ 288 + 32 ];
+	uint8_t code_sizes_code_sizes[ 19 ];
+	uint8_t distance_code_sizes[ 32 ];
+	uint8_t literal_code_sizes[ 288 ];
+
+	const uint16_t *block_distance_codes     = NULL;
+	const uint16_t *block_literal_codes      = NULL;
+	const uint8_t *block_distance_code_sizes = NULL;
+	const uint8_t *block_literal_code_sizes  = NULL;
+	static char *function                    = "libewf_deflate_encoder_write_block";
+	size_t stored_block_offset               = 0;
+	uint64_t dynamic_block_size              = 0;
+	uint64_t extra_bits_size                 = 0;
+	uint64_t fixed_block_size                = 0;
+	uint64_t stored_block_size               = 0;
+	uint32_t distance                        = 0;
+	uint32_t match_size                      = 0;
+	uint32_t sequence                        = 0;
+	uint16_t stored_size                     = 0;
+	uint8_t code_size                        = 0;
+	uint8_t distance_symbol                  = 0;
+	uint8_t length_symbol                    = 0;
+	uint8_t number_of_extra_bits             = 0;
+	int code_sizes_index                     = 0;
+	int number_of_code_sizes                 = 0;
+	int number_of_code_sizes_codes           = 0;
+	int number_of_code_sizes_sequences       = 0;
+	int number_of_distance_codes             = 0;
+	int number_of_literal_codes              = 0;
+	int run_size                             = 0;
+	int sequence_index                       = 0;
+	int symbol                               = 0;
+
+	if( encoder == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid encoder.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block data.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid block data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     literal_frequencies,
+	     0,
+	     sizeof( uint32_t ) * 288 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear literal frequencies.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     distance_frequencies,
+	     0,
+	     sizeof( uint32_t ) * 32 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear distance frequencies.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     code_sizes_frequencies,
+	     0,
+	     sizeof( uint32_t ) * 19 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear code sizes frequencies.",
+		 function );
+
+		return( -1 );
+	}
+	/* The end-of-block symbol
+	 */
+	literal_frequencies[ 256 ] = 1;
+
+	for( sequence_index = 0;
+	     sequence_index < encoder->number_of_sequences;
+	     sequence_index++ )
+	{
+		sequence = encoder->sequences[ sequence_index ];
+
+		if( sequence < 0x00010000UL )
+		{
+			literal_frequencies[ sequence ] += 1;
+		}
+		else
+		{
+			match_size      = sequence & 0x0000ffffUL;
+			distance        = sequence >> 16;
+			length_symbol   = libewf_deflate_encoder_length_symbols[ match_size - LIBEWF_DEFLATE_MINIMUM_MATCH_SIZE ];
+			distance_symbol = libewf_deflate_encoder_get_distance_symbol( distance );
+
+			literal_frequencies[ 257 + length_symbol ] += 1;
+			distance_frequencies[ distance_symbol ]    += 1;
+
+			extra_bits_size += libewf_deflate_encoder_length_number_of_extra_bits[ length_symbol ]
+			                 + libewf_deflate_encoder_distance_number_of_extra_bits[ distance_symbol ];
+		}
+	}
+	if( libewf_deflate_encoder_build_code_sizes(
+	     literal_frequencies,
+	     286,
+	     15,
+	     literal_code_sizes,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to build literal code sizes.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_deflate_encoder_build_code_sizes(
+	     distance_frequencies,
+	     30,
+	     15,
+	     distance_code_sizes,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to build distance code sizes.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_literal_codes = 286;
+
+	while( ( number_of_literal_codes > 257 )
+	    && ( literal_code_sizes[ number_of_literal_codes - 1 ] == 0 ) )
+	{
+		number_of_literal_codes--;
+	}
+	number_of_distance_codes = 30;
+
+	while( ( number_of_distance_codes > 1 )
+	    && ( distance_code_sizes[ number_of_distance_codes - 1 ] == 0 ) )
+	{
+		number_of_distance_codes--;
+	}
+	/* Run-length encode the literal and distance code sizes
+	 * A code sizes sequence contains the symbol in bits 0 - 4 and the repeat value in bits 5 - 11
+	 */
+	if( memory_copy(
+	     code_sizes,
+	     literal_code_sizes,
+	     (size_t) number_of_literal_codes ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy literal code sizes.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     &( code_sizes[ number_of_literal_codes ] ),
+	     distance_code_sizes,
+	     (size_t) number_of_distance_codes ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy distance code sizes.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_code_sizes = number_of_literal_codes + number_of_distance_codes;
+	code_sizes_index     = 0;
+
+	while( code_sizes_index < number_of_code_sizes )
+	{
+		code_size = code_sizes[ code_sizes_index ];
+		run_size  = 1;
+
+		while( ( ( code_sizes_index + run_size ) < number_of_code_sizes )
+		    && ( code_sizes[ code_sizes_index + run_size ] == code_size ) )
+		{
+			run_size++;
+		}
+		code_sizes_index += run_size;
+
+		if( code_size == 0 )
+		{
+			while( run_size >= 11 )
+			{
+				symbol = ( run_size > 138 ) ? 138 : run_size;
+
+				code_sizes_sequences[ number_of_code_sizes_sequences++ ] = (uint16_t) ( 18 | ( ( symbol - 11 ) << 5 ) );
+				code_sizes_frequencies[ 18 ]                            += 1;
+
+				run_size -= symbol;
+			}
+			if( run_size >= 3 )
+			{
+				code_sizes_sequences[ number_of_code_sizes_sequences++ ] = (uint16_t) ( 17 | ( ( run_size - 3 ) << 5 ) );
+				code_sizes_frequencies[ 17 ]                            += 1;
+
+				run_size = 0;
+			}
+		}
+		else
+		{
+			code_sizes_sequences[ number_of_code_sizes_sequences++ ] = (uint16_t) code_size;
+			code_sizes_frequencies[ code_size ]                     += 1;
+
+			run_size -= 1;
+
+			while( run_size >= 3 )
+			{
+				symbol = ( run_size > 6 ) ? 6 : run_size;
+
+				code_sizes_sequences[ number_of_code_sizes_sequences++ ] = (uint16_t) ( 16 | ( ( symbol - 3 ) << 5 ) );
+				code_sizes_frequencies[ 16 ]                            += 1;
+
+				run_size -= symbol;
+			}
+		}
+		while( run_size > 0 )
+		{
+			code_sizes_sequences[ number_of_code_sizes_sequences++ ] = (uint16_t) code_size;
+			code_sizes_frequencies[ code_size ]                     += 1;
+
+			run_size -= 1;
+		}
+	}
+	if( libewf_deflate_encoder_build_code_sizes(
+	     code_sizes_frequencies,
+	     19,
+	     7,
+	     code_sizes_code_sizes,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to build code sizes code sizes.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_code_sizes_codes = 19;
+
+	while( ( number_of_code_sizes_codes > 4 )
+	    && ( code_sizes_code_sizes[ libewf_deflate_encoder_code_sizes_order[ number_of_code_sizes_codes - 1 ] ] == 0 ) )
+	{
+		number_of_code_sizes_codes--;
+	}
+	/* Determine the size in bits of the block for each block type
+	 */
+	dynamic_block_size = 3 + 5 + 5 + 4 + ( 3 * (uint64_t) number_of_code_sizes_codes ) + extra_bits_size;
+	fixed_block_size   = 3 + extra_bits_size;
+
+	for( symbol = 0;
+	     symbol < 19;
+	     symbol++ )
+	{
+		dynamic_block_size += (uint64_t) code_sizes_frequencies[ symbol ] * code_sizes_code_sizes[ symbol ];
+	}
+	dynamic_block_size += ( 2 * (uint64_t) code_sizes_frequencies[ 16 ] )
+	                    + ( 3 * (uint64_t) code_sizes_frequencies[ 17 ] )
+	                    + ( 7 * (uint64_t) code_sizes_frequencies[ 18 ] );
+
+	for( symbol = 0;
+	     symbol < 286;
+	     symbol++ )
+	{
+		dynamic_block_size += (uint64_t) literal_frequencies[ symbol ] * literal_code_sizes[ symbol ];
+		fixed_block_size   += (uint64_t) literal_frequencies[ symbol ] * encoder->fixed_literal_code_sizes[ symbol ];
+	}
+	for( symbol = 0;
+	     symbol < 30;
+	     symbol++ )
+	{
+		dynamic_block_size += (uint64_t) distance_frequencies[ symbol ] * distance_code_sizes[ symbol ];
+		fixed_block_size   += (uint64_t) distance_frequencies[ symbol ] * encoder->fixed_distance_code_sizes[ symbol ];
+	}
+	/* A stored block contains at most 65535 bytes and has a byte aligned
+	 * 32-bit size and 1's complement of the size
+	 */
+	stored_block_size = ( ( block_data_size / 65535 ) + 1 ) * ( 3 + 7 + 32 ) + ( 8 * (uint64_t) block_data_size );
+
+	if( ( stored_block_size < dynamic_block_size )
+	 && ( stored_block_size < fixed_block_size ) )
+	{
+		do
+		{
+			if( ( block_data_size - stored_block_offset ) > 65535 )
+			{
+				stored_size = 65535;
+			}
+			else
+			{
+				stored_size = (uint16_t) ( block_data_size - stored_block_offset );
+			}
+			if( ( last_block_flag != 0 )
+			 && ( ( stored_block_offset + stored_size ) == block_data_size ) )
+			{
+				libewf_deflate_encoder_write_bits(
+				 encoder,
+				 1,
+				 1 );
+			}
+			else
+			{
+				libewf_deflate_encoder_write_bits(
+				 encoder,
+				 0,
+				 1 );
+			}
+			libewf_deflate_encoder_write_bits(
+			 encoder,
+			 LIBEWF_DEFLATE_BLOCK_TYPE_UNCOMPRESSED,
+			 2 );
+
+			libewf_deflate_encoder_flush_bits(
+			 encoder );
+
+			libewf_deflate_encoder_write_bits(
+			 encoder,
+			 (uint32_t) stored_size | ( (uint32_t) ( stored_size ^ 0xffff ) << 16 ),
+			 32 );
+
+			if( ( encoder->byte_stream_size - encoder->byte_stream_offset ) < (size_t) stored_size )
+			{
+				encoder->byte_stream_overflow = 1;
+
+				return( 1 );
+			}
+			if( memory_copy(
+			     &( encoder->byte_stream[ encoder->byte_stream_offset ] ),
+			     &( block_data[ stored_block_offset ] ),
+			     (size_t) stored_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy stored block data.",
+				 function );
+
+				return( -1 );
+			}
+			encoder->byte_stream_offset += stored_size;
+			stored_block_offset         += stored_size;
+		}
+		while( stored_block_offset < block_data_size );
+
+		return( 1 );
+	}
+	libewf_deflate_encoder_write_bits(
+	 encoder,
+	 ( last_block_flag != 0 ) ? 1 : 0,
+	 1 );
+
+	if( dynamic_block_size < fixed_block_size )
+	{
+		if( libewf_deflate_encoder_build_codes(
+		     literal_code_sizes,
+		     286,
+		     literal_codes,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to build literal codes.",
+			 function );
+
+			return( -1 );
+		}
+		if( libewf_deflate_encoder_build_codes(
+		     distance_code_sizes,
+		     30,
+		     distance_codes,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to build distance codes.",
+			 function );
+
+			return( -1 );
+		}
+		if( libewf_deflate_encoder_build_codes(
+		     code_sizes_code_sizes,
+		     19,
+		     code_sizes_codes,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to build code sizes codes.",
+			 function );
+
+			return( -1 );
+		}
+		libewf_deflate_encoder_write_bits(
+		 encoder,
+		 LIBEWF_DEFLATE_BLOCK_TYPE_HUFFMAN_DYNAMIC,
+		 2 );
+
+		libewf_deflate_encoder_write_bits(
+		 encoder,
+		 (uint32_t) ( number_of_literal_codes - 257 ),
+		 5 );
+
+		libewf_deflate_encoder_write_bits(
+		 encoder,
+		 (uint32_t) ( number_of_distance_codes - 1 ),
+		 5 );
+
+		libewf_deflate_encoder_write_bits(
+		 encoder,
+		 (uint32_t) ( number_of_code_sizes_codes - 4 ),
+		 4 );
+
+		for( code_sizes_index = 0;
+		     code_sizes_index < number_of_code_sizes_codes;
+		     code_sizes_index++ )
+		{
+			libewf_deflate_encoder_write_bits(
+			 encoder,
+			 code_sizes_code_sizes[ libewf_deflate_encoder_code_sizes_order[ code_sizes_index ] ],
+			 3 );
+		}
+		for( sequence_index = 0;
+		     sequence_index < number_of_code_sizes_sequences;
+		     sequence_index++ )
+		{
+			symbol = code_sizes_sequences[ sequence_index ] & 0x001f;
+
+			libewf_deflate_encoder_write_bits(
+			 encoder,
+			 code_sizes_codes[ symbol ],
+			 code_sizes_code_sizes[ symbol ] );
+
+			if( symbol == 16 )
+			{
+				number_of_extra_bits = 2;
+			}
+			else if( symbol == 17 )
+			{
+				number_of_extra_bits = 3;
+			}
+			else if( symbol == 18 )
+			{
+				number_of_extra_bits = 7;
+			}
+			else
+			{
+				number_of_extra_bits = 0;
+			}
+			if( number_of_extra_bits > 0 )
+			{
+				libewf_deflate_encoder_write_bits(
+				 encoder,
+				 (uint32_t) ( code_sizes_sequences[ sequence_index ] >> 5 ),
+				 number_of_extra_bits );
+			}
+		}
+		block_literal_codes       = literal_codes;
+		block_literal_code_sizes  = literal_code_sizes;
+		block_distance_codes      = distance_codes;
+		block_distance_code_sizes = distance_code_sizes;
+	}
+	else
+	{
+		libewf_deflate_encoder_write_bits(
+		 encoder,
+		 LIBEWF_DEFLATE_BLOCK_TYPE_HUFFMAN_FIXED,
+		 2 );
+
+		block_literal_codes       = encoder->fixed_literal_codes;
+		block_literal_code_sizes  = encoder->fixed_literal_code_sizes;
+		block_distance_codes      = encoder->fixed_distance_codes;
+		block_distance_code_sizes = encoder->fixed_distance_code_sizes;
+	}
+	/* The code and the extra bits of a length or distance are written at once
+	 */
+	for( sequence_index = 0;
+	     sequence_index < encoder->number_of_sequences;
+	     sequence_index++ )
+	{
+		sequence = encoder->sequences[ sequence_index ];
+
+		if( sequence < 0x00010000UL )
+		{
+			libewf_deflate_encoder_write_bits(
+			 encoder,
+			 block_literal_codes[ sequence ],
+			 block_literal_code_sizes[ sequence ] );
+		}
+		else
+		{
+			match_size      = sequence & 0x0000ffffUL;
+			distance        = sequence >> 16;
+			length_symbol   = libewf_deflate_encoder_length_symbols[ match_size - LIBEWF_DEFLATE_MINIMUM_MATCH_SIZE ];
+			distance_symbol = libewf_deflate_encoder_get_distance_symbol( distance );
+			code_size       = block_literal_code_sizes[ 257 + length_symbol ];
+
+			libewf_deflate_encoder_write_bits(
+			 encoder,
+			 (uint32_t) block_literal_codes[ 257 + length_symbol ]
+			 | ( ( match_size - libewf_deflate_encoder_length_bases[ length_symbol ] ) << code_size ),
+			 code_size + libewf_deflate_encoder_length_number_of_extra_bits[ length_symbol ] );
+
+			code_size = block_distance_code_sizes[ distance_symbol ];
+
+			libewf_deflate_encoder_write_bits(
+			 encoder,
+			 (uint32_t) block_distance_codes[ distance_symbol ]
+			 | ( ( distance - libewf_deflate_encoder_distance_bases[ distance_symbol ] ) << code_size ),
+			 code_size + libewf_deflate_encoder_distance_number_of_extra_bits[ distance_symbol ] );
+		}
+	}
+	libewf_deflate_encoder_write_bits(
+	 encoder,
+	 block_literal_codes[ 256 ],
+	 block_literal_code_sizes[ 256 ] );
+
+	return( 1 );
+}
+
+/* Compresses data using zlib compression
+ * The encoder finds matches with a hash table of the most recent position of
+ * every hashed 4-byte sequence and encodes them greedily
+ * Returns 1 on success, 0 if the compressed data buffer is too small or -1 on error
+ */
+int libewf_deflate_encoder_compress(
+     libewf_deflate_encoder_t *encoder,
+     const uint8_t *uncompressed_data,
+     size_t uncompressed_data_size,
+     uint8_t *compressed_data,
+     size_t *compressed_data_size,
+     libcerror_error_t **error )
+{
+	static char *function           = "libewf_deflate_encoder_compress";
+	size_t block_offset             = 0;
+	size_t match_offset             = 0;
+	size_t maximum_match_size       = 0;
+	size_t uncompressed_data_offset = 0;
+	uint64_t difference_64bit       = 0;
+	uint64_t match_value_64bit      = 0;
+	uint64_t value_64bit            = 0;
+	uint32_t calculated_checksum    = 0;
+	uint32_t distance               = 0;
+	uint32_t hash_value             = 0;
+	uint32_t match_size             = 0;
+	uint32_t match_value_32bit      = 0;
+	uint32_t position               = 0;
+	uint32_t position_base          = 0;
+	uint32_t value_32bit            = 0;
+	int number_of_literals          = 0;
+	int number_of_unmatched_bytes   = 0;
+
+	if( encoder == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid encoder.",
+		 function );
+
+		return( -1 );
+	}
+	if( uncompressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid uncompressed data.",
+		 function );
+
+		return( -1 );
+	}
+	/* The positions in the hash table are 32-bit
+	 */
+	if( uncompressed_data_size > (size_t) INT32_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid uncompressed data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed data.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( *compressed_data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid compressed data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	/* The hash table is only cleared when the positions would overflow
+	 */
+	if( encoder->position_base > ( (uint32_t) UINT32_MAX - (uint32_t) uncompressed_data_size ) )
+	{
+		if( memory_set(
+		     encoder->hash_table,
+		     0,
+		     sizeof( uint32_t ) * LIBEWF_DEFLATE_ENCODER_HASH_TABLE_SIZE ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear hash table.",
+			 function );
+
+			return( -1 );
+		}
+		encoder->position_base = 1;
+	}
+	position_base = encoder->position_base;
+
+	encoder->byte_stream          = compressed_data;
+	encoder->byte_stream_size     = *compressed_data_size;
+	encoder->byte_stream_offset   = 0;
+	encoder->bit_buffer           = 0;
+	encoder->bit_buffer_size      = 0;
+	encoder->byte_stream_overflow = 0;
+	encoder->number_of_sequences  = 0;
+
+	/* Write the zlib header: deflate with a 32 KiB window and the fastest compression level
+	 */
+	libewf_deflate_encoder_write_bits(
+	 encoder,
+	 0x0178,
+	 16 );
+
+	while( ( uncompressed_data_offset + LIBEWF_DEFLATE_ENCODER_MINIMUM_MATCH_SIZE ) <= uncompressed_data_size )
+	{
+		if( encoder->number_of_sequences >= LIBEWF_DEFLATE_ENCODER_MAXIMUM_NUMBER_OF_SEQUENCES )
+		{
+			if( libewf_deflate_encoder_write_block(
+			     encoder,
+			     &( uncompressed_data[ block_offset ] ),
+			     uncompressed_data_offset - block_offset,
+			     0,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write block.",
+				 function );
+
+				return( -1 );
+			}
+			encoder->number_of_sequences = 0;
+			block_offset                 = uncompressed_data_offset;
+		}
+		byte_stream_copy_to_uint32_little_endian(
+		 &( uncompressed_data[ uncompressed_data_offset ] ),
+		 value_32bit );
+
+		hash_value = (uint32_t) ( value_32bit * 0x9e3779b1UL ) >> ( 32 - LIBEWF_DEFLATE_ENCODER_HASH_BITS );
+		position   = encoder->hash_table[ hash_value ];
+		match_size = 0;
+
+		encoder->hash_table[ hash_value ] = position_base + (uint32_t) uncompressed_data_offset;
+
+		if( position >= position_base )
+		{
+			match_offset = (size_t) ( position - position_base );
+			distance     = (uint32_t) ( uncompressed_data_offset - match_offset );
+
+			if( distance <= LIBEWF_DEFLATE_WINDOW_SIZE )
+			{
+				byte_stream_copy_to_uint32_little_endian(
+				 &( uncompressed_data[ match_offset ] ),
+				 match_value_32bit );
+
+				if( match_value_32bit == value_32bit )
+				{
+					maximum_match_size = uncompressed_data_size - uncompressed_data_offset;
+
+					if( maximum_match_size > LIBEWF_DEFLATE_MAXIMUM_MATCH_SIZE )
+					{
+						maximum_match_size = LIBEWF_DEFLATE_MAXIMUM_MATCH_SIZE;
+					}
+					match_size = LIBEWF_DEFLATE_ENCODER_MINIMUM_MATCH_SIZE;
+
+					/* Compare 8 bytes at a time and determine the first differing byte
+					 * from the number of trailing zero bits of the difference
+					 */
+					while( ( (size_t) match_size + 8 ) <= maximum_match_size )
+					{
+						byte_stream_copy_to_uint64_little_endian(
+						 &( uncompressed_data[ uncompressed_data_offset + match_size ] ),
+						 value_64bit );
+
+						byte_stream_copy_to_uint64_little_endian(
+						 &( uncompressed_data[ match_offset + match_size ] ),
+						 match_value_64bit );
+
+						difference_64bit = value_64bit ^ match_value_64bit;
+
+						if( difference_64bit != 0 )
+						{
+#if defined( __GNUC__ ) || defined( __clang__ )
+							match_size += (uint32_t) ( __builtin_ctzll( difference_64bit ) >> 3 );
+#else
+							while( ( difference_64bit & 0xff ) == 0 )
+							{
+								difference_64bit >>= 8;
+								match_size        += 1;
+							}
+#endif
+							maximum_match_size = match_size;
+
+							break;
+						}
+						match_size += 8;
+					}
+					while( ( (size_t) match_size < maximum_match_size )
+					    && ( uncompressed_data[ uncompressed_data_offset + match_size ] == uncompressed_data[ match_offset + match_size ] ) )
+					{
+						match_size++;
+					}
+				}
+			}
+		}
+		if( match_size >= LIBEWF_DEFLATE_ENCODER_MINIMUM_MATCH_SIZE )
+		{
+			encoder->sequences[ encoder->number_of_sequences++ ] = ( distance << 16 ) | match_size;
+
+			uncompressed_data_offset += match_size;
+
+			/* Add the position near the end of the match to the hash table
+			 * to improve matching of the data that follows
+			 */
+			if( ( uncompressed_data_offset + 2 ) <= uncompressed_data_size )
+			{
+				byte_stream_copy_to_uint32_little_endian(
+				 &( uncompressed_data[ uncompressed_data_offset - 2 ] ),
+				 value_32bit );
+
+				hash_value = (uint32_t) ( value_32bit * 0x9e3779b1UL ) >> ( 32 - LIBEWF_DEFLATE_ENCODER_HASH_BITS );
+
+				encoder->hash_table[ hash_value ] = position_base + (uint32_t) ( uncompressed_data_offset - 2 );
+			}
+			number_of_unmatched_bytes = 0;
+		}
+		else
+		{
+			/* Data without matches is skipped at an increasing rate
+			 */
+			number_of_literals = 1 + ( number_of_unmatched_bytes >> 6 );
+
+			number_of_unmatched_bytes++;
+
+			while( ( number_of_literals > 0 )
+			    && ( uncompressed_data_offset < uncompressed_data_size )
+			    && ( encoder->number_of_sequences < LIBEWF_DEFLATE_ENCODER_MAXIMUM_NUMBER_OF_SEQUENCES ) )
+			{
+				encoder->sequences[ encoder->number_of_sequences++ ] = uncompressed_data[ uncompressed_data_offset++ ];
+
+				number_of_literals--;
+			}
+		}
+	}
+	while( uncompressed_data_offset < uncompressed_data_size )
+	{
+		if( encoder->number_of_sequences >= LIBEWF_DEFLATE_ENCODER_MAXIMUM_NUMBER_OF_SEQUENCES )
+		{
+			if( libewf_deflate_encoder_write_block(
+			     encoder,
+			     &( uncompressed_data[ block_offset ] ),
+			     uncompressed_data_offset - block_offset,
+			     0,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write block.",
+				 function );
+
+				return( -1 );
+			}
+			encoder->number_of_sequences = 0;
+			block_offset                 = uncompressed_data_offset;
+		}
+		encoder->sequences[ encoder->number_of_sequences++ ] = uncompressed_data[ uncompressed_data_offset++ ];
+	}
+	if( libewf_deflate_encoder_write_block(
+	     encoder,
+	     &( uncompressed_data[ block_offset ] ),
+	     uncompressed_data_size - block_offset,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write last block.",
+		 function );
+
+		return( -1 );
+	}
+	libewf_deflate_encoder_flush_bits(
+	 encoder );
+
+	encoder->number_of_sequences = 0;
+	encoder->position_base      += (uint32_t) uncompressed_data_size;
+
+	if( libewf_checksum_calculate_adler32(
+	     &calculated_checksum,
+	     uncompressed_data,
+	     uncompressed_data_size,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to calculate checksum.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( encoder->byte_stream_overflow != 0 )
+	 || ( ( encoder->byte_stream_size - encoder->byte_stream_offset ) < 4 ) )
+	{
+		*compressed_data_size = libewf_deflate_get_compressed_data_size_bound(
+		                         uncompressed_data_size );
+
+		return( 0 );
+	}
+	byte_stream_copy_from_uint32_big_endian(
+	 &( compressed_data[ encoder->byte_stream_offset ] ),
+	 calculated_checksum );
+
+	*compressed_data_size = encoder->byte_stream_offset + 4;
+
+	return( 1 );
+}
+
+/* Determines the maximum size of the data compressed by the encoder
+ * Returns the maximum compressed data size
+ */
+size_t libewf_deflate_get_compressed_data_size_bound(
+        size_t uncompressed_data_size )
+{
+	/* A block is stored if that is smaller, which adds at most 6 bytes per
+	 * block and per 65535 bytes stored. The zlib header, checksum and the
+	 * last partial byte add 7 bytes
+	 */
+	return( uncompressed_data_size
+	      + ( ( ( uncompressed_data_size / LIBEWF_DEFLATE_ENCODER_MAXIMUM_NUMBER_OF_SEQUENCES ) + 1 ) * 6 )
+	      + ( ( ( uncompressed_data_size / 65535 ) + 1 ) * 6 )
+	      + 7 );
+}
+
+/* Compresses data using zlib compression
+ * Returns 1 on success, 0 if the compressed data buffer is too small or -1 on error
+ */
+int libewf_deflate_compress(
+     const uint8_t *uncompressed_data,
+     size_t uncompressed_data_size,
+     uint8_t *compressed_data,
+     size_t *compressed_data_size,
+     libcerror_error_t **error )
+{
+	libewf_deflate_encoder_t *encoder = NULL;
+	static char *function             = "libewf_deflate_compress";
+	int result                        = 0;
+
+	if( libewf_deflate_encoder_initialize(
+	     &encoder,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create encoder.",
+		 function );
+
+		goto on_error;
+	}
+	result = libewf_deflate_encoder_compress(
+	          encoder,
+	          uncompressed_data,
+	          uncompressed_data_size,
+	          compressed_data,
+	          compressed_data_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+		 LIBCERROR_COMPRESSION_ERROR_COMPRESS_FAILED,
+		 "%s: unable to compress data.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_deflate_encoder_free(
+	     &encoder,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free encoder.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( encoder != NULL )
+	{
+		libewf_deflate_encoder_free(
+		 &encoder,
+		 NULL );
+	}
+	return( -1 );
+}
+
@@ -23,6 +23,7 @@
 #define _LIBEWF_DEFLATE_COMPRESSION_H
 
 #include <common.h>
+#include <byte_stream.h>
 #include <types.h>
 
 #include "libewf_libcerror.h"
@@ -31,6 +32,44 @@
 extern "C" {
 #endif
 
+/* The number of bits of the first level of the Huffman lookup table
+ */
+#define LIBEWF_DEFLATE_HUFFMAN_LOOKUP_TABLE_BITS	9
+
+/* The number of values in the Huffman lookup table, which contains
+ * the first level table followed by the second level tables
+ */
+#define LIBEWF_DEFLATE_HUFFMAN_LOOKUP_TABLE_SIZE	2048
+
+/* Flag to indicate the Huffman lookup table value refers to a second level table
+ */
+#define LIBEWF_DEFLATE_HUFFMAN_LOOKUP_FLAG_SUB_TABLE	0x8000
+
+/* The size of the deflate sliding window
+ */
+#define LIBEWF_DEFLATE_WINDOW_SIZE			32768
+
+/* The minimum and maximum size of a match
+ */
+#define LIBEWF_DEFLATE_MINIMUM_MATCH_SIZE		3
+#define LIBEWF_DEFLATE_MAXIMUM_MATCH_SIZE		258
+
+/* The number of bits of the hash of the encoder match finder
+ */
+#define LIBEWF_DEFLATE_ENCODER_HASH_BITS		15
+
+/* The number of entries in the encoder hash table
+ */
+#define LIBEWF_DEFLATE_ENCODER_HASH_TABLE_SIZE		( 1 << LIBEWF_DEFLATE_ENCODER_HASH_BITS )
+
+/* The size of a match the encoder looks for, which is the number of bytes hashed
+ */
+#define LIBEWF_DEFLATE_ENCODER_MINIMUM_MATCH_SIZE	4
+
+/* The maximum number of literals and matches the encoder stores in a block
+ */
+#define LIBEWF_DEFLATE_ENCODER_MAXIMUM_NUMBER_OF_SEQUENCES	16384
+
 /* The block types
  */
 enum LIBEWF_DEFLATE_BLOCK_TYPES
@@ -59,7 +98,7 @@ struct libewf_deflate_bit_stream
 
 	/* The bit buffer
 	 */
-	uint32_t bit_buffer;
+	uint64_t bit_buffer;
 
 	/* The number of bits remaining in the bit buffer
 	 */
@@ -86,8 +125,80 @@ struct libewf_deflate_huffman_table
 	/* The number of codes
 	 */
 	int number_of_codes;
+
+	/* The lookup table
+	 * A value of a symbol contains the symbol in bits 4 - 12 and the code size in bits 0 - 3
+	 * A value that refers to a second level table contains the sub table flag, the offset
+	 * of the second level table in bits 3 - 14 and its number of bits in bits 0 - 2
+	 * A value of 0 indicates the code must be decoded from the code counts array
+	 */
+	uint16_t lookup_table[ LIBEWF_DEFLATE_HUFFMAN_LOOKUP_TABLE_SIZE ];
+};
+
+typedef struct libewf_deflate_encoder libewf_deflate_encoder_t;
+
+struct libewf_deflate_encoder
+{
+	/* The hash table, which contains the most recent position of a hashed
+	 * sequence of bytes relative to the position base
+	 */
+	uint32_t hash_table[ LIBEWF_DEFLATE_ENCODER_HASH_TABLE_SIZE ];
+
+	/* The position base
+	 * Positions in the hash table that are smaller than the position base
+	 * refer to previously compressed data and are ignored, which allows the
+	 * hash table to be reused without clearing it
+	 */
+	uint32_t position_base;
+
+	/* The sequences of the current block
+	 * A literal is stored as its byte value and a match as its distance in
+	 * bits 16 - 31 and its size in bits 0 - 15
+	 */
+	uint32_t sequences[ LIBEWF_DEFLATE_ENCODER_MAXIMUM_NUMBER_OF_SEQUENCES ];
+
+	/* The number of sequences of the current block
+	 */
+	int number_of_sequences;
+
+	/* The literal and length code sizes and codes of the fixed Huffman codes
+	 */
+	uint8_t fixed_literal_code_sizes[ 288 ];
+	uint16_t fixed_literal_codes[ 288 ];
+
+	/* The distance code sizes and codes of the fixed Huffman codes
+	 */
+	uint8_t fixed_distance_code_sizes[ 32 ];
+	uint16_t fixed_distance_codes[ 32 ];
+
+	/* The byte stream
+	 */
+	uint8_t *byte_stream;
+
+	/* The byte stream size
+	 */
+	size_t byte_stream_size;
+
+	/* The byte stream offset
+	 */
+	size_t byte_stream_offset;
+
+	/* The bit buffer
+	 */
+	uint64_t bit_buffer;
+
+	/* The number of bits in the bit buffer
+	 */
+	uint8_t bit_buffer_size;
+
+	/* Value to indicate the byte stream was too small
+	 */
+	uint8_t byte_stream_overflow;
 };
 
+void libewf_deflate_bit_stream_fill_bit_buffer(
+      libewf_deflate_bit_stream_t *bit_stream );
+
 int libewf_deflate_bit_stream_get_value(
      libewf_deflate_bit_stream_t *bit_stream,
      uint8_t number_of_bits,
@@ -100,11 +211,9 @@ int libewf_deflate_huffman_table_construct(
      int number_of_code_sizes,
      libcerror_error_t **error );
 
-int libewf_deflate_bit_stream_get_huffman_encoded_value(
-     libewf_deflate_bit_stream_t *bit_stream,
-     libewf_deflate_huffman_table_t *table,
-     uint32_t *value_32bit,
-     libcerror_error_t **error );
+uint16_t libewf_deflate_huffman_table_get_lookup_value(
+          const libewf_deflate_huffman_table_t *table,
+          uint64_t bit_buffer );
 
 int libewf_deflate_bit_stream_get_huffman_encoded_value(
      libewf_deflate_bit_stream_t *bit_stream,
@@ -134,6 +243,81 @@ int libewf_deflate_decompress(
      size_t *uncompressed_data_size,
      libcerror_error_t **error );
 
+/* Writes bits to the byte stream of the encoder
+ * The value cannot contain more than the number of bits and the number of bits cannot exceed 32
+ * If the byte stream is too small the byte stream overflow value is set
+ */
+#define libewf_deflate_encoder_write_bits( encoder, value_32bit, number_of_bits ) \
+	( encoder )->bit_buffer      |= (uint64_t) ( value_32bit ) << ( encoder )->bit_buffer_size; \
+	( encoder )->bit_buffer_size += (uint8_t) ( number_of_bits ); \
+	\
+	if( ( encoder )->bit_buffer_size >= 32 ) \
+	{ \
+		if( ( ( encoder )->byte_stream_size - ( encoder )->byte_stream_offset ) >= 4 ) \
+		{ \
+			byte_stream_copy_from_uint32_little_endian( \
+			 &( ( encoder )->byte_stream[ ( encoder )->byte_stream_offset ] ), \
+			 (uint32_t) ( encoder )->bit_buffer ); \
+			\
+			( encoder )->byte_stream_offset += 4; \
+		} \
+		else \
+		{ \
+			( encoder )->byte_stream_overflow = 1; \
+		} \
+		( encoder )->bit_buffer     >>= 32; \
+		( encoder )->bit_buffer_size -= 32; \
+	}
+
+int libewf_deflate_encoder_initialize(
+     libewf_deflate_encoder_t **encoder,
+     libcerror_error_t **error );
+
+int libewf_deflate_encoder_free(
+     libewf_deflate_encoder_t **encoder,
+     libcerror_error_t **error );
+
+void libewf_deflate_encoder_flush_bits(
+      libewf_deflate_encoder_t *encoder );
+
+int libewf_deflate_encoder_build_code_sizes(
+     const uint32_t *frequencies,
+     int number_of_symbols,
+     uint8_t maximum_code_size,
+     uint8_t *code_sizes,
+     libcerror_error_t **error );
+
+int libewf_deflate_encoder_build_codes(
+     const uint8_t *code_sizes,
+     int number_of_symbols,
+     uint16_t *codes,
+     libcerror_error_t **error );
+
+int libewf_deflate_encoder_write_block(
+     libewf_deflate_encoder_t *encoder,
+     const uint8_t *block_data,
+     size_t block_data_size,
+     uint8_t last_block_flag,
+     libcerror_error_t **error );
+
+int libewf_deflate_encoder_compress(
+     libewf_deflate_encoder_t *encoder,
+     const uint8_t *uncompressed_data,
+     size_t uncompressed_data_size,
+     uint8_t *compressed_data,
+     size_t *compressed_data_size,
+     libcerror_error_t **error );
+
+size_t libewf_deflate_get_compressed_data_size_bound(
+        size_t uncompressed_data_size );
+
+int libewf_deflate_compress(
+     const uint8_t *uncompressed_data,
+     size_t uncompressed_data_size,
+     uint8_t *compressed_data,
+     size_t *compressed_data_size,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -25,10 +25,15 @@
 #include <common.h>
 #include <types.h>
 
+#include "libewf_async_read.h"
+#include "libewf_buffer_pool.h"
+#include "libewf_chunk_cache.h"
 #include "libewf_chunk_data.h"
 #include "libewf_chunk_group.h"
 #include "libewf_chunk_table.h"
+#include "libewf_chunk_view.h"
 #include "libewf_data_chunk.h"
+#include "libewf_deflate.h"
 #include "libewf_extern.h"
 #include "libewf_hash_sections.h"
 #include "libewf_libbfio.h"
@@ -40,7 +45,12 @@
 #include "libewf_libfvalue.h"
 #include "libewf_io_handle.h"
 #include "libewf_media_values.h"
+#include "libewf_parallel_read.h"
+#include "libewf_parallel_write.h"
+#include "libewf_read_ahead.h"
 #include "libewf_read_io_handle.h"
+#include "libewf_read_range.h"
+#include "libewf_segment_index.h"
 #include "libewf_segment_table.h"
 #include "libewf_single_files.h"
 #include "libewf_types.h"
@@ -106,6 +116,10 @@ struct libewf_internal_handle
 	 */
 	libewf_segment_table_t *segment_table;
 
+	/* The segment index file IO handle
+	 */
+	libbfio_handle_t *segment_index_file_io_handle;
+
 	/* The chunk table
 	 */
 	libewf_chunk_table_t *chunk_table;
@@ -118,10 +132,67 @@ struct libewf_internal_handle
 	 */
 	libfcache_cache_t *chunks_cache;
 
+	/* The (unpacked) chunk cache used by the positional read functions
+	 */
+	libewf_chunk_cache_t *chunk_cache;
+
+	/* The maximum size of the chunk cache
+	 */
+	size64_t maximum_chunk_cache_size;
+
+	/* The maximum size of the chunk groups cache
+	 */
+	size64_t maximum_chunk_groups_cache_size;
+
+	/* The maximum number of chunks to read ahead
+	 */
+	int maximum_number_of_read_ahead_chunks;
+
+	/* The number of read-ahead threads
+	 */
+	int number_of_read_ahead_threads;
+
+	/* The number of threads used to read and unpack the chunks of large reads
+	 */
+	int number_of_unpack_threads;
+
+	/* The number of threads used to pack the chunks of buffered writes
+	 */
+	int number_of_pack_threads;
+
+	/* The number of threads used to scan the segment files on open
+	 */
+	int number_of_scan_threads;
+
+	/* The number of threads used to process asynchronous reads
+	 */
+	int number_of_async_read_threads;
+
+	/* The maximum size of a single read that spans multiple adjacent chunks
+	 */
+	size_t maximum_coalesced_read_size;
+
+	/* The index of the chunk that follows the chunk last read from the segment files
+	 * Used to detect sequential reads, which are coalesced
+	 */
+	uint64_t next_sequential_chunk_index;
+
+	/* The number of pinned chunk views
+	 */
+	int number_of_chunk_views;
+
+	/* The asynchronous read
+	 */
+	libewf_async_read_t *async_read;
+
 	/* The current chunk data
 	 */
 	libewf_chunk_data_t *chunk_data;
 
+	/* The buffer pool of the chunk data buffers used to write
+	 */
+	libewf_buffer_pool_t *chunk_buffer_pool;
+
 	/* The date format for certain header values
 	 */
 	int date_format;
@@ -154,6 +225,24 @@ struct libewf_internal_handle
 	/* The read/write lock
 	 */
 	libcthreads_read_write_lock_t *read_write_lock;
+
+	/* The IO mutex
+	 * Serializes access to the file IO pool, segment table and chunk table
+	 * while the read/write lock is grabbed for reading
+	 */
+	libcthreads_mutex_t *io_mutex;
+
+	/* The read-ahead
+	 */
+	libewf_read_ahead_t *read_ahead;
+
+	/* The parallel read
+	 */
+	libewf_parallel_read_t *parallel_read;
+
+	/* The parallel write
+	 */
+	libewf_parallel_write_t *parallel_write;
 #endif
 };
 
@@ -173,6 +262,13 @@ int libewf_handle_clone(
      libewf_handle_t *source_handle,
      libcerror_error_t **error );
 
+LIBEWF_EXTERN \
+int libewf_handle_clone_with_flags(
+     libewf_handle_t **destination_handle,
+     libewf_handle_t *source_handle,
+     uint8_t clone_flags,
+     libcerror_error_t **error );
+
 LIBEWF_EXTERN \
 int libewf_handle_signal_abort(
      libewf_handle_t *handle,
@@ -205,9 +301,31 @@ int libewf_internal_handle_open_read_segment_file_section_data(
      int file_io_pool_entry,
      libcerror_error_t **error );
 
+int libewf_internal_handle_read_segment_index(
+     libewf_internal_handle_t *internal_handle,
+     libewf_segment_index_t **segment_index,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_write_segment_index(
+     libewf_internal_handle_t *internal_handle,
+     libewf_segment_index_t *segment_index,
+     libcerror_error_t **error );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+int libewf_internal_handle_scan_segment_files(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_segment_table_t *segment_table,
+     uint32_t first_segment_number,
+     uint32_t number_of_segments,
+     libewf_segment_file_t **segment_files,
+     libcerror_error_t **error );
+#endif
+
 int libewf_internal_handle_open_read_segment_files(
      libewf_internal_handle_t *internal_handle,
      libbfio_pool_t *file_io_pool,
+     int access_flags,
      libewf_segment_table_t *segment_table,
      libcerror_error_t **error );
 
@@ -230,6 +348,110 @@ int libewf_handle_close(
      libewf_handle_t *handle,
      libcerror_error_t **error );
 
+int libewf_internal_handle_get_chunk_cache_value(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     uint64_t chunk_index,
+     libewf_chunk_cache_value_t **chunk_cache_value,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_set_chunk_cache_value(
+     libewf_internal_handle_t *internal_handle,
+     uint64_t chunk_index,
+     libewf_chunk_data_t **chunk_data,
+     uint8_t is_read_ahead,
+     libewf_chunk_cache_value_t **chunk_cache_value,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_read_chunk_cache_value(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     uint64_t chunk_index,
+     uint8_t is_read_ahead,
+     libewf_chunk_cache_value_t **chunk_cache_value,
+     libcerror_error_t **error );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+int libewf_internal_handle_read_ahead_chunk(
+     uint64_t chunk_index,
+     libewf_internal_handle_t *internal_handle );
+
+int libewf_internal_handle_initialize_read_ahead(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error );
+#endif
+
+int libewf_internal_handle_read_chunk_fill_pattern(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     uint64_t chunk_index,
+     int file_io_pool_entry,
+     off64_t range_offset,
+     size64_t range_size,
+     uint32_t range_flags,
+     uint8_t *fill_pattern,
+     size_t fill_pattern_size,
+     libcerror_error_t **error );
+
+ssize_t libewf_internal_handle_read_chunk_direct(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         uint64_t chunk_index,
+         size_t chunk_data_offset,
+         uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error );
+
+int libewf_internal_handle_chunk_is_empty(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     uint64_t chunk_index,
+     libcerror_error_t **error );
+
+ssize_t libewf_internal_handle_read_chunk_into_buffer(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         uint64_t chunk_index,
+         size_t chunk_data_offset,
+         uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error );
+
+int libewf_internal_handle_read_chunk_into_ranges(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_read_range_t *read_ranges,
+     int number_of_read_ranges,
+     libcerror_error_t **error );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+ssize_t libewf_internal_handle_parallel_read_chunk(
+         uint64_t chunk_index,
+         size_t chunk_data_offset,
+         uint8_t *buffer,
+         size_t buffer_size,
+         libewf_internal_handle_t *internal_handle,
+         libcerror_error_t **error );
+
+int libewf_internal_handle_parallel_read_chunk_ranges(
+     libewf_read_range_t *read_ranges,
+     int number_of_read_ranges,
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_initialize_parallel_read(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error );
+#endif
+
+ssize_t libewf_internal_handle_read_buffer_at_offset_from_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
 ssize_t libewf_internal_handle_read_buffer_from_file_io_pool(
          libewf_internal_handle_t *internal_handle,
          libbfio_pool_t *file_io_pool,
@@ -252,6 +474,123 @@ ssize_t libewf_handle_read_buffer_at_offset(
          off64_t offset,
          libcerror_error_t **error );
 
+int libewf_internal_handle_read_buffers_at_offsets_from_file_io_pool(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     void **buffers,
+     size_t *buffer_sizes,
+     off64_t *offsets,
+     ssize_t *read_counts,
+     int number_of_buffers,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_read_buffers_at_offsets(
+     libewf_handle_t *handle,
+     void **buffers,
+     size_t *buffer_sizes,
+     off64_t *offsets,
+     ssize_t *read_counts,
+     int number_of_buffers,
+     libcerror_error_t **error );
+
+ssize_t libewf_internal_handle_async_read_buffer_at_offset(
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libewf_internal_handle_t *internal_handle,
+         libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_submit_read_buffer_at_offset(
+     libewf_handle_t *handle,
+     void *buffer,
+     size_t buffer_size,
+     off64_t offset,
+     void (*completion_function)(
+            void *buffer,
+            ssize_t read_count,
+            void *completion_data ),
+     void *completion_data,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_completed_read(
+     libewf_handle_t *handle,
+     void **buffer,
+     ssize_t *read_count,
+     void **completion_data,
+     libcerror_error_t **read_error,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_wait_for_submitted_reads(
+     libewf_handle_t *handle,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_pin_chunk_view_from_file_io_pool(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     off64_t offset,
+     libewf_chunk_view_t **chunk_view,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_pin_chunk_view(
+     libewf_handle_t *handle,
+     off64_t offset,
+     libewf_chunk_view_t **chunk_view,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_unpin_chunk_view(
+     libewf_handle_t *handle,
+     libewf_chunk_view_t **chunk_view,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_get_next_data_range_from_file_io_pool(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     off64_t offset,
+     off64_t *range_offset,
+     size64_t *range_size,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_next_data_range(
+     libewf_handle_t *handle,
+     off64_t offset,
+     off64_t *range_offset,
+     size64_t *range_size,
+     libcerror_error_t **error );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+int libewf_internal_handle_parallel_write_pack_chunk(
+     libewf_chunk_data_t *chunk_data,
+     libewf_deflate_encoder_t **deflate_encoder,
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_initialize_parallel_write(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_write_packed_chunk(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     uint8_t wait_for_chunk,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_flush_parallel_write(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     libcerror_error_t **error );
+#endif
+
+int libewf_internal_handle_initialize_chunk_buffer_pool(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error );
+
 ssize_t libewf_internal_handle_write_buffer_to_file_io_pool(
          libewf_internal_handle_t *internal_handle,
          libbfio_pool_t *file_io_pool,
@@ -339,6 +678,134 @@ int libewf_handle_set_maximum_number_of_open_handles(
      int maximum_number_of_open_handles,
      libcerror_error_t **error );
 
+LIBEWF_EXTERN \
+int libewf_handle_get_chunk_cache_size(
+     libewf_handle_t *handle,
+     size64_t *cache_size,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_chunk_cache_size(
+     libewf_handle_t *handle,
+     size64_t cache_size,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_get_number_of_chunk_groups_cache_entries(
+     size64_t cache_size,
+     int *number_of_cache_entries,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_chunk_groups_cache_size(
+     libewf_handle_t *handle,
+     size64_t *cache_size,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_chunk_groups_cache_size(
+     libewf_handle_t *handle,
+     size64_t cache_size,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_chunk_cache_statistics(
+     libewf_handle_t *handle,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_read_ahead_values(
+     libewf_handle_t *handle,
+     int *number_of_chunks,
+     int *number_of_threads,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_read_ahead_values(
+     libewf_handle_t *handle,
+     int number_of_chunks,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_number_of_unpack_threads(
+     libewf_handle_t *handle,
+     int *number_of_threads,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_number_of_unpack_threads(
+     libewf_handle_t *handle,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_number_of_pack_threads(
+     libewf_handle_t *handle,
+     int *number_of_threads,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_number_of_pack_threads(
+     libewf_handle_t *handle,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_number_of_scan_threads(
+     libewf_handle_t *handle,
+     int *number_of_threads,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_number_of_scan_threads(
+     libewf_handle_t *handle,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_number_of_async_read_threads(
+     libewf_handle_t *handle,
+     int *number_of_threads,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_number_of_async_read_threads(
+     libewf_handle_t *handle,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_maximum_coalesced_read_size(
+     libewf_handle_t *handle,
+     size_t *read_size,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_maximum_coalesced_read_size(
+     libewf_handle_t *handle,
+     size_t read_size,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_segment_index_filename(
+     libewf_handle_t *handle,
+     const char *filename,
+     size_t filename_length,
+     libcerror_error_t **error );
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+LIBEWF_EXTERN \
+int libewf_handle_set_segment_index_filename_wide(
+     libewf_handle_t *handle,
+     const wchar_t *filename,
+     size_t filename_length,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
 LIBEWF_EXTERN \
 int libewf_handle_segment_files_corrupted(
      libewf_handle_t *handle,
@@ -568,6 +1035,30 @@ int libewf_handle_set_compression_values(
      uint8_t compression_flags,
      libcerror_error_t **error );
 
+LIBEWF_EXTERN \
+int libewf_handle_get_compression_entropy_threshold(
+     libewf_handle_t *handle,
+     uint8_t *entropy_threshold,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_compression_entropy_threshold(
+     libewf_handle_t *handle,
+     uint8_t entropy_threshold,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_compression_target_throughput(
+     libewf_handle_t *handle,
+     uint64_t *target_throughput,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_compression_target_throughput(
+     libewf_handle_t *handle,
+     uint64_t target_throughput,
+     libcerror_error_t **error );
+
 LIBEWF_EXTERN \
 int libewf_handle_get_media_size(
      libewf_handle_t *handle,
@@ -719,6 +1210,18 @@ int libewf_handle_append_checksum_error(
      uint64_t number_of_sectors,
      libcerror_error_t **error );
 
+LIBEWF_EXTERN \
+int libewf_handle_get_statistics_value(
+     libewf_handle_t *handle,
+     int value_type,
+     uint64_t *value,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_reset_statistics(
+     libewf_handle_t *handle,
+     libcerror_error_t **error );
+
 LIBEWF_EXTERN \
 int libewf_handle_get_number_of_sessions(
      libewf_handle_t *handle,
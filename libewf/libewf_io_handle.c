@@ -24,6 +24,7 @@
 #include <types.h>
 
 #include "libewf_codepage.h"
+#include "libewf_compression_controller.h"
 #include "libewf_definitions.h"
 #include "libewf_io_handle.h"
 #include "libewf_libcerror.h"
@@ -88,15 +89,29 @@ int libewf_io_handle_initialize(
 
 		goto on_error;
 	}
-	( *io_handle )->segment_file_type  = LIBEWF_SEGMENT_FILE_TYPE_UNDEFINED;
-	( *io_handle )->format             = LIBEWF_FORMAT_ENCASE6;
-	( *io_handle )->major_version      = 1;
-	( *io_handle )->minor_version      = 0;
-	( *io_handle )->compression_method = LIBEWF_COMPRESSION_METHOD_DEFLATE;
-	( *io_handle )->compression_level  = LIBEWF_COMPRESSION_NONE;
-	( *io_handle )->zero_on_error      = 1;
-	( *io_handle )->header_codepage    = LIBEWF_CODEPAGE_ASCII;
+	( *io_handle )->segment_file_type             = LIBEWF_SEGMENT_FILE_TYPE_UNDEFINED;
+	( *io_handle )->format                        = LIBEWF_FORMAT_ENCASE6;
+	( *io_handle )->major_version                 = 1;
+	( *io_handle )->minor_version                 = 0;
+	( *io_handle )->compression_method            = LIBEWF_COMPRESSION_METHOD_DEFLATE;
+	( *io_handle )->compression_level             = LIBEWF_COMPRESSION_NONE;
+	( *io_handle )->compression_entropy_threshold = LIBEWF_DEFAULT_COMPRESSION_ENTROPY_THRESHOLD;
+	( *io_handle )->zero_on_error                 = 1;
+	( *io_handle )->header_codepage               = LIBEWF_CODEPAGE_ASCII;
+
+	if( libewf_compression_controller_initialize(
+	     &( ( *io_handle )->compression_controller ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create compression controller.",
+		 function );
 
+		goto on_error;
+	}
 	return( 1 );
 
 on_error:
@@ -146,6 +161,19 @@ int libewf_io_handle_free(
 
 			result = -1;
 		}
+		if( libewf_compression_controller_free(
+		     &( ( *io_handle )->compression_controller ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free compression controller.",
+			 function );
+
+			result = -1;
+		}
 		memory_free(
 		 *io_handle );
 
@@ -161,7 +189,8 @@ int libewf_io_handle_clear(
      libewf_io_handle_t *io_handle,
      libcerror_error_t **error )
 {
-	static char *function = "libewf_io_handle_clear";
+	libewf_compression_controller_t *compression_controller = NULL;
+	static char *function                                   = "libewf_io_handle_clear";
 
 	if( io_handle == NULL )
 	{
@@ -174,6 +203,10 @@ int libewf_io_handle_clear(
 
 		return( -1 );
 	}
+	/* The compression controller is retained
+	 */
+	compression_controller = io_handle->compression_controller;
+
 	if( memory_set(
 	     io_handle,
 	     0,
@@ -188,15 +221,33 @@ int libewf_io_handle_clear(
 
 		return( -1 );
 	}
-	io_handle->segment_file_type  = LIBEWF_SEGMENT_FILE_TYPE_UNDEFINED;
-	io_handle->format             = LIBEWF_FORMAT_ENCASE6;
-	io_handle->major_version      = 1;
-	io_handle->minor_version      = 0;
-	io_handle->compression_method = LIBEWF_COMPRESSION_METHOD_DEFLATE;
-	io_handle->compression_level  = LIBEWF_COMPRESSION_NONE;
-	io_handle->zero_on_error      = 1;
-	io_handle->header_codepage    = LIBEWF_CODEPAGE_ASCII;
+	io_handle->segment_file_type             = LIBEWF_SEGMENT_FILE_TYPE_UNDEFINED;
+	io_handle->format                        = LIBEWF_FORMAT_ENCASE6;
+	io_handle->major_version                 = 1;
+	io_handle->minor_version                 = 0;
+	io_handle->compression_method            = LIBEWF_COMPRESSION_METHOD_DEFLATE;
+	io_handle->compression_level             = LIBEWF_COMPRESSION_NONE;
+	io_handle->compression_entropy_threshold = LIBEWF_DEFAULT_COMPRESSION_ENTROPY_THRESHOLD;
+	io_handle->zero_on_error                 = 1;
+	io_handle->header_codepage               = LIBEWF_CODEPAGE_ASCII;
+	io_handle->compression_controller        = compression_controller;
+
+	if( compression_controller != NULL )
+	{
+		if( libewf_compression_controller_reset(
+		     compression_controller,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to reset compression controller.",
+			 function );
 
+			return( -1 );
+		}
+	}
 	return( 1 );
 }
 
@@ -268,6 +319,39 @@ int libewf_io_handle_clone(
 	}
 	( *destination_io_handle )->zero_on_error = source_io_handle->zero_on_error;
 
+	/* The statistics are maintained per handle
+	 */
+	if( memory_set(
+	     &( ( *destination_io_handle )->statistics ),
+	     0,
+	     sizeof( libewf_statistics_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear destination statistics.",
+		 function );
+
+		goto on_error;
+	}
+	/* The compression controller is maintained per handle
+	 */
+	( *destination_io_handle )->compression_controller = NULL;
+
+	if( libewf_compression_controller_initialize(
+	     &( ( *destination_io_handle )->compression_controller ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination compression controller.",
+		 function );
+
+		goto on_error;
+	}
 	return( 1 );
 
 on_error:
@@ -25,7 +25,9 @@
 #include <common.h>
 #include <types.h>
 
+#include "libewf_compression_controller.h"
 #include "libewf_libcerror.h"
+#include "libewf_statistics.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -67,6 +69,15 @@ struct libewf_io_handle
 	 */
 	uint8_t compression_flags;
 
+	/* The compression entropy threshold, as a percentage of 8 bits per byte
+	 * where 0 represents that the entropy of the chunk data is not estimated
+	 */
+	uint8_t compression_entropy_threshold;
+
+	/* The compression controller used by adaptive compression
+	 */
+	libewf_compression_controller_t *compression_controller;
+
 	/* Value to indicate the data and some metadata is encrypted
 	 */
 	uint8_t is_encrypted;
@@ -86,6 +97,10 @@ struct libewf_io_handle
 	/* Value to indicate if abort was signalled
 	 */
 	int abort;
+
+	/* The statistics
+	 */
+	libewf_statistics_t statistics;
 };
 
 int libewf_io_handle_initialize(
@@ -0,0 +1,897 @@
+/*
+ * Parallel read functions
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_definitions.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+#include "libewf_parallel_read.h"
+#include "libewf_read_range.h"
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+/* Creates a parallel read
+ * Make sure the value parallel_read is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_parallel_read_initialize(
+     libewf_parallel_read_t **parallel_read,
+     int number_of_threads,
+     ssize_t (*callback_function)(
+                uint64_t chunk_index,
+                size_t chunk_data_offset,
+                uint8_t *buffer,
+                size_t buffer_size,
+                void *arguments,
+                libcerror_error_t **error ),
+     int (*read_ranges_callback_function)(
+            libewf_read_range_t *read_ranges,
+            int number_of_read_ranges,
+            void *arguments,
+            libcerror_error_t **error ),
+     void *callback_function_arguments,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_parallel_read_initialize";
+
+	if( parallel_read == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid parallel read.",
+		 function );
+
+		return( -1 );
+	}
+	if( *parallel_read != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid parallel read value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_threads <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( callback_function == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid callback function.",
+		 function );
+
+		return( -1 );
+	}
+	*parallel_read = memory_allocate_structure(
+	                  libewf_parallel_read_t );
+
+	if( *parallel_read == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create parallel read.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *parallel_read,
+	     0,
+	     sizeof( libewf_parallel_read_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear parallel read.",
+		 function );
+
+		memory_free(
+		 *parallel_read );
+
+		*parallel_read = NULL;
+
+		return( -1 );
+	}
+	( *parallel_read )->number_of_threads             = number_of_threads;
+	( *parallel_read )->callback_function             = callback_function;
+	( *parallel_read )->read_ranges_callback_function = read_ranges_callback_function;
+	( *parallel_read )->callback_function_arguments   = callback_function_arguments;
+
+	if( libcthreads_thread_pool_create(
+	     &( ( *parallel_read )->thread_pool ),
+	     NULL,
+	     number_of_threads,
+	     LIBEWF_PARALLEL_READ_MAXIMUM_NUMBER_OF_QUEUED_JOBS,
+	     (int (*)(intptr_t *, void *)) &libewf_parallel_read_process_job,
+	     (void *) *parallel_read,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create thread pool.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *parallel_read != NULL )
+	{
+		memory_free(
+		 *parallel_read );
+
+		*parallel_read = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a parallel read
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_parallel_read_free(
+     libewf_parallel_read_t **parallel_read,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_parallel_read_free";
+	int result            = 1;
+
+	if( parallel_read == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid parallel read.",
+		 function );
+
+		return( -1 );
+	}
+	if( *parallel_read != NULL )
+	{
+		if( libcthreads_thread_pool_join(
+		     &( ( *parallel_read )->thread_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join thread pool.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *parallel_read );
+
+		*parallel_read = NULL;
+	}
+	return( result );
+}
+
+/* Runs jobs using the thread pool
+ * The jobs are freed by this function
+ * This function blocks until all the jobs have completed
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_parallel_read_run_jobs(
+     libewf_parallel_read_t *parallel_read,
+     libewf_parallel_read_job_t **jobs,
+     int number_of_jobs,
+     libcerror_error_t **error )
+{
+	libewf_parallel_read_batch_t *batch = NULL;
+	static char *function               = "libewf_parallel_read_run_jobs";
+	int job_index                       = 0;
+	int result                          = 1;
+
+	if( parallel_read == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid parallel read.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( jobs == NULL )
+	 || ( *jobs == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid jobs.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_jobs <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid number of jobs value zero or less.",
+		 function );
+
+		goto on_error;
+	}
+	batch = memory_allocate_structure(
+	         libewf_parallel_read_batch_t );
+
+	if( batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create batch.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     batch,
+	     0,
+	     sizeof( libewf_parallel_read_batch_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear batch.",
+		 function );
+
+		memory_free(
+		 batch );
+
+		batch = NULL;
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_initialize(
+	     &( batch->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( batch->condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create condition.",
+		 function );
+
+		goto on_error;
+	}
+	batch->parallel_read          = parallel_read;
+	batch->number_of_pending_jobs = number_of_jobs;
+
+	for( job_index = 0;
+	     job_index < number_of_jobs;
+	     job_index++ )
+	{
+		( *jobs )[ job_index ].batch = batch;
+
+		if( libcthreads_thread_pool_push(
+		     parallel_read->thread_pool,
+		     (intptr_t *) &( ( *jobs )[ job_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push job: %d onto queue.",
+			 function,
+			 job_index );
+
+			result = -1;
+
+			break;
+		}
+	}
+	if( libcthreads_mutex_grab(
+	     batch->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		goto on_error;
+	}
+	/* Jobs that could not be pushed will never complete
+	 */
+	batch->number_of_pending_jobs -= number_of_jobs - job_index;
+
+	while( batch->number_of_pending_jobs > 0 )
+	{
+		if( libcthreads_condition_wait(
+		     batch->condition,
+		     batch->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to wait for condition.",
+			 function );
+
+			libcthreads_mutex_release(
+			 batch->mutex,
+			 NULL );
+
+			goto on_error;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     batch->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( batch->has_failed != 0 )
+	{
+		if( ( error != NULL )
+		 && ( *error == NULL ) )
+		{
+			*error       = batch->error;
+			batch->error = NULL;
+		}
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read chunks.",
+		 function );
+
+		result = -1;
+	}
+	if( batch->error != NULL )
+	{
+		libcerror_error_free(
+		 &( batch->error ) );
+	}
+	if( libcthreads_condition_free(
+	     &( batch->condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free condition.",
+		 function );
+
+		result = -1;
+	}
+	if( libcthreads_mutex_free(
+	     &( batch->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free mutex.",
+		 function );
+
+		result = -1;
+	}
+	memory_free(
+	 *jobs );
+
+	*jobs = NULL;
+
+	memory_free(
+	 batch );
+
+	return( result );
+
+on_error:
+	if( batch != NULL )
+	{
+		/* The jobs and batch cannot be freed when pushed jobs might still be pending
+		 */
+		if( batch->number_of_pending_jobs > 0 )
+		{
+			*jobs = NULL;
+
+			return( -1 );
+		}
+		if( batch->error != NULL )
+		{
+			libcerror_error_free(
+			 &( batch->error ) );
+		}
+		if( batch->condition != NULL )
+		{
+			libcthreads_condition_free(
+			 &( batch->condition ),
+			 NULL );
+		}
+		if( batch->mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( batch->mutex ),
+			 NULL );
+		}
+		memory_free(
+		 batch );
+	}
+	memory_free(
+	 *jobs );
+
+	*jobs = NULL;
+
+	return( -1 );
+}
+
+/* Reads the chunks spanned by a buffer using the thread pool
+ * The chunks are read directly into the buffer, every chunk except the last
+ * must contain chunk size bytes of data
+ * This function blocks until all the chunks have been read
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libewf_parallel_read_read_chunks(
+         libewf_parallel_read_t *parallel_read,
+         uint64_t chunk_index,
+         size_t chunk_data_offset,
+         size32_t chunk_size,
+         uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	libewf_parallel_read_job_t *jobs = NULL;
+	static char *function            = "libewf_parallel_read_read_chunks";
+	size_t buffer_offset             = 0;
+	size_t read_size                 = 0;
+	uint64_t number_of_jobs          = 0;
+	int job_index                    = 0;
+
+	if( parallel_read == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid parallel read.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid chunk size value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data_offset >= (size_t) chunk_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk data offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( buffer_size == 0 )
+	 || ( buffer_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_jobs = ( (uint64_t) chunk_data_offset + buffer_size + chunk_size - 1 ) / chunk_size;
+
+	if( ( number_of_jobs > (uint64_t) INT_MAX )
+	 || ( number_of_jobs > (uint64_t) ( (size_t) SSIZE_MAX / sizeof( libewf_parallel_read_job_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of jobs value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	jobs = (libewf_parallel_read_job_t *) memory_allocate(
+	                                       sizeof( libewf_parallel_read_job_t ) * (size_t) number_of_jobs );
+
+	if( jobs == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create jobs.",
+		 function );
+
+		return( -1 );
+	}
+	for( job_index = 0;
+	     job_index < (int) number_of_jobs;
+	     job_index++ )
+	{
+		read_size = (size_t) chunk_size - chunk_data_offset;
+
+		if( read_size > ( buffer_size - buffer_offset ) )
+		{
+			read_size = buffer_size - buffer_offset;
+		}
+		jobs[ job_index ].batch                 = NULL;
+		jobs[ job_index ].chunk_index           = chunk_index + job_index;
+		jobs[ job_index ].chunk_data_offset     = chunk_data_offset;
+		jobs[ job_index ].buffer                = &( buffer[ buffer_offset ] );
+		jobs[ job_index ].buffer_size           = read_size;
+		jobs[ job_index ].read_ranges           = NULL;
+		jobs[ job_index ].number_of_read_ranges = 0;
+
+		buffer_offset    += read_size;
+		chunk_data_offset = 0;
+	}
+	if( libewf_parallel_read_run_jobs(
+	     parallel_read,
+	     &jobs,
+	     (int) number_of_jobs,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read chunks.",
+		 function );
+
+		return( -1 );
+	}
+	return( (ssize_t) buffer_size );
+}
+
+/* Reads read ranges using the thread pool
+ * The read ranges must be sorted by chunk index, the read ranges of the same chunk
+ * are read by a single job so that every chunk is read and unpacked only once
+ * This function blocks until all the read ranges have been read
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_parallel_read_read_ranges(
+     libewf_parallel_read_t *parallel_read,
+     libewf_read_range_t *read_ranges,
+     int number_of_read_ranges,
+     libcerror_error_t **error )
+{
+	libewf_parallel_read_job_t *jobs = NULL;
+	static char *function            = "libewf_parallel_read_read_ranges";
+	int job_index                    = 0;
+	int number_of_jobs               = 0;
+	int number_of_ranges_in_chunk    = 0;
+	int read_range_index             = 0;
+
+	if( parallel_read == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid parallel read.",
+		 function );
+
+		return( -1 );
+	}
+	if( parallel_read->read_ranges_callback_function == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid parallel read - missing read ranges callback function.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_ranges == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read ranges.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_read_ranges <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid number of read ranges value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	/* The number of chunks is not known in advance, hence allocate a job per read range
+	 */
+	if( (size_t) number_of_read_ranges > ( (size_t) SSIZE_MAX / sizeof( libewf_parallel_read_job_t ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of read ranges value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	jobs = (libewf_parallel_read_job_t *) memory_allocate(
+	                                       sizeof( libewf_parallel_read_job_t ) * (size_t) number_of_read_ranges );
+
+	if( jobs == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create jobs.",
+		 function );
+
+		return( -1 );
+	}
+	while( read_range_index < number_of_read_ranges )
+	{
+		if( libewf_read_range_get_number_of_ranges_in_chunk(
+		     read_ranges,
+		     number_of_read_ranges,
+		     read_range_index,
+		     &number_of_ranges_in_chunk,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of ranges in chunk of read range: %d.",
+			 function,
+			 read_range_index );
+
+			memory_free(
+			 jobs );
+
+			return( -1 );
+		}
+		job_index = number_of_jobs++;
+
+		jobs[ job_index ].batch                 = NULL;
+		jobs[ job_index ].chunk_index           = read_ranges[ read_range_index ].chunk_index;
+		jobs[ job_index ].chunk_data_offset     = 0;
+		jobs[ job_index ].buffer                = NULL;
+		jobs[ job_index ].buffer_size           = 0;
+		jobs[ job_index ].read_ranges           = &( read_ranges[ read_range_index ] );
+		jobs[ job_index ].number_of_read_ranges = number_of_ranges_in_chunk;
+
+		read_range_index += number_of_ranges_in_chunk;
+	}
+	if( libewf_parallel_read_run_jobs(
+	     parallel_read,
+	     &jobs,
+	     number_of_jobs,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read ranges.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Reads the chunk of a job
+ * Callback function for the thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_parallel_read_process_job(
+     libewf_parallel_read_job_t *job,
+     libewf_parallel_read_t *parallel_read )
+{
+	libewf_parallel_read_batch_t *batch = NULL;
+	libcerror_error_t *error            = NULL;
+	static char *function               = "libewf_parallel_read_process_job";
+	ssize_t read_count                  = 0;
+	int result                          = 1;
+
+	if( ( job == NULL )
+	 || ( job->batch == NULL )
+	 || ( parallel_read == NULL ) )
+	{
+		return( -1 );
+	}
+	batch = job->batch;
+
+	if( job->read_ranges != NULL )
+	{
+		if( parallel_read->read_ranges_callback_function(
+		     job->read_ranges,
+		     job->number_of_read_ranges,
+		     parallel_read->callback_function_arguments,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read ranges of chunk: %" PRIu64 ".",
+			 function,
+			 job->chunk_index );
+
+			result = -1;
+		}
+	}
+	else
+	{
+		read_count = parallel_read->callback_function(
+		              job->chunk_index,
+		              job->chunk_data_offset,
+		              job->buffer,
+		              job->buffer_size,
+		              parallel_read->callback_function_arguments,
+		              &error );
+
+		if( read_count == -1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read chunk: %" PRIu64 ".",
+			 function,
+			 job->chunk_index );
+
+			result = -1;
+		}
+		else if( (size_t) read_count != job->buffer_size )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid chunk: %" PRIu64 " data size value out of bounds.",
+			 function,
+			 job->chunk_index );
+
+			result = -1;
+		}
+	}
+	/* The job must always be marked as completed otherwise the reader waits indefinitely
+	 */
+	libcthreads_mutex_grab(
+	 batch->mutex,
+	 NULL );
+
+	if( ( result != 1 )
+	 && ( batch->has_failed == 0 ) )
+	{
+		batch->error      = error;
+		batch->has_failed = 1;
+
+		error = NULL;
+	}
+	batch->number_of_pending_jobs -= 1;
+
+	if( batch->number_of_pending_jobs == 0 )
+	{
+		libcthreads_condition_broadcast(
+		 batch->condition,
+		 NULL );
+	}
+	libcthreads_mutex_release(
+	 batch->mutex,
+	 NULL );
+
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( result );
+}
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
@@ -0,0 +1,189 @@
+/*
+ * Parallel read functions
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_PARALLEL_READ_H )
+#define _LIBEWF_PARALLEL_READ_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+#include "libewf_read_range.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+typedef struct libewf_parallel_read libewf_parallel_read_t;
+
+struct libewf_parallel_read
+{
+	/* The number of threads
+	 */
+	int number_of_threads;
+
+	/* The thread pool
+	 */
+	libcthreads_thread_pool_t *thread_pool;
+
+	/* The function that reads (part of) a chunk into a buffer
+	 */
+	ssize_t (*callback_function)(
+	           uint64_t chunk_index,
+	           size_t chunk_data_offset,
+	           uint8_t *buffer,
+	           size_t buffer_size,
+	           void *arguments,
+	           libcerror_error_t **error );
+
+	/* The function that reads the read ranges of a single chunk
+	 */
+	int (*read_ranges_callback_function)(
+	       libewf_read_range_t *read_ranges,
+	       int number_of_read_ranges,
+	       void *arguments,
+	       libcerror_error_t **error );
+
+	/* The arguments of the functions that read a chunk
+	 */
+	void *callback_function_arguments;
+};
+
+typedef struct libewf_parallel_read_batch libewf_parallel_read_batch_t;
+
+struct libewf_parallel_read_batch
+{
+	/* The parallel read
+	 */
+	libewf_parallel_read_t *parallel_read;
+
+	/* The number of jobs that have not completed
+	 */
+	int number_of_pending_jobs;
+
+	/* The error of the first job that failed
+	 */
+	libcerror_error_t *error;
+
+	/* Value to indicate a job failed
+	 */
+	uint8_t has_failed;
+
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The condition signalled when all jobs have completed
+	 */
+	libcthreads_condition_t *condition;
+};
+
+typedef struct libewf_parallel_read_job libewf_parallel_read_job_t;
+
+struct libewf_parallel_read_job
+{
+	/* The batch
+	 */
+	libewf_parallel_read_batch_t *batch;
+
+	/* The chunk index
+	 */
+	uint64_t chunk_index;
+
+	/* The offset in the chunk data
+	 */
+	size_t chunk_data_offset;
+
+	/* The buffer
+	 */
+	uint8_t *buffer;
+
+	/* The size of the buffer
+	 */
+	size_t buffer_size;
+
+	/* The read ranges of the chunk or NULL when the job reads into the buffer
+	 */
+	libewf_read_range_t *read_ranges;
+
+	/* The number of read ranges
+	 */
+	int number_of_read_ranges;
+};
+
+int libewf_parallel_read_initialize(
+     libewf_parallel_read_t **parallel_read,
+     int number_of_threads,
+     ssize_t (*callback_function)(
+                uint64_t chunk_index,
+                size_t chunk_data_offset,
+                uint8_t *buffer,
+                size_t buffer_size,
+                void *arguments,
+                libcerror_error_t **error ),
+     int (*read_ranges_callback_function)(
+            libewf_read_range_t *read_ranges,
+            int number_of_read_ranges,
+            void *arguments,
+            libcerror_error_t **error ),
+     void *callback_function_arguments,
+     libcerror_error_t **error );
+
+int libewf_parallel_read_free(
+     libewf_parallel_read_t **parallel_read,
+     libcerror_error_t **error );
+
+int libewf_parallel_read_run_jobs(
+     libewf_parallel_read_t *parallel_read,
+     libewf_parallel_read_job_t **jobs,
+     int number_of_jobs,
+     libcerror_error_t **error );
+
+ssize_t libewf_parallel_read_read_chunks(
+         libewf_parallel_read_t *parallel_read,
+         uint64_t chunk_index,
+         size_t chunk_data_offset,
+         size32_t chunk_size,
+         uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error );
+
+int libewf_parallel_read_read_ranges(
+     libewf_parallel_read_t *parallel_read,
+     libewf_read_range_t *read_ranges,
+     int number_of_read_ranges,
+     libcerror_error_t **error );
+
+int libewf_parallel_read_process_job(
+     libewf_parallel_read_job_t *job,
+     libewf_parallel_read_t *parallel_read );
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_PARALLEL_READ_H ) */
+
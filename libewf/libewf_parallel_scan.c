@@ -0,0 +1,765 @@
+/*
+ * Parallel segment file scan functions
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_definitions.h"
+#include "libewf_io_handle.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+#include "libewf_parallel_scan.h"
+#include "libewf_segment_file.h"
+#include "libewf_segment_table.h"
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+/* Creates a parallel scan
+ * Make sure the value parallel_scan is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_parallel_scan_initialize(
+     libewf_parallel_scan_t **parallel_scan,
+     libewf_io_handle_t *io_handle,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_parallel_scan_initialize";
+
+	if( parallel_scan == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid parallel scan.",
+		 function );
+
+		return( -1 );
+	}
+	if( *parallel_scan != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid parallel scan value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_threads <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*parallel_scan = memory_allocate_structure(
+	                  libewf_parallel_scan_t );
+
+	if( *parallel_scan == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create parallel scan.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *parallel_scan,
+	     0,
+	     sizeof( libewf_parallel_scan_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear parallel scan.",
+		 function );
+
+		memory_free(
+		 *parallel_scan );
+
+		*parallel_scan = NULL;
+
+		return( -1 );
+	}
+	( *parallel_scan )->io_handle = io_handle;
+
+	if( libcthreads_mutex_initialize(
+	     &( ( *parallel_scan )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *parallel_scan )->condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create condition.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_thread_pool_create(
+	     &( ( *parallel_scan )->thread_pool ),
+	     NULL,
+	     number_of_threads,
+	     LIBEWF_PARALLEL_SCAN_MAXIMUM_NUMBER_OF_QUEUED_JOBS,
+	     (int (*)(intptr_t *, void *)) &libewf_parallel_scan_process_job,
+	     (void *) *parallel_scan,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create thread pool.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *parallel_scan != NULL )
+	{
+		if( ( *parallel_scan )->condition != NULL )
+		{
+			libcthreads_condition_free(
+			 &( ( *parallel_scan )->condition ),
+			 NULL );
+		}
+		if( ( *parallel_scan )->mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *parallel_scan )->mutex ),
+			 NULL );
+		}
+		memory_free(
+		 *parallel_scan );
+
+		*parallel_scan = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a parallel scan
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_parallel_scan_free(
+     libewf_parallel_scan_t **parallel_scan,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_parallel_scan_free";
+	int result            = 1;
+
+	if( parallel_scan == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid parallel scan.",
+		 function );
+
+		return( -1 );
+	}
+	if( *parallel_scan != NULL )
+	{
+		/* The thread pool was already joined if a scan failed while jobs were pending
+		 */
+		if( ( *parallel_scan )->thread_pool != NULL )
+		{
+			if( libcthreads_thread_pool_join(
+			     &( ( *parallel_scan )->thread_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join thread pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *parallel_scan )->error != NULL )
+		{
+			libcerror_error_free(
+			 &( ( *parallel_scan )->error ) );
+		}
+		if( libcthreads_condition_free(
+		     &( ( *parallel_scan )->condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *parallel_scan )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *parallel_scan );
+
+		*parallel_scan = NULL;
+	}
+	return( result );
+}
+
+/* Scans a range of segment files using the thread pool
+ * Every segment file is scanned using its own file IO handle, since reads
+ * from the file IO pool are serialized
+ * The scanned segment files are stored in segment files in the order of
+ * their segment number and are not added to the segment table
+ * This function blocks until all the segment files have been scanned
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_parallel_scan_scan_segment_files(
+     libewf_parallel_scan_t *parallel_scan,
+     libbfio_pool_t *file_io_pool,
+     libewf_segment_table_t *segment_table,
+     uint32_t first_segment_number,
+     uint32_t number_of_segments,
+     libewf_segment_file_t **segment_files,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle  = NULL;
+	libewf_parallel_scan_job_t *jobs  = NULL;
+	static char *function             = "libewf_parallel_scan_scan_segment_files";
+	uint32_t job_index                = 0;
+	uint32_t number_of_pushed_jobs    = 0;
+	uint8_t jobs_completed            = 0;
+	int result                        = 1;
+
+	if( parallel_scan == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid parallel scan.",
+		 function );
+
+		return( -1 );
+	}
+	if( parallel_scan->number_of_pending_jobs != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid parallel scan - scan already in progress.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment table.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_segments == 0 )
+	 || ( number_of_segments > (uint32_t) INT_MAX )
+	 || ( (size_t) number_of_segments > ( (size_t) SSIZE_MAX / sizeof( libewf_parallel_scan_job_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of segments value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( first_segment_number > ( segment_table->number_of_segments - number_of_segments ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid first segment number value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_files == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment files.",
+		 function );
+
+		return( -1 );
+	}
+	jobs = (libewf_parallel_scan_job_t *) memory_allocate(
+	                                       sizeof( libewf_parallel_scan_job_t ) * (size_t) number_of_segments );
+
+	if( jobs == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create jobs.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     jobs,
+	     0,
+	     sizeof( libewf_parallel_scan_job_t ) * (size_t) number_of_segments ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear jobs.",
+		 function );
+
+		memory_free(
+		 jobs );
+
+		return( -1 );
+	}
+	/* The jobs are prepared up front so that no job is pushed when
+	 * the file IO handles cannot be retrieved
+	 */
+	for( job_index = 0;
+	     job_index < number_of_segments;
+	     job_index++ )
+	{
+		jobs[ job_index ].parallel_scan  = parallel_scan;
+		jobs[ job_index ].segment_number = first_segment_number + job_index;
+
+		if( libewf_segment_table_get_segment_by_index(
+		     segment_table,
+		     jobs[ job_index ].segment_number,
+		     &( jobs[ job_index ].file_io_pool_entry ),
+		     &( jobs[ job_index ].segment_file_size ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment: %" PRIu32 " from segment table.",
+			 function,
+			 jobs[ job_index ].segment_number );
+
+			goto on_error;
+		}
+		if( libbfio_pool_get_handle(
+		     file_io_pool,
+		     jobs[ job_index ].file_io_pool_entry,
+		     &file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve file IO handle: %d from pool.",
+			 function,
+			 jobs[ job_index ].file_io_pool_entry );
+
+			goto on_error;
+		}
+		if( libbfio_handle_clone(
+		     &( jobs[ job_index ].file_io_handle ),
+		     file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create file IO handle: %d.",
+			 function,
+			 jobs[ job_index ].file_io_pool_entry );
+
+			goto on_error;
+		}
+	}
+	parallel_scan->number_of_pending_jobs = (int) number_of_segments;
+	parallel_scan->has_failed             = 0;
+
+	for( job_index = 0;
+	     job_index < number_of_segments;
+	     job_index++ )
+	{
+		if( libcthreads_thread_pool_push(
+		     parallel_scan->thread_pool,
+		     (intptr_t *) &( jobs[ job_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push job: %" PRIu32 " onto queue.",
+			 function,
+			 job_index );
+
+			result = -1;
+
+			break;
+		}
+	}
+	number_of_pushed_jobs = job_index;
+
+	if( libcthreads_mutex_grab(
+	     parallel_scan->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		goto on_error;
+	}
+	/* Jobs that could not be pushed will never complete
+	 */
+	parallel_scan->number_of_pending_jobs -= (int) ( number_of_segments - number_of_pushed_jobs );
+
+	while( parallel_scan->number_of_pending_jobs > 0 )
+	{
+		if( libcthreads_condition_wait(
+		     parallel_scan->condition,
+		     parallel_scan->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to wait for condition.",
+			 function );
+
+			libcthreads_mutex_release(
+			 parallel_scan->mutex,
+			 NULL );
+
+			goto on_error;
+		}
+	}
+	jobs_completed = 1;
+
+	if( libcthreads_mutex_release(
+	     parallel_scan->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( parallel_scan->has_failed != 0 )
+	{
+		if( ( error != NULL )
+		 && ( *error == NULL ) )
+		{
+			*error               = parallel_scan->error;
+			parallel_scan->error = NULL;
+		}
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to scan segment files.",
+		 function );
+
+		result = -1;
+	}
+	if( result != 1 )
+	{
+		goto on_error;
+	}
+	for( job_index = 0;
+	     job_index < number_of_segments;
+	     job_index++ )
+	{
+		segment_files[ job_index ] = jobs[ job_index ].segment_file;
+	}
+	memory_free(
+	 jobs );
+
+	return( 1 );
+
+on_error:
+	/* The jobs cannot be freed while pushed jobs might still be pending,
+	 * joining the thread pool waits for the queued jobs to complete.
+	 * The parallel scan cannot be used for another scan after this
+	 */
+	if( ( number_of_pushed_jobs > 0 )
+	 && ( jobs_completed == 0 ) )
+	{
+		if( libcthreads_thread_pool_join(
+		     &( parallel_scan->thread_pool ),
+		     NULL ) != 1 )
+		{
+			/* The jobs are leaked since they might still be referenced
+			 */
+			return( -1 );
+		}
+		parallel_scan->number_of_pending_jobs = 0;
+	}
+	for( job_index = 0;
+	     job_index < number_of_segments;
+	     job_index++ )
+	{
+		if( jobs[ job_index ].segment_file != NULL )
+		{
+			libewf_segment_file_free(
+			 &( jobs[ job_index ].segment_file ),
+			 NULL );
+		}
+		if( jobs[ job_index ].file_io_handle != NULL )
+		{
+			libbfio_handle_free(
+			 &( jobs[ job_index ].file_io_handle ),
+			 NULL );
+		}
+	}
+	memory_free(
+	 jobs );
+
+	return( -1 );
+}
+
+/* Scans the segment file of a job
+ * Callback function for the thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_parallel_scan_process_job(
+     libewf_parallel_scan_job_t *job,
+     libewf_parallel_scan_t *parallel_scan )
+{
+	libbfio_pool_t *file_io_pool = NULL;
+	libcerror_error_t *error     = NULL;
+	static char *function        = "libewf_parallel_scan_process_job";
+	int result                   = 1;
+
+	if( ( job == NULL )
+	 || ( parallel_scan == NULL ) )
+	{
+		return( -1 );
+	}
+	/* A file IO pool with only the file IO handle of the job at the entry of
+	 * the segment file ensures the sections and chunk groups refer to
+	 * the file IO pool entry of the segment file. The pool only needs to
+	 * contain the entries up to that of the segment file
+	 */
+	if( libbfio_pool_initialize(
+	     &file_io_pool,
+	     job->file_io_pool_entry + 1,
+	     LIBBFIO_POOL_UNLIMITED_NUMBER_OF_OPEN_HANDLES,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO pool.",
+		 function );
+
+		result = -1;
+	}
+	if( result == 1 )
+	{
+		if( libbfio_pool_set_handle(
+		     file_io_pool,
+		     job->file_io_pool_entry,
+		     job->file_io_handle,
+		     LIBBFIO_OPEN_READ,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set file IO handle: %d in pool.",
+			 function,
+			 job->file_io_pool_entry );
+
+			result = -1;
+		}
+		else
+		{
+			/* The file IO handle is now managed by the file IO pool
+			 */
+			job->file_io_handle = NULL;
+		}
+	}
+	if( result == 1 )
+	{
+		if( libewf_segment_file_initialize(
+		     &( job->segment_file ),
+		     parallel_scan->io_handle,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create segment file.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( result == 1 )
+	{
+		if( libewf_segment_file_scan(
+		     job->segment_file,
+		     file_io_pool,
+		     job->file_io_pool_entry,
+		     job->segment_file_size,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to scan segment file: %" PRIu32 ".",
+			 function,
+			 job->segment_number );
+
+			result = -1;
+		}
+	}
+	if( file_io_pool != NULL )
+	{
+		if( libbfio_pool_close_all(
+		     file_io_pool,
+		     NULL ) != 0 )
+		{
+			result = -1;
+		}
+		if( libbfio_pool_free(
+		     &file_io_pool,
+		     NULL ) != 1 )
+		{
+			result = -1;
+		}
+	}
+	/* The job must always be marked as completed otherwise the scan waits indefinitely
+	 */
+	libcthreads_mutex_grab(
+	 parallel_scan->mutex,
+	 NULL );
+
+	if( ( result != 1 )
+	 && ( parallel_scan->has_failed == 0 ) )
+	{
+		parallel_scan->error      = error;
+		parallel_scan->has_failed = 1;
+
+		error = NULL;
+	}
+	parallel_scan->number_of_pending_jobs -= 1;
+
+	if( parallel_scan->number_of_pending_jobs == 0 )
+	{
+		libcthreads_condition_broadcast(
+		 parallel_scan->condition,
+		 NULL );
+	}
+	libcthreads_mutex_release(
+	 parallel_scan->mutex,
+	 NULL );
+
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( result );
+}
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
@@ -0,0 +1,133 @@
+/*
+ * Parallel segment file scan functions
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_PARALLEL_SCAN_H )
+#define _LIBEWF_PARALLEL_SCAN_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_io_handle.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+#include "libewf_segment_file.h"
+#include "libewf_segment_table.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+typedef struct libewf_parallel_scan libewf_parallel_scan_t;
+
+struct libewf_parallel_scan
+{
+	/* The IO handle
+	 */
+	libewf_io_handle_t *io_handle;
+
+	/* The thread pool
+	 */
+	libcthreads_thread_pool_t *thread_pool;
+
+	/* The number of jobs that have not completed
+	 */
+	int number_of_pending_jobs;
+
+	/* The error of the first job that failed
+	 */
+	libcerror_error_t *error;
+
+	/* Value to indicate a job failed
+	 */
+	uint8_t has_failed;
+
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The condition signalled when all jobs have completed
+	 */
+	libcthreads_condition_t *condition;
+};
+
+typedef struct libewf_parallel_scan_job libewf_parallel_scan_job_t;
+
+struct libewf_parallel_scan_job
+{
+	/* The parallel scan
+	 */
+	libewf_parallel_scan_t *parallel_scan;
+
+	/* The segment number
+	 */
+	uint32_t segment_number;
+
+	/* The file IO handle used to scan the segment file
+	 */
+	libbfio_handle_t *file_io_handle;
+
+	/* The file IO pool entry of the segment file
+	 */
+	int file_io_pool_entry;
+
+	/* The segment file size
+	 */
+	size64_t segment_file_size;
+
+	/* The scanned segment file
+	 */
+	libewf_segment_file_t *segment_file;
+};
+
+int libewf_parallel_scan_initialize(
+     libewf_parallel_scan_t **parallel_scan,
+     libewf_io_handle_t *io_handle,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+int libewf_parallel_scan_free(
+     libewf_parallel_scan_t **parallel_scan,
+     libcerror_error_t **error );
+
+int libewf_parallel_scan_scan_segment_files(
+     libewf_parallel_scan_t *parallel_scan,
+     libbfio_pool_t *file_io_pool,
+     libewf_segment_table_t *segment_table,
+     uint32_t first_segment_number,
+     uint32_t number_of_segments,
+     libewf_segment_file_t **segment_files,
+     libcerror_error_t **error );
+
+int libewf_parallel_scan_process_job(
+     libewf_parallel_scan_job_t *job,
+     libewf_parallel_scan_t *parallel_scan );
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_PARALLEL_SCAN_H ) */
+
@@ -0,0 +1,863 @@
+/*
+ * Parallel write functions
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_chunk_data.h"
+#include "libewf_deflate.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+#include "libewf_parallel_write.h"
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+/* Creates a parallel write
+ * Make sure the value parallel_write is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_parallel_write_initialize(
+     libewf_parallel_write_t **parallel_write,
+     int number_of_threads,
+     int maximum_number_of_chunks,
+     int (*callback_function)(
+            libewf_chunk_data_t *chunk_data,
+            libewf_deflate_encoder_t **deflate_encoder,
+            void *arguments,
+            libcerror_error_t **error ),
+     void *callback_function_arguments,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_parallel_write_initialize";
+
+	if( parallel_write == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid parallel write.",
+		 function );
+
+		return( -1 );
+	}
+	if( *parallel_write != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid parallel write value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_threads <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_chunks <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of chunks value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( callback_function == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid callback function.",
+		 function );
+
+		return( -1 );
+	}
+	*parallel_write = memory_allocate_structure(
+	                   libewf_parallel_write_t );
+
+	if( *parallel_write == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create parallel write.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *parallel_write,
+	     0,
+	     sizeof( libewf_parallel_write_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear parallel write.",
+		 function );
+
+		memory_free(
+		 *parallel_write );
+
+		*parallel_write = NULL;
+
+		return( -1 );
+	}
+	( *parallel_write )->number_of_threads           = number_of_threads;
+	( *parallel_write )->maximum_number_of_chunks    = maximum_number_of_chunks;
+	( *parallel_write )->callback_function           = callback_function;
+	( *parallel_write )->callback_function_arguments = callback_function_arguments;
+
+	/* Every pack thread reuses a deflate encoder, which is created on first use
+	 */
+	( *parallel_write )->deflate_encoders = (libewf_deflate_encoder_t **) memory_allocate(
+	                                         sizeof( libewf_deflate_encoder_t * ) * number_of_threads );
+
+	if( ( *parallel_write )->deflate_encoders == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create deflate encoders.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *parallel_write )->deflate_encoders,
+	     0,
+	     sizeof( libewf_deflate_encoder_t * ) * number_of_threads ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear deflate encoders.",
+		 function );
+
+		goto on_error;
+	}
+	( *parallel_write )->number_of_deflate_encoders = number_of_threads;
+
+	if( libcthreads_mutex_initialize(
+	     &( ( *parallel_write )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *parallel_write )->condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize condition.",
+		 function );
+
+		goto on_error;
+	}
+	/* The queue can hold every chunk that can be queued, hence pushing never blocks
+	 */
+	if( libcthreads_thread_pool_create(
+	     &( ( *parallel_write )->thread_pool ),
+	     NULL,
+	     number_of_threads,
+	     maximum_number_of_chunks,
+	     (int (*)(intptr_t *, void *)) &libewf_parallel_write_process_job,
+	     (void *) *parallel_write,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create thread pool.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *parallel_write != NULL )
+	{
+		if( ( *parallel_write )->condition != NULL )
+		{
+			libcthreads_condition_free(
+			 &( ( *parallel_write )->condition ),
+			 NULL );
+		}
+		if( ( *parallel_write )->mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *parallel_write )->mutex ),
+			 NULL );
+		}
+		if( ( *parallel_write )->deflate_encoders != NULL )
+		{
+			memory_free(
+			 ( *parallel_write )->deflate_encoders );
+		}
+		memory_free(
+		 *parallel_write );
+
+		*parallel_write = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a parallel write
+ * Chunks that are queued but not yet retrieved are discarded
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_parallel_write_free(
+     libewf_parallel_write_t **parallel_write,
+     libcerror_error_t **error )
+{
+	libewf_parallel_write_job_t *job = NULL;
+	static char *function            = "libewf_parallel_write_free";
+	int encoder_index                = 0;
+	int result                       = 1;
+
+	if( parallel_write == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid parallel write.",
+		 function );
+
+		return( -1 );
+	}
+	if( *parallel_write != NULL )
+	{
+		/* Joining the thread pool waits for the remaining queued chunks to be packed
+		 */
+		if( libcthreads_thread_pool_join(
+		     &( ( *parallel_write )->thread_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join thread pool.",
+			 function );
+
+			result = -1;
+		}
+		while( ( *parallel_write )->first_job != NULL )
+		{
+			job = ( *parallel_write )->first_job;
+
+			( *parallel_write )->first_job = job->next_job;
+
+			if( job->chunk_data != NULL )
+			{
+				libewf_chunk_data_free(
+				 &( job->chunk_data ),
+				 NULL );
+			}
+			if( job->error != NULL )
+			{
+				libcerror_error_free(
+				 &( job->error ) );
+			}
+			memory_free(
+			 job );
+		}
+		if( ( *parallel_write )->deflate_encoders != NULL )
+		{
+			for( encoder_index = 0;
+			     encoder_index < ( *parallel_write )->number_of_threads;
+			     encoder_index++ )
+			{
+				if( ( *parallel_write )->deflate_encoders[ encoder_index ] == NULL )
+				{
+					continue;
+				}
+				if( libewf_deflate_encoder_free(
+				     &( ( *parallel_write )->deflate_encoders[ encoder_index ] ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free deflate encoder: %d.",
+					 function,
+					 encoder_index );
+
+					result = -1;
+				}
+			}
+			memory_free(
+			 ( *parallel_write )->deflate_encoders );
+		}
+		if( libcthreads_condition_free(
+		     &( ( *parallel_write )->condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *parallel_write )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *parallel_write );
+
+		*parallel_write = NULL;
+	}
+	return( result );
+}
+
+/* Queues a chunk to be packed
+ * The parallel write takes over the management of the chunk data when the chunk was queued
+ * Returns 1 if successful, 0 if the maximum number of chunks is queued or -1 on error
+ */
+int libewf_parallel_write_push_chunk(
+     libewf_parallel_write_t *parallel_write,
+     uint64_t chunk_index,
+     libewf_chunk_data_t *chunk_data,
+     size_t input_data_size,
+     libcerror_error_t **error )
+{
+	libewf_parallel_write_job_t *job = NULL;
+	static char *function            = "libewf_parallel_write_push_chunk";
+	int result                       = 1;
+
+	if( parallel_write == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid parallel write.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     parallel_write->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( parallel_write->number_of_queued_chunks >= parallel_write->maximum_number_of_chunks )
+	{
+		result = 0;
+	}
+	else if( ( parallel_write->last_job != NULL )
+	      && ( chunk_index != ( parallel_write->last_job->chunk_index + 1 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk index: %" PRIu64 " value out of bounds.",
+		 function,
+		 chunk_index );
+
+		result = -1;
+	}
+	else
+	{
+		job = memory_allocate_structure(
+		       libewf_parallel_write_job_t );
+
+		if( job == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create job.",
+			 function );
+
+			result = -1;
+		}
+		else if( memory_set(
+		          job,
+		          0,
+		          sizeof( libewf_parallel_write_job_t ) ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear job.",
+			 function );
+
+			memory_free(
+			 job );
+
+			result = -1;
+		}
+	}
+	if( job != NULL )
+	{
+		job->parallel_write  = parallel_write;
+		job->chunk_index     = chunk_index;
+		job->chunk_data      = chunk_data;
+		job->input_data_size = input_data_size;
+
+		if( libcthreads_thread_pool_push(
+		     parallel_write->thread_pool,
+		     (intptr_t *) job,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push chunk: %" PRIu64 " onto queue.",
+			 function,
+			 chunk_index );
+
+			memory_free(
+			 job );
+
+			result = -1;
+		}
+		else
+		{
+			if( parallel_write->last_job == NULL )
+			{
+				parallel_write->first_job = job;
+			}
+			else
+			{
+				parallel_write->last_job->next_job = job;
+			}
+			parallel_write->last_job = job;
+
+			parallel_write->number_of_queued_chunks += 1;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     parallel_write->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Packs a queued chunk
+ * Callback function for the thread pool
+ * Errors are retained and returned when the chunk is retrieved
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_parallel_write_process_job(
+     libewf_parallel_write_job_t *job,
+     libewf_parallel_write_t *parallel_write )
+{
+	libcerror_error_t *error                  = NULL;
+	libewf_deflate_encoder_t *deflate_encoder = NULL;
+	static char *function                     = "libewf_parallel_write_process_job";
+	int result                                = 1;
+
+	if( job == NULL )
+	{
+		return( -1 );
+	}
+	if( parallel_write == NULL )
+	{
+		return( -1 );
+	}
+	/* There are never more jobs processed concurrently than there are deflate encoders
+	 */
+	if( libcthreads_mutex_grab(
+	     parallel_write->mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		if( parallel_write->number_of_deflate_encoders > 0 )
+		{
+			parallel_write->number_of_deflate_encoders -= 1;
+
+			deflate_encoder = parallel_write->deflate_encoders[ parallel_write->number_of_deflate_encoders ];
+
+			parallel_write->deflate_encoders[ parallel_write->number_of_deflate_encoders ] = NULL;
+		}
+		if( libcthreads_mutex_release(
+		     parallel_write->mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( result == 1 )
+	{
+		result = parallel_write->callback_function(
+		          job->chunk_data,
+		          &deflate_encoder,
+		          parallel_write->callback_function_arguments,
+		          &error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to pack chunk: %" PRIu64 " data.",
+			 function,
+			 job->chunk_index );
+
+			result = -1;
+		}
+	}
+	/* The job must always be marked as packed otherwise the writer waits indefinitely
+	 * If the mutex cannot be grabbed the job is left untouched, the writer then fails
+	 * to grab the same mutex instead of waiting for the job
+	 */
+	if( libcthreads_mutex_grab(
+	     parallel_write->mutex,
+	     NULL ) != 1 )
+	{
+		if( error != NULL )
+		{
+			libcerror_error_free(
+			 &error );
+		}
+		if( deflate_encoder != NULL )
+		{
+			libewf_deflate_encoder_free(
+			 &deflate_encoder,
+			 NULL );
+		}
+		return( -1 );
+	}
+	job->error     = error;
+	job->is_packed = 1;
+
+	if( ( deflate_encoder != NULL )
+	 && ( parallel_write->number_of_deflate_encoders < parallel_write->number_of_threads ) )
+	{
+		parallel_write->deflate_encoders[ parallel_write->number_of_deflate_encoders ] = deflate_encoder;
+
+		parallel_write->number_of_deflate_encoders += 1;
+
+		deflate_encoder = NULL;
+	}
+	if( libcthreads_condition_broadcast(
+	     parallel_write->condition,
+	     NULL ) != 1 )
+	{
+		result = -1;
+	}
+	if( libcthreads_mutex_release(
+	     parallel_write->mutex,
+	     NULL ) != 1 )
+	{
+		result = -1;
+	}
+	if( deflate_encoder != NULL )
+	{
+		libewf_deflate_encoder_free(
+		 &deflate_encoder,
+		 NULL );
+	}
+	return( result );
+}
+
+/* Retrieves the first queued chunk once it is packed
+ * The chunks are retrieved in chunk order and the management of the chunk data
+ * is passed to the caller
+ * Returns 1 if successful, 0 if no packed chunk is available or -1 on error
+ */
+int libewf_parallel_write_get_packed_chunk(
+     libewf_parallel_write_t *parallel_write,
+     uint8_t wait_for_chunk,
+     uint64_t *chunk_index,
+     libewf_chunk_data_t **chunk_data,
+     size_t *input_data_size,
+     libcerror_error_t **error )
+{
+	libewf_parallel_write_job_t *job = NULL;
+	static char *function            = "libewf_parallel_write_get_packed_chunk";
+	int result                       = 1;
+
+	if( parallel_write == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid parallel write.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk index.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( input_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid input data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     parallel_write->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	job = parallel_write->first_job;
+
+	if( job != NULL )
+	{
+		/* Chunks are packed out of order but are retrieved in order
+		 */
+		while( ( wait_for_chunk != 0 )
+		    && ( job->is_packed == 0 ) )
+		{
+			if( libcthreads_condition_wait(
+			     parallel_write->condition,
+			     parallel_write->mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to wait for condition.",
+				 function );
+
+				libcthreads_mutex_release(
+				 parallel_write->mutex,
+				 NULL );
+
+				return( -1 );
+			}
+		}
+		if( job->is_packed == 0 )
+		{
+			job = NULL;
+		}
+	}
+	if( job != NULL )
+	{
+		parallel_write->first_job = job->next_job;
+
+		if( parallel_write->first_job == NULL )
+		{
+			parallel_write->last_job = NULL;
+		}
+		parallel_write->number_of_queued_chunks -= 1;
+	}
+	if( libcthreads_mutex_release(
+	     parallel_write->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		result = -1;
+	}
+	if( result != 1 )
+	{
+		if( job != NULL )
+		{
+			libewf_chunk_data_free(
+			 &( job->chunk_data ),
+			 NULL );
+
+			if( job->error != NULL )
+			{
+				libcerror_error_free(
+				 &( job->error ) );
+			}
+			memory_free(
+			 job );
+		}
+		return( -1 );
+	}
+	if( job == NULL )
+	{
+		return( 0 );
+	}
+	if( job->error != NULL )
+	{
+		if( ( error != NULL )
+		 && ( *error == NULL ) )
+		{
+			*error     = job->error;
+			job->error = NULL;
+		}
+		else
+		{
+			libcerror_error_free(
+			 &( job->error ) );
+		}
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to pack chunk: %" PRIu64 ".",
+		 function,
+		 job->chunk_index );
+
+		result = -1;
+	}
+	if( result == 1 )
+	{
+		*chunk_index     = job->chunk_index;
+		*chunk_data      = job->chunk_data;
+		*input_data_size = job->input_data_size;
+	}
+	else
+	{
+		libewf_chunk_data_free(
+		 &( job->chunk_data ),
+		 NULL );
+	}
+	memory_free(
+	 job );
+
+	return( result );
+}
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
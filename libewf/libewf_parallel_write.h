@@ -0,0 +1,171 @@
+/*
+ * Parallel write functions
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_PARALLEL_WRITE_H )
+#define _LIBEWF_PARALLEL_WRITE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_chunk_data.h"
+#include "libewf_deflate.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+typedef struct libewf_parallel_write libewf_parallel_write_t;
+
+typedef struct libewf_parallel_write_job libewf_parallel_write_job_t;
+
+struct libewf_parallel_write_job
+{
+	/* The parallel write
+	 */
+	libewf_parallel_write_t *parallel_write;
+
+	/* The chunk index
+	 */
+	uint64_t chunk_index;
+
+	/* The chunk data
+	 */
+	libewf_chunk_data_t *chunk_data;
+
+	/* The size of the chunk data before it was packed
+	 */
+	size_t input_data_size;
+
+	/* Value to indicate the chunk data was packed
+	 */
+	uint8_t is_packed;
+
+	/* The error if the chunk data could not be packed
+	 */
+	libcerror_error_t *error;
+
+	/* The next job in chunk order
+	 */
+	libewf_parallel_write_job_t *next_job;
+};
+
+struct libewf_parallel_write
+{
+	/* The number of threads
+	 */
+	int number_of_threads;
+
+	/* The maximum number of queued chunks
+	 */
+	int maximum_number_of_chunks;
+
+	/* The number of queued chunks, which includes the chunks that were packed but not retrieved
+	 */
+	int number_of_queued_chunks;
+
+	/* The first queued job in chunk order
+	 */
+	libewf_parallel_write_job_t *first_job;
+
+	/* The last queued job in chunk order
+	 */
+	libewf_parallel_write_job_t *last_job;
+
+	/* The thread pool
+	 */
+	libcthreads_thread_pool_t *thread_pool;
+
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The condition signalled when a chunk was packed
+	 */
+	libcthreads_condition_t *condition;
+
+	/* The deflate encoders that are not in use by a pack thread
+	 */
+	libewf_deflate_encoder_t **deflate_encoders;
+
+	/* The number of deflate encoders that are not in use by a pack thread
+	 */
+	int number_of_deflate_encoders;
+
+	/* The function that packs chunk data
+	 */
+	int (*callback_function)(
+	       libewf_chunk_data_t *chunk_data,
+	       libewf_deflate_encoder_t **deflate_encoder,
+	       void *arguments,
+	       libcerror_error_t **error );
+
+	/* The arguments of the function that packs chunk data
+	 */
+	void *callback_function_arguments;
+};
+
+int libewf_parallel_write_initialize(
+     libewf_parallel_write_t **parallel_write,
+     int number_of_threads,
+     int maximum_number_of_chunks,
+     int (*callback_function)(
+            libewf_chunk_data_t *chunk_data,
+            libewf_deflate_encoder_t **deflate_encoder,
+            void *arguments,
+            libcerror_error_t **error ),
+     void *callback_function_arguments,
+     libcerror_error_t **error );
+
+int libewf_parallel_write_free(
+     libewf_parallel_write_t **parallel_write,
+     libcerror_error_t **error );
+
+int libewf_parallel_write_push_chunk(
+     libewf_parallel_write_t *parallel_write,
+     uint64_t chunk_index,
+     libewf_chunk_data_t *chunk_data,
+     size_t input_data_size,
+     libcerror_error_t **error );
+
+int libewf_parallel_write_process_job(
+     libewf_parallel_write_job_t *job,
+     libewf_parallel_write_t *parallel_write );
+
+int libewf_parallel_write_get_packed_chunk(
+     libewf_parallel_write_t *parallel_write,
+     uint8_t wait_for_chunk,
+     uint64_t *chunk_index,
+     libewf_chunk_data_t **chunk_data,
+     size_t *input_data_size,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_PARALLEL_WRITE_H ) */
+
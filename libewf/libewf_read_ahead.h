@@ -0,0 +1,116 @@
+/*
+ * Read-ahead functions
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_READ_AHEAD_H )
+#define _LIBEWF_READ_AHEAD_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+typedef struct libewf_read_ahead libewf_read_ahead_t;
+
+struct libewf_read_ahead
+{
+	/* The maximum number of chunks to read ahead
+	 */
+	int maximum_number_of_chunks;
+
+	/* The number of queued chunks
+	 */
+	int number_of_queued_chunks;
+
+	/* Value to indicate a chunk was read
+	 */
+	uint8_t chunk_was_read;
+
+	/* Value to indicate queued chunks should no longer be read
+	 */
+	uint8_t abort;
+
+	/* The index of the last chunk that was read
+	 */
+	uint64_t last_chunk_index;
+
+	/* The index of the next chunk to queue
+	 */
+	uint64_t next_chunk_index;
+
+	/* The thread pool
+	 */
+	libcthreads_thread_pool_t *thread_pool;
+
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The function that reads a chunk
+	 */
+	int (*callback_function)(
+	       uint64_t chunk_index,
+	       void *arguments );
+
+	/* The arguments of the function that reads a chunk
+	 */
+	void *callback_function_arguments;
+};
+
+int libewf_read_ahead_initialize(
+     libewf_read_ahead_t **read_ahead,
+     int maximum_number_of_chunks,
+     int number_of_threads,
+     int (*callback_function)(
+            uint64_t chunk_index,
+            void *arguments ),
+     void *callback_function_arguments,
+     libcerror_error_t **error );
+
+int libewf_read_ahead_free(
+     libewf_read_ahead_t **read_ahead,
+     libcerror_error_t **error );
+
+int libewf_read_ahead_queue_chunks(
+     libewf_read_ahead_t *read_ahead,
+     uint64_t first_chunk_index,
+     uint64_t last_chunk_index,
+     uint64_t number_of_chunks,
+     libcerror_error_t **error );
+
+int libewf_read_ahead_process_chunk(
+     uint64_t *chunk_index,
+     libewf_read_ahead_t *read_ahead );
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_READ_AHEAD_H ) */
+
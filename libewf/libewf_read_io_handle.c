@@ -20,6 +20,7 @@
  */
 
 #include <common.h>
+#include <memory.h>
 #include <types.h>
 
 #include "libewf_chunk_data.h"
@@ -228,3 +229,120 @@ on_error:
 	return( -1 );
 }
 
+/* Sets the compressed data of an empty block
+ * The compressed data is used to recognize chunks that only contain zero bytes without decompressing them
+ * This function is not multi-thread safe acquire the handle IO lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_io_handle_set_empty_block_compressed_data(
+     libewf_read_io_handle_t *read_io_handle,
+     const uint8_t *compressed_data,
+     size_t compressed_data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_read_io_handle_set_empty_block_compressed_data";
+
+	if( read_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( compressed_data_size == 0 )
+	 || ( compressed_data_size > (size_t) LIBEWF_MAXIMUM_EMPTY_BLOCK_COMPRESSED_DATA_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid compressed data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     read_io_handle->empty_block_compressed_data,
+	     compressed_data,
+	     compressed_data_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy empty block compressed data.",
+		 function );
+
+		read_io_handle->empty_block_compressed_data_size = 0;
+
+		return( -1 );
+	}
+	read_io_handle->empty_block_compressed_data_size = compressed_data_size;
+
+	return( 1 );
+}
+
+/* Determines if compressed data is the same as the compressed data of an empty block
+ * This function is not multi-thread safe acquire the handle IO lock before call
+ * Returns 1 if the compressed data is an empty block, 0 if not or -1 on error
+ */
+int libewf_read_io_handle_is_empty_block_compressed_data(
+     libewf_read_io_handle_t *read_io_handle,
+     const uint8_t *compressed_data,
+     size_t compressed_data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_read_io_handle_is_empty_block_compressed_data";
+
+	if( read_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( read_io_handle->empty_block_compressed_data_size == 0 )
+	 || ( read_io_handle->empty_block_compressed_data_size != compressed_data_size ) )
+	{
+		return( 0 );
+	}
+	if( memory_compare(
+	     read_io_handle->empty_block_compressed_data,
+	     compressed_data,
+	     compressed_data_size ) != 0 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
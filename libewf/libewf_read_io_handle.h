@@ -26,6 +26,7 @@
 #include <types.h>
 
 #include "libewf_chunk_data.h"
+#include "libewf_definitions.h"
 #include "libewf_io_handle.h"
 #include "libewf_libbfio.h"
 #include "libewf_libcdata.h"
@@ -65,6 +66,14 @@ struct libewf_read_io_handle
         /* The (total) number of chunks read
          */
         uint64_t number_of_chunks_read;
+
+	/* The compressed data of an empty block that was read
+	 */
+	uint8_t empty_block_compressed_data[ LIBEWF_MAXIMUM_EMPTY_BLOCK_COMPRESSED_DATA_SIZE ];
+
+	/* The size of the compressed data of an empty block that was read
+	 */
+	size_t empty_block_compressed_data_size;
 };
 
 int libewf_read_io_handle_initialize(
@@ -80,6 +89,18 @@ int libewf_read_io_handle_clone(
      libewf_read_io_handle_t *source_read_io_handle,
      libcerror_error_t **error );
 
+int libewf_read_io_handle_set_empty_block_compressed_data(
+     libewf_read_io_handle_t *read_io_handle,
+     const uint8_t *compressed_data,
+     size_t compressed_data_size,
+     libcerror_error_t **error );
+
+int libewf_read_io_handle_is_empty_block_compressed_data(
+     libewf_read_io_handle_t *read_io_handle,
+     const uint8_t *compressed_data,
+     size_t compressed_data_size,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
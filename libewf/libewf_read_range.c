@@ -0,0 +1,378 @@
+/*
+ * Read range functions
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "libewf_libcerror.h"
+#include "libewf_read_range.h"
+
+/* Compares two read ranges by chunk index and offset in the chunk data
+ * Callback function for qsort
+ * Returns -1 if the first read range comes before the second, 1 if after or 0 if equal
+ */
+int libewf_read_range_compare(
+     const void *first_read_range,
+     const void *second_read_range )
+{
+	const libewf_read_range_t *first_range  = (const libewf_read_range_t *) first_read_range;
+	const libewf_read_range_t *second_range = (const libewf_read_range_t *) second_read_range;
+
+	if( first_range->chunk_index < second_range->chunk_index )
+	{
+		return( -1 );
+	}
+	else if( first_range->chunk_index > second_range->chunk_index )
+	{
+		return( 1 );
+	}
+	if( first_range->chunk_data_offset < second_range->chunk_data_offset )
+	{
+		return( -1 );
+	}
+	else if( first_range->chunk_data_offset > second_range->chunk_data_offset )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Splits buffers into read ranges that each span (part of) a single chunk
+ * The buffers are limited to the media size and the read ranges are sorted by chunk index
+ * so that the read ranges of the same chunk are stored consecutively
+ * Make sure the value read_ranges is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_range_split_buffers(
+     libewf_read_range_t **read_ranges,
+     int *number_of_read_ranges,
+     void **buffers,
+     size_t *buffer_sizes,
+     off64_t *offsets,
+     int number_of_buffers,
+     size64_t media_size,
+     size32_t chunk_size,
+     libcerror_error_t **error )
+{
+	libewf_read_range_t *safe_read_ranges = NULL;
+	static char *function                 = "libewf_read_range_split_buffers";
+	size_t buffer_offset                  = 0;
+	size_t buffer_size                    = 0;
+	size_t chunk_data_offset              = 0;
+	size_t read_size                      = 0;
+	uint64_t chunk_index                  = 0;
+	uint64_t safe_number_of_read_ranges   = 0;
+	int buffer_index                      = 0;
+	int read_range_index                  = 0;
+
+	if( read_ranges == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read ranges.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_ranges != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid read ranges value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_read_ranges == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of read ranges.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffers.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_sizes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer sizes.",
+		 function );
+
+		return( -1 );
+	}
+	if( offsets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offsets.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_buffers < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of buffers value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid chunk size value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	/* Determine the number of read ranges
+	 */
+	for( buffer_index = 0;
+	     buffer_index < number_of_buffers;
+	     buffer_index++ )
+	{
+		if( buffers[ buffer_index ] == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid buffer: %d.",
+			 function,
+			 buffer_index );
+
+			return( -1 );
+		}
+		if( buffer_sizes[ buffer_index ] > (size_t) SSIZE_MAX )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid buffer: %d size value exceeds maximum.",
+			 function,
+			 buffer_index );
+
+			return( -1 );
+		}
+		if( offsets[ buffer_index ] < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid offset: %d value out of bounds.",
+			 function,
+			 buffer_index );
+
+			return( -1 );
+		}
+		if( (size64_t) offsets[ buffer_index ] >= media_size )
+		{
+			continue;
+		}
+		buffer_size = buffer_sizes[ buffer_index ];
+
+		if( (size64_t) buffer_size > ( media_size - offsets[ buffer_index ] ) )
+		{
+			buffer_size = (size_t) ( media_size - offsets[ buffer_index ] );
+		}
+		if( buffer_size == 0 )
+		{
+			continue;
+		}
+		chunk_data_offset = (size_t) ( (uint64_t) offsets[ buffer_index ] % chunk_size );
+
+		safe_number_of_read_ranges += ( (uint64_t) chunk_data_offset + buffer_size + chunk_size - 1 ) / chunk_size;
+	}
+	if( ( safe_number_of_read_ranges > (uint64_t) INT_MAX )
+	 || ( safe_number_of_read_ranges > (uint64_t) ( (size_t) SSIZE_MAX / sizeof( libewf_read_range_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of read ranges value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( safe_number_of_read_ranges > 0 )
+	{
+		safe_read_ranges = (libewf_read_range_t *) memory_allocate(
+		                                            sizeof( libewf_read_range_t ) * (size_t) safe_number_of_read_ranges );
+
+		if( safe_read_ranges == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create read ranges.",
+			 function );
+
+			return( -1 );
+		}
+		for( buffer_index = 0;
+		     buffer_index < number_of_buffers;
+		     buffer_index++ )
+		{
+			if( (size64_t) offsets[ buffer_index ] >= media_size )
+			{
+				continue;
+			}
+			buffer_size = buffer_sizes[ buffer_index ];
+
+			if( (size64_t) buffer_size > ( media_size - offsets[ buffer_index ] ) )
+			{
+				buffer_size = (size_t) ( media_size - offsets[ buffer_index ] );
+			}
+			chunk_index       = (uint64_t) offsets[ buffer_index ] / chunk_size;
+			chunk_data_offset = (size_t) ( (uint64_t) offsets[ buffer_index ] % chunk_size );
+			buffer_offset     = 0;
+
+			while( buffer_offset < buffer_size )
+			{
+				read_size = (size_t) chunk_size - chunk_data_offset;
+
+				if( read_size > ( buffer_size - buffer_offset ) )
+				{
+					read_size = buffer_size - buffer_offset;
+				}
+				safe_read_ranges[ read_range_index ].chunk_index       = chunk_index;
+				safe_read_ranges[ read_range_index ].chunk_data_offset = chunk_data_offset;
+				safe_read_ranges[ read_range_index ].buffer            = &( ( (uint8_t *) buffers[ buffer_index ] )[ buffer_offset ] );
+				safe_read_ranges[ read_range_index ].buffer_size       = read_size;
+				safe_read_ranges[ read_range_index ].buffer_index      = buffer_index;
+
+				read_range_index++;
+
+				buffer_offset    += read_size;
+				chunk_index      += 1;
+				chunk_data_offset = 0;
+			}
+		}
+		qsort(
+		 safe_read_ranges,
+		 (size_t) safe_number_of_read_ranges,
+		 sizeof( libewf_read_range_t ),
+		 &libewf_read_range_compare );
+	}
+	*read_ranges           = safe_read_ranges;
+	*number_of_read_ranges = (int) safe_number_of_read_ranges;
+
+	return( 1 );
+}
+
+/* Retrieves the number of consecutive read ranges, starting at a specific read range, that span the same chunk
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_range_get_number_of_ranges_in_chunk(
+     libewf_read_range_t *read_ranges,
+     int number_of_read_ranges,
+     int read_range_index,
+     int *number_of_ranges_in_chunk,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_read_range_get_number_of_ranges_in_chunk";
+	uint64_t chunk_index  = 0;
+	int last_range_index  = 0;
+
+	if( read_ranges == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read ranges.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( read_range_index < 0 )
+	 || ( read_range_index >= number_of_read_ranges ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid read range index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_ranges_in_chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of ranges in chunk.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_index      = read_ranges[ read_range_index ].chunk_index;
+	last_range_index = read_range_index + 1;
+
+	while( ( last_range_index < number_of_read_ranges )
+	    && ( read_ranges[ last_range_index ].chunk_index == chunk_index ) )
+	{
+		last_range_index++;
+	}
+	*number_of_ranges_in_chunk = last_range_index - read_range_index;
+
+	return( 1 );
+}
+
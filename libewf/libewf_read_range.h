@@ -0,0 +1,88 @@
+/*
+ * Read range functions
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_READ_RANGE_H )
+#define _LIBEWF_READ_RANGE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_read_range libewf_read_range_t;
+
+/* A read range is the part of a buffer that is read from a single chunk
+ */
+struct libewf_read_range
+{
+	/* The chunk index
+	 */
+	uint64_t chunk_index;
+
+	/* The offset in the chunk data
+	 */
+	size_t chunk_data_offset;
+
+	/* The buffer
+	 */
+	uint8_t *buffer;
+
+	/* The size of the buffer
+	 */
+	size_t buffer_size;
+
+	/* The index of the buffer the range is part of
+	 */
+	int buffer_index;
+};
+
+int libewf_read_range_compare(
+     const void *first_read_range,
+     const void *second_read_range );
+
+int libewf_read_range_split_buffers(
+     libewf_read_range_t **read_ranges,
+     int *number_of_read_ranges,
+     void **buffers,
+     size_t *buffer_sizes,
+     off64_t *offsets,
+     int number_of_buffers,
+     size64_t media_size,
+     size32_t chunk_size,
+     libcerror_error_t **error );
+
+int libewf_read_range_get_number_of_ranges_in_chunk(
+     libewf_read_range_t *read_ranges,
+     int number_of_read_ranges,
+     int read_range_index,
+     int *number_of_ranges_in_chunk,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_READ_RANGE_H ) */
+
@@ -2034,8 +2034,10 @@ ssize_t libewf_section_write_compressed_string(
 	          &compressed_string_size,
 	          compression_method,
 	          compression_level,
+	          0,
 	          uncompressed_string,
 	          uncompressed_string_size,
+	          NULL,
 	          error );
 
 	if( result == 0 )
@@ -2097,8 +2099,10 @@ ssize_t libewf_section_write_compressed_string(
 		          &compressed_string_size,
 		          compression_method,
 		          compression_level,
+		          0,
 		          uncompressed_string,
 		          uncompressed_string_size,
+		          NULL,
 		          error );
 	}
 	if( result != 1 )
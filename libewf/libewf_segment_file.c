@@ -54,6 +54,7 @@
 #include "libewf_segment_file.h"
 #include "libewf_segment_table.h"
 #include "libewf_single_files.h"
+#include "libewf_statistics.h"
 #include "libewf_unused.h"
 
 #include "ewf_file_header.h"
@@ -4163,6 +4164,14 @@ ssize_t libewf_segment_file_write_chunk_data(
 	}
 	segment_file->current_offset += write_count;
 
+	LIBEWF_STATISTICS_ADD(
+	 segment_file->io_handle->statistics.bytes_written,
+	 write_count );
+
+	LIBEWF_STATISTICS_ADD(
+	 segment_file->io_handle->statistics.number_of_writes,
+	 1 );
+
 	return( write_count );
 }
 
@@ -5877,62 +5886,54 @@ on_error:
 	return( -1 );
 }
 
-/* Reads a segment file
- * Callback function for the segment files list
+/* Scans a segment file for its sections and chunk groups
+ * The tables are only read when the chunk size is known
  * Returns 1 if successful or -1 on error
  */
-int libewf_segment_file_read_element_data(
-     libewf_io_handle_t *io_handle,
+int libewf_segment_file_scan(
+     libewf_segment_file_t *segment_file,
      libbfio_pool_t *file_io_pool,
-     libfdata_list_element_t *element,
-     libfcache_cache_t *segment_file_cache,
      int file_io_pool_entry,
-     off64_t segment_file_offset,
      size64_t segment_file_size,
-     uint32_t element_flags LIBEWF_ATTRIBUTE_UNUSED,
-     uint8_t read_flags LIBEWF_ATTRIBUTE_UNUSED,
      libcerror_error_t **error )
 {
-	libfcache_cache_t *sections_cache   = NULL;
-	libewf_section_t *section           = NULL;
-	libewf_segment_file_t *segment_file = NULL;
-	static char *function               = "libewf_segment_file_read_element_data";
-	off64_t section_data_offset         = 0;
-	ssize_t read_count                  = 0;
-	int element_index                   = 0;
-	int last_section                    = 0;
-	int number_of_sections              = 0;
-	int result                          = 0;
-	int section_index                   = 0;
-
-	LIBEWF_UNREFERENCED_PARAMETER( element_flags )
-	LIBEWF_UNREFERENCED_PARAMETER( read_flags )
+	libfcache_cache_t *sections_cache = NULL;
+	libewf_io_handle_t *io_handle     = NULL;
+	libewf_section_t *section         = NULL;
+	static char *function             = "libewf_segment_file_scan";
+	off64_t section_data_offset       = 0;
+	off64_t segment_file_offset       = 0;
+	ssize_t read_count                = 0;
+	int element_index                 = 0;
+	int last_section                  = 0;
+	int number_of_sections            = 0;
+	int result                        = 0;
+	int section_index                 = 0;
 
-	if( io_handle == NULL )
+	if( segment_file == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid IO handle.",
+		 "%s: invalid segment file.",
 		 function );
 
 		return( -1 );
 	}
-	if( libewf_segment_file_initialize(
-	     &segment_file,
-	     io_handle,
-	     error ) != 1 )
+	if( segment_file->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create segment file.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid segment file - missing IO handle.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
+	io_handle = segment_file->io_handle;
+
 	read_count = libewf_segment_file_read_file_header(
 		      segment_file,
 		      file_io_pool,
@@ -6065,6 +6066,29 @@ int libewf_segment_file_read_element_data(
 		}
 		segment_file->current_offset = segment_file_offset + read_count;
 
+		if( ( section->type != LIBEWF_SECTION_TYPE_SECTOR_DATA )
+		 && ( section->type != LIBEWF_SECTION_TYPE_SECTOR_TABLE )
+		 && ( section->type != LIBEWF_SECTION_TYPE_NEXT )
+		 && ( section->type != LIBEWF_SECTION_TYPE_DONE ) )
+		{
+			/* The EWF version 1 table2 and data sections repeat information
+			 * of the table and volume sections
+			 */
+			if( ( segment_file->major_version != 1 )
+			 || ( ( ( section->type_string_length != 6 )
+			   ||   ( memory_compare(
+			          (void *) section->type_string,
+			          (void *) "table2",
+			          6 ) != 0 ) )
+			  && ( ( section->type_string_length != 4 )
+			   ||  ( memory_compare(
+			          (void *) section->type_string,
+			          (void *) "data",
+			          4 ) != 0 ) ) ) )
+			{
+				segment_file->flags |= LIBEWF_SEGMENT_FILE_FLAG_HAS_METADATA_SECTIONS;
+			}
+		}
 		if( segment_file->major_version == 1 )
 		{
 			if( section->type == LIBEWF_SECTION_TYPE_NEXT )
@@ -6237,7 +6261,10 @@ int libewf_segment_file_read_element_data(
 			                                               - segment_file->device_information_section_index;
 		}
 	}
-	if( io_handle->chunk_size != 0 )
+	/* The chunk groups are not read when only the metadata is read
+	 */
+	if( ( io_handle->chunk_size != 0 )
+	 && ( ( io_handle->access_flags & LIBEWF_ACCESS_FLAG_METADATA ) == 0 ) )
 	{
 		if( libfcache_cache_initialize(
 		     &sections_cache,
@@ -6424,6 +6451,89 @@ int libewf_segment_file_read_element_data(
 			goto on_error;
 		}
 	}
+
+	return( 1 );
+
+on_error:
+	if( sections_cache != NULL )
+	{
+		libfcache_cache_free(
+		 &sections_cache,
+		 NULL );
+	}
+	if( section != NULL )
+	{
+		libewf_section_free(
+		 &section,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads a segment file
+ * Callback function for the segment files list
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_file_read_element_data(
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     libfdata_list_element_t *element,
+     libfcache_cache_t *segment_file_cache,
+     int file_io_pool_entry,
+     off64_t segment_file_offset LIBEWF_ATTRIBUTE_UNUSED,
+     size64_t segment_file_size,
+     uint32_t element_flags LIBEWF_ATTRIBUTE_UNUSED,
+     uint8_t read_flags LIBEWF_ATTRIBUTE_UNUSED,
+     libcerror_error_t **error )
+{
+	libewf_segment_file_t *segment_file = NULL;
+	static char *function               = "libewf_segment_file_read_element_data";
+
+	LIBEWF_UNREFERENCED_PARAMETER( segment_file_offset )
+	LIBEWF_UNREFERENCED_PARAMETER( element_flags )
+	LIBEWF_UNREFERENCED_PARAMETER( read_flags )
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_segment_file_initialize(
+	     &segment_file,
+	     io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create segment file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_segment_file_scan(
+	     segment_file,
+	     file_io_pool,
+	     file_io_pool_entry,
+	     segment_file_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to scan segment file.",
+		 function );
+
+		goto on_error;
+	}
 	if( libfdata_list_element_set_element_value(
 	     element,
 	     (intptr_t *) file_io_pool,
@@ -6445,18 +6555,6 @@ int libewf_segment_file_read_element_data(
 	return( 1 );
 
 on_error:
-	if( sections_cache != NULL )
-	{
-		libfcache_cache_free(
-		 &sections_cache,
-		 NULL );
-	}
-	if( section != NULL )
-	{
-		libewf_section_free(
-		 &section,
-		 NULL );
-	}
 	if( segment_file != NULL )
 	{
 		libewf_segment_file_free(
@@ -6645,6 +6743,10 @@ int libewf_segment_file_read_chunk_group_element_data(
 
 		return( -1 );
 	}
+	LIBEWF_STATISTICS_ADD(
+	 segment_file->io_handle->statistics.chunk_group_cache_misses,
+	 1 );
+
 	if( libewf_section_initialize(
 	     &section,
 	     error ) != 1 )
@@ -6679,6 +6781,14 @@ int libewf_segment_file_read_chunk_group_element_data(
 
 			goto on_error;
 		}
+		LIBEWF_STATISTICS_ADD(
+		 segment_file->io_handle->statistics.bytes_read,
+		 read_count );
+
+		LIBEWF_STATISTICS_ADD(
+		 segment_file->io_handle->statistics.number_of_reads,
+		 1 );
+
 		segment_file->current_offset = chunk_group_data_offset + read_count;
 
 		if( chunk_group_data_size != section->size )
@@ -6757,6 +6867,14 @@ int libewf_segment_file_read_chunk_group_element_data(
 
 		goto on_error;
 	}
+	LIBEWF_STATISTICS_ADD(
+	 segment_file->io_handle->statistics.bytes_read,
+	 read_count );
+
+	LIBEWF_STATISTICS_ADD(
+	 segment_file->io_handle->statistics.number_of_reads,
+	 1 );
+
 	segment_file->current_offset += read_count;
 	chunk_group_data_size        -= read_count;
 
@@ -6986,3 +7104,93 @@ int libewf_segment_file_get_chunk_group_by_offset(
 	return( result );
 }
 
+/* Retrieves a specific chunk group
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_file_get_chunk_group_by_index(
+     libewf_segment_file_t *segment_file,
+     libbfio_pool_t *file_io_pool,
+     libfcache_cache_t *chunk_groups_cache,
+     int chunk_group_index,
+     libewf_chunk_group_t **chunk_group,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_segment_file_get_chunk_group_by_index";
+
+	if( segment_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfdata_list_get_element_value_by_index(
+	     segment_file->chunk_groups_list,
+	     (intptr_t *) file_io_pool,
+	     chunk_groups_cache,
+	     chunk_group_index,
+	     (intptr_t **) chunk_group,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk group: %d from chunk groups list.",
+		 function,
+		 chunk_group_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the storage media size of a specific chunk group
+ * Returns 1 if successful, 0 if not set or -1 on error
+ */
+int libewf_segment_file_get_chunk_group_storage_media_size_by_index(
+     libewf_segment_file_t *segment_file,
+     int chunk_group_index,
+     size64_t *storage_media_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_segment_file_get_chunk_group_storage_media_size_by_index";
+	int result            = 0;
+
+	if( segment_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file.",
+		 function );
+
+		return( -1 );
+	}
+	result = libfdata_list_get_mapped_size_by_index(
+	          segment_file->chunk_groups_list,
+	          chunk_group_index,
+	          storage_media_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk group: %d mapped size.",
+		 function,
+		 chunk_group_index );
+
+		return( -1 );
+	}
+	return( result );
+}
+
@@ -371,6 +371,13 @@ int libewf_segment_file_write_sections_correction(
      ewf_data_t **data_section,
      libcerror_error_t **error );
 
+int libewf_segment_file_scan(
+     libewf_segment_file_t *segment_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     size64_t segment_file_size,
+     libcerror_error_t **error );
+
 int libewf_segment_file_read_element_data(
      libewf_io_handle_t *io_handle,
      libbfio_pool_t *file_io_pool,
@@ -417,6 +424,20 @@ int libewf_segment_file_get_chunk_group_by_offset(
      libewf_chunk_group_t **chunk_group,
      libcerror_error_t **error );
 
+int libewf_segment_file_get_chunk_group_by_index(
+     libewf_segment_file_t *segment_file,
+     libbfio_pool_t *file_io_pool,
+     libfcache_cache_t *chunk_groups_cache,
+     int chunk_group_index,
+     libewf_chunk_group_t **chunk_group,
+     libcerror_error_t **error );
+
+int libewf_segment_file_get_chunk_group_storage_media_size_by_index(
+     libewf_segment_file_t *segment_file,
+     int chunk_group_index,
+     size64_t *storage_media_size,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
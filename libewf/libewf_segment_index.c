@@ -0,0 +1,1357 @@
+/*
+ * Segment index functions
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_checksum.h"
+#include "libewf_definitions.h"
+#include "libewf_io_handle.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcnotify.h"
+#include "libewf_libfdata.h"
+#include "libewf_section.h"
+#include "libewf_segment_file.h"
+#include "libewf_segment_index.h"
+
+#include "ewf_section.h"
+#include "ewf_segment_index.h"
+
+const uint8_t ewf_segment_index_signature[ 8 ] = { 'E', 'W', 'F', 'I', 'N', 'D', 'E', 'X' };
+
+/* Creates a segment index
+ * Make sure the value segment_index is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_index_initialize(
+     libewf_segment_index_t **segment_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_segment_index_initialize";
+
+	if( segment_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment index.",
+		 function );
+
+		return( -1 );
+	}
+	if( *segment_index != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid segment index value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*segment_index = memory_allocate_structure(
+	                  libewf_segment_index_t );
+
+	if( *segment_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create segment index.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *segment_index,
+	     0,
+	     sizeof( libewf_segment_index_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear segment index.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *segment_index != NULL )
+	{
+		memory_free(
+		 *segment_index );
+
+		*segment_index = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a segment index
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_index_free(
+     libewf_segment_index_t **segment_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_segment_index_free";
+
+	if( segment_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment index.",
+		 function );
+
+		return( -1 );
+	}
+	if( *segment_index != NULL )
+	{
+		if( ( *segment_index )->segment_data_offsets != NULL )
+		{
+			memory_free(
+			 ( *segment_index )->segment_data_offsets );
+		}
+		if( ( *segment_index )->data != NULL )
+		{
+			memory_free(
+			 ( *segment_index )->data );
+		}
+		memory_free(
+		 *segment_index );
+
+		*segment_index = NULL;
+	}
+	return( 1 );
+}
+
+/* Reads a segment index from a file IO handle
+ * The file IO handle must be open
+ * Returns 1 if successful, 0 if the file does not contain a valid segment index or -1 on error
+ */
+int libewf_segment_index_read_file_io_handle(
+     libewf_segment_index_t *segment_index,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	ewf_segment_index_header_t header_data;
+
+	ewf_segment_index_segment_t *segment_data = NULL;
+	uint8_t *data                             = NULL;
+	size_t *segment_data_offsets              = NULL;
+	static char *function                     = "libewf_segment_index_read_file_io_handle";
+	size_t data_offset                        = 0;
+	size_t segment_entries_size               = 0;
+	ssize_t read_count                        = 0;
+	size64_t file_size                        = 0;
+	uint64_t data_size                        = 0;
+	uint32_t calculated_checksum              = 0;
+	uint32_t format_version                   = 0;
+	uint32_t number_of_chunk_groups           = 0;
+	uint32_t number_of_sections               = 0;
+	uint32_t number_of_segments               = 0;
+	uint32_t segment_number                   = 0;
+	uint32_t stored_checksum                  = 0;
+
+	if( segment_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment index.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_index->data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid segment index - data value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_handle_seek_offset(
+	     file_io_handle,
+	     0,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek header offset: 0.",
+		 function );
+
+		goto on_error;
+	}
+	read_count = libbfio_handle_read_buffer(
+	              file_io_handle,
+	              (uint8_t *) &header_data,
+	              sizeof( ewf_segment_index_header_t ),
+	              error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read header data.",
+		 function );
+
+		goto on_error;
+	}
+	if( read_count != (ssize_t) sizeof( ewf_segment_index_header_t ) )
+	{
+		return( 0 );
+	}
+	if( memory_compare(
+	     header_data.signature,
+	     ewf_segment_index_signature,
+	     8 ) != 0 )
+	{
+		return( 0 );
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 header_data.checksum,
+	 stored_checksum );
+
+	if( libewf_checksum_calculate_adler32(
+	     &calculated_checksum,
+	     (uint8_t *) &header_data,
+	     sizeof( ewf_segment_index_header_t ) - 4,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate header checksum.",
+		 function );
+
+		goto on_error;
+	}
+	if( stored_checksum != calculated_checksum )
+	{
+		return( 0 );
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 header_data.format_version,
+	 format_version );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 header_data.number_of_segments,
+	 number_of_segments );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 header_data.data_size,
+	 data_size );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 header_data.data_checksum,
+	 stored_checksum );
+
+	if( format_version != 2 )
+	{
+		return( 0 );
+	}
+	if( ( number_of_segments == 0 )
+	 || ( (size_t) number_of_segments > ( (size_t) SSIZE_MAX / sizeof( ewf_segment_index_segment_t ) ) )
+	 || ( data_size > (uint64_t) SSIZE_MAX ) )
+	{
+		return( 0 );
+	}
+	if( data_size < ( (uint64_t) number_of_segments * sizeof( ewf_segment_index_segment_t ) ) )
+	{
+		return( 0 );
+	}
+	/* The data size is bounded by the file size before the data is allocated
+	 */
+	if( libbfio_handle_get_size(
+	     file_io_handle,
+	     &file_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file size.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( file_size < (size64_t) sizeof( ewf_segment_index_header_t ) )
+	 || ( data_size > ( file_size - sizeof( ewf_segment_index_header_t ) ) ) )
+	{
+		return( 0 );
+	}
+	data = (uint8_t *) memory_allocate(
+	                    sizeof( uint8_t ) * (size_t) data_size );
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create data.",
+		 function );
+
+		goto on_error;
+	}
+	segment_data_offsets = (size_t *) memory_allocate(
+	                                   sizeof( size_t ) * number_of_segments );
+
+	if( segment_data_offsets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create segment data offsets.",
+		 function );
+
+		goto on_error;
+	}
+	read_count = libbfio_handle_read_buffer(
+	              file_io_handle,
+	              data,
+	              (size_t) data_size,
+	              error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read data.",
+		 function );
+
+		goto on_error;
+	}
+	if( read_count != (ssize_t) data_size )
+	{
+		goto on_invalid;
+	}
+	if( libewf_checksum_calculate_adler32(
+	     &calculated_checksum,
+	     data,
+	     (size_t) data_size,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate data checksum.",
+		 function );
+
+		goto on_error;
+	}
+	if( stored_checksum != calculated_checksum )
+	{
+		goto on_invalid;
+	}
+	/* Validate the layout of the segment entries so that they can be used without further bounds checks
+	 */
+	for( segment_number = 0;
+	     segment_number < number_of_segments;
+	     segment_number++ )
+	{
+		if( sizeof( ewf_segment_index_segment_t ) > ( (size_t) data_size - data_offset ) )
+		{
+			goto on_invalid;
+		}
+		segment_data = (ewf_segment_index_segment_t *) &( data[ data_offset ] );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 segment_data->number_of_sections,
+		 number_of_sections );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 segment_data->number_of_chunk_groups,
+		 number_of_chunk_groups );
+
+		segment_data_offsets[ segment_number ] = data_offset;
+
+		data_offset += sizeof( ewf_segment_index_segment_t );
+
+		if( ( (uint64_t) number_of_sections * sizeof( ewf_segment_index_section_t ) ) > ( data_size - data_offset ) )
+		{
+			goto on_invalid;
+		}
+		segment_entries_size = (size_t) number_of_sections * sizeof( ewf_segment_index_section_t );
+
+		data_offset += segment_entries_size;
+
+		if( ( (uint64_t) number_of_chunk_groups * sizeof( ewf_segment_index_chunk_group_t ) ) > ( data_size - data_offset ) )
+		{
+			goto on_invalid;
+		}
+		segment_entries_size = (size_t) number_of_chunk_groups * sizeof( ewf_segment_index_chunk_group_t );
+
+		data_offset += segment_entries_size;
+	}
+	if( data_offset != (size_t) data_size )
+	{
+		goto on_invalid;
+	}
+	if( memory_copy(
+	     segment_index->set_identifier,
+	     header_data.set_identifier,
+	     16 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy set identifier.",
+		 function );
+
+		goto on_error;
+	}
+	segment_index->data                                     = data;
+	segment_index->data_size                                = (size_t) data_size;
+	segment_index->allocated_data_size                      = (size_t) data_size;
+	segment_index->segment_data_offsets                     = segment_data_offsets;
+	segment_index->number_of_allocated_segment_data_offsets = number_of_segments;
+	segment_index->number_of_segments                       = number_of_segments;
+
+	return( 1 );
+
+on_invalid:
+	memory_free(
+	 segment_data_offsets );
+
+	memory_free(
+	 data );
+
+	return( 0 );
+
+on_error:
+	if( segment_data_offsets != NULL )
+	{
+		memory_free(
+		 segment_data_offsets );
+	}
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	return( -1 );
+}
+
+/* Writes a segment index to a file IO handle
+ * The file IO handle must be open
+ * The set identifier must be set to that of the media values
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_index_write_file_io_handle(
+     libewf_segment_index_t *segment_index,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	ewf_segment_index_header_t header_data;
+
+	static char *function = "libewf_segment_index_write_file_io_handle";
+	ssize_t write_count   = 0;
+	uint32_t checksum     = 0;
+
+	if( segment_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment index.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( segment_index->data == NULL )
+	 || ( segment_index->number_of_segments == 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid segment index - missing data.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     &header_data,
+	     0,
+	     sizeof( ewf_segment_index_header_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear header data.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     header_data.signature,
+	     ewf_segment_index_signature,
+	     8 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy signature.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     header_data.set_identifier,
+	     segment_index->set_identifier,
+	     16 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy set identifier.",
+		 function );
+
+		return( -1 );
+	}
+	/* Format version 2 stores the set identifier of the media values
+	 */
+	byte_stream_copy_from_uint32_little_endian(
+	 header_data.format_version,
+	 2 );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 header_data.number_of_segments,
+	 segment_index->number_of_segments );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 header_data.data_size,
+	 (uint64_t) segment_index->data_size );
+
+	if( libewf_checksum_calculate_adler32(
+	     &checksum,
+	     segment_index->data,
+	     segment_index->data_size,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate data checksum.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 header_data.data_checksum,
+	 checksum );
+
+	if( libewf_checksum_calculate_adler32(
+	     &checksum,
+	     (uint8_t *) &header_data,
+	     sizeof( ewf_segment_index_header_t ) - 4,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate header checksum.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 header_data.checksum,
+	 checksum );
+
+	write_count = libbfio_handle_write_buffer(
+	               file_io_handle,
+	               (uint8_t *) &header_data,
+	               sizeof( ewf_segment_index_header_t ),
+	               error );
+
+	if( write_count != (ssize_t) sizeof( ewf_segment_index_header_t ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write header data.",
+		 function );
+
+		return( -1 );
+	}
+	write_count = libbfio_handle_write_buffer(
+	               file_io_handle,
+	               segment_index->data,
+	               segment_index->data_size,
+	               error );
+
+	if( write_count != (ssize_t) segment_index->data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write data.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Appends the layout of a segment file to the segment index
+ * The segment files must be appended in order of their segment number
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_index_append_segment_file(
+     libewf_segment_index_t *segment_index,
+     libewf_segment_file_t *segment_file,
+     size64_t segment_file_size,
+     libcerror_error_t **error )
+{
+	ewf_segment_index_chunk_group_t *chunk_group_data = NULL;
+	ewf_segment_index_section_t *section_data         = NULL;
+	ewf_segment_index_segment_t *segment_data         = NULL;
+	void *reallocation                                = NULL;
+	static char *function                             = "libewf_segment_index_append_segment_file";
+	off64_t element_offset                            = 0;
+	size64_t element_size                             = 0;
+	size64_t mapped_size                              = 0;
+	size_t data_offset                                = 0;
+	size_t required_data_size                         = 0;
+	uint32_t element_flags                            = 0;
+	uint32_t number_of_segment_data_offsets           = 0;
+	int element_file_io_pool_entry                    = 0;
+	int element_index                                 = 0;
+	int number_of_chunk_groups                        = 0;
+	int number_of_sections                            = 0;
+
+	if( segment_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment index.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_file->segment_number != ( segment_index->number_of_segments + 1 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported segment number: %" PRIu32 " expected: %" PRIu32 ".",
+		 function,
+		 segment_file->segment_number,
+		 segment_index->number_of_segments + 1 );
+
+		return( -1 );
+	}
+	if( libfdata_list_get_number_of_elements(
+	     segment_file->sections_list,
+	     &number_of_sections,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve the number of sections.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfdata_list_get_number_of_elements(
+	     segment_file->chunk_groups_list,
+	     &number_of_chunk_groups,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve the number of chunk groups.",
+		 function );
+
+		return( -1 );
+	}
+	required_data_size = sizeof( ewf_segment_index_segment_t )
+	                   + ( (size_t) number_of_sections * sizeof( ewf_segment_index_section_t ) )
+	                   + ( (size_t) number_of_chunk_groups * sizeof( ewf_segment_index_chunk_group_t ) );
+
+	if( required_data_size > ( (size_t) SSIZE_MAX - segment_index->data_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid required data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	required_data_size += segment_index->data_size;
+
+	if( required_data_size > segment_index->allocated_data_size )
+	{
+		if( required_data_size < ( (size_t) SSIZE_MAX / 2 ) )
+		{
+			required_data_size *= 2;
+		}
+		reallocation = memory_reallocate(
+		                segment_index->data,
+		                sizeof( uint8_t ) * required_data_size );
+
+		if( reallocation == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize data.",
+			 function );
+
+			return( -1 );
+		}
+		segment_index->data                = (uint8_t *) reallocation;
+		segment_index->allocated_data_size = required_data_size;
+	}
+	if( segment_index->number_of_segments >= segment_index->number_of_allocated_segment_data_offsets )
+	{
+		number_of_segment_data_offsets = segment_index->number_of_allocated_segment_data_offsets * 2;
+
+		if( number_of_segment_data_offsets < 16 )
+		{
+			number_of_segment_data_offsets = 16;
+		}
+		reallocation = memory_reallocate(
+		                segment_index->segment_data_offsets,
+		                sizeof( size_t ) * number_of_segment_data_offsets );
+
+		if( reallocation == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize segment data offsets.",
+			 function );
+
+			return( -1 );
+		}
+		segment_index->segment_data_offsets                     = (size_t *) reallocation;
+		segment_index->number_of_allocated_segment_data_offsets = number_of_segment_data_offsets;
+	}
+	data_offset  = segment_index->data_size;
+	segment_data = (ewf_segment_index_segment_t *) &( segment_index->data[ data_offset ] );
+
+	if( memory_set(
+	     segment_data,
+	     0,
+	     sizeof( ewf_segment_index_segment_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear segment data.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 segment_data->segment_number,
+	 segment_file->segment_number );
+
+	segment_data->type          = segment_file->type;
+	segment_data->major_version = segment_file->major_version;
+	segment_data->minor_version = segment_file->minor_version;
+	segment_data->flags         = segment_file->flags & ~( LIBEWF_SEGMENT_FILE_FLAG_WRITE_OPEN );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 segment_data->segment_file_size,
+	 segment_file_size );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 segment_data->last_section_offset,
+	 (uint64_t) segment_file->last_section_offset );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 segment_data->storage_media_size,
+	 segment_file->storage_media_size );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 segment_data->number_of_chunks,
+	 segment_file->number_of_chunks );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 segment_data->last_chunk_filled,
+	 (uint64_t) segment_file->last_chunk_filled );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 segment_data->device_information_section_index,
+	 (uint32_t) segment_file->device_information_section_index );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 segment_data->number_of_sections,
+	 (uint32_t) number_of_sections );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 segment_data->number_of_chunk_groups,
+	 (uint32_t) number_of_chunk_groups );
+
+	data_offset += sizeof( ewf_segment_index_segment_t );
+
+	for( element_index = 0;
+	     element_index < number_of_sections;
+	     element_index++ )
+	{
+		if( libfdata_list_get_element_by_index(
+		     segment_file->sections_list,
+		     element_index,
+		     &element_file_io_pool_entry,
+		     &element_offset,
+		     &element_size,
+		     &element_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve section: %d from sections list.",
+			 function,
+			 element_index );
+
+			return( -1 );
+		}
+		section_data = (ewf_segment_index_section_t *) &( segment_index->data[ data_offset ] );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 section_data->offset,
+		 (uint64_t) element_offset );
+
+		data_offset += sizeof( ewf_segment_index_section_t );
+	}
+	for( element_index = 0;
+	     element_index < number_of_chunk_groups;
+	     element_index++ )
+	{
+		if( libfdata_list_get_element_by_index(
+		     segment_file->chunk_groups_list,
+		     element_index,
+		     &element_file_io_pool_entry,
+		     &element_offset,
+		     &element_size,
+		     &element_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk group: %d from chunk groups list.",
+			 function,
+			 element_index );
+
+			return( -1 );
+		}
+		if( libfdata_list_get_mapped_size_by_index(
+		     segment_file->chunk_groups_list,
+		     element_index,
+		     &mapped_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk group: %d mapped size.",
+			 function,
+			 element_index );
+
+			return( -1 );
+		}
+		chunk_group_data = (ewf_segment_index_chunk_group_t *) &( segment_index->data[ data_offset ] );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 chunk_group_data->data_offset,
+		 (uint64_t) element_offset );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 chunk_group_data->data_size,
+		 element_size );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 chunk_group_data->mapped_size,
+		 mapped_size );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 chunk_group_data->range_flags,
+		 element_flags );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 chunk_group_data->padding,
+		 0 );
+
+		data_offset += sizeof( ewf_segment_index_chunk_group_t );
+	}
+	segment_index->segment_data_offsets[ segment_index->number_of_segments ] = segment_index->data_size;
+
+	segment_index->data_size           = data_offset;
+	segment_index->number_of_segments += 1;
+
+	return( 1 );
+}
+
+/* Retrieves a segment file from the segment index
+ * The segment file header and last section descriptor are read to determine if the
+ * segment index still corresponds to the segment file
+ * The set identifier of the segment index is checked against the media values
+ * by the caller after the volume section of the first segment file was read
+ * Returns 1 if successful, 0 if the segment index is stale or -1 on error
+ */
+int libewf_segment_index_get_segment_file(
+     libewf_segment_index_t *segment_index,
+     uint32_t segment_number,
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     size64_t segment_file_size,
+     libewf_segment_file_t **segment_file,
+     libcerror_error_t **error )
+{
+	ewf_segment_index_chunk_group_t *chunk_group_data = NULL;
+	ewf_segment_index_section_t *section_data         = NULL;
+	ewf_segment_index_segment_t *segment_data         = NULL;
+	libewf_section_t *section                         = NULL;
+	libewf_segment_file_t *safe_segment_file          = NULL;
+	static char *function                             = "libewf_segment_index_get_segment_file";
+	size64_t chunk_group_data_size                    = 0;
+	size64_t mapped_size                              = 0;
+	size64_t stored_segment_file_size                 = 0;
+	size_t data_offset                                = 0;
+	size_t section_descriptor_size                    = 0;
+	ssize_t read_count                                = 0;
+	uint64_t chunk_group_data_offset                  = 0;
+	uint64_t last_section_offset                      = 0;
+	uint64_t section_offset                           = 0;
+	uint64_t value_64bit                              = 0;
+	uint32_t number_of_chunk_groups                   = 0;
+	uint32_t number_of_sections                       = 0;
+	uint32_t range_flags                              = 0;
+	uint32_t stored_segment_number                    = 0;
+	uint32_t value_32bit                              = 0;
+	uint32_t element_index                            = 0;
+	uint8_t segment_file_type                         = 0;
+	int section_element_index                         = 0;
+	int result                                        = 0;
+
+	if( segment_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment index.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_number >= segment_index->number_of_segments )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid segment number value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file.",
+		 function );
+
+		return( -1 );
+	}
+	data_offset  = segment_index->segment_data_offsets[ segment_number ];
+	segment_data = (ewf_segment_index_segment_t *) &( segment_index->data[ data_offset ] );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 segment_data->segment_number,
+	 stored_segment_number );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 segment_data->segment_file_size,
+	 stored_segment_file_size );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 segment_data->last_section_offset,
+	 last_section_offset );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 segment_data->number_of_sections,
+	 number_of_sections );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 segment_data->number_of_chunk_groups,
+	 number_of_chunk_groups );
+
+	if( ( stored_segment_number != ( segment_number + 1 ) )
+	 || ( stored_segment_file_size != segment_file_size )
+	 || ( number_of_sections == 0 )
+	 || ( last_section_offset >= (uint64_t) segment_file_size ) )
+	{
+		return( 0 );
+	}
+	if( libewf_segment_file_initialize(
+	     &safe_segment_file,
+	     io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create segment file.",
+		 function );
+
+		goto on_error;
+	}
+	read_count = libewf_segment_file_read_file_header(
+		      safe_segment_file,
+		      file_io_pool,
+		      file_io_pool_entry,
+		      error );
+
+	if( read_count == -1 )
+	{
+		goto on_stale;
+	}
+	segment_file_type = safe_segment_file->type;
+
+	if( ( io_handle->segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
+	 && ( segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF1 ) )
+	{
+		segment_file_type = LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART;
+	}
+	if( ( segment_file_type != segment_data->type )
+	 || ( safe_segment_file->major_version != segment_data->major_version )
+	 || ( safe_segment_file->minor_version != segment_data->minor_version )
+	 || ( safe_segment_file->segment_number != stored_segment_number ) )
+	{
+		goto on_stale;
+	}
+	if( safe_segment_file->major_version == 1 )
+	{
+		section_descriptor_size = sizeof( ewf_section_descriptor_v1_t );
+	}
+	else if( safe_segment_file->major_version == 2 )
+	{
+		if( memory_compare(
+		     safe_segment_file->set_identifier,
+		     segment_index->set_identifier,
+		     16 ) != 0 )
+		{
+			goto on_stale;
+		}
+		section_descriptor_size = sizeof( ewf_section_descriptor_v2_t );
+	}
+	else
+	{
+		goto on_stale;
+	}
+	safe_segment_file->type = segment_file_type;
+
+	/* The last section descriptor is checksummed and changes when
+	 * the segment file is rewritten or extended
+	 */
+	if( libewf_section_initialize(
+	     &section,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create section.",
+		 function );
+
+		goto on_error;
+	}
+	read_count = libewf_section_descriptor_read(
+		      section,
+		      file_io_pool,
+		      file_io_pool_entry,
+		      (off64_t) last_section_offset,
+		      safe_segment_file->major_version,
+		      error );
+
+	if( read_count == -1 )
+	{
+		goto on_stale;
+	}
+	if( ( segment_data->flags & LIBEWF_SEGMENT_FILE_FLAG_IS_LAST ) != 0 )
+	{
+		if( section->type != LIBEWF_SECTION_TYPE_DONE )
+		{
+			goto on_stale;
+		}
+	}
+	else if( section->type != LIBEWF_SECTION_TYPE_NEXT )
+	{
+		goto on_stale;
+	}
+	if( libewf_section_free(
+	     &section,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free section.",
+		 function );
+
+		goto on_error;
+	}
+	data_offset += sizeof( ewf_segment_index_segment_t );
+
+	for( element_index = 0;
+	     element_index < number_of_sections;
+	     element_index++ )
+	{
+		section_data = (ewf_segment_index_section_t *) &( segment_index->data[ data_offset ] );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 section_data->offset,
+		 section_offset );
+
+		if( section_offset >= (uint64_t) segment_file_size )
+		{
+			goto on_stale;
+		}
+		if( libfdata_list_append_element(
+		     safe_segment_file->sections_list,
+		     &section_element_index,
+		     file_io_pool_entry,
+		     (off64_t) section_offset,
+		     (size64_t) section_descriptor_size,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append section to sections list.",
+			 function );
+
+			goto on_error;
+		}
+		data_offset += sizeof( ewf_segment_index_section_t );
+	}
+	for( element_index = 0;
+	     element_index < number_of_chunk_groups;
+	     element_index++ )
+	{
+		chunk_group_data = (ewf_segment_index_chunk_group_t *) &( segment_index->data[ data_offset ] );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 chunk_group_data->data_offset,
+		 chunk_group_data_offset );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 chunk_group_data->data_size,
+		 chunk_group_data_size );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 chunk_group_data->mapped_size,
+		 mapped_size );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 chunk_group_data->range_flags,
+		 range_flags );
+
+		if( ( chunk_group_data_offset >= (uint64_t) segment_file_size )
+		 || ( chunk_group_data_size > ( segment_file_size - chunk_group_data_offset ) ) )
+		{
+			goto on_stale;
+		}
+		if( libfdata_list_append_element_with_mapped_size(
+		     safe_segment_file->chunk_groups_list,
+		     &( safe_segment_file->chunk_groups_index ),
+		     file_io_pool_entry,
+		     (off64_t) chunk_group_data_offset,
+		     chunk_group_data_size,
+		     range_flags,
+		     mapped_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append element with mapped size to chunk groups list.",
+			 function );
+
+			goto on_error;
+		}
+		data_offset += sizeof( ewf_segment_index_chunk_group_t );
+	}
+	safe_segment_file->last_section_offset = (off64_t) last_section_offset;
+	safe_segment_file->current_offset      = (off64_t) ( last_section_offset + section_descriptor_size );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 segment_data->storage_media_size,
+	 safe_segment_file->storage_media_size );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 segment_data->number_of_chunks,
+	 safe_segment_file->number_of_chunks );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 segment_data->last_chunk_filled,
+	 value_64bit );
+
+	safe_segment_file->last_chunk_filled          = (int64_t) value_64bit;
+	safe_segment_file->previous_last_chunk_filled = (int64_t) value_64bit;
+
+	byte_stream_copy_to_uint32_little_endian(
+	 segment_data->device_information_section_index,
+	 value_32bit );
+
+	safe_segment_file->device_information_section_index = (int) ( (int32_t) value_32bit );
+	safe_segment_file->flags                            = segment_data->flags;
+
+	*segment_file = safe_segment_file;
+
+	return( 1 );
+
+on_stale:
+	result = 0;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: segment index is stale for segment: %" PRIu32 ".\n",
+		 function,
+		 segment_number + 1 );
+
+		if( ( error != NULL )
+		 && ( *error != NULL ) )
+		{
+			libcnotify_print_error_backtrace(
+			 *error );
+		}
+	}
+#endif
+	libcerror_error_free(
+	 error );
+
+	goto on_cleanup;
+
+on_error:
+	result = -1;
+
+on_cleanup:
+	if( section != NULL )
+	{
+		libewf_section_free(
+		 &section,
+		 NULL );
+	}
+	if( safe_segment_file != NULL )
+	{
+		libewf_segment_file_free(
+		 &safe_segment_file,
+		 NULL );
+	}
+	return( result );
+}
+
@@ -0,0 +1,112 @@
+/*
+ * Segment index functions
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_SEGMENT_INDEX_H )
+#define _LIBEWF_SEGMENT_INDEX_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_io_handle.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_segment_file.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_segment_index libewf_segment_index_t;
+
+/* The segment index contains the section and chunk group layout of the segment files
+ * so that a set of segment files can be opened without scanning their section chains
+ */
+struct libewf_segment_index
+{
+	/* The number of segments
+	 */
+	uint32_t number_of_segments;
+
+	/* The set identifier of the media values
+	 */
+	uint8_t set_identifier[ 16 ];
+
+	/* The data
+	 */
+	uint8_t *data;
+
+	/* The data size
+	 */
+	size_t data_size;
+
+	/* The allocated data size
+	 */
+	size_t allocated_data_size;
+
+	/* The offsets of the segments in the data
+	 */
+	size_t *segment_data_offsets;
+
+	/* The number of allocated segment data offsets
+	 */
+	uint32_t number_of_allocated_segment_data_offsets;
+};
+
+int libewf_segment_index_initialize(
+     libewf_segment_index_t **segment_index,
+     libcerror_error_t **error );
+
+int libewf_segment_index_free(
+     libewf_segment_index_t **segment_index,
+     libcerror_error_t **error );
+
+int libewf_segment_index_read_file_io_handle(
+     libewf_segment_index_t *segment_index,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+int libewf_segment_index_write_file_io_handle(
+     libewf_segment_index_t *segment_index,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+int libewf_segment_index_append_segment_file(
+     libewf_segment_index_t *segment_index,
+     libewf_segment_file_t *segment_file,
+     size64_t segment_file_size,
+     libcerror_error_t **error );
+
+int libewf_segment_index_get_segment_file(
+     libewf_segment_index_t *segment_index,
+     uint32_t segment_number,
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     size64_t segment_file_size,
+     libewf_segment_file_t **segment_file,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_SEGMENT_INDEX_H ) */
+
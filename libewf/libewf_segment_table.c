@@ -307,13 +307,13 @@ int libewf_segment_table_clone(
 		( *destination_segment_table )->basename = system_string_allocate(
 					                    source_segment_table->basename_size );
 
-		if( *destination_segment_table == NULL )
+		if( ( *destination_segment_table )->basename == NULL )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_MEMORY,
 			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-			 "%s: unable to create destination segment table.",
+			 "%s: unable to create destination basename.",
 			 function );
 
 			goto on_error;
@@ -362,13 +362,38 @@ int libewf_segment_table_clone(
 
 		goto on_error;
 	}
-	( *destination_segment_table )->maximum_segment_size = source_segment_table->maximum_segment_size;
+	( *destination_segment_table )->maximum_segment_size       = source_segment_table->maximum_segment_size;
+	( *destination_segment_table )->number_of_segments         = source_segment_table->number_of_segments;
+	( *destination_segment_table )->number_of_scanned_segments = source_segment_table->number_of_scanned_segments;
+	( *destination_segment_table )->scanned_storage_media_size = source_segment_table->scanned_storage_media_size;
+	( *destination_segment_table )->flags                      = source_segment_table->flags;
+
+	if( memory_copy(
+	     ( *destination_segment_table )->set_identifier,
+	     source_segment_table->set_identifier,
+	     16 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy source to destination set identifier.",
+		 function );
+
+		goto on_error;
+	}
 
 	return( 1 );
 
 on_error:
 	if( *destination_segment_table != NULL )
 	{
+		if( ( *destination_segment_table )->segment_files_cache != NULL )
+		{
+			libfcache_cache_free(
+			 &( ( *destination_segment_table )->segment_files_cache ),
+			 NULL );
+		}
 		if( ( *destination_segment_table )->segment_files_list != NULL )
 		{
 			libfdata_list_free(
@@ -442,7 +467,11 @@ int libewf_segment_table_empty(
 
 		result = -1;
 	}
-	segment_table->number_of_segments = 0;
+	segment_table->number_of_segments         = 0;
+	segment_table->number_of_scanned_segments = 0;
+	segment_table->scanned_storage_media_size = 0;
+
+	segment_table->flags &= ~( LIBEWF_SEGMENT_TABLE_FLAG_SCAN_ON_DEMAND );
 
 	return( result );
 }
@@ -1751,6 +1780,179 @@ int libewf_segment_table_get_segment_file_by_index(
 	return( 1 );
 }
 
+/* Scans the segment files up to the one that contains a specific offset
+ * Segment files that were not scanned on open are scanned in order on demand,
+ * since the offset of a segment file depends on the size of its predecessors
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_table_scan_segment_files_to_offset(
+     libewf_segment_table_t *segment_table,
+     libbfio_pool_t *file_io_pool,
+     off64_t offset,
+     libcerror_error_t **error )
+{
+	libewf_segment_file_t *segment_file = NULL;
+	static char *function               = "libewf_segment_table_scan_segment_files_to_offset";
+	uint32_t segment_number             = 0;
+
+	if( segment_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment table.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( segment_table->flags & LIBEWF_SEGMENT_TABLE_FLAG_SCAN_ON_DEMAND ) == 0 )
+	{
+		return( 1 );
+	}
+	while( ( segment_table->number_of_scanned_segments < segment_table->number_of_segments )
+	    && ( (size64_t) offset >= segment_table->scanned_storage_media_size ) )
+	{
+		segment_number = segment_table->number_of_scanned_segments;
+
+		if( libewf_segment_table_get_segment_file_by_index(
+		     segment_table,
+		     segment_number,
+		     file_io_pool,
+		     &segment_file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment file: %" PRIu32 " from segment table.",
+			 function,
+			 segment_number );
+
+			return( -1 );
+		}
+		if( segment_file == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing segment file: %" PRIu32 ".",
+			 function,
+			 segment_number );
+
+			return( -1 );
+		}
+		if( segment_file->io_handle == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid segment file: %" PRIu32 " - missing IO handle.",
+			 function,
+			 segment_number );
+
+			return( -1 );
+		}
+		if( segment_file->segment_number != ( segment_number + 1 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_INPUT,
+			 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+			 "%s: segment number mismatch ( stored: %" PRIu32 ", expected: %" PRIu32 " ).",
+			 function,
+			 segment_file->segment_number,
+			 segment_number + 1 );
+
+			return( -1 );
+		}
+		if( ( segment_file->major_version != segment_file->io_handle->major_version )
+		 || ( segment_file->minor_version != segment_file->io_handle->minor_version ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_INPUT,
+			 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+			 "%s: segment file: %" PRIu32 " format version value mismatch.",
+			 function,
+			 segment_number );
+
+			return( -1 );
+		}
+		if( segment_file->major_version == 2 )
+		{
+			if( segment_file->compression_method != segment_file->io_handle->compression_method )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_INPUT,
+				 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+				 "%s: segment file: %" PRIu32 " compression method value mismatch.",
+				 function,
+				 segment_number );
+
+				return( -1 );
+			}
+			if( memory_compare(
+			     segment_table->set_identifier,
+			     segment_file->set_identifier,
+			     16 ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_INPUT,
+				 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+				 "%s: segment file: %" PRIu32 " set identifier value mismatch.",
+				 function,
+				 segment_number );
+
+				return( -1 );
+			}
+		}
+		if( ( segment_file->flags & LIBEWF_SEGMENT_FILE_FLAG_IS_CORRUPTED ) != 0 )
+		{
+			segment_table->flags |= LIBEWF_SEGMENT_TABLE_FLAG_IS_CORRUPTED;
+		}
+		if( libewf_segment_table_set_segment_storage_media_size_by_index(
+		     segment_table,
+		     segment_number,
+		     segment_file->storage_media_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set mapped range of element: %" PRIu32 " in segment table.",
+			 function,
+			 segment_number );
+
+			return( -1 );
+		}
+		segment_table->scanned_storage_media_size += segment_file->storage_media_size;
+		segment_table->number_of_scanned_segments += 1;
+	}
+	if( segment_table->number_of_scanned_segments >= segment_table->number_of_segments )
+	{
+		segment_table->flags &= ~( LIBEWF_SEGMENT_TABLE_FLAG_SCAN_ON_DEMAND );
+	}
+	return( 1 );
+}
+
 /* Retrieves a segment file at a specific offset from the segment table
  * Returns 1 if successful, 0 if not or -1 on error
  */
@@ -1789,6 +1991,22 @@ int libewf_segment_table_get_segment_file_at_offset(
 
 		return( -1 );
 	}
+	if( libewf_segment_table_scan_segment_files_to_offset(
+	     segment_table,
+	     file_io_pool,
+	     offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to scan segment files up to offset: 0x%08" PRIx64 ".",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
 	result = libfdata_list_get_element_value_at_offset(
 	          segment_table->segment_files_list,
 	          (intptr_t *) file_io_pool,
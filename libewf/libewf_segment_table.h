@@ -64,6 +64,18 @@ struct libewf_segment_table
 	 */
 	libfcache_cache_t *segment_files_cache;
 
+	/* The number of segments that have been scanned
+	 */
+	uint32_t number_of_scanned_segments;
+
+	/* The storage media size of the segments that have been scanned
+	 */
+	size64_t scanned_storage_media_size;
+
+	/* The set identifier of the segment files scanned on demand
+	 */
+	uint8_t set_identifier[ 16 ];
+
 	/* Flags
 	 */
 	uint8_t flags;
@@ -169,6 +181,12 @@ int libewf_segment_table_get_segment_file_by_index(
      libewf_segment_file_t **segment_file,
      libcerror_error_t **error );
 
+int libewf_segment_table_scan_segment_files_to_offset(
+     libewf_segment_table_t *segment_table,
+     libbfio_pool_t *file_io_pool,
+     off64_t offset,
+     libcerror_error_t **error );
+
 int libewf_segment_table_get_segment_file_at_offset(
      libewf_segment_table_t *segment_table,
      off64_t offset,
@@ -0,0 +1,226 @@
+/*
+ * Statistics functions
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <types.h>
+
+#if defined( HAVE_TIME_H ) || defined( WINAPI )
+#include <time.h>
+#endif
+
+#include "libewf_definitions.h"
+#include "libewf_libcerror.h"
+#include "libewf_statistics.h"
+
+/* Retrieves a monotonic timestamp in nano seconds
+ * Returns the timestamp or 0 if not available
+ */
+uint64_t libewf_statistics_get_timestamp(
+          void )
+{
+#if defined( WINAPI )
+	LARGE_INTEGER counter;
+	LARGE_INTEGER frequency;
+
+	if( ( QueryPerformanceFrequency(
+	       &frequency ) == 0 )
+	 || ( QueryPerformanceCounter(
+	       &counter ) == 0 ) )
+	{
+		return( 0 );
+	}
+	return( ( (uint64_t) ( counter.QuadPart / frequency.QuadPart ) * 1000000000UL )
+	      + ( ( (uint64_t) ( counter.QuadPart % frequency.QuadPart ) * 1000000000UL ) / (uint64_t) frequency.QuadPart ) );
+
+#elif defined( HAVE_CLOCK_GETTIME ) && defined( CLOCK_MONOTONIC )
+	struct timespec time_value;
+
+	if( clock_gettime(
+	     CLOCK_MONOTONIC,
+	     &time_value ) != 0 )
+	{
+		return( 0 );
+	}
+	return( ( (uint64_t) time_value.tv_sec * 1000000000UL ) + (uint64_t) time_value.tv_nsec );
+
+#else
+	return( 0 );
+
+#endif
+}
+
+/* Retrieves a specific statistics value
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_statistics_get_value(
+     libewf_statistics_t *statistics,
+     int value_type,
+     uint64_t *value,
+     libcerror_error_t **error )
+{
+	static char *function        = "libewf_statistics_get_value";
+	uint64_t chunk_group_lookups = 0;
+	uint64_t chunk_group_misses  = 0;
+
+	if( statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value.",
+		 function );
+
+		return( -1 );
+	}
+	switch( value_type )
+	{
+		case LIBEWF_STATISTICS_VALUE_PACKED_CHUNK_CACHE_HITS:
+			*value = LIBEWF_STATISTICS_GET( statistics->packed_chunk_cache_hits );
+			break;
+
+		case LIBEWF_STATISTICS_VALUE_PACKED_CHUNK_CACHE_MISSES:
+			*value = LIBEWF_STATISTICS_GET( statistics->packed_chunk_cache_misses );
+			break;
+
+		case LIBEWF_STATISTICS_VALUE_CHUNK_GROUP_CACHE_HITS:
+			/* A chunk group lookup that did not need to read the chunk group is a hit
+			 */
+			chunk_group_lookups = LIBEWF_STATISTICS_GET( statistics->chunk_group_lookups );
+			chunk_group_misses  = LIBEWF_STATISTICS_GET( statistics->chunk_group_cache_misses );
+
+			if( chunk_group_lookups > chunk_group_misses )
+			{
+				*value = chunk_group_lookups - chunk_group_misses;
+			}
+			else
+			{
+				*value = 0;
+			}
+			break;
+
+		case LIBEWF_STATISTICS_VALUE_CHUNK_GROUP_CACHE_MISSES:
+			*value = LIBEWF_STATISTICS_GET( statistics->chunk_group_cache_misses );
+			break;
+
+		case LIBEWF_STATISTICS_VALUE_BYTES_READ:
+			*value = LIBEWF_STATISTICS_GET( statistics->bytes_read );
+			break;
+
+		case LIBEWF_STATISTICS_VALUE_NUMBER_OF_READS:
+			*value = LIBEWF_STATISTICS_GET( statistics->number_of_reads );
+			break;
+
+		case LIBEWF_STATISTICS_VALUE_BYTES_WRITTEN:
+			*value = LIBEWF_STATISTICS_GET( statistics->bytes_written );
+			break;
+
+		case LIBEWF_STATISTICS_VALUE_NUMBER_OF_WRITES:
+			*value = LIBEWF_STATISTICS_GET( statistics->number_of_writes );
+			break;
+
+		case LIBEWF_STATISTICS_VALUE_BYTES_DECOMPRESSED:
+			*value = LIBEWF_STATISTICS_GET( statistics->bytes_decompressed );
+			break;
+
+		case LIBEWF_STATISTICS_VALUE_NUMBER_OF_CHECKSUM_VERIFICATIONS:
+			*value = LIBEWF_STATISTICS_GET( statistics->number_of_checksum_verifications );
+			break;
+
+		case LIBEWF_STATISTICS_VALUE_DECOMPRESSION_TIME:
+			*value = LIBEWF_STATISTICS_GET( statistics->decompression_time );
+			break;
+
+		case LIBEWF_STATISTICS_VALUE_COMPRESSION_TIME:
+			*value = LIBEWF_STATISTICS_GET( statistics->compression_time );
+			break;
+
+		case LIBEWF_STATISTICS_VALUE_NUMBER_OF_SKIPPED_COMPRESSIONS:
+			*value = LIBEWF_STATISTICS_GET( statistics->number_of_skipped_compressions );
+			break;
+
+		case LIBEWF_STATISTICS_VALUE_NUMBER_OF_DISCARDED_COMPRESSIONS:
+			*value = LIBEWF_STATISTICS_GET( statistics->number_of_discarded_compressions );
+			break;
+
+		default:
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported value type: %d.",
+			 function,
+			 value_type );
+
+			return( -1 );
+	}
+	return( 1 );
+}
+
+/* Resets the statistics values
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_statistics_reset(
+     libewf_statistics_t *statistics,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_statistics_reset";
+
+	if( statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid statistics.",
+		 function );
+
+		return( -1 );
+	}
+	LIBEWF_STATISTICS_SET( statistics->packed_chunk_cache_hits, 0 );
+	LIBEWF_STATISTICS_SET( statistics->packed_chunk_cache_misses, 0 );
+	LIBEWF_STATISTICS_SET( statistics->chunk_group_lookups, 0 );
+	LIBEWF_STATISTICS_SET( statistics->chunk_group_cache_misses, 0 );
+	LIBEWF_STATISTICS_SET( statistics->bytes_read, 0 );
+	LIBEWF_STATISTICS_SET( statistics->number_of_reads, 0 );
+	LIBEWF_STATISTICS_SET( statistics->bytes_written, 0 );
+	LIBEWF_STATISTICS_SET( statistics->number_of_writes, 0 );
+	LIBEWF_STATISTICS_SET( statistics->bytes_decompressed, 0 );
+	LIBEWF_STATISTICS_SET( statistics->number_of_checksum_verifications, 0 );
+	LIBEWF_STATISTICS_SET( statistics->decompression_time, 0 );
+	LIBEWF_STATISTICS_SET( statistics->compression_time, 0 );
+	LIBEWF_STATISTICS_SET( statistics->number_of_skipped_compressions, 0 );
+	LIBEWF_STATISTICS_SET( statistics->number_of_discarded_compressions, 0 );
+
+	return( 1 );
+}
+
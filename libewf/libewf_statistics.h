@@ -0,0 +1,149 @@
+/*
+ * Statistics functions
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_STATISTICS_H )
+#define _LIBEWF_STATISTICS_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The statistics values are updated with relaxed atomic operations
+ * so that they can be updated from the hot paths without a lock
+ */
+#if defined( __clang__ ) || ( defined( __GNUC__ ) && ( ( __GNUC__ > 4 ) || ( ( __GNUC__ == 4 ) && ( __GNUC_MINOR__ >= 7 ) ) ) )
+#define LIBEWF_STATISTICS_ADD( statistics_value, value ) \
+	__atomic_fetch_add( &( statistics_value ), (uint64_t) ( value ), __ATOMIC_RELAXED )
+
+#define LIBEWF_STATISTICS_GET( statistics_value ) \
+	__atomic_load_n( &( statistics_value ), __ATOMIC_RELAXED )
+
+#define LIBEWF_STATISTICS_SET( statistics_value, value ) \
+	__atomic_store_n( &( statistics_value ), (uint64_t) ( value ), __ATOMIC_RELAXED )
+
+#elif defined( _MSC_VER ) && defined( WINAPI ) && ( WINVER >= 0x0600 )
+#define LIBEWF_STATISTICS_ADD( statistics_value, value ) \
+	InterlockedExchangeAdd64( (LONGLONG volatile *) &( statistics_value ), (LONGLONG) ( value ) )
+
+#define LIBEWF_STATISTICS_GET( statistics_value ) \
+	(uint64_t) InterlockedCompareExchange64( (LONGLONG volatile *) &( statistics_value ), 0, 0 )
+
+#define LIBEWF_STATISTICS_SET( statistics_value, value ) \
+	InterlockedExchange64( (LONGLONG volatile *) &( statistics_value ), (LONGLONG) ( value ) )
+
+#else
+#define LIBEWF_STATISTICS_ADD( statistics_value, value ) \
+	( statistics_value ) += (uint64_t) ( value )
+
+#define LIBEWF_STATISTICS_GET( statistics_value ) \
+	( statistics_value )
+
+#define LIBEWF_STATISTICS_SET( statistics_value, value ) \
+	( statistics_value ) = (uint64_t) ( value )
+
+#endif
+
+typedef struct libewf_statistics libewf_statistics_t;
+
+struct libewf_statistics
+{
+	/* The number of packed chunk data cache hits
+	 */
+	uint64_t packed_chunk_cache_hits;
+
+	/* The number of packed chunk data cache misses
+	 */
+	uint64_t packed_chunk_cache_misses;
+
+	/* The number of chunk group lookups
+	 */
+	uint64_t chunk_group_lookups;
+
+	/* The number of chunk group cache misses
+	 */
+	uint64_t chunk_group_cache_misses;
+
+	/* The number of bytes read from the segment files
+	 */
+	uint64_t bytes_read;
+
+	/* The number of read operations on the segment files
+	 */
+	uint64_t number_of_reads;
+
+	/* The number of bytes written to the segment files
+	 */
+	uint64_t bytes_written;
+
+	/* The number of write operations on the segment files
+	 */
+	uint64_t number_of_writes;
+
+	/* The number of bytes of decompressed chunk data
+	 */
+	uint64_t bytes_decompressed;
+
+	/* The number of chunk data checksum verifications
+	 */
+	uint64_t number_of_checksum_verifications;
+
+	/* The time spent decompressing chunk data in nano seconds
+	 */
+	uint64_t decompression_time;
+
+	/* The time spent compressing chunk data in nano seconds
+	 */
+	uint64_t compression_time;
+
+	/* The number of chunks stored uncompressed without compressing them
+	 * since their data was estimated to be incompressible
+	 */
+	uint64_t number_of_skipped_compressions;
+
+	/* The number of chunks stored uncompressed since their compressed data was not smaller
+	 */
+	uint64_t number_of_discarded_compressions;
+};
+
+uint64_t libewf_statistics_get_timestamp(
+          void );
+
+int libewf_statistics_get_value(
+     libewf_statistics_t *statistics,
+     int value_type,
+     uint64_t *value,
+     libcerror_error_t **error );
+
+int libewf_statistics_reset(
+     libewf_statistics_t *statistics,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_STATISTICS_H ) */
+
@@ -39,6 +39,7 @@
 #include "libewf_chunk_table.h"
 #include "libewf_compression.h"
 #include "libewf_definitions.h"
+#include "libewf_deflate.h"
 #include "libewf_filename.h"
 #include "libewf_header_sections.h"
 #include "libewf_header_values.h"
@@ -223,6 +224,22 @@ int libewf_write_io_handle_free(
 			memory_free(
 			 ( *write_io_handle )->compressed_zero_byte_empty_block );
 		}
+		if( ( *write_io_handle )->deflate_encoder != NULL )
+		{
+			if( libewf_deflate_encoder_free(
+			     &( ( *write_io_handle )->deflate_encoder ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free deflate encoder.",
+				 function );
+
+				result = -1;
+			}
+		}
 		if( libewf_chunk_group_free(
 		     &( ( *write_io_handle )->chunk_group ),
 		     error ) != 1 )
@@ -320,6 +337,7 @@ int libewf_write_io_handle_clone(
 	( *destination_write_io_handle )->table_entries_data      = NULL;
 	( *destination_write_io_handle )->table_entries_data_size = 0;
 	( *destination_write_io_handle )->number_of_table_entries = 0;
+	( *destination_write_io_handle )->deflate_encoder         = NULL;
 
 	if( source_write_io_handle->case_data != NULL )
 	{
@@ -786,8 +804,10 @@ int libewf_write_io_handle_initialize_values(
 				  &( write_io_handle->compressed_zero_byte_empty_block_size ),
 				  io_handle->compression_method,
 				  compression_level,
+				  io_handle->compression_flags,
 				  zero_byte_empty_block,
 				  (size_t) media_values->chunk_size,
+				  NULL,
 				  error );
 
 			/* Check if the compressed buffer was too small
@@ -842,8 +862,10 @@ int libewf_write_io_handle_initialize_values(
 					  &( write_io_handle->compressed_zero_byte_empty_block_size ),
 					  io_handle->compression_method,
 					  compression_level,
+					  io_handle->compression_flags,
 					  zero_byte_empty_block,
 					  (size_t) media_values->chunk_size,
+					  NULL,
 					  error );
 			}
 			if( result != 1 )
@@ -3342,8 +3364,8 @@ ssize_t libewf_write_io_handle_write_new_chunk(
 	total_write_count += write_count;
 
 /* TODO re-implement using set by index instead of append ? */
-	if( libfdata_list_append_element(
-	     write_io_handle->chunk_group->chunks_list,
+	if( libewf_chunk_group_append_chunk_range(
+	     write_io_handle->chunk_group,
 	     &element_index,
 	     file_io_pool_entry,
 	     chunk_offset,
@@ -3355,7 +3377,7 @@ ssize_t libewf_write_io_handle_write_new_chunk(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-		 "%s: unable to append chunk: %" PRIu64 " in chunks list.",
+		 "%s: unable to append chunk: %" PRIu64 " range to chunk group.",
 		 function,
 		 chunk_index );
 
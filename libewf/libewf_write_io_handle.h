@@ -37,6 +37,7 @@
 #include "libewf_chunk_data.h"
 #include "libewf_chunk_group.h"
 #include "libewf_chunk_table.h"
+#include "libewf_deflate.h"
 #include "libewf_io_handle.h"
 #include "libewf_libbfio.h"
 #include "libewf_libcerror.h"
@@ -208,6 +209,10 @@ struct libewf_write_io_handle
 	/* The size of the compressed zero byte empty block
 	 */
 	size_t compressed_zero_byte_empty_block_size;
+
+	/* The deflate encoder used to pack chunks on the writing thread
+	 */
+	libewf_deflate_encoder_t *deflate_encoder;
 };
 
 int libewf_write_io_handle_initialize(
@@ -4,9 +4,9 @@ dnl Version: 20161212
 
 dnl Function to detect if tests dependencies are available
 AC_DEFUN([AX_TESTS_CHECK_LOCAL],
-  [AC_CHECK_HEADERS([dlfcn.h])
+  [AC_CHECK_HEADERS([dlfcn.h sys/time.h])
 
-  AC_CHECK_FUNCS([fmemopen getopt])
+  AC_CHECK_FUNCS([fmemopen getopt gettimeofday])
 
   AC_CHECK_LIB(
     dl,
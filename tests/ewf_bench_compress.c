@@ -0,0 +1,904 @@
+/*
+ * Expert Witness Compression Format (EWF) library deflate compression benchmark program
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include <stdio.h>
+
+#if defined( HAVE_ZLIB ) || defined( ZLIB_DLL )
+#include <zlib.h>
+#endif
+
+#include "ewf_bench_functions.h"
+#include "ewf_test_getopt.h"
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+
+#include "../libewf/libewf_deflate.h"
+
+#define EWF_BENCH_COMPRESS_NUMBER_OF_CHUNKS	4096
+#define EWF_BENCH_COMPRESS_NUMBER_OF_ITERATIONS	4
+
+enum EWF_BENCH_COMPRESS_ENCODERS
+{
+	EWF_BENCH_COMPRESS_ENCODER_LIBEWF	= 0,
+	EWF_BENCH_COMPRESS_ENCODER_ZLIB		= 1
+};
+
+/* Prints the executable usage information
+ */
+void ewf_bench_compress_usage_fprint(
+      FILE *stream )
+{
+	if( stream == NULL )
+	{
+		return;
+	}
+	fprintf( stream, "Use ewf_bench_compress to measure the deflate compression throughput\n"
+	                 "and ratio of the built-in encoder and zlib (fast) on the chunks of an\n"
+	                 "image.\n\n" );
+
+	fprintf( stream, "Usage: ewf_bench_compress [ -c number_of_chunks ]\n"
+	                 "                          [ -i number_of_iterations ] source\n\n" );
+
+	fprintf( stream, "\tsource: the first or only segment file of the EWF image\n\n" );
+	fprintf( stream, "\t-c:     specify the maximum number of chunks to read\n"
+	                 "\t        (default is %d)\n", EWF_BENCH_COMPRESS_NUMBER_OF_CHUNKS );
+	fprintf( stream, "\t-i:     specify the number of times the chunks are compressed\n"
+	                 "\t        (default is %d)\n", EWF_BENCH_COMPRESS_NUMBER_OF_ITERATIONS );
+}
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+/* Reads the chunks of the media data
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_bench_compress_read_chunks(
+     libewf_handle_t *handle,
+     uint8_t *media_data,
+     size_t chunk_size,
+     int maximum_number_of_chunks,
+     int *number_of_chunks,
+     libcerror_error_t **error )
+{
+	static char *function = "ewf_bench_compress_read_chunks";
+	ssize_t read_count    = 0;
+	int chunk_index       = 0;
+
+	if( media_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media data.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_chunks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of chunks.",
+		 function );
+
+		return( -1 );
+	}
+	/* Only complete chunks are used
+	 */
+	while( chunk_index < maximum_number_of_chunks )
+	{
+		read_count = libewf_handle_read_buffer(
+		              handle,
+		              &( media_data[ (size_t) chunk_index * chunk_size ] ),
+		              chunk_size,
+		              error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read chunk: %d.",
+			 function,
+			 chunk_index );
+
+			*number_of_chunks = chunk_index;
+
+			return( -1 );
+		}
+		else if( (size_t) read_count != chunk_size )
+		{
+			break;
+		}
+		chunk_index++;
+	}
+	*number_of_chunks = chunk_index;
+
+	return( 1 );
+}
+
+/* Compresses a chunk using a specific encoder
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_bench_compress_chunk(
+     libewf_deflate_encoder_t *encoder,
+     int compressor,
+     const uint8_t *uncompressed_data,
+     size_t uncompressed_data_size,
+     uint8_t *compressed_data,
+     size_t *compressed_data_size,
+     libcerror_error_t **error )
+{
+	static char *function            = "ewf_bench_compress_chunk";
+
+#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) ) || defined( ZLIB_DLL )
+	uLongf zlib_compressed_data_size = 0;
+	int result                       = 0;
+#endif
+
+	if( compressor == EWF_BENCH_COMPRESS_ENCODER_LIBEWF )
+	{
+		if( libewf_deflate_encoder_compress(
+		     encoder,
+		     uncompressed_data,
+		     uncompressed_data_size,
+		     compressed_data,
+		     compressed_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+			 LIBCERROR_COMPRESSION_ERROR_COMPRESS_FAILED,
+			 "%s: unable to compress chunk.",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) ) || defined( ZLIB_DLL )
+	if( compressor == EWF_BENCH_COMPRESS_ENCODER_ZLIB )
+	{
+		zlib_compressed_data_size = (uLongf) *compressed_data_size;
+
+		result = compress2(
+		          (Bytef *) compressed_data,
+		          &zlib_compressed_data_size,
+		          (Bytef *) uncompressed_data,
+		          (uLong) uncompressed_data_size,
+		          Z_BEST_SPEED );
+
+		if( result != Z_OK )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+			 LIBCERROR_COMPRESSION_ERROR_COMPRESS_FAILED,
+			 "%s: unable to compress chunk with zlib: %d.",
+			 function,
+			 result );
+
+			return( -1 );
+		}
+		*compressed_data_size = (size_t) zlib_compressed_data_size;
+
+		return( 1 );
+	}
+#endif
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+	 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+	 "%s: unsupported encoder.",
+	 function );
+
+	return( -1 );
+}
+
+/* Checks if the chunks compressed by the built-in encoder decompress to the original data
+ * The data is decompressed with zlib if available or the built-in decoder otherwise
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_bench_compress_verify_encoder(
+     libewf_deflate_encoder_t *encoder,
+     const uint8_t *media_data,
+     int number_of_chunks,
+     size_t chunk_size,
+     uint8_t *compressed_data,
+     size_t maximum_compressed_data_size,
+     uint8_t *uncompressed_data,
+     libcerror_error_t **error )
+{
+	const uint8_t *chunk_data          = NULL;
+	static char *function              = "ewf_bench_compress_verify_encoder";
+	size_t compressed_data_size        = 0;
+	size_t uncompressed_data_size      = 0;
+	int chunk_index                    = 0;
+
+#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_UNCOMPRESS ) ) || defined( ZLIB_DLL )
+	uLongf zlib_uncompressed_data_size = 0;
+	int result                         = 0;
+#endif
+
+	for( chunk_index = 0;
+	     chunk_index < number_of_chunks;
+	     chunk_index++ )
+	{
+		chunk_data           = &( media_data[ (size_t) chunk_index * chunk_size ] );
+		compressed_data_size = maximum_compressed_data_size;
+
+		if( ewf_bench_compress_chunk(
+		     encoder,
+		     EWF_BENCH_COMPRESS_ENCODER_LIBEWF,
+		     chunk_data,
+		     chunk_size,
+		     compressed_data,
+		     &compressed_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+			 LIBCERROR_COMPRESSION_ERROR_COMPRESS_FAILED,
+			 "%s: unable to compress chunk: %d.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_UNCOMPRESS ) ) || defined( ZLIB_DLL )
+		zlib_uncompressed_data_size = (uLongf) chunk_size;
+
+		result = uncompress(
+		          (Bytef *) uncompressed_data,
+		          &zlib_uncompressed_data_size,
+		          (Bytef *) compressed_data,
+		          (uLong) compressed_data_size );
+
+		if( result != Z_OK )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to decompress chunk: %d with zlib: %d.\n",
+			 chunk_index,
+			 result );
+
+			return( 0 );
+		}
+		uncompressed_data_size = (size_t) zlib_uncompressed_data_size;
+#else
+		uncompressed_data_size = chunk_size;
+
+		if( libewf_deflate_decompress(
+		     compressed_data,
+		     compressed_data_size,
+		     uncompressed_data,
+		     &uncompressed_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+			 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+			 "%s: unable to decompress chunk: %d.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+#endif
+		if( ( uncompressed_data_size != chunk_size )
+		 || ( memory_compare(
+		       uncompressed_data,
+		       chunk_data,
+		       chunk_size ) != 0 ) )
+		{
+			fprintf(
+			 stderr,
+			 "Mismatch in decompressed data of chunk: %d.\n",
+			 chunk_index );
+
+			return( 0 );
+		}
+	}
+	return( 1 );
+}
+
+/* Compresses the chunks a number of times using a specific encoder
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_bench_compress(
+     libewf_deflate_encoder_t *encoder,
+     const uint8_t *media_data,
+     int number_of_chunks,
+     size_t chunk_size,
+     int compressor,
+     int number_of_iterations,
+     uint8_t *compressed_data,
+     size_t maximum_compressed_data_size,
+     size64_t *compressed_size,
+     uint64_t *elapsed_time,
+     libcerror_error_t **error )
+{
+	static char *function       = "ewf_bench_compress";
+	size_t compressed_data_size = 0;
+	uint64_t start_time         = 0;
+	int chunk_index             = 0;
+	int iteration               = 0;
+
+	*compressed_size = 0;
+
+	start_time = ewf_bench_get_time_in_microseconds();
+
+	for( iteration = 0;
+	     iteration < number_of_iterations;
+	     iteration++ )
+	{
+		for( chunk_index = 0;
+		     chunk_index < number_of_chunks;
+		     chunk_index++ )
+		{
+			compressed_data_size = maximum_compressed_data_size;
+
+			if( ewf_bench_compress_chunk(
+			     encoder,
+			     compressor,
+			     &( media_data[ (size_t) chunk_index * chunk_size ] ),
+			     chunk_size,
+			     compressed_data,
+			     &compressed_data_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+				 LIBCERROR_COMPRESSION_ERROR_COMPRESS_FAILED,
+				 "%s: unable to compress chunk: %d.",
+				 function,
+				 chunk_index );
+
+				return( -1 );
+			}
+			*compressed_size += compressed_data_size;
+		}
+	}
+	*elapsed_time = ewf_bench_get_time_in_microseconds() - start_time;
+
+	return( 1 );
+}
+
+/* Prints the results of an encoder
+ */
+void ewf_bench_compress_results_fprint(
+      FILE *stream,
+      const char *encoder_name,
+      size64_t uncompressed_size,
+      size64_t compressed_size,
+      uint64_t elapsed_time )
+{
+	if( elapsed_time == 0 )
+	{
+		elapsed_time = 1;
+	}
+	fprintf(
+	 stream,
+	 "%s\t%" PRIu64 "\t\t%.1f\t%.3f\n",
+	 encoder_name,
+	 elapsed_time / 1000,
+	 ( (double) uncompressed_size / ( 1024.0 * 1024.0 ) ) / ( (double) elapsed_time / 1000000.0 ),
+	 (double) compressed_size / (double) uncompressed_size );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+	libcerror_error_t *error                        = NULL;
+	libewf_handle_t *handle                         = NULL;
+	system_character_t **filenames                  = NULL;
+	system_character_t *option_number_of_chunks     = NULL;
+	system_character_t *option_number_of_iterations = NULL;
+	system_integer_t option                         = 0;
+	size_t string_length                            = 0;
+	uint64_t maximum_number_of_chunks               = EWF_BENCH_COMPRESS_NUMBER_OF_CHUNKS;
+	uint64_t number_of_iterations                   = EWF_BENCH_COMPRESS_NUMBER_OF_ITERATIONS;
+	int number_of_filenames                         = 0;
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+	libewf_deflate_encoder_t *encoder               = NULL;
+	uint8_t *compressed_data                        = NULL;
+	uint8_t *media_data                             = NULL;
+	uint8_t *uncompressed_data                      = NULL;
+	size64_t compressed_size                        = 0;
+	size64_t uncompressed_size                      = 0;
+	size_t maximum_compressed_data_size             = 0;
+	uint64_t elapsed_time                           = 0;
+	size32_t chunk_size                             = 0;
+	int number_of_chunks                            = 0;
+	int result                                      = 0;
+#endif
+
+	while( ( option = ewf_test_getopt(
+	                   argc,
+	                   argv,
+	                   _SYSTEM_STRING( "c:hi:" ) ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_SYSTEM ".\n",
+				 argv[ optind - 1 ] );
+
+				ewf_bench_compress_usage_fprint(
+				 stdout );
+
+				return( EXIT_FAILURE );
+
+			case (system_integer_t) 'c':
+				option_number_of_chunks = optarg;
+
+				break;
+
+			case (system_integer_t) 'h':
+				ewf_bench_compress_usage_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+
+			case (system_integer_t) 'i':
+				option_number_of_iterations = optarg;
+
+				break;
+		}
+	}
+	if( optind == argc )
+	{
+		fprintf(
+		 stderr,
+		 "Missing source file.\n" );
+
+		ewf_bench_compress_usage_fprint(
+		 stdout );
+
+		return( EXIT_FAILURE );
+	}
+#if !defined( __GNUC__ ) || defined( LIBEWF_DLL_IMPORT )
+	fprintf(
+	 stderr,
+	 "Access to the library internal functions is not available.\n" );
+
+	return( EXIT_FAILURE );
+#else
+	if( option_number_of_chunks != NULL )
+	{
+		string_length = system_string_length(
+		                 option_number_of_chunks );
+
+		if( ( ewf_bench_system_string_decimal_copy_to_64_bit(
+		       option_number_of_chunks,
+		       string_length + 1,
+		       &maximum_number_of_chunks,
+		       &error ) != 1 )
+		 || ( maximum_number_of_chunks == 0 )
+		 || ( maximum_number_of_chunks > (uint64_t) INT_MAX ) )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported number of chunks.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_number_of_iterations != NULL )
+	{
+		string_length = system_string_length(
+		                 option_number_of_iterations );
+
+		if( ( ewf_bench_system_string_decimal_copy_to_64_bit(
+		       option_number_of_iterations,
+		       string_length + 1,
+		       &number_of_iterations,
+		       &error ) != 1 )
+		 || ( number_of_iterations == 0 )
+		 || ( number_of_iterations > (uint64_t) INT_MAX ) )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported number of iterations.\n" );
+
+			goto on_error;
+		}
+	}
+	string_length = system_string_length(
+	                 argv[ optind ] );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_glob_wide(
+	     argv[ optind ],
+	     string_length,
+	     LIBEWF_FORMAT_UNKNOWN,
+	     &filenames,
+	     &number_of_filenames,
+	     &error ) != 1 )
+#else
+	if( libewf_glob(
+	     argv[ optind ],
+	     string_length,
+	     LIBEWF_FORMAT_UNKNOWN,
+	     &filenames,
+	     &number_of_filenames,
+	     &error ) != 1 )
+#endif
+	{
+		fprintf(
+		 stderr,
+		 "Unable to glob filenames.\n" );
+
+		goto on_error;
+	}
+	if( libewf_handle_initialize(
+	     &handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create handle.\n" );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_handle_open_wide(
+	     handle,
+	     filenames,
+	     number_of_filenames,
+	     LIBEWF_OPEN_READ,
+	     &error ) != 1 )
+#else
+	if( libewf_handle_open(
+	     handle,
+	     filenames,
+	     number_of_filenames,
+	     LIBEWF_OPEN_READ,
+	     &error ) != 1 )
+#endif
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open handle.\n" );
+
+		goto on_error;
+	}
+	if( libewf_handle_get_chunk_size(
+	     handle,
+	     &chunk_size,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to retrieve chunk size.\n" );
+
+		goto on_error;
+	}
+	if( ( chunk_size == 0 )
+	 || ( maximum_number_of_chunks > (uint64_t) ( (size_t) SSIZE_MAX / chunk_size ) ) )
+	{
+		fprintf(
+		 stderr,
+		 "Unsupported chunk size.\n" );
+
+		goto on_error;
+	}
+	media_data = (uint8_t *) memory_allocate(
+	                          sizeof( uint8_t ) * (size_t) maximum_number_of_chunks * chunk_size );
+
+	if( media_data == NULL )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create media data.\n" );
+
+		goto on_error;
+	}
+	maximum_compressed_data_size = libewf_deflate_get_compressed_data_size_bound(
+	                                (size_t) chunk_size );
+
+	compressed_data = (uint8_t *) memory_allocate(
+	                               sizeof( uint8_t ) * maximum_compressed_data_size );
+
+	if( compressed_data == NULL )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create compressed data.\n" );
+
+		goto on_error;
+	}
+	uncompressed_data = (uint8_t *) memory_allocate(
+	                                 sizeof( uint8_t ) * chunk_size );
+
+	if( uncompressed_data == NULL )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create uncompressed data.\n" );
+
+		goto on_error;
+	}
+	if( ewf_bench_compress_read_chunks(
+	     handle,
+	     media_data,
+	     (size_t) chunk_size,
+	     (int) maximum_number_of_chunks,
+	     &number_of_chunks,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to read chunks.\n" );
+
+		goto on_error;
+	}
+	if( number_of_chunks == 0 )
+	{
+		fprintf(
+		 stderr,
+		 "No chunks found.\n" );
+
+		goto on_error;
+	}
+	uncompressed_size = (size64_t) number_of_chunks * chunk_size * number_of_iterations;
+
+	fprintf(
+	 stdout,
+	 "Compressing: %d chunks of %" PRIu32 " bytes %" PRIu64 " times\n\n",
+	 number_of_chunks,
+	 chunk_size,
+	 number_of_iterations );
+
+	/* The encoder is reused for all the chunks, as it would be by a writer
+	 */
+	if( libewf_deflate_encoder_initialize(
+	     &encoder,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create encoder.\n" );
+
+		goto on_error;
+	}
+	result = ewf_bench_compress_verify_encoder(
+	          encoder,
+	          media_data,
+	          number_of_chunks,
+	          (size_t) chunk_size,
+	          compressed_data,
+	          maximum_compressed_data_size,
+	          uncompressed_data,
+	          &error );
+
+	if( result != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to verify encoder.\n" );
+
+		goto on_error;
+	}
+	fprintf(
+	 stdout,
+	 "encoder\ttime (ms)\tMiB/s\tratio\n" );
+
+	if( ewf_bench_compress(
+	     encoder,
+	     media_data,
+	     number_of_chunks,
+	     (size_t) chunk_size,
+	     EWF_BENCH_COMPRESS_ENCODER_LIBEWF,
+	     (int) number_of_iterations,
+	     compressed_data,
+	     maximum_compressed_data_size,
+	     &compressed_size,
+	     &elapsed_time,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to compress chunks.\n" );
+
+		goto on_error;
+	}
+	ewf_bench_compress_results_fprint(
+	 stdout,
+	 "libewf",
+	 uncompressed_size,
+	 compressed_size,
+	 elapsed_time );
+
+#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) ) || defined( ZLIB_DLL )
+	if( ewf_bench_compress(
+	     NULL,
+	     media_data,
+	     number_of_chunks,
+	     (size_t) chunk_size,
+	     EWF_BENCH_COMPRESS_ENCODER_ZLIB,
+	     (int) number_of_iterations,
+	     compressed_data,
+	     maximum_compressed_data_size,
+	     &compressed_size,
+	     &elapsed_time,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to compress chunks with zlib.\n" );
+
+		goto on_error;
+	}
+	ewf_bench_compress_results_fprint(
+	 stdout,
+	 "zlib",
+	 uncompressed_size,
+	 compressed_size,
+	 elapsed_time );
+#endif
+	if( libewf_deflate_encoder_free(
+	     &encoder,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free encoder.\n" );
+
+		goto on_error;
+	}
+	memory_free(
+	 uncompressed_data );
+
+	uncompressed_data = NULL;
+
+	memory_free(
+	 compressed_data );
+
+	compressed_data = NULL;
+
+	memory_free(
+	 media_data );
+
+	media_data = NULL;
+
+	if( libewf_handle_close(
+	     handle,
+	     &error ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close handle.\n" );
+
+		goto on_error;
+	}
+	if( libewf_handle_free(
+	     &handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free handle.\n" );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_glob_wide_free(
+	     filenames,
+	     number_of_filenames,
+	     &error ) != 1 )
+#else
+	if( libewf_glob_free(
+	     filenames,
+	     number_of_filenames,
+	     &error ) != 1 )
+#endif
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free glob.\n" );
+
+		goto on_error;
+	}
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	if( encoder != NULL )
+	{
+		libewf_deflate_encoder_free(
+		 &encoder,
+		 NULL );
+	}
+	if( uncompressed_data != NULL )
+	{
+		memory_free(
+		 uncompressed_data );
+	}
+	if( compressed_data != NULL )
+	{
+		memory_free(
+		 compressed_data );
+	}
+	if( media_data != NULL )
+	{
+		memory_free(
+		 media_data );
+	}
+	if( handle != NULL )
+	{
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	if( filenames != NULL )
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		libewf_glob_wide_free(
+		 filenames,
+		 number_of_filenames,
+		 NULL );
+#else
+		libewf_glob_free(
+		 filenames,
+		 number_of_filenames,
+		 NULL );
+#endif
+	}
+	return( EXIT_FAILURE );
+
+#endif /* !defined( __GNUC__ ) || defined( LIBEWF_DLL_IMPORT ) */
+}
+
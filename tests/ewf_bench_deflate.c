@@ -0,0 +1,933 @@
+/*
+ * Expert Witness Compression Format (EWF) library deflate decompression benchmark program
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include <stdio.h>
+
+#if defined( HAVE_ZLIB ) || defined( ZLIB_DLL )
+#include <zlib.h>
+#endif
+
+#include "ewf_bench_functions.h"
+#include "ewf_test_getopt.h"
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+
+#include "../libewf/libewf_chunk_data.h"
+#include "../libewf/libewf_data_chunk.h"
+#include "../libewf/libewf_definitions.h"
+#include "../libewf/libewf_deflate.h"
+
+#define EWF_BENCH_DEFLATE_NUMBER_OF_CHUNKS	4096
+#define EWF_BENCH_DEFLATE_NUMBER_OF_ITERATIONS	4
+
+enum EWF_BENCH_DEFLATE_DECODERS
+{
+	EWF_BENCH_DEFLATE_DECODER_LIBEWF	= 0,
+	EWF_BENCH_DEFLATE_DECODER_ZLIB		= 1
+};
+
+typedef struct ewf_bench_deflate_chunk ewf_bench_deflate_chunk_t;
+
+struct ewf_bench_deflate_chunk
+{
+	/* The compressed data
+	 */
+	uint8_t *compressed_data;
+
+	/* The compressed data size
+	 */
+	size_t compressed_data_size;
+};
+
+/* Prints the executable usage information
+ */
+void ewf_bench_deflate_usage_fprint(
+      FILE *stream )
+{
+	if( stream == NULL )
+	{
+		return;
+	}
+	fprintf( stream, "Use ewf_bench_deflate to measure the deflate decompression throughput\n"
+	                 "of the built-in decoder and zlib on the compressed chunks of an image.\n\n" );
+
+	fprintf( stream, "Usage: ewf_bench_deflate [ -c number_of_chunks ]\n"
+	                 "                         [ -i number_of_iterations ] source\n\n" );
+
+	fprintf( stream, "\tsource: the first or only segment file of the EWF image\n\n" );
+	fprintf( stream, "\t-c:     specify the maximum number of compressed chunks to read\n"
+	                 "\t        (default is %d)\n", EWF_BENCH_DEFLATE_NUMBER_OF_CHUNKS );
+	fprintf( stream, "\t-i:     specify the number of times the chunks are decompressed\n"
+	                 "\t        (default is %d)\n", EWF_BENCH_DEFLATE_NUMBER_OF_ITERATIONS );
+}
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+/* Reads the compressed chunks of the media data
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_bench_deflate_read_chunks(
+     libewf_handle_t *handle,
+     ewf_bench_deflate_chunk_t *chunks,
+     int maximum_number_of_chunks,
+     int *number_of_chunks,
+     libcerror_error_t **error )
+{
+	libewf_chunk_data_t *chunk_data = NULL;
+	libewf_data_chunk_t *data_chunk = NULL;
+	static char *function           = "ewf_bench_deflate_read_chunks";
+	ssize_t read_count              = 0;
+	int chunk_index                 = 0;
+
+	if( chunks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunks.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_chunks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of chunks.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_handle_get_data_chunk(
+	     handle,
+	     &data_chunk,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve data chunk.",
+		 function );
+
+		goto on_error;
+	}
+	while( chunk_index < maximum_number_of_chunks )
+	{
+		read_count = libewf_handle_read_data_chunk(
+		              handle,
+		              data_chunk,
+		              error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read data chunk.",
+			 function );
+
+			goto on_error;
+		}
+		else if( read_count == 0 )
+		{
+			break;
+		}
+		/* Only the chunks that are stored deflate compressed are used
+		 */
+		chunk_data = ( (libewf_internal_data_chunk_t *) data_chunk )->chunk_data;
+
+		if( ( chunk_data == NULL )
+		 || ( chunk_data->data == NULL )
+		 || ( chunk_data->data_size < 2 ) )
+		{
+			continue;
+		}
+		if( ( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_PACKED ) == 0 )
+		 || ( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED ) == 0 )
+		 || ( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_USES_PATTERN_FILL ) != 0 )
+		 || ( ( chunk_data->data[ 0 ] & 0x0f ) != 8 ) )
+		{
+			continue;
+		}
+		chunks[ chunk_index ].compressed_data = (uint8_t *) memory_allocate(
+		                                                     sizeof( uint8_t ) * chunk_data->data_size );
+
+		if( chunks[ chunk_index ].compressed_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create compressed data: %d.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		if( memory_copy(
+		     chunks[ chunk_index ].compressed_data,
+		     chunk_data->data,
+		     chunk_data->data_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy compressed data: %d.",
+			 function,
+			 chunk_index );
+
+			memory_free(
+			 chunks[ chunk_index ].compressed_data );
+
+			chunks[ chunk_index ].compressed_data = NULL;
+
+			goto on_error;
+		}
+		chunks[ chunk_index ].compressed_data_size = chunk_data->data_size;
+
+		chunk_index++;
+	}
+	if( libewf_data_chunk_free(
+	     &data_chunk,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free data chunk.",
+		 function );
+
+		goto on_error;
+	}
+	*number_of_chunks = chunk_index;
+
+	return( 1 );
+
+on_error:
+	if( data_chunk != NULL )
+	{
+		libewf_data_chunk_free(
+		 &data_chunk,
+		 NULL );
+	}
+	*number_of_chunks = chunk_index;
+
+	return( -1 );
+}
+
+/* Decompresses a chunk using a specific decoder
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_bench_deflate_decompress_chunk(
+     ewf_bench_deflate_chunk_t *chunk,
+     int decoder,
+     uint8_t *uncompressed_data,
+     size_t *uncompressed_data_size,
+     libcerror_error_t **error )
+{
+	static char *function              = "ewf_bench_deflate_decompress_chunk";
+
+#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_UNCOMPRESS ) ) || defined( ZLIB_DLL )
+	uLongf zlib_uncompressed_data_size = 0;
+	int result                         = 0;
+#endif
+
+	if( decoder == EWF_BENCH_DEFLATE_DECODER_LIBEWF )
+	{
+		if( libewf_deflate_decompress(
+		     chunk->compressed_data,
+		     chunk->compressed_data_size,
+		     uncompressed_data,
+		     uncompressed_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+			 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+			 "%s: unable to decompress chunk.",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_UNCOMPRESS ) ) || defined( ZLIB_DLL )
+	if( decoder == EWF_BENCH_DEFLATE_DECODER_ZLIB )
+	{
+		zlib_uncompressed_data_size = (uLongf) *uncompressed_data_size;
+
+		result = uncompress(
+		          (Bytef *) uncompressed_data,
+		          &zlib_uncompressed_data_size,
+		          (Bytef *) chunk->compressed_data,
+		          (uLong) chunk->compressed_data_size );
+
+		if( result != Z_OK )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+			 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+			 "%s: unable to decompress chunk with zlib: %d.",
+			 function,
+			 result );
+
+			return( -1 );
+		}
+		*uncompressed_data_size = (size_t) zlib_uncompressed_data_size;
+
+		return( 1 );
+	}
+#endif
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+	 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+	 "%s: unsupported decoder.",
+	 function );
+
+	return( -1 );
+}
+
+#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_UNCOMPRESS ) ) || defined( ZLIB_DLL )
+
+/* Checks if the decoders decompress the chunks to the same data
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_bench_deflate_compare_decoders(
+     ewf_bench_deflate_chunk_t *chunks,
+     int number_of_chunks,
+     uint8_t *uncompressed_data,
+     uint8_t *reference_data,
+     size_t chunk_size,
+     libcerror_error_t **error )
+{
+	static char *function         = "ewf_bench_deflate_compare_decoders";
+	size_t reference_data_size    = 0;
+	size_t uncompressed_data_size = 0;
+	int chunk_index               = 0;
+
+	for( chunk_index = 0;
+	     chunk_index < number_of_chunks;
+	     chunk_index++ )
+	{
+		uncompressed_data_size = chunk_size;
+
+		if( ewf_bench_deflate_decompress_chunk(
+		     &( chunks[ chunk_index ] ),
+		     EWF_BENCH_DEFLATE_DECODER_LIBEWF,
+		     uncompressed_data,
+		     &uncompressed_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+			 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+			 "%s: unable to decompress chunk: %d.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		reference_data_size = chunk_size;
+
+		if( ewf_bench_deflate_decompress_chunk(
+		     &( chunks[ chunk_index ] ),
+		     EWF_BENCH_DEFLATE_DECODER_ZLIB,
+		     reference_data,
+		     &reference_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+			 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+			 "%s: unable to decompress chunk: %d with zlib.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		if( ( uncompressed_data_size != reference_data_size )
+		 || ( memory_compare(
+		       uncompressed_data,
+		       reference_data,
+		       reference_data_size ) != 0 ) )
+		{
+			fprintf(
+			 stderr,
+			 "Mismatch in decompressed data of chunk: %d.\n",
+			 chunk_index );
+
+			return( 0 );
+		}
+	}
+	return( 1 );
+}
+
+#endif /* ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_UNCOMPRESS ) ) || defined( ZLIB_DLL ) */
+
+/* Decompresses the chunks a number of times using a specific decoder
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_bench_deflate(
+     ewf_bench_deflate_chunk_t *chunks,
+     int number_of_chunks,
+     int decoder,
+     int number_of_iterations,
+     uint8_t *uncompressed_data,
+     size_t chunk_size,
+     size64_t *uncompressed_size,
+     uint64_t *elapsed_time,
+     libcerror_error_t **error )
+{
+	static char *function         = "ewf_bench_deflate";
+	size_t uncompressed_data_size = 0;
+	uint64_t start_time           = 0;
+	int chunk_index               = 0;
+	int iteration                 = 0;
+
+	*uncompressed_size = 0;
+
+	start_time = ewf_bench_get_time_in_microseconds();
+
+	for( iteration = 0;
+	     iteration < number_of_iterations;
+	     iteration++ )
+	{
+		for( chunk_index = 0;
+		     chunk_index < number_of_chunks;
+		     chunk_index++ )
+		{
+			uncompressed_data_size = chunk_size;
+
+			if( ewf_bench_deflate_decompress_chunk(
+			     &( chunks[ chunk_index ] ),
+			     decoder,
+			     uncompressed_data,
+			     &uncompressed_data_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+				 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+				 "%s: unable to decompress chunk: %d.",
+				 function,
+				 chunk_index );
+
+				return( -1 );
+			}
+			*uncompressed_size += uncompressed_data_size;
+		}
+	}
+	*elapsed_time = ewf_bench_get_time_in_microseconds() - start_time;
+
+	return( 1 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+	libcerror_error_t *error                        = NULL;
+	libewf_handle_t *handle                         = NULL;
+	system_character_t **filenames                  = NULL;
+	system_character_t *option_number_of_chunks     = NULL;
+	system_character_t *option_number_of_iterations = NULL;
+	system_integer_t option                         = 0;
+	size_t string_length                            = 0;
+	uint64_t maximum_number_of_chunks               = EWF_BENCH_DEFLATE_NUMBER_OF_CHUNKS;
+	uint64_t number_of_iterations                   = EWF_BENCH_DEFLATE_NUMBER_OF_ITERATIONS;
+	int number_of_filenames                         = 0;
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+	ewf_bench_deflate_chunk_t *chunks               = NULL;
+	uint8_t *reference_data                         = NULL;
+	uint8_t *uncompressed_data                      = NULL;
+	size64_t compressed_size                        = 0;
+	size64_t uncompressed_size                      = 0;
+	uint64_t elapsed_time                           = 0;
+	size32_t chunk_size                             = 0;
+	int chunk_index                                 = 0;
+	int number_of_chunks                            = 0;
+#endif
+
+	while( ( option = ewf_test_getopt(
+	                   argc,
+	                   argv,
+	                   _SYSTEM_STRING( "c:hi:" ) ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_SYSTEM ".\n",
+				 argv[ optind - 1 ] );
+
+				ewf_bench_deflate_usage_fprint(
+				 stdout );
+
+				return( EXIT_FAILURE );
+
+			case (system_integer_t) 'c':
+				option_number_of_chunks = optarg;
+
+				break;
+
+			case (system_integer_t) 'h':
+				ewf_bench_deflate_usage_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+
+			case (system_integer_t) 'i':
+				option_number_of_iterations = optarg;
+
+				break;
+		}
+	}
+	if( optind == argc )
+	{
+		fprintf(
+		 stderr,
+		 "Missing source file.\n" );
+
+		ewf_bench_deflate_usage_fprint(
+		 stdout );
+
+		return( EXIT_FAILURE );
+	}
+#if !defined( __GNUC__ ) || defined( LIBEWF_DLL_IMPORT )
+	fprintf(
+	 stderr,
+	 "Access to the library internal functions is not available.\n" );
+
+	return( EXIT_FAILURE );
+#else
+	if( option_number_of_chunks != NULL )
+	{
+		string_length = system_string_length(
+		                 option_number_of_chunks );
+
+		if( ( ewf_bench_system_string_decimal_copy_to_64_bit(
+		       option_number_of_chunks,
+		       string_length + 1,
+		       &maximum_number_of_chunks,
+		       &error ) != 1 )
+		 || ( maximum_number_of_chunks == 0 )
+		 || ( maximum_number_of_chunks > (uint64_t) ( INT_MAX / sizeof( ewf_bench_deflate_chunk_t ) ) ) )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported number of chunks.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_number_of_iterations != NULL )
+	{
+		string_length = system_string_length(
+		                 option_number_of_iterations );
+
+		if( ( ewf_bench_system_string_decimal_copy_to_64_bit(
+		       option_number_of_iterations,
+		       string_length + 1,
+		       &number_of_iterations,
+		       &error ) != 1 )
+		 || ( number_of_iterations == 0 )
+		 || ( number_of_iterations > (uint64_t) INT_MAX ) )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported number of iterations.\n" );
+
+			goto on_error;
+		}
+	}
+	string_length = system_string_length(
+	                 argv[ optind ] );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_glob_wide(
+	     argv[ optind ],
+	     string_length,
+	     LIBEWF_FORMAT_UNKNOWN,
+	     &filenames,
+	     &number_of_filenames,
+	     &error ) != 1 )
+#else
+	if( libewf_glob(
+	     argv[ optind ],
+	     string_length,
+	     LIBEWF_FORMAT_UNKNOWN,
+	     &filenames,
+	     &number_of_filenames,
+	     &error ) != 1 )
+#endif
+	{
+		fprintf(
+		 stderr,
+		 "Unable to glob filenames.\n" );
+
+		goto on_error;
+	}
+	if( libewf_handle_initialize(
+	     &handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create handle.\n" );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_handle_open_wide(
+	     handle,
+	     filenames,
+	     number_of_filenames,
+	     LIBEWF_OPEN_READ,
+	     &error ) != 1 )
+#else
+	if( libewf_handle_open(
+	     handle,
+	     filenames,
+	     number_of_filenames,
+	     LIBEWF_OPEN_READ,
+	     &error ) != 1 )
+#endif
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open handle.\n" );
+
+		goto on_error;
+	}
+	if( libewf_handle_get_chunk_size(
+	     handle,
+	     &chunk_size,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to retrieve chunk size.\n" );
+
+		goto on_error;
+	}
+	chunks = (ewf_bench_deflate_chunk_t *) memory_allocate(
+	                                        sizeof( ewf_bench_deflate_chunk_t ) * (size_t) maximum_number_of_chunks );
+
+	if( chunks == NULL )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create chunks.\n" );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     chunks,
+	     0,
+	     sizeof( ewf_bench_deflate_chunk_t ) * (size_t) maximum_number_of_chunks ) == NULL )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to clear chunks.\n" );
+
+		goto on_error;
+	}
+	uncompressed_data = (uint8_t *) memory_allocate(
+	                                 sizeof( uint8_t ) * chunk_size );
+
+	if( uncompressed_data == NULL )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create uncompressed data.\n" );
+
+		goto on_error;
+	}
+	reference_data = (uint8_t *) memory_allocate(
+	                              sizeof( uint8_t ) * chunk_size );
+
+	if( reference_data == NULL )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create reference data.\n" );
+
+		goto on_error;
+	}
+	if( ewf_bench_deflate_read_chunks(
+	     handle,
+	     chunks,
+	     (int) maximum_number_of_chunks,
+	     &number_of_chunks,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to read compressed chunks.\n" );
+
+		goto on_error;
+	}
+	if( number_of_chunks == 0 )
+	{
+		fprintf(
+		 stderr,
+		 "No deflate compressed chunks found.\n" );
+
+		goto on_error;
+	}
+	for( chunk_index = 0;
+	     chunk_index < number_of_chunks;
+	     chunk_index++ )
+	{
+		compressed_size += chunks[ chunk_index ].compressed_data_size;
+	}
+	fprintf(
+	 stdout,
+	 "Decompressing: %d chunks of %" PRIu32 " bytes (%" PRIu64 " compressed bytes) %" PRIu64 " times\n\n",
+	 number_of_chunks,
+	 chunk_size,
+	 compressed_size,
+	 number_of_iterations );
+
+#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_UNCOMPRESS ) ) || defined( ZLIB_DLL )
+	if( ewf_bench_deflate_compare_decoders(
+	     chunks,
+	     number_of_chunks,
+	     uncompressed_data,
+	     reference_data,
+	     (size_t) chunk_size,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to compare decoders.\n" );
+
+		goto on_error;
+	}
+#endif
+	fprintf(
+	 stdout,
+	 "decoder\ttime (ms)\tMiB/s\n" );
+
+	if( ewf_bench_deflate(
+	     chunks,
+	     number_of_chunks,
+	     EWF_BENCH_DEFLATE_DECODER_LIBEWF,
+	     (int) number_of_iterations,
+	     uncompressed_data,
+	     (size_t) chunk_size,
+	     &uncompressed_size,
+	     &elapsed_time,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to decompress chunks.\n" );
+
+		goto on_error;
+	}
+	if( elapsed_time == 0 )
+	{
+		elapsed_time = 1;
+	}
+	fprintf(
+	 stdout,
+	 "libewf\t%" PRIu64 "\t\t%.1f\n",
+	 elapsed_time / 1000,
+	 ( (double) uncompressed_size / ( 1024.0 * 1024.0 ) ) / ( (double) elapsed_time / 1000000.0 ) );
+
+#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_UNCOMPRESS ) ) || defined( ZLIB_DLL )
+	if( ewf_bench_deflate(
+	     chunks,
+	     number_of_chunks,
+	     EWF_BENCH_DEFLATE_DECODER_ZLIB,
+	     (int) number_of_iterations,
+	     uncompressed_data,
+	     (size_t) chunk_size,
+	     &uncompressed_size,
+	     &elapsed_time,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to decompress chunks with zlib.\n" );
+
+		goto on_error;
+	}
+	if( elapsed_time == 0 )
+	{
+		elapsed_time = 1;
+	}
+	fprintf(
+	 stdout,
+	 "zlib\t%" PRIu64 "\t\t%.1f\n",
+	 elapsed_time / 1000,
+	 ( (double) uncompressed_size / ( 1024.0 * 1024.0 ) ) / ( (double) elapsed_time / 1000000.0 ) );
+#endif
+	for( chunk_index = 0;
+	     chunk_index < number_of_chunks;
+	     chunk_index++ )
+	{
+		memory_free(
+		 chunks[ chunk_index ].compressed_data );
+	}
+	memory_free(
+	 chunks );
+
+	chunks = NULL;
+
+	memory_free(
+	 reference_data );
+
+	reference_data = NULL;
+
+	memory_free(
+	 uncompressed_data );
+
+	uncompressed_data = NULL;
+
+	if( libewf_handle_close(
+	     handle,
+	     &error ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close handle.\n" );
+
+		goto on_error;
+	}
+	if( libewf_handle_free(
+	     &handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free handle.\n" );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_glob_wide_free(
+	     filenames,
+	     number_of_filenames,
+	     &error ) != 1 )
+#else
+	if( libewf_glob_free(
+	     filenames,
+	     number_of_filenames,
+	     &error ) != 1 )
+#endif
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free glob.\n" );
+
+		goto on_error;
+	}
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunks != NULL )
+	{
+		for( chunk_index = 0;
+		     chunk_index < number_of_chunks;
+		     chunk_index++ )
+		{
+			memory_free(
+			 chunks[ chunk_index ].compressed_data );
+		}
+		memory_free(
+		 chunks );
+	}
+	if( reference_data != NULL )
+	{
+		memory_free(
+		 reference_data );
+	}
+	if( uncompressed_data != NULL )
+	{
+		memory_free(
+		 uncompressed_data );
+	}
+	if( handle != NULL )
+	{
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	if( filenames != NULL )
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		libewf_glob_wide_free(
+		 filenames,
+		 number_of_filenames,
+		 NULL );
+#else
+		libewf_glob_free(
+		 filenames,
+		 number_of_filenames,
+		 NULL );
+#endif
+	}
+	return( EXIT_FAILURE );
+
+#endif /* !defined( __GNUC__ ) || defined( LIBEWF_DLL_IMPORT ) */
+}
+
@@ -0,0 +1,48 @@
+/*
+ * Functions for benchmarking
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _EWF_BENCH_FUNCTIONS_H )
+#define _EWF_BENCH_FUNCTIONS_H
+
+#include <common.h>
+#include <types.h>
+
+#include "ewf_test_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+uint64_t ewf_bench_get_time_in_microseconds(
+          void );
+
+int ewf_bench_system_string_decimal_copy_to_64_bit(
+     const system_character_t *string,
+     size_t string_size,
+     uint64_t *value_64bit,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _EWF_BENCH_FUNCTIONS_H ) */
+
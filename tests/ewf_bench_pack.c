@@ -0,0 +1,529 @@
+/*
+ * Expert Witness Compression Format (EWF) library chunk pack allocation benchmark program
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include <stdio.h>
+
+#include "ewf_bench_functions.h"
+#include "ewf_test_getopt.h"
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+
+#include "../libewf/libewf_buffer_pool.h"
+#include "../libewf/libewf_chunk_data.h"
+#include "../libewf/libewf_definitions.h"
+#include "../libewf/libewf_deflate.h"
+#include "../libewf/libewf_io_handle.h"
+
+#define EWF_BENCH_PACK_CHUNK_SIZE		32768
+#define EWF_BENCH_PACK_NUMBER_OF_CHUNKS		16384
+
+/* Prints the executable usage information
+ */
+void ewf_bench_pack_usage_fprint(
+      FILE *stream )
+{
+	if( stream == NULL )
+	{
+		return;
+	}
+	fprintf( stream, "Use ewf_bench_pack to count the buffer allocations needed to pack\n"
+	                 "chunks with and without reusing the chunk buffers.\n\n" );
+
+	fprintf( stream, "Usage: ewf_bench_pack [ -c number_of_chunks ] [ -s chunk_size ]\n\n" );
+
+	fprintf( stream, "\t-c:     specify the number of chunks to pack\n"
+	                 "\t        (default is %d)\n", EWF_BENCH_PACK_NUMBER_OF_CHUNKS );
+	fprintf( stream, "\t-s:     specify the chunk size\n"
+	                 "\t        (default is %d)\n", EWF_BENCH_PACK_CHUNK_SIZE );
+}
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+/* Fills the source data with chunks of varying compressibility
+ * The first chunk contains zero bytes, the second text, the third pseudo random data
+ * and the fourth half text and half pseudo random data
+ */
+void ewf_bench_pack_fill_source_data(
+      uint8_t *source_data,
+      size32_t chunk_size )
+{
+	const char *text      = "The quick brown fox jumps over the lazy dog. ";
+	size_t data_offset    = 0;
+	size_t text_length    = 0;
+	uint32_t random_value = 0x12345678UL;
+
+	text_length = narrow_string_length(
+	               text );
+
+	for( data_offset = 0;
+	     data_offset < (size_t) chunk_size;
+	     data_offset++ )
+	{
+		source_data[ data_offset ]              = 0;
+		source_data[ chunk_size + data_offset ] = (uint8_t) text[ data_offset % text_length ];
+
+		random_value = ( random_value * 1103515245UL ) + 12345;
+
+		source_data[ ( 2 * (size_t) chunk_size ) + data_offset ] = (uint8_t) ( random_value >> 16 );
+
+		if( data_offset < ( (size_t) chunk_size / 2 ) )
+		{
+			source_data[ ( 3 * (size_t) chunk_size ) + data_offset ] = (uint8_t) text[ data_offset % text_length ];
+		}
+		else
+		{
+			source_data[ ( 3 * (size_t) chunk_size ) + data_offset ] = (uint8_t) ( random_value >> 8 );
+		}
+	}
+}
+
+/* Packs a number of chunks using chunk data that retrieves its buffers from a buffer pool
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_bench_pack(
+     libewf_io_handle_t *io_handle,
+     const uint8_t *source_data,
+     size32_t chunk_size,
+     int number_of_chunks,
+     int maximum_number_of_buffers,
+     uint64_t *number_of_allocations,
+     uint64_t *number_of_reuses,
+     uint64_t *elapsed_time,
+     libcerror_error_t **error )
+{
+	libewf_buffer_pool_t *buffer_pool         = NULL;
+	libewf_chunk_data_t *chunk_data           = NULL;
+	libewf_deflate_encoder_t *deflate_encoder = NULL;
+	static char *function                     = "ewf_bench_pack";
+	uint64_t start_time                       = 0;
+	size_t buffer_size                        = 0;
+	int chunk_index                           = 0;
+
+	/* The buffers are large enough for the data and the compressed data of a chunk
+	 */
+	buffer_size = ( ( (size_t) chunk_size + 4 + 15 ) / 16 ) * 16;
+
+	if( libewf_buffer_pool_initialize(
+	     &buffer_pool,
+	     buffer_size,
+	     maximum_number_of_buffers,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create buffer pool.",
+		 function );
+
+		goto on_error;
+	}
+	start_time = ewf_bench_get_time_in_microseconds();
+
+	for( chunk_index = 0;
+	     chunk_index < number_of_chunks;
+	     chunk_index++ )
+	{
+		if( libewf_chunk_data_initialize_with_buffer_pool(
+		     &chunk_data,
+		     buffer_pool,
+		     chunk_size,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create chunk: %d data.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		if( memory_copy(
+		     chunk_data->data,
+		     &( source_data[ ( chunk_index % 4 ) * (size_t) chunk_size ] ),
+		     (size_t) chunk_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy chunk: %d data.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		chunk_data->data_size = (size_t) chunk_size;
+
+		if( libewf_chunk_data_pack(
+		     chunk_data,
+		     io_handle,
+		     NULL,
+		     0,
+		     LIBEWF_PACK_FLAG_CALCULATE_CHECKSUM,
+		     &deflate_encoder,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to pack chunk: %d data.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		if( libewf_chunk_data_free(
+		     &chunk_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk: %d data.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+	}
+	*elapsed_time = ewf_bench_get_time_in_microseconds() - start_time;
+
+	if( deflate_encoder != NULL )
+	{
+		if( libewf_deflate_encoder_free(
+		     &deflate_encoder,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free deflate encoder.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libewf_buffer_pool_get_number_of_allocations(
+	     buffer_pool,
+	     number_of_allocations,
+	     number_of_reuses,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of allocations.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_buffer_pool_free(
+	     &buffer_pool,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free buffer pool.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+	}
+	if( deflate_encoder != NULL )
+	{
+		libewf_deflate_encoder_free(
+		 &deflate_encoder,
+		 NULL );
+	}
+	if( buffer_pool != NULL )
+	{
+		libewf_buffer_pool_free(
+		 &buffer_pool,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+	libcerror_error_t *error                    = NULL;
+	system_character_t *option_chunk_size       = NULL;
+	system_character_t *option_number_of_chunks = NULL;
+	system_integer_t option                     = 0;
+	size_t string_length                        = 0;
+	uint64_t chunk_size                         = EWF_BENCH_PACK_CHUNK_SIZE;
+	uint64_t number_of_chunks                   = EWF_BENCH_PACK_NUMBER_OF_CHUNKS;
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+	libewf_io_handle_t *io_handle               = NULL;
+	uint8_t *source_data                        = NULL;
+	uint64_t elapsed_time                       = 0;
+	uint64_t number_of_allocations              = 0;
+	uint64_t number_of_reuses                   = 0;
+#endif
+
+	while( ( option = ewf_test_getopt(
+	                   argc,
+	                   argv,
+	                   _SYSTEM_STRING( "c:hs:" ) ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_SYSTEM ".\n",
+				 argv[ optind - 1 ] );
+
+				ewf_bench_pack_usage_fprint(
+				 stdout );
+
+				return( EXIT_FAILURE );
+
+			case (system_integer_t) 'c':
+				option_number_of_chunks = optarg;
+
+				break;
+
+			case (system_integer_t) 'h':
+				ewf_bench_pack_usage_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+
+			case (system_integer_t) 's':
+				option_chunk_size = optarg;
+
+				break;
+		}
+	}
+#if !defined( __GNUC__ ) || defined( LIBEWF_DLL_IMPORT )
+	fprintf(
+	 stderr,
+	 "Access to the library internal functions is not available.\n" );
+
+	return( EXIT_FAILURE );
+#else
+	if( option_number_of_chunks != NULL )
+	{
+		string_length = system_string_length(
+		                 option_number_of_chunks );
+
+		if( ( ewf_bench_system_string_decimal_copy_to_64_bit(
+		       option_number_of_chunks,
+		       string_length + 1,
+		       &number_of_chunks,
+		       &error ) != 1 )
+		 || ( number_of_chunks == 0 )
+		 || ( number_of_chunks > (uint64_t) INT_MAX ) )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported number of chunks.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_chunk_size != NULL )
+	{
+		string_length = system_string_length(
+		                 option_chunk_size );
+
+		if( ( ewf_bench_system_string_decimal_copy_to_64_bit(
+		       option_chunk_size,
+		       string_length + 1,
+		       &chunk_size,
+		       &error ) != 1 )
+		 || ( chunk_size < 512 )
+		 || ( chunk_size > (uint64_t) ( 64 * 1024 * 1024 ) ) )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported chunk size.\n" );
+
+			goto on_error;
+		}
+	}
+	source_data = (uint8_t *) memory_allocate(
+	                           sizeof( uint8_t ) * 4 * (size_t) chunk_size );
+
+	if( source_data == NULL )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create source data.\n" );
+
+		goto on_error;
+	}
+	ewf_bench_pack_fill_source_data(
+	 source_data,
+	 (size32_t) chunk_size );
+
+	if( libewf_io_handle_initialize(
+	     &io_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create IO handle.\n" );
+
+		goto on_error;
+	}
+	io_handle->compression_method = LIBEWF_COMPRESSION_METHOD_DEFLATE;
+	io_handle->compression_level  = LIBEWF_COMPRESSION_DEFAULT;
+
+	fprintf(
+	 stdout,
+	 "Packing: %" PRIu64 " chunks of %" PRIu64 " bytes\n\n",
+	 number_of_chunks,
+	 chunk_size );
+
+	fprintf(
+	 stdout,
+	 "buffers\t\tallocations\treuses\t\ttime (ms)\n" );
+
+	/* Without retaining unused buffers every buffer is allocated and freed,
+	 * which is equivalent to allocating the buffers of every chunk
+	 */
+	if( ewf_bench_pack(
+	     io_handle,
+	     source_data,
+	     (size32_t) chunk_size,
+	     (int) number_of_chunks,
+	     0,
+	     &number_of_allocations,
+	     &number_of_reuses,
+	     &elapsed_time,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to pack chunks.\n" );
+
+		goto on_error;
+	}
+	fprintf(
+	 stdout,
+	 "allocated\t%" PRIu64 "\t\t%" PRIu64 "\t\t%" PRIu64 "\n",
+	 number_of_allocations,
+	 number_of_reuses,
+	 elapsed_time / 1000 );
+
+	if( ewf_bench_pack(
+	     io_handle,
+	     source_data,
+	     (size32_t) chunk_size,
+	     (int) number_of_chunks,
+	     LIBEWF_CHUNK_BUFFER_POOL_MAXIMUM_NUMBER_OF_BUFFERS,
+	     &number_of_allocations,
+	     &number_of_reuses,
+	     &elapsed_time,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to pack chunks with reused buffers.\n" );
+
+		goto on_error;
+	}
+	fprintf(
+	 stdout,
+	 "pooled\t\t%" PRIu64 "\t\t%" PRIu64 "\t\t%" PRIu64 "\n",
+	 number_of_allocations,
+	 number_of_reuses,
+	 elapsed_time / 1000 );
+
+	if( libewf_io_handle_free(
+	     &io_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free IO handle.\n" );
+
+		goto on_error;
+	}
+	memory_free(
+	 source_data );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	if( io_handle != NULL )
+	{
+		libewf_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	if( source_data != NULL )
+	{
+		memory_free(
+		 source_data );
+	}
+	return( EXIT_FAILURE );
+
+#endif /* !defined( __GNUC__ ) || defined( LIBEWF_DLL_IMPORT ) */
+}
+
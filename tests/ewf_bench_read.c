@@ -0,0 +1,755 @@
+/*
+ * Expert Witness Compression Format (EWF) library multi-threaded read benchmark program
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include <stdio.h>
+
+#include "ewf_bench_functions.h"
+#include "ewf_test_getopt.h"
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libcthreads.h"
+#include "ewf_test_libewf.h"
+
+#define EWF_BENCH_READ_BUFFER_SIZE		65536
+#define EWF_BENCH_READ_MAXIMUM_NUMBER_OF_THREADS	64
+
+typedef struct ewf_bench_read_thread_values ewf_bench_read_thread_values_t;
+
+struct ewf_bench_read_thread_values
+{
+	/* The handle
+	 */
+	libewf_handle_t *handle;
+
+	/* The read buffer
+	 */
+	uint8_t *buffer;
+
+	/* The read buffer size
+	 */
+	size_t buffer_size;
+
+	/* The offset to start reading at
+	 */
+	off64_t offset;
+
+	/* The number of bytes to read
+	 */
+	size64_t size;
+
+	/* The number of bytes read
+	 */
+	size64_t read_count;
+
+	/* The result
+	 */
+	int result;
+};
+
+/* Prints the executable usage information
+ */
+void ewf_bench_read_usage_fprint(
+      FILE *stream )
+{
+	if( stream == NULL )
+	{
+		return;
+	}
+	fprintf( stream, "Use ewf_bench_read to measure the scaling of concurrent reads\n"
+	                 "on a single handle.\n\n" );
+
+	fprintf( stream, "Usage: ewf_bench_read [ -b buffer_size ] [ -B number_of_bytes ]\n"
+	                 "                      [ -j maximum_number_of_threads ]\n"
+	                 "                      [ -r number_of_read_ahead_chunks ]\n"
+	                 "                      [ -u number_of_unpack_threads ] source\n\n" );
+
+	fprintf( stream, "\tsource: the first or only segment file of the EWF image\n\n" );
+	fprintf( stream, "\t-b:     specify the size of the read buffer per thread\n"
+	                 "\t        (default is %d)\n", EWF_BENCH_READ_BUFFER_SIZE );
+	fprintf( stream, "\t-B:     specify the number of bytes to read (default is all bytes)\n" );
+	fprintf( stream, "\t-j:     specify the maximum number of concurrent threads, the\n"
+	                 "\t        benchmark runs with 1, 2, 4, ... up to this number of\n"
+	                 "\t        threads (default is 4)\n" );
+	fprintf( stream, "\t-r:     specify the number of chunks to read ahead, the chunks are\n"
+	                 "\t        read ahead by the maximum number of threads (default is 0)\n" );
+	fprintf( stream, "\t-u:     specify the number of threads used to unpack the chunks\n"
+	                 "\t        of large reads (default is the library default)\n" );
+}
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBEWF )
+
+/* Reads a range of the media data
+ * Callback function for the read threads
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_bench_read_thread_callback(
+     ewf_bench_read_thread_values_t *thread_values )
+{
+	libcerror_error_t *error = NULL;
+	size64_t remaining_size  = 0;
+	ssize_t read_count       = 0;
+	size_t read_size         = 0;
+	off64_t offset           = 0;
+
+	if( thread_values == NULL )
+	{
+		return( -1 );
+	}
+	offset         = thread_values->offset;
+	remaining_size = thread_values->size;
+
+	while( remaining_size > 0 )
+	{
+		read_size = thread_values->buffer_size;
+
+		if( (size64_t) read_size > remaining_size )
+		{
+			read_size = (size_t) remaining_size;
+		}
+		read_count = libewf_handle_read_buffer_at_offset(
+		              thread_values->handle,
+		              thread_values->buffer,
+		              read_size,
+		              offset,
+		              &error );
+
+		if( read_count == -1 )
+		{
+			libcerror_error_backtrace_fprint(
+			 error,
+			 stderr );
+
+			libcerror_error_free(
+			 &error );
+
+			thread_values->result = -1;
+
+			return( -1 );
+		}
+		if( read_count == 0 )
+		{
+			break;
+		}
+		offset                     += (off64_t) read_count;
+		remaining_size             -= (size64_t) read_count;
+		thread_values->read_count  += (size64_t) read_count;
+	}
+	thread_values->result = 1;
+
+	return( 1 );
+}
+
+/* Reads the media data concurrently using a specific number of threads
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_bench_read(
+     libewf_handle_t *handle,
+     size64_t size,
+     size_t buffer_size,
+     int number_of_threads,
+     size64_t *read_count,
+     uint64_t *elapsed_time,
+     libcerror_error_t **error )
+{
+	ewf_bench_read_thread_values_t thread_values[ EWF_BENCH_READ_MAXIMUM_NUMBER_OF_THREADS ];
+	libcthreads_thread_t *threads[ EWF_BENCH_READ_MAXIMUM_NUMBER_OF_THREADS ];
+
+	static char *function     = "ewf_bench_read";
+	size64_t range_size       = 0;
+	uint64_t start_time       = 0;
+	int number_of_run_threads = 0;
+	int result                = 1;
+	int thread_index          = 0;
+
+	if( ( number_of_threads <= 0 )
+	 || ( number_of_threads > EWF_BENCH_READ_MAXIMUM_NUMBER_OF_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     thread_values,
+	     0,
+	     sizeof( ewf_bench_read_thread_values_t ) * EWF_BENCH_READ_MAXIMUM_NUMBER_OF_THREADS ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear thread values.",
+		 function );
+
+		return( -1 );
+	}
+	/* Every thread reads a contiguous range aligned to the buffer size
+	 */
+	range_size = size / number_of_threads;
+
+	if( ( range_size % buffer_size ) != 0 )
+	{
+		range_size += buffer_size - ( range_size % buffer_size );
+	}
+	for( thread_index = 0;
+	     thread_index < number_of_threads;
+	     thread_index++ )
+	{
+		threads[ thread_index ] = NULL;
+
+		thread_values[ thread_index ].handle      = handle;
+		thread_values[ thread_index ].buffer_size = buffer_size;
+		thread_values[ thread_index ].offset      = (off64_t) ( range_size * thread_index );
+
+		if( (size64_t) thread_values[ thread_index ].offset < size )
+		{
+			thread_values[ thread_index ].size = size - thread_values[ thread_index ].offset;
+
+			if( thread_values[ thread_index ].size > range_size )
+			{
+				thread_values[ thread_index ].size = range_size;
+			}
+		}
+		thread_values[ thread_index ].buffer = (uint8_t *) memory_allocate(
+		                                                    sizeof( uint8_t ) * buffer_size );
+
+		if( thread_values[ thread_index ].buffer == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create buffer: %d.",
+			 function,
+			 thread_index );
+
+			result = -1;
+
+			break;
+		}
+	}
+	start_time = ewf_bench_get_time_in_microseconds();
+
+	for( thread_index = 0;
+	     ( result == 1 ) && ( thread_index < number_of_threads );
+	     thread_index++ )
+	{
+		if( libcthreads_thread_create(
+		     &( threads[ thread_index ] ),
+		     NULL,
+		     (int (*)(void *)) &ewf_bench_read_thread_callback,
+		     (void *) &( thread_values[ thread_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create thread: %d.",
+			 function,
+			 thread_index );
+
+			result = -1;
+
+			break;
+		}
+		number_of_run_threads++;
+	}
+	for( thread_index = 0;
+	     thread_index < number_of_run_threads;
+	     thread_index++ )
+	{
+		if( libcthreads_thread_join(
+		     &( threads[ thread_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join thread: %d.",
+			 function,
+			 thread_index );
+
+			result = -1;
+		}
+	}
+	*elapsed_time = ewf_bench_get_time_in_microseconds() - start_time;
+	*read_count   = 0;
+
+	for( thread_index = 0;
+	     thread_index < number_of_threads;
+	     thread_index++ )
+	{
+		if( thread_values[ thread_index ].buffer != NULL )
+		{
+			memory_free(
+			 thread_values[ thread_index ].buffer );
+		}
+		if( ( thread_index < number_of_run_threads )
+		 && ( thread_values[ thread_index ].result != 1 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: thread: %d failed to read data.",
+			 function,
+			 thread_index );
+
+			result = -1;
+		}
+		*read_count += thread_values[ thread_index ].read_count;
+	}
+	return( result );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBEWF ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+	libcerror_error_t *error                      = NULL;
+	libewf_handle_t *handle                       = NULL;
+	system_character_t **filenames                = NULL;
+	system_character_t *option_buffer_size        = NULL;
+	system_character_t *option_number_of_bytes    = NULL;
+	system_character_t *option_number_of_threads  = NULL;
+	system_character_t *option_read_ahead_chunks  = NULL;
+	system_character_t *option_unpack_threads     = NULL;
+	system_integer_t option                       = 0;
+	size64_t media_size                           = 0;
+	size64_t read_count                           = 0;
+	size_t string_length                          = 0;
+	uint64_t buffer_size                          = EWF_BENCH_READ_BUFFER_SIZE;
+	uint64_t elapsed_time                         = 0;
+	uint64_t maximum_number_of_threads            = 4;
+	uint64_t number_of_bytes                      = 0;
+	uint64_t number_of_read_ahead_chunks          = 0;
+	uint64_t number_of_unpack_threads             = 0;
+	uint64_t single_thread_elapsed_time           = 0;
+	int number_of_filenames                       = 0;
+	int number_of_threads                         = 0;
+
+	while( ( option = ewf_test_getopt(
+	                   argc,
+	                   argv,
+	                   _SYSTEM_STRING( "b:B:hj:r:u:" ) ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_SYSTEM ".\n",
+				 argv[ optind - 1 ] );
+
+				ewf_bench_read_usage_fprint(
+				 stdout );
+
+				return( EXIT_FAILURE );
+
+			case (system_integer_t) 'b':
+				option_buffer_size = optarg;
+
+				break;
+
+			case (system_integer_t) 'B':
+				option_number_of_bytes = optarg;
+
+				break;
+
+			case (system_integer_t) 'h':
+				ewf_bench_read_usage_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+
+			case (system_integer_t) 'j':
+				option_number_of_threads = optarg;
+
+				break;
+
+			case (system_integer_t) 'r':
+				option_read_ahead_chunks = optarg;
+
+				break;
+
+			case (system_integer_t) 'u':
+				option_unpack_threads = optarg;
+
+				break;
+		}
+	}
+	if( optind == argc )
+	{
+		fprintf(
+		 stderr,
+		 "Missing source file.\n" );
+
+		ewf_bench_read_usage_fprint(
+		 stdout );
+
+		return( EXIT_FAILURE );
+	}
+#if !defined( HAVE_MULTI_THREAD_SUPPORT ) || defined( HAVE_LOCAL_LIBEWF )
+	fprintf(
+	 stderr,
+	 "Multi-threading support is not available.\n" );
+
+	return( EXIT_FAILURE );
+#else
+	if( option_buffer_size != NULL )
+	{
+		string_length = system_string_length(
+		                 option_buffer_size );
+
+		if( ( ewf_bench_system_string_decimal_copy_to_64_bit(
+		       option_buffer_size,
+		       string_length + 1,
+		       &buffer_size,
+		       &error ) != 1 )
+		 || ( buffer_size == 0 )
+		 || ( buffer_size > (uint64_t) SSIZE_MAX ) )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported buffer size.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_number_of_bytes != NULL )
+	{
+		string_length = system_string_length(
+		                 option_number_of_bytes );
+
+		if( ewf_bench_system_string_decimal_copy_to_64_bit(
+		     option_number_of_bytes,
+		     string_length + 1,
+		     &number_of_bytes,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported number of bytes.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_number_of_threads != NULL )
+	{
+		string_length = system_string_length(
+		                 option_number_of_threads );
+
+		if( ( ewf_bench_system_string_decimal_copy_to_64_bit(
+		       option_number_of_threads,
+		       string_length + 1,
+		       &maximum_number_of_threads,
+		       &error ) != 1 )
+		 || ( maximum_number_of_threads == 0 )
+		 || ( maximum_number_of_threads > EWF_BENCH_READ_MAXIMUM_NUMBER_OF_THREADS ) )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported maximum number of threads.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_read_ahead_chunks != NULL )
+	{
+		string_length = system_string_length(
+		                 option_read_ahead_chunks );
+
+		if( ( ewf_bench_system_string_decimal_copy_to_64_bit(
+		       option_read_ahead_chunks,
+		       string_length + 1,
+		       &number_of_read_ahead_chunks,
+		       &error ) != 1 )
+		 || ( number_of_read_ahead_chunks > (uint64_t) INT_MAX ) )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported number of read-ahead chunks.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_unpack_threads != NULL )
+	{
+		string_length = system_string_length(
+		                 option_unpack_threads );
+
+		if( ( ewf_bench_system_string_decimal_copy_to_64_bit(
+		       option_unpack_threads,
+		       string_length + 1,
+		       &number_of_unpack_threads,
+		       &error ) != 1 )
+		 || ( number_of_unpack_threads > (uint64_t) INT_MAX ) )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported number of unpack threads.\n" );
+
+			goto on_error;
+		}
+	}
+	string_length = system_string_length(
+	                 argv[ optind ] );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_glob_wide(
+	     argv[ optind ],
+	     string_length,
+	     LIBEWF_FORMAT_UNKNOWN,
+	     &filenames,
+	     &number_of_filenames,
+	     &error ) != 1 )
+#else
+	if( libewf_glob(
+	     argv[ optind ],
+	     string_length,
+	     LIBEWF_FORMAT_UNKNOWN,
+	     &filenames,
+	     &number_of_filenames,
+	     &error ) != 1 )
+#endif
+	{
+		fprintf(
+		 stderr,
+		 "Unable to glob filenames.\n" );
+
+		goto on_error;
+	}
+	if( libewf_handle_initialize(
+	     &handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create handle.\n" );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_handle_open_wide(
+	     handle,
+	     filenames,
+	     number_of_filenames,
+	     LIBEWF_OPEN_READ,
+	     &error ) != 1 )
+#else
+	if( libewf_handle_open(
+	     handle,
+	     filenames,
+	     number_of_filenames,
+	     LIBEWF_OPEN_READ,
+	     &error ) != 1 )
+#endif
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open handle.\n" );
+
+		goto on_error;
+	}
+	if( libewf_handle_set_read_ahead_values(
+	     handle,
+	     (int) number_of_read_ahead_chunks,
+	     (int) maximum_number_of_threads,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to set read-ahead values.\n" );
+
+		goto on_error;
+	}
+	if( option_unpack_threads != NULL )
+	{
+		if( libewf_handle_set_number_of_unpack_threads(
+		     handle,
+		     (int) number_of_unpack_threads,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set number of unpack threads.\n" );
+
+			goto on_error;
+		}
+	}
+	if( libewf_handle_get_media_size(
+	     handle,
+	     &media_size,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to retrieve media size.\n" );
+
+		goto on_error;
+	}
+	if( ( number_of_bytes == 0 )
+	 || ( number_of_bytes > media_size ) )
+	{
+		number_of_bytes = media_size;
+	}
+	fprintf(
+	 stdout,
+	 "Reading: %" PRIu64 " bytes with buffer size: %" PRIu64 " and read-ahead: %" PRIu64 " chunks\n\n",
+	 number_of_bytes,
+	 buffer_size,
+	 number_of_read_ahead_chunks );
+
+	fprintf(
+	 stdout,
+	 "threads\ttime (ms)\tMiB/s\tspeed up\n" );
+
+	for( number_of_threads = 1;
+	     number_of_threads <= (int) maximum_number_of_threads;
+	     number_of_threads *= 2 )
+	{
+		if( ewf_bench_read(
+		     handle,
+		     number_of_bytes,
+		     (size_t) buffer_size,
+		     number_of_threads,
+		     &read_count,
+		     &elapsed_time,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to read data with: %d threads.\n",
+			 number_of_threads );
+
+			goto on_error;
+		}
+		if( elapsed_time == 0 )
+		{
+			elapsed_time = 1;
+		}
+		if( number_of_threads == 1 )
+		{
+			single_thread_elapsed_time = elapsed_time;
+		}
+		fprintf(
+		 stdout,
+		 "%d\t%" PRIu64 "\t\t%.1f\t%.2f\n",
+		 number_of_threads,
+		 elapsed_time / 1000,
+		 ( (double) read_count / ( 1024.0 * 1024.0 ) ) / ( (double) elapsed_time / 1000000.0 ),
+		 (double) single_thread_elapsed_time / (double) elapsed_time );
+	}
+	if( libewf_handle_close(
+	     handle,
+	     &error ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close handle.\n" );
+
+		goto on_error;
+	}
+	if( libewf_handle_free(
+	     &handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free handle.\n" );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_glob_wide_free(
+	     filenames,
+	     number_of_filenames,
+	     &error ) != 1 )
+#else
+	if( libewf_glob_free(
+	     filenames,
+	     number_of_filenames,
+	     &error ) != 1 )
+#endif
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free glob.\n" );
+
+		goto on_error;
+	}
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	if( handle != NULL )
+	{
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	if( filenames != NULL )
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		libewf_glob_wide_free(
+		 filenames,
+		 number_of_filenames,
+		 NULL );
+#else
+		libewf_glob_free(
+		 filenames,
+		 number_of_filenames,
+		 NULL );
+#endif
+	}
+	return( EXIT_FAILURE );
+
+#endif /* !defined( HAVE_MULTI_THREAD_SUPPORT ) || defined( HAVE_LOCAL_LIBEWF ) */
+}
+
@@ -0,0 +1,405 @@
+/*
+ * Library checksum functions test program
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_checksum.h"
+#include "../libewf/libewf_deflate.h"
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+/* Spans several blocks of 5552 bytes, the maximum number of bytes
+ * between modulo reductions, plus a remainder that is not a multiple
+ * of a vector size
+ */
+#define EWF_TEST_CHECKSUM_DATA_SIZE	( ( 3 * 5552 ) + 103 )
+
+uint8_t ewf_test_checksum_data[ EWF_TEST_CHECKSUM_DATA_SIZE ];
+
+/* Fills the test data with pseudo random bytes
+ */
+void ewf_test_checksum_initialize_data(
+      uint8_t fill_byte )
+{
+	size_t data_offset   = 0;
+	uint32_t value_32bit = 0x12345678UL;
+
+	for( data_offset = 0;
+	     data_offset < EWF_TEST_CHECKSUM_DATA_SIZE;
+	     data_offset++ )
+	{
+		if( fill_byte != 0 )
+		{
+			ewf_test_checksum_data[ data_offset ] = fill_byte;
+		}
+		else
+		{
+			value_32bit = ( value_32bit * 1103515245UL ) + 12345;
+
+			ewf_test_checksum_data[ data_offset ] = (uint8_t) ( value_32bit >> 16 );
+		}
+	}
+}
+
+/* Tests the libewf_checksum_calculate_adler32 function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_checksum_calculate_adler32(
+     void )
+{
+	uint8_t data[ 9 ] = {
+		'W', 'i', 'k', 'i', 'p', 'e', 'd', 'i', 'a' };
+
+	libcerror_error_t *error = NULL;
+	uint32_t checksum_value  = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_checksum_calculate_adler32(
+	          &checksum_value,
+	          data,
+	          9,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "checksum_value",
+	 checksum_value,
+	 (uint32_t) 0x11e60398UL );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_checksum_calculate_adler32(
+	          NULL,
+	          data,
+	          9,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_checksum_calculate_adler32(
+	          &checksum_value,
+	          NULL,
+	          9,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_checksum_calculate_adler32(
+	          &checksum_value,
+	          data,
+	          (size_t) SSIZE_MAX + 1,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Compares the Adler-32 of an implementation with that of libewf_deflate_calculate_adler32
+ * for various sizes, alignments and initial values of the test data
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_checksum_compare_adler32_implementation(
+     int implementation )
+{
+	size_t sizes[ 17 ] = {
+		0, 1, 15, 16, 17, 31, 32, 33, 63, 64, 100,
+		5551, 5552, 5553, 5568, ( 2 * 5552 ) + 7, 0 };
+
+	uint32_t initial_values[ 4 ] = {
+		1, 0, 0x12345678UL, 0xfff0fff0UL };
+
+	libcerror_error_t *error     = NULL;
+	size_t data_offset           = 0;
+	uint32_t calculated_checksum = 0;
+	uint32_t expected_checksum   = 0;
+	int initial_value_index      = 0;
+	int result                   = 0;
+	int size_index               = 0;
+
+	sizes[ 16 ] = EWF_TEST_CHECKSUM_DATA_SIZE - 3;
+
+	for( size_index = 0;
+	     size_index < 17;
+	     size_index++ )
+	{
+		for( data_offset = 0;
+		     data_offset < 4;
+		     data_offset++ )
+		{
+			for( initial_value_index = 0;
+			     initial_value_index < 4;
+			     initial_value_index++ )
+			{
+				result = libewf_deflate_calculate_adler32(
+				          &expected_checksum,
+				          &( ewf_test_checksum_data[ data_offset ] ),
+				          sizes[ size_index ],
+				          initial_values[ initial_value_index ],
+				          &error );
+
+				EWF_TEST_ASSERT_EQUAL_INT(
+				 "result",
+				 result,
+				 1 );
+
+				EWF_TEST_ASSERT_IS_NULL(
+				 "error",
+				 error );
+
+				result = libewf_checksum_calculate_adler32_with_implementation(
+				          &calculated_checksum,
+				          &( ewf_test_checksum_data[ data_offset ] ),
+				          sizes[ size_index ],
+				          initial_values[ initial_value_index ],
+				          implementation,
+				          &error );
+
+				EWF_TEST_ASSERT_EQUAL_INT(
+				 "result",
+				 result,
+				 1 );
+
+				EWF_TEST_ASSERT_IS_NULL(
+				 "error",
+				 error );
+
+				EWF_TEST_ASSERT_EQUAL_UINT32(
+				 "calculated_checksum",
+				 calculated_checksum,
+				 expected_checksum );
+			}
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_checksum_calculate_adler32_with_implementation function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_checksum_calculate_adler32_with_implementation(
+     void )
+{
+	uint8_t fill_bytes[ 3 ] = {
+		0, 0xff, 0x01 };
+
+	libcerror_error_t *error = NULL;
+	uint32_t checksum_value  = 0;
+	int fill_byte_index      = 0;
+	int implementation       = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	for( fill_byte_index = 0;
+	     fill_byte_index < 3;
+	     fill_byte_index++ )
+	{
+		ewf_test_checksum_initialize_data(
+		 fill_bytes[ fill_byte_index ] );
+
+		for( implementation = LIBEWF_CHECKSUM_ADLER32_IMPLEMENTATION_SCALAR;
+		     implementation <= LIBEWF_CHECKSUM_ADLER32_IMPLEMENTATION_NEON;
+		     implementation++ )
+		{
+			if( libewf_checksum_adler32_implementation_is_supported(
+			     implementation ) == 0 )
+			{
+				continue;
+			}
+			result = ewf_test_checksum_compare_adler32_implementation(
+			          implementation );
+
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+		}
+	}
+	/* Test error cases
+	 */
+	result = libewf_checksum_calculate_adler32_with_implementation(
+	          &checksum_value,
+	          ewf_test_checksum_data,
+	          EWF_TEST_CHECKSUM_DATA_SIZE,
+	          1,
+	          -1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_checksum_get_adler32_implementation function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_checksum_get_adler32_implementation(
+     void )
+{
+	int implementation = 0;
+	int result         = 0;
+
+	implementation = libewf_checksum_get_adler32_implementation();
+
+	result = libewf_checksum_adler32_implementation_is_supported(
+	          implementation );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	return( 1 );
+
+on_error:
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_checksum_calculate_adler32",
+	 ewf_test_checksum_calculate_adler32 );
+
+	EWF_TEST_RUN(
+	 "libewf_checksum_calculate_adler32_with_implementation",
+	 ewf_test_checksum_calculate_adler32_with_implementation );
+
+	EWF_TEST_RUN(
+	 "libewf_checksum_get_adler32_implementation",
+	 ewf_test_checksum_get_adler32_implementation );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -21,6 +21,7 @@
 
 #include <common.h>
 #include <file_stream.h>
+#include <memory.h>
 #include <types.h>
 
 #if defined( HAVE_STDLIB_H ) || defined( WINAPI )
@@ -33,7 +34,9 @@
 #include "ewf_test_memory.h"
 #include "ewf_test_unused.h"
 
+#include "../libewf/libewf_buffer_pool.h"
 #include "../libewf/libewf_chunk_data.h"
+#include "../libewf/libewf_definitions.h"
 
 #if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
 
@@ -223,6 +226,573 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libewf_chunk_data_initialize_with_buffer_pool and libewf_chunk_data_detach_buffer_pool functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_data_initialize_with_buffer_pool(
+     void )
+{
+	libcerror_error_t *error          = NULL;
+	libewf_buffer_pool_t *buffer_pool = NULL;
+	libewf_chunk_data_t *chunk_data   = NULL;
+	uint64_t number_of_allocations    = 0;
+	uint64_t number_of_reuses         = 0;
+	int result                        = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_buffer_pool_initialize(
+	          &buffer_pool,
+	          4112,
+	          2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "buffer_pool",
+	 buffer_pool );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_chunk_data_initialize_with_buffer_pool(
+	          &chunk_data,
+	          buffer_pool,
+	          4096,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_data",
+	 chunk_data );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "chunk_data->flags",
+	 (int) chunk_data->flags,
+	 ( LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA | LIBEWF_CHUNK_DATA_ITEM_FLAG_POOLED_DATA ) );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_data_free(
+	          &chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The data buffer released by the previous chunk data is reused
+	 */
+	result = libewf_chunk_data_initialize_with_buffer_pool(
+	          &chunk_data,
+	          buffer_pool,
+	          4096,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_data",
+	 chunk_data );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_buffer_pool_get_number_of_allocations(
+	          buffer_pool,
+	          &number_of_allocations,
+	          &number_of_reuses,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_allocations",
+	 number_of_allocations,
+	 (uint64_t) 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_reuses",
+	 number_of_reuses,
+	 (uint64_t) 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* A detached chunk data can outlive the buffer pool
+	 */
+	result = libewf_chunk_data_detach_buffer_pool(
+	          chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_data->buffer_pool",
+	 chunk_data->buffer_pool );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "chunk_data->flags",
+	 (int) chunk_data->flags,
+	 LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_buffer_pool_free(
+	          &buffer_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_data_free(
+	          &chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_data_detach_buffer_pool(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+	}
+	if( buffer_pool != NULL )
+	{
+		libewf_buffer_pool_free(
+		 &buffer_pool,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_data_read_from_buffer function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_data_read_from_buffer(
+     void )
+{
+	uint8_t buffer[ 4100 ];
+
+	libcerror_error_t *error        = NULL;
+	libewf_chunk_data_t *chunk_data = NULL;
+	ssize_t read_count              = 0;
+	size_t buffer_index             = 0;
+	int result                      = 0;
+
+	/* Initialize test
+	 */
+	for( buffer_index = 0;
+	     buffer_index < 4100;
+	     buffer_index++ )
+	{
+		buffer[ buffer_index ] = (uint8_t) buffer_index;
+	}
+	result = libewf_chunk_data_initialize(
+	          &chunk_data,
+	          4096,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_data",
+	 chunk_data );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	read_count = libewf_chunk_data_read_from_buffer(
+	              chunk_data,
+	              buffer,
+	              4100,
+	              LIBEWF_RANGE_FLAG_HAS_CHECKSUM | LIBEWF_RANGE_FLAG_IS_CORRUPTED,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 4100 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "chunk_data->data_size",
+	 chunk_data->data_size,
+	 (size_t) 4100 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "chunk_data->range_flags",
+	 chunk_data->range_flags,
+	 (uint32_t) ( LIBEWF_RANGE_FLAG_HAS_CHECKSUM | LIBEWF_RANGE_FLAG_IS_PACKED ) );
+
+	result = memory_compare(
+	          chunk_data->data,
+	          buffer,
+	          4100 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	read_count = libewf_chunk_data_read_from_buffer(
+	              NULL,
+	              buffer,
+	              4100,
+	              0,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libewf_chunk_data_read_from_buffer(
+	              chunk_data,
+	              NULL,
+	              4100,
+	              0,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libewf_chunk_data_read_from_buffer(
+	              chunk_data,
+	              buffer,
+	              0,
+	              0,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libewf_chunk_data_read_from_buffer(
+	              chunk_data,
+	              buffer,
+	              (size_t) SSIZE_MAX + 1,
+	              0,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_chunk_data_free(
+	          &chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_data",
+	 chunk_data );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_data_check_for_incompressible_data function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_data_check_for_incompressible_data(
+     void )
+{
+	uint8_t buffer[ 32768 ];
+
+	libcerror_error_t *error = NULL;
+	size_t buffer_index      = 0;
+	uint32_t random_value    = 0x12345678UL;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	for( buffer_index = 0;
+	     buffer_index < 32768;
+	     buffer_index++ )
+	{
+		random_value ^= random_value << 13;
+		random_value ^= random_value >> 17;
+		random_value ^= random_value << 5;
+
+		buffer[ buffer_index ] = (uint8_t) ( random_value >> 24 );
+	}
+	/* Test regular cases
+	 */
+	result = libewf_chunk_data_check_for_incompressible_data(
+	          buffer,
+	          32768,
+	          LIBEWF_DEFAULT_COMPRESSION_ENTROPY_THRESHOLD,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_data_check_for_incompressible_data(
+	          buffer,
+	          32768,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Data of which the byte values only use 4 bits is not estimated to be incompressible
+	 */
+	for( buffer_index = 0;
+	     buffer_index < 32768;
+	     buffer_index++ )
+	{
+		buffer[ buffer_index ] &= 0x0f;
+	}
+	result = libewf_chunk_data_check_for_incompressible_data(
+	          buffer,
+	          32768,
+	          LIBEWF_DEFAULT_COMPRESSION_ENTROPY_THRESHOLD,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_data_check_for_incompressible_data(
+	          buffer,
+	          32768,
+	          45,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_data_check_for_incompressible_data(
+	          NULL,
+	          32768,
+	          LIBEWF_DEFAULT_COMPRESSION_ENTROPY_THRESHOLD,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_data_check_for_incompressible_data(
+	          buffer,
+	          (size_t) SSIZE_MAX + 1,
+	          LIBEWF_DEFAULT_COMPRESSION_ENTROPY_THRESHOLD,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_data_check_for_incompressible_data(
+	          buffer,
+	          32768,
+	          101,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
 #endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
 
 /* The main program
@@ -252,6 +822,14 @@ int main(
 	 "libewf_chunk_data_clone",
 	 ewf_test_chunk_data_clone );
 
+	EWF_TEST_RUN(
+	 "libewf_chunk_data_initialize_with_buffer_pool",
+	 ewf_test_chunk_data_initialize_with_buffer_pool );
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_data_read_from_buffer",
+	 ewf_test_chunk_data_read_from_buffer );
+
 	/* TODO: add tests for libewf_chunk_data_read_buffer */
 
 	/* TODO: add tests for libewf_chunk_data_write_buffer */
@@ -264,6 +842,10 @@ int main(
 
 	/* TODO: add tests for libewf_chunk_data_check_for_64_bit_pattern_fill */
 
+	EWF_TEST_RUN(
+	 "libewf_chunk_data_check_for_incompressible_data",
+	 ewf_test_chunk_data_check_for_incompressible_data );
+
 	/* TODO: add tests for libewf_chunk_data_write */
 
 	/* TODO: add tests for libewf_chunk_data_get_write_size */
@@ -34,6 +34,7 @@
 #include "ewf_test_unused.h"
 
 #include "../libewf/libewf_chunk_group.h"
+#include "../libewf/libewf_definitions.h"
 
 #if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
 
@@ -665,6 +666,603 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libewf_chunk_group_append_chunk_range function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_group_append_chunk_range(
+     void )
+{
+	libcerror_error_t *error          = NULL;
+	libewf_chunk_group_t *chunk_group = NULL;
+	libewf_io_handle_t *io_handle     = NULL;
+	off64_t chunk_data_offset         = 0;
+	size64_t chunk_data_size          = 0;
+	uint32_t range_flags              = 0;
+	int chunk_group_index             = 0;
+	int file_io_pool_entry            = 0;
+	int number_of_chunks              = 0;
+	int result                        = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_group_initialize(
+	          &chunk_group,
+	          io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_group",
+	 chunk_group );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_chunk_group_append_chunk_range(
+	          chunk_group,
+	          &chunk_group_index,
+	          1,
+	          0x00001000,
+	          32772,
+	          LIBEWF_RANGE_FLAG_HAS_CHECKSUM,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "chunk_group_index",
+	 chunk_group_index,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_group_append_chunk_range(
+	          chunk_group,
+	          &chunk_group_index,
+	          1,
+	          0x00009004,
+	          1024,
+	          LIBEWF_RANGE_FLAG_IS_COMPRESSED,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "chunk_group_index",
+	 chunk_group_index,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_group->large_data_offsets",
+	 chunk_group->large_data_offsets );
+
+	/* Test a chunk data offset that cannot be stored relative to the base offset
+	 */
+	result = libewf_chunk_group_append_chunk_range(
+	          chunk_group,
+	          &chunk_group_index,
+	          1,
+	          0x00000200,
+	          8,
+	          LIBEWF_RANGE_FLAG_IS_COMPRESSED | LIBEWF_RANGE_FLAG_USES_PATTERN_FILL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "chunk_group_index",
+	 chunk_group_index,
+	 2 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_group->large_data_offsets",
+	 chunk_group->large_data_offsets );
+
+	result = libewf_chunk_group_get_number_of_chunks(
+	          chunk_group,
+	          &number_of_chunks,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_chunks",
+	 number_of_chunks,
+	 3 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_group_get_chunk_range_by_index(
+	          chunk_group,
+	          1,
+	          &file_io_pool_entry,
+	          &chunk_data_offset,
+	          &chunk_data_size,
+	          &range_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "file_io_pool_entry",
+	 file_io_pool_entry,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "chunk_data_offset",
+	 (int64_t) chunk_data_offset,
+	 (int64_t) 0x00009004 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "chunk_data_size",
+	 (uint64_t) chunk_data_size,
+	 (uint64_t) 1024 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "range_flags",
+	 range_flags,
+	 (uint32_t) LIBEWF_RANGE_FLAG_IS_COMPRESSED );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_group_get_chunk_range_by_index(
+	          chunk_group,
+	          2,
+	          &file_io_pool_entry,
+	          &chunk_data_offset,
+	          &chunk_data_size,
+	          &range_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "chunk_data_offset",
+	 (int64_t) chunk_data_offset,
+	 (int64_t) 0x00000200 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_group_append_chunk_range(
+	          NULL,
+	          &chunk_group_index,
+	          1,
+	          0x00011004,
+	          32772,
+	          LIBEWF_RANGE_FLAG_HAS_CHECKSUM,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_group_append_chunk_range(
+	          chunk_group,
+	          NULL,
+	          1,
+	          0x00011004,
+	          32772,
+	          LIBEWF_RANGE_FLAG_HAS_CHECKSUM,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_group_append_chunk_range(
+	          chunk_group,
+	          &chunk_group_index,
+	          2,
+	          0x00011004,
+	          32772,
+	          LIBEWF_RANGE_FLAG_HAS_CHECKSUM,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_group_get_chunk_range_by_index(
+	          chunk_group,
+	          3,
+	          &file_io_pool_entry,
+	          &chunk_data_offset,
+	          &chunk_data_size,
+	          &range_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_chunk_group_free(
+	          &chunk_group,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_group",
+	 chunk_group );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_group != NULL )
+	{
+		libewf_chunk_group_free(
+		 &chunk_group,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libewf_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_group_get_chunk_index_at_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_group_get_chunk_index_at_offset(
+     void )
+{
+	libcerror_error_t *error          = NULL;
+	libewf_chunk_group_t *chunk_group = NULL;
+	libewf_io_handle_t *io_handle     = NULL;
+	off64_t chunk_data_offset         = 0;
+	int chunk_group_index             = 0;
+	int chunk_index                   = 0;
+	int result                        = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_group_initialize(
+	          &chunk_group,
+	          io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_group",
+	 chunk_group );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	chunk_group->chunk_size = 32768;
+
+	for( chunk_index = 0;
+	     chunk_index < 4;
+	     chunk_index++ )
+	{
+		result = libewf_chunk_group_append_chunk_range(
+		          chunk_group,
+		          &chunk_group_index,
+		          0,
+		          (off64_t) 0x00001000 + ( chunk_index * 32772 ),
+		          32772,
+		          LIBEWF_RANGE_FLAG_HAS_CHECKSUM,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test regular cases
+	 */
+	result = libewf_chunk_group_get_chunk_index_at_offset(
+	          chunk_group,
+	          ( 2 * 32768 ) + 100,
+	          &chunk_group_index,
+	          &chunk_data_offset,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "chunk_group_index",
+	 chunk_group_index,
+	 2 );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "chunk_data_offset",
+	 (int64_t) chunk_data_offset,
+	 (int64_t) 100 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_group_get_chunk_index_at_offset(
+	          chunk_group,
+	          4 * 32768,
+	          &chunk_group_index,
+	          &chunk_data_offset,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_group_get_chunk_index_at_offset(
+	          NULL,
+	          0,
+	          &chunk_group_index,
+	          &chunk_data_offset,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_group_get_chunk_index_at_offset(
+	          chunk_group,
+	          0,
+	          NULL,
+	          &chunk_data_offset,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_group_get_chunk_index_at_offset(
+	          chunk_group,
+	          0,
+	          &chunk_group_index,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_chunk_group_free(
+	          &chunk_group,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_group",
+	 chunk_group );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_group != NULL )
+	{
+		libewf_chunk_group_free(
+		 &chunk_group,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libewf_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
 #endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
 
 /* The main program
@@ -700,6 +1298,14 @@ int main(
 	 "libewf_chunk_group_clone",
 	 ewf_test_chunk_group_clone );
 
+	EWF_TEST_RUN(
+	 "libewf_chunk_group_append_chunk_range",
+	 ewf_test_chunk_group_append_chunk_range );
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_group_get_chunk_index_at_offset",
+	 ewf_test_chunk_group_get_chunk_index_at_offset );
+
 	/* TODO: add tests for libewf_chunk_group_fill_v1 */
 
 	/* TODO: add tests for libewf_chunk_group_fill_v2 */
@@ -0,0 +1,799 @@
+/*
+ * Library compression_controller type test program
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_compression_controller.h"
+#include "../libewf/libewf_definitions.h"
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+/* Tests the libewf_compression_controller_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_compression_controller_initialize(
+     void )
+{
+	libcerror_error_t *error                                 = NULL;
+	libewf_compression_controller_t *compression_controller = NULL;
+	int result                                               = 0;
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+	int number_of_malloc_fail_tests                          = 1;
+	int number_of_memset_fail_tests                          = 1;
+	int test_number                                          = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libewf_compression_controller_initialize(
+	          &compression_controller,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "compression_controller",
+	 compression_controller );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_compression_controller_free(
+	          &compression_controller,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "compression_controller",
+	 compression_controller );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_compression_controller_initialize(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	compression_controller = (libewf_compression_controller_t *) 0x12345678UL;
+
+	result = libewf_compression_controller_initialize(
+	          &compression_controller,
+	          &error );
+
+	compression_controller = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_compression_controller_initialize with malloc failing
+		 */
+		ewf_test_malloc_attempts_before_fail = test_number;
+
+		result = libewf_compression_controller_initialize(
+		          &compression_controller,
+		          &error );
+
+		if( ewf_test_malloc_attempts_before_fail != -1 )
+		{
+			ewf_test_malloc_attempts_before_fail = -1;
+
+			if( compression_controller != NULL )
+			{
+				libewf_compression_controller_free(
+				 &compression_controller,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "compression_controller",
+			 compression_controller );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_compression_controller_initialize with memset failing
+		 */
+		ewf_test_memset_attempts_before_fail = test_number;
+
+		result = libewf_compression_controller_initialize(
+		          &compression_controller,
+		          &error );
+
+		if( ewf_test_memset_attempts_before_fail != -1 )
+		{
+			ewf_test_memset_attempts_before_fail = -1;
+
+			if( compression_controller != NULL )
+			{
+				libewf_compression_controller_free(
+				 &compression_controller,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "compression_controller",
+			 compression_controller );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_EWF_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( compression_controller != NULL )
+	{
+		libewf_compression_controller_free(
+		 &compression_controller,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_compression_controller_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_compression_controller_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libewf_compression_controller_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_compression_controller_get_target_throughput and
+ * libewf_compression_controller_set_target_throughput functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_compression_controller_get_set_target_throughput(
+     void )
+{
+	libcerror_error_t *error                                 = NULL;
+	libewf_compression_controller_t *compression_controller = NULL;
+	uint64_t target_throughput                               = 0;
+	int result                                               = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_compression_controller_initialize(
+	          &compression_controller,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "compression_controller",
+	 compression_controller );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_compression_controller_get_target_throughput(
+	          compression_controller,
+	          &target_throughput,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "target_throughput",
+	 target_throughput,
+	 (uint64_t) 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_compression_controller_set_target_throughput(
+	          compression_controller,
+	          104857600,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_compression_controller_get_target_throughput(
+	          compression_controller,
+	          &target_throughput,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "target_throughput",
+	 target_throughput,
+	 (uint64_t) 104857600 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_compression_controller_get_target_throughput(
+	          NULL,
+	          &target_throughput,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_compression_controller_get_target_throughput(
+	          compression_controller,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_compression_controller_set_target_throughput(
+	          NULL,
+	          104857600,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_compression_controller_set_number_of_threads(
+	          compression_controller,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_compression_controller_free(
+	          &compression_controller,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "compression_controller",
+	 compression_controller );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( compression_controller != NULL )
+	{
+		libewf_compression_controller_free(
+		 &compression_controller,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_compression_controller_update function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_compression_controller_update(
+     void )
+{
+	libcerror_error_t *error                                 = NULL;
+	libewf_compression_controller_t *compression_controller = NULL;
+	int compression_level                                    = 0;
+	int result                                               = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_compression_controller_initialize(
+	          &compression_controller,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "compression_controller",
+	 compression_controller );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_compression_controller_get_compression_level(
+	          compression_controller,
+	          &compression_level,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "compression_level",
+	 compression_level,
+	 LIBEWF_ADAPTIVE_COMPRESSION_INITIAL_LEVEL );
+
+	/* Test regular cases
+	 * Without a target throughput a window with a good compression ratio
+	 * raises the compression level
+	 */
+	result = libewf_compression_controller_update(
+	          compression_controller,
+	          compression_level,
+	          LIBEWF_ADAPTIVE_COMPRESSION_WINDOW_SIZE,
+	          LIBEWF_ADAPTIVE_COMPRESSION_WINDOW_SIZE / 4,
+	          1000000000,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_compression_controller_get_compression_level(
+	          compression_controller,
+	          &compression_level,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "compression_level",
+	 compression_level,
+	 LIBEWF_ADAPTIVE_COMPRESSION_INITIAL_LEVEL + 1 );
+
+	/* Data compressed with a previous compression level is ignored
+	 */
+	result = libewf_compression_controller_update(
+	          compression_controller,
+	          LIBEWF_ADAPTIVE_COMPRESSION_INITIAL_LEVEL,
+	          LIBEWF_ADAPTIVE_COMPRESSION_WINDOW_SIZE,
+	          LIBEWF_ADAPTIVE_COMPRESSION_WINDOW_SIZE,
+	          1000000000,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_compression_controller_get_compression_level(
+	          compression_controller,
+	          &compression_level,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "compression_level",
+	 compression_level,
+	 LIBEWF_ADAPTIVE_COMPRESSION_INITIAL_LEVEL + 1 );
+
+	/* A throughput below half of the target throughput lowers the compression level by 2
+	 */
+	result = libewf_compression_controller_set_target_throughput(
+	          compression_controller,
+	          LIBEWF_ADAPTIVE_COMPRESSION_WINDOW_SIZE * 4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_compression_controller_update(
+	          compression_controller,
+	          compression_level,
+	          LIBEWF_ADAPTIVE_COMPRESSION_WINDOW_SIZE,
+	          LIBEWF_ADAPTIVE_COMPRESSION_WINDOW_SIZE / 4,
+	          1000000000,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_compression_controller_get_compression_level(
+	          compression_controller,
+	          &compression_level,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "compression_level",
+	 compression_level,
+	 LIBEWF_ADAPTIVE_COMPRESSION_INITIAL_LEVEL - 1 );
+
+	/* A poor compression ratio lowers the compression level by 1
+	 */
+	result = libewf_compression_controller_update(
+	          compression_controller,
+	          compression_level,
+	          LIBEWF_ADAPTIVE_COMPRESSION_WINDOW_SIZE,
+	          LIBEWF_ADAPTIVE_COMPRESSION_WINDOW_SIZE,
+	          100000000,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_compression_controller_get_compression_level(
+	          compression_controller,
+	          &compression_level,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "compression_level",
+	 compression_level,
+	 LIBEWF_ADAPTIVE_COMPRESSION_INITIAL_LEVEL - 2 );
+
+	/* Test error cases
+	 */
+	result = libewf_compression_controller_update(
+	          NULL,
+	          compression_level,
+	          LIBEWF_ADAPTIVE_COMPRESSION_WINDOW_SIZE,
+	          LIBEWF_ADAPTIVE_COMPRESSION_WINDOW_SIZE,
+	          1000000000,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_compression_controller_get_compression_level(
+	          compression_controller,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_compression_controller_free(
+	          &compression_controller,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "compression_controller",
+	 compression_controller );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( compression_controller != NULL )
+	{
+		libewf_compression_controller_free(
+		 &compression_controller,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_compression_controller_initialize",
+	 ewf_test_compression_controller_initialize );
+
+	EWF_TEST_RUN(
+	 "libewf_compression_controller_free",
+	 ewf_test_compression_controller_free );
+
+	EWF_TEST_RUN(
+	 "libewf_compression_controller_get_set_target_throughput",
+	 ewf_test_compression_controller_get_set_target_throughput );
+
+	EWF_TEST_RUN(
+	 "libewf_compression_controller_update",
+	 ewf_test_compression_controller_update );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
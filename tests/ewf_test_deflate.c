@@ -0,0 +1,1580 @@
+/*
+ * Library deflate functions test program
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_deflate.h"
+
+uint8_t ewf_test_deflate_uncompressed_data[ 280 ] = {
+	0x54, 0x68, 0x65, 0x20, 0x45, 0x78, 0x70, 0x65, 0x72, 0x74, 0x20, 0x57, 0x69, 0x74, 0x6e, 0x65,
+	0x73, 0x73, 0x20, 0x43, 0x6f, 0x6d, 0x70, 0x72, 0x65, 0x73, 0x73, 0x69, 0x6f, 0x6e, 0x20, 0x46,
+	0x6f, 0x72, 0x6d, 0x61, 0x74, 0x20, 0x28, 0x45, 0x57, 0x46, 0x29, 0x20, 0x73, 0x74, 0x6f, 0x72,
+	0x65, 0x73, 0x20, 0x6d, 0x65, 0x64, 0x69, 0x61, 0x20, 0x64, 0x61, 0x74, 0x61, 0x20, 0x69, 0x6e,
+	0x20, 0x63, 0x68, 0x75, 0x6e, 0x6b, 0x73, 0x20, 0x74, 0x68, 0x61, 0x74, 0x20, 0x61, 0x72, 0x65,
+	0x20, 0x63, 0x6f, 0x6d, 0x70, 0x72, 0x65, 0x73, 0x73, 0x65, 0x64, 0x20, 0x77, 0x69, 0x74, 0x68,
+	0x20, 0x64, 0x65, 0x66, 0x6c, 0x61, 0x74, 0x65, 0x2e, 0x20, 0x54, 0x68, 0x65, 0x20, 0x63, 0x68,
+	0x75, 0x6e, 0x6b, 0x73, 0x20, 0x6f, 0x66, 0x20, 0x61, 0x20, 0x73, 0x74, 0x6f, 0x72, 0x61, 0x67,
+	0x65, 0x20, 0x6d, 0x65, 0x64, 0x69, 0x61, 0x20, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x20, 0x63, 0x6f,
+	0x6e, 0x74, 0x61, 0x69, 0x6e, 0x20, 0x61, 0x20, 0x6c, 0x6f, 0x74, 0x20, 0x6f, 0x66, 0x20, 0x72,
+	0x65, 0x70, 0x65, 0x74, 0x69, 0x74, 0x69, 0x76, 0x65, 0x20, 0x64, 0x61, 0x74, 0x61, 0x2c, 0x20,
+	0x66, 0x6f, 0x72, 0x20, 0x65, 0x78, 0x61, 0x6d, 0x70, 0x6c, 0x65, 0x20, 0x74, 0x68, 0x65, 0x20,
+	0x72, 0x65, 0x70, 0x65, 0x74, 0x69, 0x74, 0x69, 0x76, 0x65, 0x20, 0x64, 0x61, 0x74, 0x61, 0x20,
+	0x69, 0x6e, 0x20, 0x74, 0x68, 0x65, 0x20, 0x63, 0x68, 0x75, 0x6e, 0x6b, 0x73, 0x20, 0x6f, 0x66,
+	0x20, 0x61, 0x20, 0x73, 0x74, 0x6f, 0x72, 0x61, 0x67, 0x65, 0x20, 0x6d, 0x65, 0x64, 0x69, 0x61,
+	0x20, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x2e, 0x20, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37,
+	0x38, 0x39, 0x61, 0x62, 0x63, 0x64, 0x65, 0x66, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37,
+	0x38, 0x39, 0x61, 0x62, 0x63, 0x64, 0x65, 0x66 };
+
+uint8_t ewf_test_deflate_fixed_huffman_compressed_data[ 195 ] = {
+	0x78, 0x01, 0x0b, 0xc9, 0x48, 0x55, 0x70, 0xad, 0x28, 0x48, 0x2d, 0x2a, 0x51, 0x08, 0xcf, 0x2c,
+	0xc9, 0x4b, 0x2d, 0x2e, 0x56, 0x70, 0xce, 0xcf, 0x2d, 0x28, 0x02, 0x32, 0x32, 0xf3, 0xf3, 0x14,
+	0xdc, 0xf2, 0x8b, 0x72, 0x13, 0x4b, 0x14, 0x34, 0x5c, 0xc3, 0xdd, 0x34, 0x15, 0x8a, 0x4b, 0xf2,
+	0x81, 0xe2, 0x0a, 0xb9, 0xa9, 0x29, 0x99, 0x89, 0x0a, 0x29, 0x89, 0x25, 0x89, 0x0a, 0x99, 0x79,
+	0x0a, 0xc9, 0x19, 0xa5, 0x79, 0xd9, 0xc5, 0x0a, 0x25, 0x19, 0x40, 0x65, 0x89, 0x45, 0xa9, 0x0a,
+	0xc9, 0x50, 0xdd, 0xa9, 0x29, 0x0a, 0xe5, 0x99, 0x25, 0x19, 0x0a, 0x29, 0xa9, 0x69, 0x39, 0x89,
+	0x25, 0xa9, 0x7a, 0x0a, 0x21, 0x40, 0x9b, 0xa0, 0x8a, 0xf3, 0xd3, 0x14, 0x12, 0xc1, 0xa6, 0x25,
+	0xa6, 0xa7, 0x42, 0x8d, 0xcb, 0xcc, 0x05, 0xb1, 0x93, 0xf3, 0xf3, 0x4a, 0x12, 0x81, 0x86, 0x26,
+	0x2a, 0xe4, 0xe4, 0x97, 0x80, 0x94, 0x15, 0xa5, 0x16, 0xa4, 0x96, 0x64, 0x96, 0x64, 0x96, 0xa5,
+	0x82, 0x2d, 0xd4, 0x51, 0x48, 0xcb, 0x2f, 0x52, 0x48, 0xad, 0x48, 0xcc, 0x2d, 0xc8, 0x49, 0x05,
+	0xda, 0x99, 0x8a, 0xae, 0x00, 0xe4, 0xa2, 0x12, 0xc2, 0x16, 0xe9, 0x29, 0x18, 0x18, 0x1a, 0x19,
+	0x9b, 0x98, 0x9a, 0x99, 0x5b, 0x58, 0x26, 0x26, 0x25, 0x03, 0xdd, 0x88, 0xce, 0x07, 0x00, 0x21,
+	0x6f, 0x61, 0xd5 };
+
+uint8_t ewf_test_deflate_dynamic_huffman_compressed_data[ 168 ] = {
+	0x78, 0xda, 0x85, 0x8e, 0x49, 0x0e, 0xc2, 0x30, 0x0c, 0x45, 0xaf, 0xf2, 0x97, 0x20, 0xa1, 0x8a,
+	0x79, 0x58, 0xa3, 0xf6, 0x04, 0x95, 0xba, 0x36, 0xa9, 0x4b, 0x22, 0x9a, 0x41, 0x89, 0x81, 0x1e,
+	0x9f, 0xb4, 0xea, 0xaa, 0x1b, 0x76, 0xb6, 0xf5, 0xfc, 0xdf, 0xaf, 0x35, 0xa3, 0x1c, 0x02, 0x47,
+	0x41, 0x63, 0xc4, 0x71, 0x4a, 0xb8, 0x7b, 0x1b, 0x62, 0x1e, 0x8c, 0x77, 0xa8, 0x7c, 0xb4, 0x24,
+	0x58, 0x95, 0x4d, 0xb5, 0x46, 0x12, 0x9f, 0xef, 0xb0, 0xdc, 0x1a, 0x42, 0x4b, 0x42, 0x30, 0x0e,
+	0x4a, 0xbf, 0xdd, 0x2b, 0x41, 0x74, 0xc6, 0x28, 0x32, 0xd4, 0xfc, 0xcd, 0x2d, 0xbe, 0x46, 0x34,
+	0x5a, 0xee, 0x7a, 0x12, 0x2e, 0x50, 0x67, 0xd3, 0x0c, 0xfb, 0x0e, 0x34, 0xa5, 0xd1, 0x93, 0xe7,
+	0x38, 0x63, 0xc7, 0x59, 0x79, 0x27, 0x94, 0x43, 0x09, 0xbd, 0x97, 0x11, 0x8b, 0x1c, 0x58, 0x8c,
+	0x98, 0x0f, 0x4f, 0xc2, 0x0d, 0x3a, 0x1f, 0xc1, 0x03, 0xd9, 0xd0, 0x73, 0x76, 0xf2, 0x12, 0x18,
+	0x1b, 0xc9, 0x7f, 0x51, 0x81, 0xed, 0x6e, 0x7f, 0x38, 0x9e, 0xce, 0x97, 0xeb, 0x8d, 0x1e, 0x2a,
+	0x77, 0x5c, 0xee, 0x3f, 0x21, 0x6f, 0x61, 0xd5 };
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+/* Tests the libewf_deflate_bit_stream_get_value function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_deflate_bit_stream_get_value(
+     void )
+{
+	uint8_t byte_stream[ 8 ] = {
+		0x12, 0x34, 0x56, 0x78, 0x9a, 0xbc, 0xde, 0xf0 };
+
+	libewf_deflate_bit_stream_t bit_stream;
+
+	libcerror_error_t *error = NULL;
+	uint32_t value_32bit     = 0;
+	int result               = 0;
+
+	bit_stream.byte_stream        = byte_stream;
+	bit_stream.byte_stream_size   = 8;
+	bit_stream.byte_stream_offset = 0;
+	bit_stream.bit_buffer         = 0;
+	bit_stream.bit_buffer_size    = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_deflate_bit_stream_get_value(
+	          &bit_stream,
+	          0,
+	          &value_32bit,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "value_32bit",
+	 value_32bit,
+	 (uint32_t) 0x00000000UL );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_deflate_bit_stream_get_value(
+	          &bit_stream,
+	          4,
+	          &value_32bit,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "value_32bit",
+	 value_32bit,
+	 (uint32_t) 0x00000002UL );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_deflate_bit_stream_get_value(
+	          &bit_stream,
+	          12,
+	          &value_32bit,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "value_32bit",
+	 value_32bit,
+	 (uint32_t) 0x00000341UL );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_deflate_bit_stream_get_value(
+	          &bit_stream,
+	          32,
+	          &value_32bit,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "value_32bit",
+	 value_32bit,
+	 (uint32_t) 0xbc9a7856UL );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_deflate_bit_stream_get_value(
+	          &bit_stream,
+	          16,
+	          &value_32bit,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "value_32bit",
+	 value_32bit,
+	 (uint32_t) 0x0000f0deUL );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_deflate_bit_stream_get_value(
+	          &bit_stream,
+	          1,
+	          &value_32bit,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_deflate_bit_stream_get_value(
+	          NULL,
+	          4,
+	          &value_32bit,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_deflate_bit_stream_get_value(
+	          &bit_stream,
+	          33,
+	          &value_32bit,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_deflate_bit_stream_get_value(
+	          &bit_stream,
+	          4,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_deflate_bit_stream_get_huffman_encoded_value function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_deflate_bit_stream_get_huffman_encoded_value(
+     void )
+{
+	/* Code sizes of 1 to 15 bits so that codes are stored in both
+	 * the first and second level of the lookup table
+	 */
+	uint16_t code_sizes_array[ 16 ] = {
+		1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 15 };
+
+	uint8_t byte_stream[ 3 ];
+
+	libewf_deflate_bit_stream_t bit_stream;
+	libewf_deflate_huffman_table_t table;
+
+	libcerror_error_t *error = NULL;
+	uint32_t value_32bit     = 0;
+	uint16_t encoded_value   = 0;
+	int result               = 0;
+	int symbol               = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_deflate_huffman_table_construct(
+	          &table,
+	          code_sizes_array,
+	          16,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( symbol = 0;
+	     symbol < 16;
+	     symbol++ )
+	{
+		/* The canonical code of the symbol consists of symbol number of 1-bits
+		 * followed by a 0-bit, except for the last symbol
+		 */
+		if( symbol < 15 )
+		{
+			encoded_value = (uint16_t) ( ( 1 << symbol ) - 1 );
+		}
+		else
+		{
+			encoded_value = 0x7fff;
+		}
+		byte_stream[ 0 ] = (uint8_t) ( encoded_value & 0xff );
+		byte_stream[ 1 ] = (uint8_t) ( encoded_value >> 8 );
+		byte_stream[ 2 ] = 0;
+
+		bit_stream.byte_stream        = byte_stream;
+		bit_stream.byte_stream_size   = 3;
+		bit_stream.byte_stream_offset = 0;
+		bit_stream.bit_buffer         = 0;
+		bit_stream.bit_buffer_size    = 0;
+
+		result = libewf_deflate_bit_stream_get_huffman_encoded_value(
+		          &bit_stream,
+		          &table,
+		          &value_32bit,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_EQUAL_UINT32(
+		 "value_32bit",
+		 value_32bit,
+		 (uint32_t) symbol );
+
+		EWF_TEST_ASSERT_EQUAL_UINT8(
+		 "bit_stream.bit_buffer_size",
+		 bit_stream.bit_buffer_size,
+		 (uint8_t) ( 24 - code_sizes_array[ symbol ] ) );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test error cases
+	 */
+	result = libewf_deflate_bit_stream_get_huffman_encoded_value(
+	          NULL,
+	          &table,
+	          &value_32bit,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_deflate_bit_stream_get_huffman_encoded_value(
+	          &bit_stream,
+	          NULL,
+	          &value_32bit,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_deflate_bit_stream_get_huffman_encoded_value(
+	          &bit_stream,
+	          &table,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_deflate_calculate_adler32 function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_deflate_calculate_adler32(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	uint32_t checksum_value  = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_deflate_calculate_adler32(
+	          &checksum_value,
+	          ewf_test_deflate_uncompressed_data,
+	          280,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "checksum_value",
+	 checksum_value,
+	 (uint32_t) 0x216f61d5UL );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_deflate_calculate_adler32(
+	          NULL,
+	          ewf_test_deflate_uncompressed_data,
+	          280,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_deflate_calculate_adler32(
+	          &checksum_value,
+	          NULL,
+	          280,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_deflate_decompress function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_deflate_decompress(
+     void )
+{
+	uint8_t uncompressed_data[ 512 ];
+
+	libcerror_error_t *error      = NULL;
+	size_t uncompressed_data_size = 0;
+	int result                    = 0;
+
+	/* Test regular cases
+	 */
+	uncompressed_data_size = 512;
+
+	result = libewf_deflate_decompress(
+	          ewf_test_deflate_fixed_huffman_compressed_data,
+	          195,
+	          uncompressed_data,
+	          &uncompressed_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "uncompressed_data_size",
+	 uncompressed_data_size,
+	 (size_t) 280 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          uncompressed_data,
+	          ewf_test_deflate_uncompressed_data,
+	          280 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	uncompressed_data_size = 512;
+
+	result = libewf_deflate_decompress(
+	          ewf_test_deflate_dynamic_huffman_compressed_data,
+	          168,
+	          uncompressed_data,
+	          &uncompressed_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "uncompressed_data_size",
+	 uncompressed_data_size,
+	 (size_t) 280 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          uncompressed_data,
+	          ewf_test_deflate_uncompressed_data,
+	          280 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	uncompressed_data_size = 512;
+
+	result = libewf_deflate_decompress(
+	          NULL,
+	          168,
+	          uncompressed_data,
+	          &uncompressed_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_deflate_decompress(
+	          ewf_test_deflate_dynamic_huffman_compressed_data,
+	          (size_t) SSIZE_MAX + 1,
+	          uncompressed_data,
+	          &uncompressed_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_deflate_decompress(
+	          ewf_test_deflate_dynamic_huffman_compressed_data,
+	          168,
+	          NULL,
+	          &uncompressed_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_deflate_decompress(
+	          ewf_test_deflate_dynamic_huffman_compressed_data,
+	          168,
+	          uncompressed_data,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test decompress with an uncompressed data size that is too small
+	 */
+	uncompressed_data_size = 100;
+
+	result = libewf_deflate_decompress(
+	          ewf_test_deflate_dynamic_huffman_compressed_data,
+	          168,
+	          uncompressed_data,
+	          &uncompressed_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test decompress with compressed data that is truncated
+	 */
+	uncompressed_data_size = 512;
+
+	result = libewf_deflate_decompress(
+	          ewf_test_deflate_dynamic_huffman_compressed_data,
+	          100,
+	          uncompressed_data,
+	          &uncompressed_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_deflate_encoder_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_deflate_encoder_initialize(
+     void )
+{
+	libcerror_error_t *error          = NULL;
+	libewf_deflate_encoder_t *encoder = NULL;
+	int result                        = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_deflate_encoder_initialize(
+	          &encoder,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "encoder",
+	 encoder );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_deflate_encoder_free(
+	          &encoder,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "encoder",
+	 encoder );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_deflate_encoder_initialize(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	encoder = (libewf_deflate_encoder_t *) 0x12345678UL;
+
+	result = libewf_deflate_encoder_initialize(
+	          &encoder,
+	          &error );
+
+	encoder = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( encoder != NULL )
+	{
+		libewf_deflate_encoder_free(
+		 &encoder,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_deflate_encoder_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_deflate_encoder_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libewf_deflate_encoder_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_deflate_encoder_build_code_sizes function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_deflate_encoder_build_code_sizes(
+     void )
+{
+	uint32_t frequencies[ 19 ];
+	uint8_t code_sizes[ 19 ];
+
+	libcerror_error_t *error = NULL;
+	uint32_t kraft_sum       = 0;
+	int result               = 0;
+	int symbol               = 0;
+
+	/* Test regular cases
+	 */
+	for( symbol = 0;
+	     symbol < 19;
+	     symbol++ )
+	{
+		frequencies[ symbol ] = (uint32_t) 1 << symbol;
+	}
+	result = libewf_deflate_encoder_build_code_sizes(
+	          frequencies,
+	          19,
+	          7,
+	          code_sizes,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The code sizes should be limited and form a complete code
+	 */
+	for( symbol = 0;
+	     symbol < 19;
+	     symbol++ )
+	{
+		EWF_TEST_ASSERT_NOT_EQUAL_INT(
+		 "code_sizes[ symbol ]",
+		 (int) code_sizes[ symbol ],
+		 0 );
+
+		EWF_TEST_ASSERT_LESS_THAN_INT(
+		 "code_sizes[ symbol ]",
+		 (int) code_sizes[ symbol ],
+		 8 );
+
+		kraft_sum += (uint32_t) 1 << ( 7 - code_sizes[ symbol ] );
+	}
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "kraft_sum",
+	 kraft_sum,
+	 (uint32_t) 128 );
+
+	/* A single used symbol results in a code of 2 symbols
+	 */
+	for( symbol = 0;
+	     symbol < 19;
+	     symbol++ )
+	{
+		frequencies[ symbol ] = 0;
+	}
+	frequencies[ 5 ] = 10;
+
+	result = libewf_deflate_encoder_build_code_sizes(
+	          frequencies,
+	          19,
+	          7,
+	          code_sizes,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "code_sizes[ 0 ]",
+	 (int) code_sizes[ 0 ],
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "code_sizes[ 5 ]",
+	 (int) code_sizes[ 5 ],
+	 1 );
+
+	/* Test error cases
+	 */
+	result = libewf_deflate_encoder_build_code_sizes(
+	          NULL,
+	          19,
+	          7,
+	          code_sizes,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_deflate_encoder_build_code_sizes(
+	          frequencies,
+	          19,
+	          4,
+	          code_sizes,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_deflate_encoder_build_code_sizes(
+	          frequencies,
+	          19,
+	          7,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_deflate_encoder_compress function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_deflate_encoder_compress(
+     void )
+{
+	uint8_t compressed_data[ 8192 ];
+	uint8_t data[ 4096 ];
+	uint8_t uncompressed_data[ 4096 ];
+
+	libcerror_error_t *error          = NULL;
+	libewf_deflate_encoder_t *encoder = NULL;
+	size_t compressed_data_size       = 0;
+	size_t data_offset                = 0;
+	size_t uncompressed_data_size     = 0;
+	uint32_t random_value             = 12345;
+	int data_type                     = 0;
+	int result                        = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_deflate_encoder_initialize(
+	          &encoder,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "encoder",
+	 encoder );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases with data of zero bytes, repetitive text and pseudo random bytes
+	 * where the encoder is reused for every buffer
+	 */
+	for( data_type = 0;
+	     data_type < 3;
+	     data_type++ )
+	{
+		for( data_offset = 0;
+		     data_offset < 4096;
+		     data_offset++ )
+		{
+			if( data_type == 0 )
+			{
+				data[ data_offset ] = 0;
+			}
+			else if( data_type == 1 )
+			{
+				data[ data_offset ] = ewf_test_deflate_uncompressed_data[ data_offset % 280 ];
+			}
+			else
+			{
+				random_value = ( random_value * 1103515245UL ) + 12345;
+
+				data[ data_offset ] = (uint8_t) ( random_value >> 16 );
+			}
+		}
+		compressed_data_size = 8192;
+
+		result = libewf_deflate_encoder_compress(
+		          encoder,
+		          data,
+		          4096,
+		          compressed_data,
+		          &compressed_data_size,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		uncompressed_data_size = 4096;
+
+		result = libewf_deflate_decompress(
+		          compressed_data,
+		          compressed_data_size,
+		          uncompressed_data,
+		          &uncompressed_data_size,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_EQUAL_SIZE(
+		 "uncompressed_data_size",
+		 uncompressed_data_size,
+		 (size_t) 4096 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          uncompressed_data,
+		          data,
+		          4096 );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	/* Test compressing empty data
+	 */
+	compressed_data_size = 8192;
+
+	result = libewf_deflate_encoder_compress(
+	          encoder,
+	          data,
+	          0,
+	          compressed_data,
+	          &compressed_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	uncompressed_data_size = 4096;
+
+	result = libewf_deflate_decompress(
+	          compressed_data,
+	          compressed_data_size,
+	          uncompressed_data,
+	          &uncompressed_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "uncompressed_data_size",
+	 uncompressed_data_size,
+	 (size_t) 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test compressing with a compressed data buffer that is too small
+	 */
+	compressed_data_size = 16;
+
+	result = libewf_deflate_encoder_compress(
+	          encoder,
+	          data,
+	          4096,
+	          compressed_data,
+	          &compressed_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "compressed_data_size",
+	 compressed_data_size,
+	 libewf_deflate_get_compressed_data_size_bound( 4096 ) );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	compressed_data_size = 8192;
+
+	result = libewf_deflate_encoder_compress(
+	          NULL,
+	          data,
+	          4096,
+	          compressed_data,
+	          &compressed_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_deflate_encoder_compress(
+	          encoder,
+	          NULL,
+	          4096,
+	          compressed_data,
+	          &compressed_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_deflate_encoder_compress(
+	          encoder,
+	          data,
+	          (size_t) SSIZE_MAX + 1,
+	          compressed_data,
+	          &compressed_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_deflate_encoder_compress(
+	          encoder,
+	          data,
+	          4096,
+	          NULL,
+	          &compressed_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_deflate_encoder_compress(
+	          encoder,
+	          data,
+	          4096,
+	          compressed_data,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_deflate_encoder_free(
+	          &encoder,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "encoder",
+	 encoder );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( encoder != NULL )
+	{
+		libewf_deflate_encoder_free(
+		 &encoder,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_deflate_compress function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_deflate_compress(
+     void )
+{
+	uint8_t compressed_data[ 512 ];
+	uint8_t uncompressed_data[ 512 ];
+
+	libcerror_error_t *error      = NULL;
+	size_t compressed_data_size   = 0;
+	size_t uncompressed_data_size = 0;
+	int result                    = 0;
+
+	/* Test regular cases
+	 */
+	compressed_data_size = 512;
+
+	result = libewf_deflate_compress(
+	          ewf_test_deflate_uncompressed_data,
+	          280,
+	          compressed_data,
+	          &compressed_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The data is stored with a zlib header without a preset dictionary
+	 */
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "compressed_data[ 0 ]",
+	 compressed_data[ 0 ],
+	 (uint8_t) 0x78 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "compressed_data[ 1 ]",
+	 compressed_data[ 1 ],
+	 (uint8_t) 0x01 );
+
+	uncompressed_data_size = 512;
+
+	result = libewf_deflate_decompress(
+	          compressed_data,
+	          compressed_data_size,
+	          uncompressed_data,
+	          &uncompressed_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "uncompressed_data_size",
+	 uncompressed_data_size,
+	 (size_t) 280 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          uncompressed_data,
+	          ewf_test_deflate_uncompressed_data,
+	          280 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	compressed_data_size = 512;
+
+	result = libewf_deflate_compress(
+	          NULL,
+	          280,
+	          compressed_data,
+	          &compressed_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_deflate_compress(
+	          ewf_test_deflate_uncompressed_data,
+	          280,
+	          NULL,
+	          &compressed_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_deflate_bit_stream_get_value",
+	 ewf_test_deflate_bit_stream_get_value );
+
+	EWF_TEST_RUN(
+	 "libewf_deflate_bit_stream_get_huffman_encoded_value",
+	 ewf_test_deflate_bit_stream_get_huffman_encoded_value );
+
+	EWF_TEST_RUN(
+	 "libewf_deflate_calculate_adler32",
+	 ewf_test_deflate_calculate_adler32 );
+
+	EWF_TEST_RUN(
+	 "libewf_deflate_decompress",
+	 ewf_test_deflate_decompress );
+
+	EWF_TEST_RUN(
+	 "libewf_deflate_encoder_initialize",
+	 ewf_test_deflate_encoder_initialize );
+
+	EWF_TEST_RUN(
+	 "libewf_deflate_encoder_free",
+	 ewf_test_deflate_encoder_free );
+
+	EWF_TEST_RUN(
+	 "libewf_deflate_encoder_build_code_sizes",
+	 ewf_test_deflate_encoder_build_code_sizes );
+
+	EWF_TEST_RUN(
+	 "libewf_deflate_encoder_compress",
+	 ewf_test_deflate_encoder_compress );
+
+	EWF_TEST_RUN(
+	 "libewf_deflate_compress",
+	 ewf_test_deflate_compress );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -21,6 +21,7 @@
 
 #include <common.h>
 #include <file_stream.h>
+#include <memory.h>
 #include <narrow_string.h>
 #include <system_string.h>
 #include <types.h>
@@ -1360,19 +1361,42 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libewf_handle_signal_abort function
+/* Tests the libewf_handle_open function with LIBEWF_OPEN_READ_METADATA
+ * The values are compared with those of a handle opened with LIBEWF_OPEN_READ
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_handle_signal_abort(
+int ewf_test_handle_open_read_metadata(
+     const system_character_t *source,
      libewf_handle_t *handle )
 {
-	libcerror_error_t *error = NULL;
-	int result               = 0;
+	uint8_t buffer[ 512 ];
+	char narrow_source[ 256 ];
 
-	/* Test regular cases
+	libcerror_error_t *error                  = NULL;
+	libewf_chunk_view_t *chunk_view           = NULL;
+	libewf_data_chunk_t *data_chunk           = NULL;
+	libewf_handle_t *metadata_handle          = NULL;
+	char **filenames                          = NULL;
+	size64_t expected_media_size              = 0;
+	size64_t media_size                       = 0;
+	size64_t range_size                       = 0;
+	size_t narrow_source_length               = 0;
+	ssize_t read_count                        = 0;
+	off64_t range_offset                      = 0;
+	uint32_t expected_number_of_hash_values   = 0;
+	uint32_t expected_number_of_header_values = 0;
+	uint32_t number_of_hash_values            = 0;
+	uint32_t number_of_header_values          = 0;
+	int expected_result                       = 0;
+	int number_of_filenames                   = 0;
+	int result                                = 0;
+
+	/* Initialize test
 	 */
-	result = libewf_handle_signal_abort(
-	          handle,
+	result = ewf_test_get_narrow_source(
+	          source,
+	          narrow_source,
+	          256,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -1384,54 +1408,50 @@ int ewf_test_handle_signal_abort(
 	 "error",
 	 error );
 
-	/* Test error cases
-	 */
-	result = libewf_handle_signal_abort(
-	          NULL,
+	narrow_source_length = narrow_string_length(
+	                        narrow_source );
+
+	result = libewf_glob(
+	          narrow_source,
+	          narrow_source_length,
+	          LIBEWF_FORMAT_UNKNOWN,
+	          &filenames,
+	          &number_of_filenames,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
-	EWF_TEST_ASSERT_IS_NOT_NULL(
+	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
-
-	return( 1 );
+	result = libewf_handle_initialize(
+	          &metadata_handle,
+	          &error );
 
-on_error:
-	if( error != NULL )
-	{
-		libcerror_error_free(
-		 &error );
-	}
-	return( 0 );
-}
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-/* Tests the libewf_handle_read_buffer function
- * Returns 1 if successful or 0 if not
- */
-int ewf_test_handle_read_buffer(
-     libewf_handle_t *handle )
-{
-	uint8_t buffer[ 16 ];
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "metadata_handle",
+	 metadata_handle );
 
-	libcerror_error_t *error = NULL;
-	size64_t media_size      = 0;
-	ssize_t read_count       = 0;
-	off64_t offset           = 0;
-	int result               = 0;
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-	/* Determine size
+	/* Test open
 	 */
-	result = libewf_handle_get_media_size(
-	          handle,
-	          &media_size,
+	result = libewf_handle_open(
+	          metadata_handle,
+	          (char * const *) filenames,
+	          number_of_filenames,
+	          LIBEWF_OPEN_READ_METADATA,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -1443,116 +1463,117 @@ int ewf_test_handle_read_buffer(
 	 "error",
 	 error );
 
-	/* Reset offset to 0
+	/* Test if the media, header and hash values can be retrieved
 	 */
-	offset = libewf_handle_seek_offset(
+	result = libewf_handle_get_media_size(
 	          handle,
-	          0,
-	          SEEK_SET,
+	          &expected_media_size,
 	          &error );
 
-	EWF_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) 0 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	/* Test regular cases
-	 */
-	if( media_size > 16 )
-	{
-		read_count = libewf_handle_read_buffer(
-		              handle,
-		              buffer,
-		              16,
-		              &error );
+	result = libewf_handle_get_media_size(
+	          metadata_handle,
+	          &media_size,
+	          &error );
 
-		EWF_TEST_ASSERT_EQUAL_SSIZE(
-		 "read_count",
-		 read_count,
-		 (ssize_t) 16 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-		EWF_TEST_ASSERT_IS_NULL(
-		 "error",
-		 error );
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "media_size",
+	 (uint64_t) media_size,
+	 (uint64_t) expected_media_size );
 
-		/* Set offset to media_size - 8
-		 */
-		offset = libewf_handle_seek_offset(
-		          handle,
-		          -8,
-		          SEEK_END,
-		          &error );
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-		EWF_TEST_ASSERT_EQUAL_INT64(
-		 "offset",
-		 offset,
-		 (int64_t) media_size - 8 );
+	expected_result = libewf_handle_get_number_of_header_values(
+	                   handle,
+	                   &expected_number_of_header_values,
+	                   &error );
 
-		EWF_TEST_ASSERT_IS_NULL(
-		 "error",
-		 error );
+	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	 "expected_result",
+	 expected_result,
+	 -1 );
 
-		/* Read buffer on media_size boundary
-		 */
-		read_count = libewf_handle_read_buffer(
-		              handle,
-		              buffer,
-		              16,
-		              &error );
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-		EWF_TEST_ASSERT_EQUAL_SSIZE(
-		 "read_count",
-		 read_count,
-		 (ssize_t) 8 );
+	result = libewf_handle_get_number_of_header_values(
+	          metadata_handle,
+	          &number_of_header_values,
+	          &error );
 
-		EWF_TEST_ASSERT_IS_NULL(
-		 "error",
-		 error );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 expected_result );
 
-		/* Read buffer beyond media_size boundary
-		 */
-		read_count = libewf_handle_read_buffer(
-		              handle,
-		              buffer,
-		              16,
-		              &error );
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-		EWF_TEST_ASSERT_EQUAL_SSIZE(
-		 "read_count",
-		 read_count,
-		 (ssize_t) 0 );
+	if( result != 0 )
+	{
+		EWF_TEST_ASSERT_EQUAL_UINT32(
+		 "number_of_header_values",
+		 number_of_header_values,
+		 expected_number_of_header_values );
+	}
+	expected_result = libewf_handle_get_number_of_hash_values(
+	                   handle,
+	                   &expected_number_of_hash_values,
+	                   &error );
 
-		EWF_TEST_ASSERT_IS_NULL(
-		 "error",
-		 error );
+	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	 "expected_result",
+	 expected_result,
+	 -1 );
 
-		/* Reset offset to 0
-		 */
-		offset = libewf_handle_seek_offset(
-		          handle,
-		          0,
-		          SEEK_SET,
-		          &error );
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-		EWF_TEST_ASSERT_EQUAL_INT64(
-		 "offset",
-		 offset,
-		 (int64_t) 0 );
+	result = libewf_handle_get_number_of_hash_values(
+	          metadata_handle,
+	          &number_of_hash_values,
+	          &error );
 
-		EWF_TEST_ASSERT_IS_NULL(
-		 "error",
-		 error );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 expected_result );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( result != 0 )
+	{
+		EWF_TEST_ASSERT_EQUAL_UINT32(
+		 "number_of_hash_values",
+		 number_of_hash_values,
+		 expected_number_of_hash_values );
 	}
-	/* Test error cases
+	/* Test if the media data cannot be read
 	 */
 	read_count = libewf_handle_read_buffer(
-	              NULL,
+	              metadata_handle,
 	              buffer,
-	              16,
+	              512,
 	              &error );
 
 	EWF_TEST_ASSERT_EQUAL_SSIZE(
@@ -1567,28 +1588,27 @@ int ewf_test_handle_read_buffer(
 	libcerror_error_free(
 	 &error );
 
-	read_count = libewf_handle_read_buffer(
-	              handle,
-	              NULL,
-	              16,
-	              &error );
+	result = libewf_handle_get_data_chunk(
+	          metadata_handle,
+	          &data_chunk,
+	          &error );
 
-	EWF_TEST_ASSERT_EQUAL_SSIZE(
-	 "read_count",
-	 read_count,
-	 (ssize_t) -1 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
 	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "data_chunk",
+	 data_chunk );
+
+	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
-
-	read_count = libewf_handle_read_buffer(
-	              handle,
-	              buffer,
-	              (size_t) SSIZE_MAX + 1,
+	read_count = libewf_handle_read_data_chunk(
+	              metadata_handle,
+	              data_chunk,
 	              &error );
 
 	EWF_TEST_ASSERT_EQUAL_SSIZE(
@@ -1603,34 +1623,271 @@ int ewf_test_handle_read_buffer(
 	libcerror_error_free(
 	 &error );
 
-	return( 1 );
+	result = libewf_data_chunk_free(
+	          &data_chunk,
+	          &error );
 
-on_error:
-	if( error != NULL )
-	{
-		libcerror_error_free(
-		 &error );
-	}
-	return( 0 );
-}
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-/* Tests the libewf_handle_read_buffer_at_offset function
- * Returns 1 if successful or 0 if not
- */
-int ewf_test_handle_read_buffer_at_offset(
-     libewf_handle_t *handle )
-{
-	uint8_t buffer[ 16 ];
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-	libcerror_error_t *error = NULL;
-	size64_t media_size      = 0;
-	ssize_t read_count       = 0;
-	int result               = 0;
+	result = libewf_handle_pin_chunk_view(
+	          metadata_handle,
+	          0,
+	          &chunk_view,
+	          &error );
 
-	/* Determine size
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_view",
+	 chunk_view );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_next_data_range(
+	          metadata_handle,
+	          0,
+	          &range_offset,
+	          &range_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_handle_close(
+	          metadata_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_free(
+	          &metadata_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "metadata_handle",
+	 metadata_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_glob_free(
+	          filenames,
+	          number_of_filenames,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( data_chunk != NULL )
+	{
+		libewf_data_chunk_free(
+		 &data_chunk,
+		 NULL );
+	}
+	if( metadata_handle != NULL )
+	{
+		libewf_handle_free(
+		 &metadata_handle,
+		 NULL );
+	}
+	if( filenames != NULL )
+	{
+		libewf_glob_free(
+		 filenames,
+		 number_of_filenames,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_open function with LIBEWF_OPEN_READ_LAZY
+ * The data is compared with that of a handle opened with LIBEWF_OPEN_READ
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_open_read_lazy(
+     const system_character_t *source,
+     libewf_handle_t *handle )
+{
+	uint8_t expected_buffer[ 512 ];
+	uint8_t buffer[ 512 ];
+	char narrow_source[ 256 ];
+
+	off64_t offsets[ 6 ];
+
+	libcerror_error_t *error     = NULL;
+	libewf_handle_t *lazy_handle = NULL;
+	char **filenames             = NULL;
+	size64_t expected_media_size = 0;
+	size64_t media_size          = 0;
+	size_t narrow_source_length  = 0;
+	ssize_t expected_read_count  = 0;
+	ssize_t read_count           = 0;
+	off64_t offset               = 0;
+	uint32_t chunk_size          = 0;
+	int number_of_filenames      = 0;
+	int offset_index             = 0;
+	int result                   = 0;
+
+	/* Initialize test
 	 */
+	result = ewf_test_get_narrow_source(
+	          source,
+	          narrow_source,
+	          256,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	narrow_source_length = narrow_string_length(
+	                        narrow_source );
+
+	result = libewf_glob(
+	          narrow_source,
+	          narrow_source_length,
+	          LIBEWF_FORMAT_UNKNOWN,
+	          &filenames,
+	          &number_of_filenames,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
 	result = libewf_handle_get_media_size(
 	          handle,
+	          &expected_media_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_get_chunk_size(
+	          handle,
+	          &chunk_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_GREATER_THAN_INT(
+	 "chunk_size",
+	 (int) chunk_size,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_initialize(
+	          &lazy_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "lazy_handle",
+	 lazy_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test open
+	 */
+	result = libewf_handle_open(
+	          lazy_handle,
+	          (char * const *) filenames,
+	          number_of_filenames,
+	          LIBEWF_OPEN_READ_LAZY,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_get_media_size(
+	          lazy_handle,
 	          &media_size,
 	          &error );
 
@@ -1639,79 +1896,3544 @@ int ewf_test_handle_read_buffer_at_offset(
 	 result,
 	 1 );
 
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "media_size",
+	 (uint64_t) media_size,
+	 (uint64_t) expected_media_size );
+
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	/* Test regular cases
+	/* Test if the data read on demand matches the data read by the handle
+	 * that scanned all segment files on open. The offsets are not in order
+	 * so that segment files in the middle are scanned before the last chunk
+	 * and the last chunk is read before the start of the media
 	 */
-	if( media_size > 16 )
+	offsets[ 0 ] = (off64_t) ( media_size / 2 );
+	offsets[ 1 ] = (off64_t) ( ( media_size / 4 ) * 3 );
+	offsets[ 2 ] = (off64_t) ( ( ( media_size - 1 ) / chunk_size ) * chunk_size );
+	offsets[ 3 ] = (off64_t) ( media_size - 1 );
+	offsets[ 4 ] = (off64_t) ( media_size / 4 );
+	offsets[ 5 ] = 0;
+
+	for( offset_index = 0;
+	     offset_index < 6;
+	     offset_index++ )
 	{
+		offset = offsets[ offset_index ];
+
+		expected_read_count = libewf_handle_read_buffer_at_offset(
+		                       handle,
+		                       expected_buffer,
+		                       512,
+		                       offset,
+		                       &error );
+
+		EWF_TEST_ASSERT_GREATER_THAN_INT(
+		 "expected_read_count",
+		 (int) expected_read_count,
+		 0 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
 		read_count = libewf_handle_read_buffer_at_offset(
-		              handle,
+		              lazy_handle,
 		              buffer,
-		              16,
-		              0,
+		              512,
+		              offset,
 		              &error );
 
 		EWF_TEST_ASSERT_EQUAL_SSIZE(
 		 "read_count",
 		 read_count,
-		 (ssize_t) 16 );
+		 expected_read_count );
 
 		EWF_TEST_ASSERT_IS_NULL(
 		 "error",
 		 error );
 
-		/* Read buffer on media_size boundary
-		 */
-		read_count = libewf_handle_read_buffer_at_offset(
-		              handle,
-		              buffer,
-		              16,
-		              media_size - 8,
-		              &error );
+		result = memory_compare(
+		          buffer,
+		          expected_buffer,
+		          (size_t) read_count );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	/* Clean up
+	 */
+	result = libewf_handle_close(
+	          lazy_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_free(
+	          &lazy_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "lazy_handle",
+	 lazy_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_glob_free(
+	          filenames,
+	          number_of_filenames,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( lazy_handle != NULL )
+	{
+		libewf_handle_free(
+		 &lazy_handle,
+		 NULL );
+	}
+	if( filenames != NULL )
+	{
+		libewf_glob_free(
+		 filenames,
+		 number_of_filenames,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_clone_with_flags function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_clone_with_flags(
+     libewf_handle_t *handle )
+{
+	uint8_t clone_buffer[ 16 ];
+	uint8_t source_buffer[ 16 ];
+
+	libcerror_error_t *error         = NULL;
+	libewf_handle_t *clone_handle    = NULL;
+	size64_t media_size              = 0;
+	ssize_t read_count               = 0;
+	uint64_t clone_number_of_hits    = 0;
+	uint64_t clone_number_of_misses  = 0;
+	uint64_t source_number_of_hits   = 0;
+	uint64_t source_number_of_misses = 0;
+	int result                       = 0;
+
+	/* Determine size
+	 */
+	result = libewf_handle_get_media_size(
+	          handle,
+	          &media_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_clone_with_flags(
+	          &clone_handle,
+	          handle,
+	          LIBEWF_CLONE_FLAG_SHARE_CHUNK_CACHE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "clone_handle",
+	 clone_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( media_size > 16 )
+	{
+		read_count = libewf_handle_read_buffer_at_offset(
+		              handle,
+		              source_buffer,
+		              16,
+		              0,
+		              &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 16 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		read_count = libewf_handle_read_buffer_at_offset(
+		              clone_handle,
+		              clone_buffer,
+		              16,
+		              0,
+		              &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 16 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          clone_buffer,
+		          source_buffer,
+		          16 );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	/* The chunk cache statistics are shared with the source handle
+	 */
+	result = libewf_handle_get_chunk_cache_statistics(
+	          handle,
+	          &source_number_of_hits,
+	          &source_number_of_misses,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_get_chunk_cache_statistics(
+	          clone_handle,
+	          &clone_number_of_hits,
+	          &clone_number_of_misses,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "clone_number_of_hits",
+	 clone_number_of_hits,
+	 source_number_of_hits );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "clone_number_of_misses",
+	 clone_number_of_misses,
+	 source_number_of_misses );
+
+	result = libewf_handle_free(
+	          &clone_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "clone_handle",
+	 clone_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_handle_clone_with_flags(
+	          NULL,
+	          handle,
+	          LIBEWF_CLONE_FLAG_SHARE_CHUNK_CACHE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_clone_with_flags(
+	          &clone_handle,
+	          handle,
+	          0xff,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "clone_handle",
+	 clone_handle );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( clone_handle != NULL )
+	{
+		libewf_handle_free(
+		 &clone_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_signal_abort function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_signal_abort(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_signal_abort(
+	          handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_handle_signal_abort(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_read_buffer function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_read_buffer(
+     libewf_handle_t *handle )
+{
+	uint8_t buffer[ 16 ];
+
+	libcerror_error_t *error = NULL;
+	size64_t media_size      = 0;
+	ssize_t read_count       = 0;
+	off64_t offset           = 0;
+	int result               = 0;
+
+	/* Determine size
+	 */
+	result = libewf_handle_get_media_size(
+	          handle,
+	          &media_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Reset offset to 0
+	 */
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          0,
+	          SEEK_SET,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	if( media_size > 16 )
+	{
+		read_count = libewf_handle_read_buffer(
+		              handle,
+		              buffer,
+		              16,
+		              &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 16 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Set offset to media_size - 8
+		 */
+		offset = libewf_handle_seek_offset(
+		          handle,
+		          -8,
+		          SEEK_END,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT64(
+		 "offset",
+		 offset,
+		 (int64_t) media_size - 8 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Read buffer on media_size boundary
+		 */
+		read_count = libewf_handle_read_buffer(
+		              handle,
+		              buffer,
+		              16,
+		              &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 8 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Read buffer beyond media_size boundary
+		 */
+		read_count = libewf_handle_read_buffer(
+		              handle,
+		              buffer,
+		              16,
+		              &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 0 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Reset offset to 0
+		 */
+		offset = libewf_handle_seek_offset(
+		          handle,
+		          0,
+		          SEEK_SET,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT64(
+		 "offset",
+		 offset,
+		 (int64_t) 0 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test error cases
+	 */
+	read_count = libewf_handle_read_buffer(
+	              NULL,
+	              buffer,
+	              16,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libewf_handle_read_buffer(
+	              handle,
+	              NULL,
+	              16,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libewf_handle_read_buffer(
+	              handle,
+	              buffer,
+	              (size_t) SSIZE_MAX + 1,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_read_buffer_at_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_read_buffer_at_offset(
+     libewf_handle_t *handle )
+{
+	uint8_t buffer[ 16 ];
+
+	libcerror_error_t *error = NULL;
+	size64_t media_size      = 0;
+	ssize_t read_count       = 0;
+	int result               = 0;
+
+	/* Determine size
+	 */
+	result = libewf_handle_get_media_size(
+	          handle,
+	          &media_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	if( media_size > 16 )
+	{
+		read_count = libewf_handle_read_buffer_at_offset(
+		              handle,
+		              buffer,
+		              16,
+		              0,
+		              &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 16 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Read buffer on media_size boundary
+		 */
+		read_count = libewf_handle_read_buffer_at_offset(
+		              handle,
+		              buffer,
+		              16,
+		              media_size - 8,
+		              &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 8 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Read buffer beyond media_size boundary
+		 */
+		read_count = libewf_handle_read_buffer_at_offset(
+		              handle,
+		              buffer,
+		              16,
+		              media_size + 8,
+		              &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 0 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test error cases
+	 */
+	read_count = libewf_handle_read_buffer_at_offset(
+	              NULL,
+	              buffer,
+	              16,
+	              0,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libewf_handle_read_buffer_at_offset(
+	              handle,
+	              NULL,
+	              16,
+	              0,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libewf_handle_read_buffer_at_offset(
+	              handle,
+	              buffer,
+	              (size_t) SSIZE_MAX + 1,
+	              0,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libewf_handle_read_buffer_at_offset(
+	              handle,
+	              buffer,
+	              16,
+	              -1,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_read_buffers_at_offsets function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_read_buffers_at_offsets(
+     libewf_handle_t *handle )
+{
+	uint8_t buffer1[ 16 ];
+	uint8_t buffer2[ 16 ];
+	uint8_t buffer3[ 16 ];
+	uint8_t buffer4[ 16 ];
+	uint8_t expected_buffer[ 16 ];
+
+	void *buffers[ 4 ]       = { buffer1, buffer2, buffer3, buffer4 };
+	size_t buffer_sizes[ 4 ] = { 16, 16, 16, 16 };
+	off64_t offsets[ 4 ]     = { 0, 8, 0, 0 };
+	ssize_t read_counts[ 4 ] = { 0, 0, 0, 0 };
+	libcerror_error_t *error = NULL;
+	size64_t media_size      = 0;
+	ssize_t read_count       = 0;
+	int result               = 0;
+
+	/* Determine size
+	 */
+	result = libewf_handle_get_media_size(
+	          handle,
+	          &media_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	if( media_size > 32 )
+	{
+		/* The first two buffers overlap, the third buffer is on the media_size boundary
+		 * and the fourth buffer is beyond the media_size boundary
+		 */
+		offsets[ 2 ] = (off64_t) media_size - 8;
+		offsets[ 3 ] = (off64_t) media_size + 8;
+
+		result = libewf_handle_read_buffers_at_offsets(
+		          handle,
+		          buffers,
+		          buffer_sizes,
+		          offsets,
+		          read_counts,
+		          4,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_counts[ 0 ]",
+		 read_counts[ 0 ],
+		 (ssize_t) 16 );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_counts[ 1 ]",
+		 read_counts[ 1 ],
+		 (ssize_t) 16 );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_counts[ 2 ]",
+		 read_counts[ 2 ],
+		 (ssize_t) 8 );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_counts[ 3 ]",
+		 read_counts[ 3 ],
+		 (ssize_t) 0 );
+
+		/* The data must match the data read per buffer
+		 */
+		read_count = libewf_handle_read_buffer_at_offset(
+		              handle,
+		              expected_buffer,
+		              16,
+		              8,
+		              &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 16 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          buffer2,
+		          expected_buffer,
+		          16 );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		result = memory_compare(
+		          &( buffer1[ 8 ] ),
+		          expected_buffer,
+		          8 );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		read_count = libewf_handle_read_buffer_at_offset(
+		              handle,
+		              expected_buffer,
+		              16,
+		              offsets[ 2 ],
+		              &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 8 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          buffer3,
+		          expected_buffer,
+		          8 );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	result = libewf_handle_read_buffers_at_offsets(
+	          handle,
+	          buffers,
+	          buffer_sizes,
+	          offsets,
+	          read_counts,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_handle_read_buffers_at_offsets(
+	          NULL,
+	          buffers,
+	          buffer_sizes,
+	          offsets,
+	          read_counts,
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_read_buffers_at_offsets(
+	          handle,
+	          NULL,
+	          buffer_sizes,
+	          offsets,
+	          read_counts,
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_read_buffers_at_offsets(
+	          handle,
+	          buffers,
+	          buffer_sizes,
+	          offsets,
+	          NULL,
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_read_buffers_at_offsets(
+	          handle,
+	          buffers,
+	          buffer_sizes,
+	          offsets,
+	          read_counts,
+	          -1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Stores the read count of a completed asynchronous read
+ * Completion function for the asynchronous read tests
+ */
+void ewf_test_handle_read_completed(
+      void *buffer EWF_TEST_ATTRIBUTE_UNUSED,
+      ssize_t read_count,
+      void *completion_data )
+{
+	ssize_t *completed_read_count = (ssize_t *) completion_data;
+
+	EWF_TEST_UNREFERENCED_PARAMETER( buffer )
+
+	if( completed_read_count != NULL )
+	{
+		*completed_read_count = read_count;
+	}
+}
+
+/* Tests the libewf_handle_submit_read_buffer_at_offset, libewf_handle_get_completed_read
+ * and libewf_handle_wait_for_submitted_reads functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_submit_read_buffer_at_offset(
+     libewf_handle_t *handle )
+{
+	uint8_t buffer[ 16 ];
+	uint8_t expected_buffer[ 16 ];
+
+	libcerror_error_t *error       = NULL;
+	libcerror_error_t *read_error  = NULL;
+	libewf_handle_t *closed_handle = NULL;
+	void *completed_buffer         = NULL;
+	void *completion_data          = NULL;
+	size64_t media_size            = 0;
+	ssize_t completed_read_count   = 0;
+	ssize_t read_count             = 0;
+	int result                     = 0;
+
+	/* Determine size
+	 */
+	result = libewf_handle_get_media_size(
+	          handle,
+	          &media_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	if( media_size > 16 )
+	{
+		read_count = libewf_handle_read_buffer_at_offset(
+		              handle,
+		              expected_buffer,
+		              16,
+		              0,
+		              &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 16 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Test a read that is retrieved from the completion queue
+		 */
+		result = libewf_handle_submit_read_buffer_at_offset(
+		          handle,
+		          buffer,
+		          16,
+		          0,
+		          NULL,
+		          (void *) expected_buffer,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libewf_handle_wait_for_submitted_reads(
+		          handle,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libewf_handle_get_completed_read(
+		          handle,
+		          &completed_buffer,
+		          &read_count,
+		          &completion_data,
+		          &read_error,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "read_error",
+		 read_error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 16 );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "completed_buffer",
+		 (int) ( completed_buffer == (void *) buffer ),
+		 1 );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "completion_data",
+		 (int) ( completion_data == (void *) expected_buffer ),
+		 1 );
+
+		result = memory_compare(
+		          buffer,
+		          expected_buffer,
+		          16 );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		/* Test a read that calls the completion function
+		 */
+		completed_read_count = 0;
+
+		result = libewf_handle_submit_read_buffer_at_offset(
+		          handle,
+		          buffer,
+		          16,
+		          (off64_t) media_size - 8,
+		          &ewf_test_handle_read_completed,
+		          (void *) &completed_read_count,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libewf_handle_wait_for_submitted_reads(
+		          handle,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "completed_read_count",
+		 completed_read_count,
+		 (ssize_t) 8 );
+	}
+	/* Test that there is no completed read left to retrieve
+	 */
+	result = libewf_handle_get_completed_read(
+	          handle,
+	          &completed_buffer,
+	          &read_count,
+	          &completion_data,
+	          &read_error,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_handle_submit_read_buffer_at_offset(
+	          NULL,
+	          buffer,
+	          16,
+	          0,
+	          NULL,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_submit_read_buffer_at_offset(
+	          handle,
+	          NULL,
+	          16,
+	          0,
+	          NULL,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_submit_read_buffer_at_offset(
+	          handle,
+	          buffer,
+	          (size_t) SSIZE_MAX + 1,
+	          0,
+	          NULL,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_submit_read_buffer_at_offset(
+	          handle,
+	          buffer,
+	          16,
+	          -1,
+	          NULL,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_completed_read(
+	          NULL,
+	          &completed_buffer,
+	          &read_count,
+	          &completion_data,
+	          &read_error,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_completed_read(
+	          handle,
+	          NULL,
+	          &read_count,
+	          &completion_data,
+	          &read_error,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_completed_read(
+	          handle,
+	          &completed_buffer,
+	          NULL,
+	          &completion_data,
+	          &read_error,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_completed_read(
+	          handle,
+	          &completed_buffer,
+	          &read_count,
+	          NULL,
+	          &read_error,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_wait_for_submitted_reads(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test that a read cannot be submitted to a handle that is not open
+	 */
+	result = libewf_handle_initialize(
+	          &closed_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "closed_handle",
+	 closed_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_submit_read_buffer_at_offset(
+	          closed_handle,
+	          buffer,
+	          16,
+	          0,
+	          NULL,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_free(
+	          &closed_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "closed_handle",
+	 closed_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( read_error != NULL )
+	{
+		libcerror_error_free(
+		 &read_error );
+	}
+	if( closed_handle != NULL )
+	{
+		libewf_handle_free(
+		 &closed_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_get_data_chunk function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_get_data_chunk(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error        = NULL;
+	libewf_data_chunk_t *data_chunk = 0;
+	int data_chunk_is_set           = 0;
+	int result                      = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_get_data_chunk(
+	          handle,
+	          &data_chunk,
+	          &error );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	data_chunk_is_set = result;
+
+	if( data_chunk_is_set != 0 )
+	{
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "data_chunk",
+		 data_chunk );
+
+		result = libewf_data_chunk_free(
+		          &data_chunk,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test error cases
+	 */
+	result = libewf_handle_get_data_chunk(
+	          NULL,
+	          &data_chunk,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "data_chunk",
+	 data_chunk );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	if( data_chunk_is_set != 0 )
+	{
+		result = libewf_handle_get_data_chunk(
+		          handle,
+		          NULL,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "data_chunk",
+		 data_chunk );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( data_chunk != NULL )
+	{
+		libewf_data_chunk_free(
+		 &data_chunk,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBEWF )
+
+/* Tests that the libewf_handle_read_buffer_at_offset function returns the same data
+ * when the chunks of a large read are read in parallel
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_read_buffer_at_offset_parallel(
+     libewf_handle_t *handle )
+{
+	uint8_t parallel_buffer[ 4 * 32768 ];
+	uint8_t sequential_buffer[ 4 * 32768 ];
+
+	libcerror_error_t *error = NULL;
+	size64_t media_size      = 0;
+	size_t read_size         = 4 * 32768;
+	ssize_t read_count       = 0;
+	int number_of_threads    = 0;
+	int result               = 0;
+
+	result = libewf_handle_get_media_size(
+	          handle,
+	          &media_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( media_size < (size64_t) read_size )
+	{
+		read_size = (size_t) media_size;
+	}
+	result = libewf_handle_get_number_of_unpack_threads(
+	          handle,
+	          &number_of_threads,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_set_number_of_unpack_threads(
+	          handle,
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	read_count = libewf_handle_read_buffer_at_offset(
+	              handle,
+	              parallel_buffer,
+	              read_size,
+	              0,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) read_size );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_set_number_of_unpack_threads(
+	          handle,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	read_count = libewf_handle_read_buffer_at_offset(
+	              handle,
+	              sequential_buffer,
+	              read_size,
+	              0,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) read_size );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          parallel_buffer,
+	          sequential_buffer,
+	          read_size );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libewf_handle_set_number_of_unpack_threads(
+	          handle,
+	          number_of_threads,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBEWF ) */
+
+/* Tests the libewf_handle_get_next_data_range function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_get_next_data_range(
+     libewf_handle_t *handle )
+{
+	uint8_t buffer[ 512 ];
+
+	libcerror_error_t *error = NULL;
+	size64_t media_size      = 0;
+	size64_t range_size      = 0;
+	size_t buffer_offset     = 0;
+	size_t read_size         = 0;
+	ssize_t read_count       = 0;
+	off64_t offset           = 0;
+	off64_t range_offset     = 0;
+	int result               = 0;
+
+	result = libewf_handle_get_media_size(
+	          handle,
+	          &media_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	while( (size64_t) offset < media_size )
+	{
+		result = libewf_handle_get_next_data_range(
+		          handle,
+		          offset,
+		          &range_offset,
+		          &range_size,
+		          &error );
+
+		EWF_TEST_ASSERT_NOT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		if( result == 0 )
+		{
+			range_offset = (off64_t) media_size;
+			range_size   = 0;
+		}
+		else
+		{
+			EWF_TEST_ASSERT_LESS_THAN_UINT64(
+			 "offset",
+			 (uint64_t) offset,
+			 (uint64_t) range_offset + 1 );
+
+			EWF_TEST_ASSERT_NOT_EQUAL_INT64(
+			 "range_size",
+			 (int64_t) range_size,
+			 (int64_t) 0 );
+
+			EWF_TEST_ASSERT_LESS_THAN_UINT64(
+			 "range_size",
+			 (uint64_t) range_size,
+			 (uint64_t) ( media_size - range_offset + 1 ) );
+		}
+		/* The data in between data ranges only consists of zero bytes
+		 */
+		if( range_offset > offset )
+		{
+			read_size = sizeof( buffer );
+
+			if( (size64_t) read_size > (size64_t) ( range_offset - offset ) )
+			{
+				read_size = (size_t) ( range_offset - offset );
+			}
+			read_count = libewf_handle_read_buffer_at_offset(
+			              handle,
+			              buffer,
+			              read_size,
+			              offset,
+			              &error );
+
+			EWF_TEST_ASSERT_EQUAL_SSIZE(
+			 "read_count",
+			 read_count,
+			 (ssize_t) read_size );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			for( buffer_offset = 0;
+			     buffer_offset < read_size;
+			     buffer_offset++ )
+			{
+				EWF_TEST_ASSERT_EQUAL_UINT8(
+				 "buffer[ buffer_offset ]",
+				 buffer[ buffer_offset ],
+				 0 );
+			}
+		}
+		offset = range_offset + range_size;
+	}
+	result = libewf_handle_get_next_data_range(
+	          handle,
+	          (off64_t) media_size,
+	          &range_offset,
+	          &range_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_handle_get_next_data_range(
+	          NULL,
+	          0,
+	          &range_offset,
+	          &range_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_next_data_range(
+	          handle,
+	          -1,
+	          &range_offset,
+	          &range_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_next_data_range(
+	          handle,
+	          0,
+	          NULL,
+	          &range_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_next_data_range(
+	          handle,
+	          0,
+	          &range_offset,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_read_buffer_at_offset function with reads of entire chunks
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_read_buffer_at_offset_entire_chunks(
+     libewf_handle_t *handle )
+{
+	uint8_t buffer[ 2 * 32768 ];
+	uint8_t chunk_buffer[ 32768 ];
+
+	libcerror_error_t *error        = NULL;
+	libewf_chunk_view_t *chunk_view = NULL;
+	const uint8_t *data             = NULL;
+	size64_t media_size             = 0;
+	size_t data_size                = 0;
+	size_t read_size                = 0;
+	ssize_t read_count              = 0;
+	off64_t offset                  = 0;
+	uint32_t chunk_size             = 0;
+	int chunk_iterator              = 0;
+	int result                      = 0;
+
+	result = libewf_handle_get_media_size(
+	          handle,
+	          &media_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_get_chunk_size(
+	          handle,
+	          &chunk_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( ( chunk_size == 0 )
+	 || ( chunk_size > 32768 )
+	 || ( media_size < (size64_t) ( 2 * chunk_size ) ) )
+	{
+		return( 1 );
+	}
+	/* Use chunks that have not been read by the previous tests, if available,
+	 * so that they are not read from the chunk cache
+	 */
+	if( media_size >= (size64_t) ( 8 * chunk_size ) )
+	{
+		offset = (off64_t) ( 6 * chunk_size );
+	}
+	read_size = (size_t) ( 2 * chunk_size );
+
+	/* Test regular cases
+	 */
+	read_count = libewf_handle_read_buffer_at_offset(
+	              handle,
+	              chunk_buffer,
+	              (size_t) chunk_size,
+	              offset + chunk_size,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) chunk_size );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	read_count = libewf_handle_read_buffer_at_offset(
+	              handle,
+	              buffer,
+	              read_size,
+	              offset,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) read_size );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          &( buffer[ chunk_size ] ),
+	          chunk_buffer,
+	          (size_t) chunk_size );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Compare the data with the unpacked chunks in the chunk cache
+	 */
+	for( chunk_iterator = 0;
+	     chunk_iterator < 2;
+	     chunk_iterator++ )
+	{
+		result = libewf_handle_pin_chunk_view(
+		          handle,
+		          offset + ( chunk_iterator * chunk_size ),
+		          &chunk_view,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libewf_chunk_view_get_data(
+		          chunk_view,
+		          &data,
+		          &data_size,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_EQUAL_SIZE(
+		 "data_size",
+		 data_size,
+		 (size_t) chunk_size );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          data,
+		          &( buffer[ chunk_iterator * chunk_size ] ),
+		          (size_t) chunk_size );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		result = libewf_handle_unpin_chunk_view(
+		          handle,
+		          &chunk_view,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_view != NULL )
+	{
+		libewf_handle_unpin_chunk_view(
+		 handle,
+		 &chunk_view,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_pin_chunk_view and libewf_handle_unpin_chunk_view functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_pin_chunk_view(
+     libewf_handle_t *handle )
+{
+	uint8_t buffer[ 16 ];
+
+	libcerror_error_t *error         = NULL;
+	libewf_chunk_view_t *chunk_view  = NULL;
+	libewf_chunk_view_t *chunk_view2 = NULL;
+	const uint8_t *data              = NULL;
+	size64_t media_size              = 0;
+	size_t data_size                 = 0;
+	ssize_t read_count               = 0;
+	off64_t offset                   = 0;
+	int result                       = 0;
+
+	/* Determine size
+	 */
+	result = libewf_handle_get_media_size(
+	          handle,
+	          &media_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	if( media_size > 16 )
+	{
+		read_count = libewf_handle_read_buffer_at_offset(
+		              handle,
+		              buffer,
+		              16,
+		              0,
+		              &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 16 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libewf_handle_pin_chunk_view(
+		          handle,
+		          0,
+		          &chunk_view,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "chunk_view",
+		 chunk_view );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libewf_chunk_view_get_data(
+		          chunk_view,
+		          &data,
+		          &data_size,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "data",
+		 data );
+
+		EWF_TEST_ASSERT_GREATER_THAN_INT(
+		 "data_size",
+		 (int) data_size,
+		 15 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          data,
+		          buffer,
+		          16 );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		result = libewf_chunk_view_get_offset(
+		          chunk_view,
+		          &offset,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_EQUAL_INT64(
+		 "offset",
+		 (int64_t) offset,
+		 (int64_t) 0 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Pin the same chunk twice
+		 */
+		result = libewf_handle_pin_chunk_view(
+		          handle,
+		          8,
+		          &chunk_view2,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libewf_chunk_view_get_data(
+		          chunk_view2,
+		          &data,
+		          &data_size,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          data,
+		          &( buffer[ 8 ] ),
+		          8 );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		result = libewf_handle_unpin_chunk_view(
+		          handle,
+		          &chunk_view2,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "chunk_view2",
+		 chunk_view2 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libewf_handle_unpin_chunk_view(
+		          handle,
+		          &chunk_view,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "chunk_view",
+		 chunk_view );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Pin chunk view on media_size boundary
+		 */
+		result = libewf_handle_pin_chunk_view(
+		          handle,
+		          media_size - 8,
+		          &chunk_view,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libewf_chunk_view_get_data(
+		          chunk_view,
+		          &data,
+		          &data_size,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_EQUAL_SIZE(
+		 "data_size",
+		 data_size,
+		 (size_t) 8 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libewf_handle_unpin_chunk_view(
+		          handle,
+		          &chunk_view,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Pin chunk view beyond media_size boundary
+		 */
+		result = libewf_handle_pin_chunk_view(
+		          handle,
+		          media_size,
+		          &chunk_view,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "chunk_view",
+		 chunk_view );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test error cases
+	 */
+	result = libewf_handle_pin_chunk_view(
+	          NULL,
+	          0,
+	          &chunk_view,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_pin_chunk_view(
+	          handle,
+	          -1,
+	          &chunk_view,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_pin_chunk_view(
+	          handle,
+	          0,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_unpin_chunk_view(
+	          NULL,
+	          &chunk_view,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_view2 != NULL )
+	{
+		libewf_handle_unpin_chunk_view(
+		 handle,
+		 &chunk_view2,
+		 NULL );
+	}
+	if( chunk_view != NULL )
+	{
+		libewf_handle_unpin_chunk_view(
+		 handle,
+		 &chunk_view,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_seek_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_seek_offset(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error = NULL;
+	size64_t size            = 0;
+	off64_t offset           = 0;
+
+	/* Test regular cases
+	 */
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          0,
+	          SEEK_END,
+	          &error );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	size = (size64_t) offset;
+
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          1024,
+	          SEEK_SET,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 1024 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          -512,
+	          SEEK_CUR,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 512 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          (off64_t) ( size + 512 ),
+	          SEEK_SET,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) ( size + 512 ) );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Reset offset to 0
+	 */
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          0,
+	          SEEK_SET,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	offset = libewf_handle_seek_offset(
+	          NULL,
+	          0,
+	          SEEK_SET,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          -1,
+	          SEEK_SET,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          -1,
+	          SEEK_CUR,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          (off64_t) ( -1 * ( size + 1 ) ),
+	          SEEK_END,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_get_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_get_offset(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error = NULL;
+	off64_t offset           = 0;
+	int offset_is_set        = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_get_offset(
+	          handle,
+	          &offset,
+	          &error );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	offset_is_set = result;
+
+	/* Test error cases
+	 */
+	result = libewf_handle_get_offset(
+	          NULL,
+	          &offset,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	if( offset_is_set != 0 )
+	{
+		result = libewf_handle_get_offset(
+		          handle,
+		          NULL,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_get_chunk_cache_size and libewf_handle_set_chunk_cache_size functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_set_chunk_cache_size(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error  = NULL;
+	size64_t cache_size       = 0;
+	size64_t saved_cache_size = 0;
+	int result                = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_get_chunk_cache_size(
+	          handle,
+	          &saved_cache_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_set_chunk_cache_size(
+	          handle,
+	          1024 * 1024,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_get_chunk_cache_size(
+	          handle,
+	          &cache_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "cache_size",
+	 cache_size,
+	 (uint64_t) 1024 * 1024 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_set_chunk_cache_size(
+	          handle,
+	          saved_cache_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_handle_get_chunk_cache_size(
+	          NULL,
+	          &cache_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_chunk_cache_size(
+	          handle,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_set_chunk_cache_size(
+	          NULL,
+	          1024 * 1024,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_set_chunk_cache_size(
+	          handle,
+	          (size64_t) INT64_MAX + 1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_get_maximum_coalesced_read_size and libewf_handle_set_maximum_coalesced_read_size functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_set_maximum_coalesced_read_size(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error = NULL;
+	size_t read_size         = 0;
+	size_t saved_read_size   = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_get_maximum_coalesced_read_size(
+	          handle,
+	          &saved_read_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_set_maximum_coalesced_read_size(
+	          handle,
+	          1024 * 1024,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_get_maximum_coalesced_read_size(
+	          handle,
+	          &read_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "read_size",
+	 read_size,
+	 (size_t) 1024 * 1024 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_set_maximum_coalesced_read_size(
+	          handle,
+	          saved_read_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_handle_get_maximum_coalesced_read_size(
+	          NULL,
+	          &read_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_maximum_coalesced_read_size(
+	          handle,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_set_maximum_coalesced_read_size(
+	          NULL,
+	          1024 * 1024,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_set_maximum_coalesced_read_size(
+	          handle,
+	          (size_t) SSIZE_MAX + 1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_get_chunk_cache_statistics function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_get_chunk_cache_statistics(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error  = NULL;
+	uint64_t number_of_hits   = 0;
+	uint64_t number_of_misses = 0;
+	int result                = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_get_chunk_cache_statistics(
+	          handle,
+	          &number_of_hits,
+	          &number_of_misses,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_handle_get_chunk_cache_statistics(
+	          NULL,
+	          &number_of_hits,
+	          &number_of_misses,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_chunk_cache_statistics(
+	          handle,
+	          NULL,
+	          &number_of_misses,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_chunk_cache_statistics(
+	          handle,
+	          &number_of_hits,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_get_read_ahead_values and libewf_handle_set_read_ahead_values functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_set_read_ahead_values(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error    = NULL;
+	int number_of_chunks        = 0;
+	int number_of_threads       = 0;
+	int result                  = 0;
+	int saved_number_of_chunks  = 0;
+	int saved_number_of_threads = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_get_read_ahead_values(
+	          handle,
+	          &saved_number_of_chunks,
+	          &saved_number_of_threads,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_set_read_ahead_values(
+	          handle,
+	          4,
+	          2,
+	          &error );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBEWF )
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_get_read_ahead_values(
+	          handle,
+	          &number_of_chunks,
+	          &number_of_threads,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_chunks",
+	 number_of_chunks,
+	 4 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_threads",
+	 number_of_threads,
+	 2 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+#else
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+#endif
+	result = libewf_handle_set_read_ahead_values(
+	          handle,
+	          saved_number_of_chunks,
+	          saved_number_of_threads,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_handle_get_read_ahead_values(
+	          NULL,
+	          &number_of_chunks,
+	          &number_of_threads,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_read_ahead_values(
+	          handle,
+	          NULL,
+	          &number_of_threads,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_read_ahead_values(
+	          handle,
+	          &number_of_chunks,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_set_read_ahead_values(
+	          NULL,
+	          0,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_set_read_ahead_values(
+	          handle,
+	          -1,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_set_read_ahead_values(
+	          handle,
+	          0,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_get_number_of_unpack_threads and libewf_handle_set_number_of_unpack_threads functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_set_number_of_unpack_threads(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error    = NULL;
+	int number_of_threads       = 0;
+	int result                  = 0;
+	int saved_number_of_threads = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_get_number_of_unpack_threads(
+	          handle,
+	          &saved_number_of_threads,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_set_number_of_unpack_threads(
+	          handle,
+	          2,
+	          &error );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBEWF )
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_get_number_of_unpack_threads(
+	          handle,
+	          &number_of_threads,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_threads",
+	 number_of_threads,
+	 2 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+#else
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
-		EWF_TEST_ASSERT_EQUAL_SSIZE(
-		 "read_count",
-		 read_count,
-		 (ssize_t) 8 );
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
 
-		EWF_TEST_ASSERT_IS_NULL(
-		 "error",
-		 error );
+	libcerror_error_free(
+	 &error );
+#endif
+	result = libewf_handle_set_number_of_unpack_threads(
+	          handle,
+	          saved_number_of_threads,
+	          &error );
 
-		/* Read buffer beyond media_size boundary
-		 */
-		read_count = libewf_handle_read_buffer_at_offset(
-		              handle,
-		              buffer,
-		              16,
-		              media_size + 8,
-		              &error );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-		EWF_TEST_ASSERT_EQUAL_SSIZE(
-		 "read_count",
-		 read_count,
-		 (ssize_t) 0 );
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-		EWF_TEST_ASSERT_IS_NULL(
-		 "error",
-		 error );
-	}
 	/* Test error cases
 	 */
-	read_count = libewf_handle_read_buffer_at_offset(
-	              NULL,
-	              buffer,
-	              16,
-	              0,
-	              &error );
+	result = libewf_handle_get_number_of_unpack_threads(
+	          NULL,
+	          &number_of_threads,
+	          &error );
 
-	EWF_TEST_ASSERT_EQUAL_SSIZE(
-	 "read_count",
-	 read_count,
-	 (ssize_t) -1 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
@@ -1720,17 +5442,15 @@ int ewf_test_handle_read_buffer_at_offset(
 	libcerror_error_free(
 	 &error );
 
-	read_count = libewf_handle_read_buffer_at_offset(
-	              handle,
-	              NULL,
-	              16,
-	              0,
-	              &error );
+	result = libewf_handle_get_number_of_unpack_threads(
+	          handle,
+	          NULL,
+	          &error );
 
-	EWF_TEST_ASSERT_EQUAL_SSIZE(
-	 "read_count",
-	 read_count,
-	 (ssize_t) -1 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
@@ -1739,17 +5459,15 @@ int ewf_test_handle_read_buffer_at_offset(
 	libcerror_error_free(
 	 &error );
 
-	read_count = libewf_handle_read_buffer_at_offset(
-	              handle,
-	              buffer,
-	              (size_t) SSIZE_MAX + 1,
-	              0,
-	              &error );
+	result = libewf_handle_set_number_of_unpack_threads(
+	          NULL,
+	          0,
+	          &error );
 
-	EWF_TEST_ASSERT_EQUAL_SSIZE(
-	 "read_count",
-	 read_count,
-	 (ssize_t) -1 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
@@ -1758,17 +5476,15 @@ int ewf_test_handle_read_buffer_at_offset(
 	libcerror_error_free(
 	 &error );
 
-	read_count = libewf_handle_read_buffer_at_offset(
-	              handle,
-	              buffer,
-	              16,
-	              -1,
-	              &error );
+	result = libewf_handle_set_number_of_unpack_threads(
+	          handle,
+	          -1,
+	          &error );
 
-	EWF_TEST_ASSERT_EQUAL_SSIZE(
-	 "read_count",
-	 read_count,
-	 (ssize_t) -1 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
@@ -1788,59 +5504,98 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libewf_handle_get_data_chunk function
+/* Tests the libewf_handle_get_number_of_pack_threads and libewf_handle_set_number_of_pack_threads functions
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_handle_get_data_chunk(
+int ewf_test_handle_set_number_of_pack_threads(
      libewf_handle_t *handle )
 {
-	libcerror_error_t *error        = NULL;
-	libewf_data_chunk_t *data_chunk = 0;
-	int data_chunk_is_set           = 0;
-	int result                      = 0;
+	libcerror_error_t *error    = NULL;
+	int number_of_threads       = 0;
+	int result                  = 0;
+	int saved_number_of_threads = 0;
 
 	/* Test regular cases
 	 */
-	result = libewf_handle_get_data_chunk(
+	result = libewf_handle_get_number_of_pack_threads(
 	          handle,
-	          &data_chunk,
+	          &saved_number_of_threads,
 	          &error );
 
-	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	EWF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	data_chunk_is_set = result;
+	result = libewf_handle_set_number_of_pack_threads(
+	          handle,
+	          2,
+	          &error );
 
-	if( data_chunk_is_set != 0 )
-	{
-		EWF_TEST_ASSERT_IS_NOT_NULL(
-		 "data_chunk",
-		 data_chunk );
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBEWF )
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-		result = libewf_data_chunk_free(
-		          &data_chunk,
-		          &error );
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-		EWF_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 1 );
+	result = libewf_handle_get_number_of_pack_threads(
+	          handle,
+	          &number_of_threads,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_threads",
+	 number_of_threads,
+	 2 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+#else
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+#endif
+	result = libewf_handle_set_number_of_pack_threads(
+	          handle,
+	          saved_number_of_threads,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-		EWF_TEST_ASSERT_IS_NULL(
-		 "error",
-		 error );
-	}
 	/* Test error cases
 	 */
-	result = libewf_handle_get_data_chunk(
+	result = libewf_handle_get_number_of_pack_threads(
 	          NULL,
-	          &data_chunk,
+	          &number_of_threads,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -1848,9 +5603,22 @@ int ewf_test_handle_get_data_chunk(
 	 result,
 	 -1 );
 
-	EWF_TEST_ASSERT_IS_NULL(
-	 "data_chunk",
-	 data_chunk );
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_number_of_pack_threads(
+	          handle,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
@@ -1859,132 +5627,133 @@ int ewf_test_handle_get_data_chunk(
 	libcerror_error_free(
 	 &error );
 
-	if( data_chunk_is_set != 0 )
-	{
-		result = libewf_handle_get_data_chunk(
-		          handle,
-		          NULL,
-		          &error );
+	result = libewf_handle_set_number_of_pack_threads(
+	          NULL,
+	          0,
+	          &error );
 
-		EWF_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 -1 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
-		EWF_TEST_ASSERT_IS_NULL(
-		 "data_chunk",
-		 data_chunk );
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
 
-		EWF_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_set_number_of_pack_threads(
+	          handle,
+	          -1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
 
-		libcerror_error_free(
-		 &error );
-	}
 	return( 1 );
 
 on_error:
 	if( error != NULL )
 	{
 		libcerror_error_free(
-		 &error );
-	}
-	if( data_chunk != NULL )
-	{
-		libewf_data_chunk_free(
-		 &data_chunk,
-		 NULL );
+		 &error );
 	}
 	return( 0 );
 }
 
-/* Tests the libewf_handle_seek_offset function
+/* Tests the libewf_handle_get_number_of_async_read_threads and libewf_handle_set_number_of_async_read_threads functions
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_handle_seek_offset(
+int ewf_test_handle_set_number_of_async_read_threads(
      libewf_handle_t *handle )
 {
-	libcerror_error_t *error = NULL;
-	size64_t size            = 0;
-	off64_t offset           = 0;
+	libcerror_error_t *error    = NULL;
+	int number_of_threads       = 0;
+	int result                  = 0;
+	int saved_number_of_threads = 0;
 
 	/* Test regular cases
 	 */
-	offset = libewf_handle_seek_offset(
+	result = libewf_handle_get_number_of_async_read_threads(
 	          handle,
-	          0,
-	          SEEK_END,
+	          &saved_number_of_threads,
 	          &error );
 
-	EWF_TEST_ASSERT_NOT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) -1 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	size = (size64_t) offset;
-
-	offset = libewf_handle_seek_offset(
+	result = libewf_handle_set_number_of_async_read_threads(
 	          handle,
-	          1024,
-	          SEEK_SET,
+	          2,
 	          &error );
 
-	EWF_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) 1024 );
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBEWF )
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	offset = libewf_handle_seek_offset(
+	result = libewf_handle_get_number_of_async_read_threads(
 	          handle,
-	          -512,
-	          SEEK_CUR,
+	          &number_of_threads,
 	          &error );
 
-	EWF_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) 512 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_threads",
+	 number_of_threads,
+	 2 );
 
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
+#else
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
-	offset = libewf_handle_seek_offset(
-	          handle,
-	          (off64_t) ( size + 512 ),
-	          SEEK_SET,
-	          &error );
-
-	EWF_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) ( size + 512 ) );
-
-	EWF_TEST_ASSERT_IS_NULL(
+	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
 
-	/* Reset offset to 0
-	 */
-	offset = libewf_handle_seek_offset(
+	libcerror_error_free(
+	 &error );
+#endif
+	result = libewf_handle_set_number_of_async_read_threads(
 	          handle,
-	          0,
-	          SEEK_SET,
+	          saved_number_of_threads,
 	          &error );
 
-	EWF_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) 0 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
@@ -1992,16 +5761,15 @@ int ewf_test_handle_seek_offset(
 
 	/* Test error cases
 	 */
-	offset = libewf_handle_seek_offset(
+	result = libewf_handle_get_number_of_async_read_threads(
 	          NULL,
-	          0,
-	          SEEK_SET,
+	          &number_of_threads,
 	          &error );
 
-	EWF_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) -1 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
@@ -2010,16 +5778,15 @@ int ewf_test_handle_seek_offset(
 	libcerror_error_free(
 	 &error );
 
-	offset = libewf_handle_seek_offset(
+	result = libewf_handle_get_number_of_async_read_threads(
 	          handle,
-	          -1,
-	          SEEK_SET,
+	          NULL,
 	          &error );
 
-	EWF_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) -1 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
@@ -2028,31 +5795,32 @@ int ewf_test_handle_seek_offset(
 	libcerror_error_free(
 	 &error );
 
-	offset = libewf_handle_seek_offset(
-	          handle,
-	          -1,
-	          SEEK_CUR,
+	result = libewf_handle_set_number_of_async_read_threads(
+	          NULL,
+	          0,
 	          &error );
 
-	EWF_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) -1 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
 
-	offset = libewf_handle_seek_offset(
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_set_number_of_async_read_threads(
 	          handle,
-	          (off64_t) ( -1 * ( size + 1 ) ),
-	          SEEK_END,
+	          -1,
 	          &error );
 
-	EWF_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) -1 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
@@ -2072,40 +5840,98 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libewf_handle_get_offset function
+/* Tests the libewf_handle_get_number_of_scan_threads and libewf_handle_set_number_of_scan_threads functions
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_handle_get_offset(
+int ewf_test_handle_set_number_of_scan_threads(
      libewf_handle_t *handle )
 {
-	libcerror_error_t *error = NULL;
-	off64_t offset           = 0;
-	int offset_is_set        = 0;
-	int result               = 0;
+	libcerror_error_t *error    = NULL;
+	int number_of_threads       = 0;
+	int result                  = 0;
+	int saved_number_of_threads = 0;
 
 	/* Test regular cases
 	 */
-	result = libewf_handle_get_offset(
+	result = libewf_handle_get_number_of_scan_threads(
 	          handle,
-	          &offset,
+	          &saved_number_of_threads,
 	          &error );
 
-	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	EWF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	offset_is_set = result;
+	result = libewf_handle_set_number_of_scan_threads(
+	          handle,
+	          2,
+	          &error );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBEWF )
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_get_number_of_scan_threads(
+	          handle,
+	          &number_of_threads,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_threads",
+	 number_of_threads,
+	 2 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+#else
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+#endif
+	result = libewf_handle_set_number_of_scan_threads(
+	          handle,
+	          saved_number_of_threads,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
 	/* Test error cases
 	 */
-	result = libewf_handle_get_offset(
+	result = libewf_handle_get_number_of_scan_threads(
 	          NULL,
-	          &offset,
+	          &number_of_threads,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -2120,25 +5946,57 @@ int ewf_test_handle_get_offset(
 	libcerror_error_free(
 	 &error );
 
-	if( offset_is_set != 0 )
-	{
-		result = libewf_handle_get_offset(
-		          handle,
-		          NULL,
-		          &error );
+	result = libewf_handle_get_number_of_scan_threads(
+	          handle,
+	          NULL,
+	          &error );
 
-		EWF_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 -1 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
-		EWF_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_set_number_of_scan_threads(
+	          NULL,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_set_number_of_scan_threads(
+	          handle,
+	          -1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
 
-		libcerror_error_free(
-		 &error );
-	}
 	return( 1 );
 
 on_error:
@@ -2665,20 +6523,268 @@ int ewf_test_handle_get_root_file_entry(
 		          &root_file_entry,
 		          &error );
 
-		EWF_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 1 );
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test error cases
+	 */
+	result = libewf_handle_get_root_file_entry(
+	          NULL,
+	          &root_file_entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "root_file_entry",
+	 root_file_entry );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	if( root_file_entry_is_set != 0 )
+	{
+		result = libewf_handle_get_root_file_entry(
+		          handle,
+		          NULL,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "root_file_entry",
+		 root_file_entry );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( root_file_entry != NULL )
+	{
+		libewf_file_entry_free(
+		 &root_file_entry,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_get_sectors_per_chunk function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_get_sectors_per_chunk(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error     = NULL;
+	uint32_t sectors_per_chunk   = 0;
+	int result                   = 0;
+	int sectors_per_chunk_is_set = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_get_sectors_per_chunk(
+	          handle,
+	          &sectors_per_chunk,
+	          &error );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	sectors_per_chunk_is_set = result;
+
+	/* Test error cases
+	 */
+	result = libewf_handle_get_sectors_per_chunk(
+	          NULL,
+	          &sectors_per_chunk,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	if( sectors_per_chunk_is_set != 0 )
+	{
+		result = libewf_handle_get_sectors_per_chunk(
+		          handle,
+		          NULL,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_get_bytes_per_sector function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_get_bytes_per_sector(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error    = NULL;
+	uint32_t bytes_per_sector   = 0;
+	int bytes_per_sector_is_set = 0;
+	int result                  = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_get_bytes_per_sector(
+	          handle,
+	          &bytes_per_sector,
+	          &error );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	bytes_per_sector_is_set = result;
+
+	/* Test error cases
+	 */
+	result = libewf_handle_get_bytes_per_sector(
+	          NULL,
+	          &bytes_per_sector,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	if( bytes_per_sector_is_set != 0 )
+	{
+		result = libewf_handle_get_bytes_per_sector(
+		          handle,
+		          NULL,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_get_number_of_sectors function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_get_number_of_sectors(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error     = NULL;
+	uint64_t number_of_sectors   = 0;
+	int number_of_sectors_is_set = 0;
+	int result                   = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_get_number_of_sectors(
+	          handle,
+	          &number_of_sectors,
+	          &error );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	number_of_sectors_is_set = result;
 
-		EWF_TEST_ASSERT_IS_NULL(
-		 "error",
-		 error );
-	}
 	/* Test error cases
 	 */
-	result = libewf_handle_get_root_file_entry(
+	result = libewf_handle_get_number_of_sectors(
 	          NULL,
-	          &root_file_entry,
+	          &number_of_sectors,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -2686,10 +6792,6 @@ int ewf_test_handle_get_root_file_entry(
 	 result,
 	 -1 );
 
-	EWF_TEST_ASSERT_IS_NULL(
-	 "root_file_entry",
-	 root_file_entry );
-
 	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
@@ -2697,9 +6799,9 @@ int ewf_test_handle_get_root_file_entry(
 	libcerror_error_free(
 	 &error );
 
-	if( root_file_entry_is_set != 0 )
+	if( number_of_sectors_is_set != 0 )
 	{
-		result = libewf_handle_get_root_file_entry(
+		result = libewf_handle_get_number_of_sectors(
 		          handle,
 		          NULL,
 		          &error );
@@ -2709,10 +6811,6 @@ int ewf_test_handle_get_root_file_entry(
 		 result,
 		 -1 );
 
-		EWF_TEST_ASSERT_IS_NULL(
-		 "root_file_entry",
-		 root_file_entry );
-
 		EWF_TEST_ASSERT_IS_NOT_NULL(
 		 "error",
 		 error );
@@ -2728,31 +6826,25 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
-	if( root_file_entry != NULL )
-	{
-		libewf_file_entry_free(
-		 &root_file_entry,
-		 NULL );
-	}
 	return( 0 );
 }
 
-/* Tests the libewf_handle_get_sectors_per_chunk function
+/* Tests the libewf_handle_get_chunk_size function
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_handle_get_sectors_per_chunk(
+int ewf_test_handle_get_chunk_size(
      libewf_handle_t *handle )
 {
-	libcerror_error_t *error     = NULL;
-	uint32_t sectors_per_chunk   = 0;
-	int result                   = 0;
-	int sectors_per_chunk_is_set = 0;
+	libcerror_error_t *error = NULL;
+	size32_t chunk_size      = 0;
+	int chunk_size_is_set    = 0;
+	int result               = 0;
 
 	/* Test regular cases
 	 */
-	result = libewf_handle_get_sectors_per_chunk(
+	result = libewf_handle_get_chunk_size(
 	          handle,
-	          &sectors_per_chunk,
+	          &chunk_size,
 	          &error );
 
 	EWF_TEST_ASSERT_NOT_EQUAL_INT(
@@ -2764,13 +6856,13 @@ int ewf_test_handle_get_sectors_per_chunk(
 	 "error",
 	 error );
 
-	sectors_per_chunk_is_set = result;
+	chunk_size_is_set = result;
 
 	/* Test error cases
 	 */
-	result = libewf_handle_get_sectors_per_chunk(
+	result = libewf_handle_get_chunk_size(
 	          NULL,
-	          &sectors_per_chunk,
+	          &chunk_size,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -2785,9 +6877,9 @@ int ewf_test_handle_get_sectors_per_chunk(
 	libcerror_error_free(
 	 &error );
 
-	if( sectors_per_chunk_is_set != 0 )
+	if( chunk_size_is_set != 0 )
 	{
-		result = libewf_handle_get_sectors_per_chunk(
+		result = libewf_handle_get_chunk_size(
 		          handle,
 		          NULL,
 		          &error );
@@ -2815,22 +6907,22 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libewf_handle_get_bytes_per_sector function
+/* Tests the libewf_handle_get_error_granularity function
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_handle_get_bytes_per_sector(
+int ewf_test_handle_get_error_granularity(
      libewf_handle_t *handle )
 {
-	libcerror_error_t *error    = NULL;
-	uint32_t bytes_per_sector   = 0;
-	int bytes_per_sector_is_set = 0;
-	int result                  = 0;
+	libcerror_error_t *error     = NULL;
+	uint32_t error_granularity   = 0;
+	int error_granularity_is_set = 0;
+	int result                   = 0;
 
 	/* Test regular cases
 	 */
-	result = libewf_handle_get_bytes_per_sector(
+	result = libewf_handle_get_error_granularity(
 	          handle,
-	          &bytes_per_sector,
+	          &error_granularity,
 	          &error );
 
 	EWF_TEST_ASSERT_NOT_EQUAL_INT(
@@ -2842,13 +6934,13 @@ int ewf_test_handle_get_bytes_per_sector(
 	 "error",
 	 error );
 
-	bytes_per_sector_is_set = result;
+	error_granularity_is_set = result;
 
 	/* Test error cases
 	 */
-	result = libewf_handle_get_bytes_per_sector(
+	result = libewf_handle_get_error_granularity(
 	          NULL,
-	          &bytes_per_sector,
+	          &error_granularity,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -2863,9 +6955,9 @@ int ewf_test_handle_get_bytes_per_sector(
 	libcerror_error_free(
 	 &error );
 
-	if( bytes_per_sector_is_set != 0 )
+	if( error_granularity_is_set != 0 )
 	{
-		result = libewf_handle_get_bytes_per_sector(
+		result = libewf_handle_get_error_granularity(
 		          handle,
 		          NULL,
 		          &error );
@@ -2893,22 +6985,22 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libewf_handle_get_number_of_sectors function
+/* Tests the libewf_handle_get_compression_method function
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_handle_get_number_of_sectors(
+int ewf_test_handle_get_compression_method(
      libewf_handle_t *handle )
 {
-	libcerror_error_t *error     = NULL;
-	uint64_t number_of_sectors   = 0;
-	int number_of_sectors_is_set = 0;
-	int result                   = 0;
+	libcerror_error_t *error      = NULL;
+	uint16_t compression_method   = 0;
+	int compression_method_is_set = 0;
+	int result                    = 0;
 
 	/* Test regular cases
 	 */
-	result = libewf_handle_get_number_of_sectors(
+	result = libewf_handle_get_compression_method(
 	          handle,
-	          &number_of_sectors,
+	          &compression_method,
 	          &error );
 
 	EWF_TEST_ASSERT_NOT_EQUAL_INT(
@@ -2920,13 +7012,13 @@ int ewf_test_handle_get_number_of_sectors(
 	 "error",
 	 error );
 
-	number_of_sectors_is_set = result;
+	compression_method_is_set = result;
 
 	/* Test error cases
 	 */
-	result = libewf_handle_get_number_of_sectors(
+	result = libewf_handle_get_compression_method(
 	          NULL,
-	          &number_of_sectors,
+	          &compression_method,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -2941,9 +7033,9 @@ int ewf_test_handle_get_number_of_sectors(
 	libcerror_error_free(
 	 &error );
 
-	if( number_of_sectors_is_set != 0 )
+	if( compression_method_is_set != 0 )
 	{
-		result = libewf_handle_get_number_of_sectors(
+		result = libewf_handle_get_compression_method(
 		          handle,
 		          NULL,
 		          &error );
@@ -2971,40 +7063,85 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libewf_handle_get_chunk_size function
+/* Tests the libewf_handle_get_compression_entropy_threshold and libewf_handle_set_compression_entropy_threshold functions
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_handle_get_chunk_size(
+int ewf_test_handle_set_compression_entropy_threshold(
      libewf_handle_t *handle )
 {
-	libcerror_error_t *error = NULL;
-	size32_t chunk_size      = 0;
-	int chunk_size_is_set    = 0;
-	int result               = 0;
+	libcerror_error_t *error        = NULL;
+	uint8_t entropy_threshold       = 0;
+	uint8_t saved_entropy_threshold = 0;
+	int result                      = 0;
 
 	/* Test regular cases
 	 */
-	result = libewf_handle_get_chunk_size(
+	result = libewf_handle_get_compression_entropy_threshold(
 	          handle,
-	          &chunk_size,
+	          &saved_entropy_threshold,
 	          &error );
 
-	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	EWF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	chunk_size_is_set = result;
+	result = libewf_handle_set_compression_entropy_threshold(
+	          handle,
+	          90,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_get_compression_entropy_threshold(
+	          handle,
+	          &entropy_threshold,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "entropy_threshold",
+	 entropy_threshold,
+	 90 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_set_compression_entropy_threshold(
+	          handle,
+	          saved_entropy_threshold,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
 	/* Test error cases
 	 */
-	result = libewf_handle_get_chunk_size(
+	result = libewf_handle_get_compression_entropy_threshold(
 	          NULL,
-	          &chunk_size,
+	          &entropy_threshold,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -3019,25 +7156,57 @@ int ewf_test_handle_get_chunk_size(
 	libcerror_error_free(
 	 &error );
 
-	if( chunk_size_is_set != 0 )
-	{
-		result = libewf_handle_get_chunk_size(
-		          handle,
-		          NULL,
-		          &error );
+	result = libewf_handle_get_compression_entropy_threshold(
+	          handle,
+	          NULL,
+	          &error );
 
-		EWF_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 -1 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
-		EWF_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_set_compression_entropy_threshold(
+	          NULL,
+	          90,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_set_compression_entropy_threshold(
+	          handle,
+	          101,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
 
-		libcerror_error_free(
-		 &error );
-	}
 	return( 1 );
 
 on_error:
@@ -3049,40 +7218,85 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libewf_handle_get_error_granularity function
+/* Tests the libewf_handle_get_compression_target_throughput and libewf_handle_set_compression_target_throughput functions
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_handle_get_error_granularity(
+int ewf_test_handle_set_compression_target_throughput(
      libewf_handle_t *handle )
 {
-	libcerror_error_t *error     = NULL;
-	uint32_t error_granularity   = 0;
-	int error_granularity_is_set = 0;
-	int result                   = 0;
+	libcerror_error_t *error         = NULL;
+	uint64_t saved_target_throughput = 0;
+	uint64_t target_throughput       = 0;
+	int result                       = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_get_compression_target_throughput(
+	          handle,
+	          &saved_target_throughput,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_set_compression_target_throughput(
+	          handle,
+	          104857600,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-	/* Test regular cases
-	 */
-	result = libewf_handle_get_error_granularity(
+	result = libewf_handle_get_compression_target_throughput(
 	          handle,
-	          &error_granularity,
+	          &target_throughput,
 	          &error );
 
-	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	EWF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "target_throughput",
+	 target_throughput,
+	 (uint64_t) 104857600 );
 
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	error_granularity_is_set = result;
+	result = libewf_handle_set_compression_target_throughput(
+	          handle,
+	          saved_target_throughput,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
 	/* Test error cases
 	 */
-	result = libewf_handle_get_error_granularity(
+	result = libewf_handle_get_compression_target_throughput(
 	          NULL,
-	          &error_granularity,
+	          &target_throughput,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -3097,70 +7311,26 @@ int ewf_test_handle_get_error_granularity(
 	libcerror_error_free(
 	 &error );
 
-	if( error_granularity_is_set != 0 )
-	{
-		result = libewf_handle_get_error_granularity(
-		          handle,
-		          NULL,
-		          &error );
-
-		EWF_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 -1 );
-
-		EWF_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
-
-		libcerror_error_free(
-		 &error );
-	}
-	return( 1 );
-
-on_error:
-	if( error != NULL )
-	{
-		libcerror_error_free(
-		 &error );
-	}
-	return( 0 );
-}
-
-/* Tests the libewf_handle_get_compression_method function
- * Returns 1 if successful or 0 if not
- */
-int ewf_test_handle_get_compression_method(
-     libewf_handle_t *handle )
-{
-	libcerror_error_t *error      = NULL;
-	uint16_t compression_method   = 0;
-	int compression_method_is_set = 0;
-	int result                    = 0;
-
-	/* Test regular cases
-	 */
-	result = libewf_handle_get_compression_method(
+	result = libewf_handle_get_compression_target_throughput(
 	          handle,
-	          &compression_method,
+	          NULL,
 	          &error );
 
-	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	EWF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
 	 -1 );
 
-	EWF_TEST_ASSERT_IS_NULL(
+	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
 
-	compression_method_is_set = result;
+	libcerror_error_free(
+	 &error );
 
-	/* Test error cases
-	 */
-	result = libewf_handle_get_compression_method(
+	result = libewf_handle_set_compression_target_throughput(
 	          NULL,
-	          &compression_method,
+	          104857600,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -3175,25 +7345,6 @@ int ewf_test_handle_get_compression_method(
 	libcerror_error_free(
 	 &error );
 
-	if( compression_method_is_set != 0 )
-	{
-		result = libewf_handle_get_compression_method(
-		          handle,
-		          NULL,
-		          &error );
-
-		EWF_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 -1 );
-
-		EWF_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
-
-		libcerror_error_free(
-		 &error );
-	}
 	return( 1 );
 
 on_error:
@@ -3673,6 +7824,115 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libewf_handle_get_statistics_value function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_get_statistics_value(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error = NULL;
+	uint64_t value           = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_get_statistics_value(
+	          handle,
+	          LIBEWF_STATISTICS_VALUE_CHUNK_CACHE_HITS,
+	          &value,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_get_statistics_value(
+	          handle,
+	          LIBEWF_STATISTICS_VALUE_BYTES_READ,
+	          &value,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_handle_get_statistics_value(
+	          NULL,
+	          LIBEWF_STATISTICS_VALUE_CHUNK_CACHE_HITS,
+	          &value,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_statistics_value(
+	          handle,
+	          -1,
+	          &value,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_statistics_value(
+	          handle,
+	          LIBEWF_STATISTICS_VALUE_CHUNK_CACHE_HITS,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
 /* Tests the libewf_handle_get_number_of_sessions function
  * Returns 1 if successful or 0 if not
  */
@@ -4299,6 +8559,23 @@ int main(
 		 "error",
 		 error );
 
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_open_read_metadata",
+		 ewf_test_handle_open_read_metadata,
+		 source,
+		 handle );
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_open_read_lazy",
+		 ewf_test_handle_open_read_lazy,
+		 source,
+		 handle );
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_clone_with_flags",
+		 ewf_test_handle_clone_with_flags,
+		 handle );
+
 		EWF_TEST_RUN_WITH_ARGS(
 		 "libewf_handle_signal_abort",
 		 ewf_test_handle_signal_abort,
@@ -4314,6 +8591,39 @@ int main(
 		 ewf_test_handle_read_buffer_at_offset,
 		 handle );
 
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_read_buffers_at_offsets",
+		 ewf_test_handle_read_buffers_at_offsets,
+		 handle );
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_submit_read_buffer_at_offset",
+		 ewf_test_handle_submit_read_buffer_at_offset,
+		 handle );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBEWF )
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_read_buffer_at_offset_parallel",
+		 ewf_test_handle_read_buffer_at_offset_parallel,
+		 handle );
+
+#endif
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_pin_chunk_view",
+		 ewf_test_handle_pin_chunk_view,
+		 handle );
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_read_buffer_at_offset_entire_chunks",
+		 ewf_test_handle_read_buffer_at_offset_entire_chunks,
+		 handle );
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_get_next_data_range",
+		 ewf_test_handle_get_next_data_range,
+		 handle );
+
 		/* TODO: add tests for libewf_handle_write_buffer */
 
 		/* TODO: add tests for libewf_handle_write_buffer_at_offset */
@@ -4341,6 +8651,48 @@ int main(
 
 		/* TODO: add tests for libewf_handle_set_maximum_number_of_open_handles */
 
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_set_chunk_cache_size",
+		 ewf_test_handle_set_chunk_cache_size,
+		 handle );
+
+		/* TODO: add tests for libewf_handle_set_chunk_groups_cache_size */
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_set_maximum_coalesced_read_size",
+		 ewf_test_handle_set_maximum_coalesced_read_size,
+		 handle );
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_get_chunk_cache_statistics",
+		 ewf_test_handle_get_chunk_cache_statistics,
+		 handle );
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_set_read_ahead_values",
+		 ewf_test_handle_set_read_ahead_values,
+		 handle );
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_set_number_of_unpack_threads",
+		 ewf_test_handle_set_number_of_unpack_threads,
+		 handle );
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_set_number_of_pack_threads",
+		 ewf_test_handle_set_number_of_pack_threads,
+		 handle );
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_set_number_of_scan_threads",
+		 ewf_test_handle_set_number_of_scan_threads,
+		 handle );
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_set_number_of_async_read_threads",
+		 ewf_test_handle_set_number_of_async_read_threads,
+		 handle );
+
 		/* TODO: add tests for libewf_handle_segment_files_corrupted */
 
 		/* TODO: add tests for libewf_handle_segment_files_encrypted */
@@ -4448,6 +8800,16 @@ int main(
 
 		/* TODO: add tests for libewf_handle_set_compression_values */
 
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_set_compression_entropy_threshold",
+		 ewf_test_handle_set_compression_entropy_threshold,
+		 handle );
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_set_compression_target_throughput",
+		 ewf_test_handle_set_compression_target_throughput,
+		 handle );
+
 		EWF_TEST_RUN_WITH_ARGS(
 		 "libewf_handle_get_media_size",
 		 ewf_test_handle_get_media_size,
@@ -4512,6 +8874,13 @@ int main(
 
 		/* TODO: add tests for libewf_handle_append_checksum_error */
 
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_get_statistics_value",
+		 ewf_test_handle_get_statistics_value,
+		 handle );
+
+		/* TODO: add tests for libewf_handle_reset_statistics */
+
 		EWF_TEST_RUN_WITH_ARGS(
 		 "libewf_handle_get_number_of_sessions",
 		 ewf_test_handle_get_number_of_sessions,
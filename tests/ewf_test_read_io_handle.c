@@ -416,6 +416,243 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libewf_read_io_handle_set_empty_block_compressed_data and libewf_read_io_handle_is_empty_block_compressed_data functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_read_io_handle_empty_block_compressed_data(
+     void )
+{
+	uint8_t compressed_data1[ 8 ] = { 0x78, 0x9c, 0x63, 0x60, 0x18, 0x05, 0xa3, 0x60 };
+	uint8_t compressed_data2[ 8 ] = { 0x78, 0x9c, 0x63, 0x60, 0x18, 0x05, 0xa3, 0x61 };
+
+	libcerror_error_t *error                = NULL;
+	libewf_read_io_handle_t *read_io_handle = NULL;
+	int result                              = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_read_io_handle_initialize(
+	          &read_io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "read_io_handle",
+	 read_io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_read_io_handle_is_empty_block_compressed_data(
+	          read_io_handle,
+	          compressed_data1,
+	          8,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_read_io_handle_set_empty_block_compressed_data(
+	          read_io_handle,
+	          compressed_data1,
+	          8,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_read_io_handle_is_empty_block_compressed_data(
+	          read_io_handle,
+	          compressed_data1,
+	          8,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_read_io_handle_is_empty_block_compressed_data(
+	          read_io_handle,
+	          compressed_data2,
+	          8,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_read_io_handle_is_empty_block_compressed_data(
+	          read_io_handle,
+	          compressed_data1,
+	          7,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_read_io_handle_set_empty_block_compressed_data(
+	          NULL,
+	          compressed_data1,
+	          8,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_read_io_handle_set_empty_block_compressed_data(
+	          read_io_handle,
+	          NULL,
+	          8,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_read_io_handle_set_empty_block_compressed_data(
+	          read_io_handle,
+	          compressed_data1,
+	          (size_t) LIBEWF_MAXIMUM_EMPTY_BLOCK_COMPRESSED_DATA_SIZE + 1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_read_io_handle_is_empty_block_compressed_data(
+	          NULL,
+	          compressed_data1,
+	          8,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_read_io_handle_is_empty_block_compressed_data(
+	          read_io_handle,
+	          NULL,
+	          8,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_read_io_handle_free(
+	          &read_io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "read_io_handle",
+	 read_io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( read_io_handle != NULL )
+	{
+		libewf_read_io_handle_free(
+		 &read_io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
 #endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
 
 /* The main program
@@ -447,6 +684,10 @@ int main(
 	 "libewf_read_io_handle_clone",
 	 ewf_test_read_io_handle_clone );
 
+	EWF_TEST_RUN(
+	 "libewf_read_io_handle_empty_block_compressed_data",
+	 ewf_test_read_io_handle_empty_block_compressed_data );
+
 #endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
 
 	return( EXIT_SUCCESS );
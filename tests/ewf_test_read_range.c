@@ -0,0 +1,446 @@
+/*
+ * Library read_range type test program
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_read_range.h"
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+/* Tests the libewf_read_range_split_buffers function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_read_range_split_buffers(
+     void )
+{
+	uint8_t buffer1[ 30 ];
+	uint8_t buffer2[ 16 ];
+	uint8_t buffer3[ 20 ];
+	uint8_t buffer4[ 8 ];
+
+	void *buffers[ 4 ]               = { buffer1, buffer2, buffer3, buffer4 };
+	size_t buffer_sizes[ 4 ]         = { 30, 16, 20, 8 };
+	off64_t offsets[ 4 ]             = { 40, 0, 90, 200 };
+	libcerror_error_t *error         = NULL;
+	libewf_read_range_t *read_ranges = NULL;
+	int number_of_ranges_in_chunk    = 0;
+	int number_of_read_ranges        = 0;
+	int result                       = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_read_range_split_buffers(
+	          &read_ranges,
+	          &number_of_read_ranges,
+	          buffers,
+	          buffer_sizes,
+	          offsets,
+	          4,
+	          100,
+	          32,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "read_ranges",
+	 read_ranges );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_read_ranges",
+	 number_of_read_ranges,
+	 5 );
+
+	/* The read ranges are sorted by chunk index and offset in the chunk data
+	 */
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "read_ranges[ 0 ].chunk_index",
+	 read_ranges[ 0 ].chunk_index,
+	 (uint64_t) 0 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "read_ranges[ 0 ].buffer_index",
+	 read_ranges[ 0 ].buffer_index,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "read_ranges[ 0 ].buffer_size",
+	 read_ranges[ 0 ].buffer_size,
+	 (size_t) 16 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "read_ranges[ 1 ].chunk_index",
+	 read_ranges[ 1 ].chunk_index,
+	 (uint64_t) 1 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "read_ranges[ 1 ].chunk_data_offset",
+	 read_ranges[ 1 ].chunk_data_offset,
+	 (size_t) 8 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "read_ranges[ 1 ].buffer_size",
+	 read_ranges[ 1 ].buffer_size,
+	 (size_t) 24 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "read_ranges[ 2 ].chunk_index",
+	 read_ranges[ 2 ].chunk_index,
+	 (uint64_t) 2 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "read_ranges[ 2 ].buffer_index",
+	 read_ranges[ 2 ].buffer_index,
+	 0 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "read_ranges[ 2 ].buffer_size",
+	 read_ranges[ 2 ].buffer_size,
+	 (size_t) 6 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "read_ranges[ 3 ].chunk_index",
+	 read_ranges[ 3 ].chunk_index,
+	 (uint64_t) 2 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "read_ranges[ 3 ].buffer_index",
+	 read_ranges[ 3 ].buffer_index,
+	 2 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "read_ranges[ 3 ].chunk_data_offset",
+	 read_ranges[ 3 ].chunk_data_offset,
+	 (size_t) 26 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "read_ranges[ 3 ].buffer_size",
+	 read_ranges[ 3 ].buffer_size,
+	 (size_t) 6 );
+
+	/* The last read range is limited to the media size
+	 */
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "read_ranges[ 4 ].chunk_index",
+	 read_ranges[ 4 ].chunk_index,
+	 (uint64_t) 3 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "read_ranges[ 4 ].buffer_size",
+	 read_ranges[ 4 ].buffer_size,
+	 (size_t) 4 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "read_ranges[ 4 ].buffer",
+	 (int) ( read_ranges[ 4 ].buffer - buffer3 ),
+	 6 );
+
+	result = libewf_read_range_get_number_of_ranges_in_chunk(
+	          read_ranges,
+	          number_of_read_ranges,
+	          2,
+	          &number_of_ranges_in_chunk,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_ranges_in_chunk",
+	 number_of_ranges_in_chunk,
+	 2 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_read_range_get_number_of_ranges_in_chunk(
+	          read_ranges,
+	          number_of_read_ranges,
+	          4,
+	          &number_of_ranges_in_chunk,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_ranges_in_chunk",
+	 number_of_ranges_in_chunk,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_read_range_get_number_of_ranges_in_chunk(
+	          read_ranges,
+	          number_of_read_ranges,
+	          5,
+	          &number_of_ranges_in_chunk,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_read_range_split_buffers(
+	          &read_ranges,
+	          &number_of_read_ranges,
+	          buffers,
+	          buffer_sizes,
+	          offsets,
+	          4,
+	          100,
+	          32,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	memory_free(
+	 read_ranges );
+
+	read_ranges = NULL;
+
+	result = libewf_read_range_split_buffers(
+	          NULL,
+	          &number_of_read_ranges,
+	          buffers,
+	          buffer_sizes,
+	          offsets,
+	          4,
+	          100,
+	          32,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_read_range_split_buffers(
+	          &read_ranges,
+	          &number_of_read_ranges,
+	          buffers,
+	          buffer_sizes,
+	          offsets,
+	          -1,
+	          100,
+	          32,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_read_range_split_buffers(
+	          &read_ranges,
+	          &number_of_read_ranges,
+	          buffers,
+	          buffer_sizes,
+	          offsets,
+	          4,
+	          100,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	offsets[ 1 ] = -1;
+
+	result = libewf_read_range_split_buffers(
+	          &read_ranges,
+	          &number_of_read_ranges,
+	          buffers,
+	          buffer_sizes,
+	          offsets,
+	          4,
+	          100,
+	          32,
+	          &error );
+
+	offsets[ 1 ] = 0;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "read_ranges",
+	 read_ranges );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	buffers[ 2 ] = NULL;
+
+	result = libewf_read_range_split_buffers(
+	          &read_ranges,
+	          &number_of_read_ranges,
+	          buffers,
+	          buffer_sizes,
+	          offsets,
+	          4,
+	          100,
+	          32,
+	          &error );
+
+	buffers[ 2 ] = buffer3;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "read_ranges",
+	 read_ranges );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( read_ranges != NULL )
+	{
+		memory_free(
+		 read_ranges );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+	/* TODO: add tests for libewf_read_range_compare */
+
+	EWF_TEST_RUN(
+	 "libewf_read_range_split_buffers",
+	 ewf_test_read_range_split_buffers );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
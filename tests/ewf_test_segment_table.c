@@ -33,6 +33,8 @@
 #include "ewf_test_memory.h"
 #include "ewf_test_unused.h"
 
+#include "../libewf/libewf_definitions.h"
+#include "../libewf/libewf_io_handle.h"
 #include "../libewf/libewf_segment_table.h"
 
 #if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
@@ -264,6 +266,255 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libewf_segment_table_scan_segment_files_to_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_segment_table_scan_segment_files_to_offset(
+     void )
+{
+	libcerror_error_t *error              = NULL;
+	libewf_io_handle_t *io_handle         = NULL;
+	libewf_segment_table_t *segment_table = NULL;
+	int result                            = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_segment_table_initialize(
+	          &segment_table,
+	          io_handle,
+	          LIBEWF_DEFAULT_SEGMENT_FILE_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "segment_table",
+	 segment_table );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_segment_table_scan_segment_files_to_offset(
+	          segment_table,
+	          NULL,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test if scanning on demand is disabled when all the segments have been scanned
+	 */
+	segment_table->flags |= LIBEWF_SEGMENT_TABLE_FLAG_SCAN_ON_DEMAND;
+
+	result = libewf_segment_table_scan_segment_files_to_offset(
+	          segment_table,
+	          NULL,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "flags",
+	 (int) ( segment_table->flags & LIBEWF_SEGMENT_TABLE_FLAG_SCAN_ON_DEMAND ),
+	 0 );
+
+	/* Test if no segment is scanned for an offset in the segments that have been scanned
+	 */
+	segment_table->flags                     |= LIBEWF_SEGMENT_TABLE_FLAG_SCAN_ON_DEMAND;
+	segment_table->number_of_segments         = 2;
+	segment_table->number_of_scanned_segments = 1;
+	segment_table->scanned_storage_media_size = 4096;
+
+	result = libewf_segment_table_scan_segment_files_to_offset(
+	          segment_table,
+	          NULL,
+	          4095,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "number_of_scanned_segments",
+	 segment_table->number_of_scanned_segments,
+	 1 );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	 "flags",
+	 (int) ( segment_table->flags & LIBEWF_SEGMENT_TABLE_FLAG_SCAN_ON_DEMAND ),
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libewf_segment_table_scan_segment_files_to_offset(
+	          NULL,
+	          NULL,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_segment_table_scan_segment_files_to_offset(
+	          segment_table,
+	          NULL,
+	          -1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test error case where the next segment to scan is missing
+	 */
+	result = libewf_segment_table_scan_segment_files_to_offset(
+	          segment_table,
+	          NULL,
+	          4096,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "number_of_scanned_segments",
+	 segment_table->number_of_scanned_segments,
+	 1 );
+
+	/* Clean up
+	 */
+	segment_table->flags                     &= ~( LIBEWF_SEGMENT_TABLE_FLAG_SCAN_ON_DEMAND );
+	segment_table->number_of_segments         = 0;
+	segment_table->number_of_scanned_segments = 0;
+	segment_table->scanned_storage_media_size = 0;
+
+	result = libewf_segment_table_free(
+	          &segment_table,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "segment_table",
+	 segment_table );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( segment_table != NULL )
+	{
+		libewf_segment_table_free(
+		 &segment_table,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libewf_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
 #endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
 
 /* The main program
@@ -331,6 +582,10 @@ int main(
 
 	/* TODO: add tests for libewf_segment_table_get_segment_file_by_index */
 
+	EWF_TEST_RUN(
+	 "libewf_segment_table_scan_segment_files_to_offset",
+	 ewf_test_segment_table_scan_segment_files_to_offset );
+
 	/* TODO: add tests for libewf_segment_table_get_segment_file_at_offset */
 
 	/* TODO: add tests for libewf_segment_table_set_segment_file_by_index */
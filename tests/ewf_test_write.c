@@ -20,6 +20,7 @@
  */
 
 #include <common.h>
+#include <file_stream.h>
 #include <memory.h>
 #include <narrow_string.h>
 #include <system_string.h>
@@ -42,6 +43,12 @@
 
 #define EWF_TEST_WRITE_BUFFER_SIZE		4096
 
+/* The date used for the acquiry and system date header values
+ * so that the images written by the tests do not depend on the current time
+ */
+#define EWF_TEST_WRITE_DATE			"1483228800"
+#define EWF_TEST_WRITE_DATE_LENGTH		10
+
 /* Copies a string of a decimal value to a 64-bit value
  * Returns 1 if successful or -1 on error
  */
@@ -153,6 +160,7 @@ int ewf_test_system_string_decimal_copy_to_64_bit(
 }
 
 /* Tests writing data of media size to EWF file(s) with a maximum segment size
+ * The chunks are packed by number of pack threads, where 0 represents the sequential write
  * Return 1 if successful, 0 if not or -1 on error
  */
 int ewf_test_write(
@@ -161,6 +169,7 @@ int ewf_test_write(
      size64_t maximum_segment_size,
      int8_t compression_level,
      uint8_t compression_flags,
+     int number_of_pack_threads,
      libcerror_error_t **error )
 {
 	libewf_handle_t *handle = NULL;
@@ -257,6 +266,57 @@ int ewf_test_write(
 
 		goto on_error;
 	}
+	if( number_of_pack_threads > 0 )
+	{
+		if( libewf_handle_set_number_of_pack_threads(
+		     handle,
+		     number_of_pack_threads,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable set number of pack threads.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libewf_handle_set_utf8_header_value(
+	     handle,
+	     (uint8_t *) "acquiry_date",
+	     12,
+	     (uint8_t *) EWF_TEST_WRITE_DATE,
+	     EWF_TEST_WRITE_DATE_LENGTH,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable set header value: acquiry_date.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_set_utf8_header_value(
+	     handle,
+	     (uint8_t *) "system_date",
+	     11,
+	     (uint8_t *) EWF_TEST_WRITE_DATE,
+	     EWF_TEST_WRITE_DATE_LENGTH,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable set header value: system_date.",
+		 function );
+
+		goto on_error;
+	}
 	buffer = (uint8_t *) memory_allocate(
 	                      EWF_TEST_WRITE_BUFFER_SIZE );
 
@@ -438,6 +498,327 @@ on_error:
 	return( -1 );
 }
 
+/* Compares the data of two files
+ * Returns 1 if the data is identical, 0 if not or -1 on error
+ */
+int ewf_test_write_compare_files(
+     const system_character_t *first_filename,
+     const system_character_t *second_filename,
+     libcerror_error_t **error )
+{
+	uint8_t first_buffer[ EWF_TEST_WRITE_BUFFER_SIZE ];
+	uint8_t second_buffer[ EWF_TEST_WRITE_BUFFER_SIZE ];
+
+	FILE *first_stream     = NULL;
+	FILE *second_stream    = NULL;
+	static char *function  = "ewf_test_write_compare_files";
+	size_t first_read_size = 0;
+	size_t read_size       = 0;
+	int result             = 1;
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	first_stream = file_stream_open_wide(
+	                first_filename,
+	                L"rb" );
+#else
+	first_stream = file_stream_open(
+	                first_filename,
+	                "rb" );
+#endif
+	if( first_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open first file.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	second_stream = file_stream_open_wide(
+	                 second_filename,
+	                 L"rb" );
+#else
+	second_stream = file_stream_open(
+	                 second_filename,
+	                 "rb" );
+#endif
+	if( second_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open second file.",
+		 function );
+
+		goto on_error;
+	}
+	do
+	{
+		first_read_size = file_stream_read(
+		                   first_stream,
+		                   first_buffer,
+		                   EWF_TEST_WRITE_BUFFER_SIZE );
+
+		read_size = file_stream_read(
+		             second_stream,
+		             second_buffer,
+		             EWF_TEST_WRITE_BUFFER_SIZE );
+
+		if( read_size != first_read_size )
+		{
+			result = 0;
+		}
+		else if( memory_compare(
+		          first_buffer,
+		          second_buffer,
+		          read_size ) != 0 )
+		{
+			result = 0;
+		}
+	}
+	while( ( result == 1 )
+	    && ( read_size == EWF_TEST_WRITE_BUFFER_SIZE ) );
+
+	if( file_stream_close(
+	     second_stream ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close second file.",
+		 function );
+
+		second_stream = NULL;
+
+		goto on_error;
+	}
+	second_stream = NULL;
+
+	if( file_stream_close(
+	     first_stream ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close first file.",
+		 function );
+
+		first_stream = NULL;
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( second_stream != NULL )
+	{
+		file_stream_close(
+		 second_stream );
+	}
+	if( first_stream != NULL )
+	{
+		file_stream_close(
+		 first_stream );
+	}
+	return( -1 );
+}
+
+/* Compares the segment files of two EWF images
+ * The images are referenced by the filename they were written with
+ * Returns 1 if the segment files are identical, 0 if not or -1 on error
+ */
+int ewf_test_write_compare_images(
+     const system_character_t *first_filename,
+     const system_character_t *second_filename,
+     libcerror_error_t **error )
+{
+	const system_character_t *filenames[ 2 ]     = { NULL, NULL };
+	system_character_t *segment_filename         = NULL;
+	system_character_t **segment_filenames[ 2 ]  = { NULL, NULL };
+	static char *function                        = "ewf_test_write_compare_images";
+	size_t filename_length                       = 0;
+	int filename_index                           = 0;
+	int image_index                              = 0;
+	int number_of_segment_filenames[ 2 ]         = { 0, 0 };
+	int result                                   = 1;
+
+	filenames[ 0 ] = first_filename;
+	filenames[ 1 ] = second_filename;
+
+	for( image_index = 0;
+	     image_index < 2;
+	     image_index++ )
+	{
+		filename_length = system_string_length(
+		                   filenames[ image_index ] );
+
+		/* The first segment file has the .E01 extension
+		 */
+		segment_filename = system_string_allocate(
+		                    filename_length + 5 );
+
+		if( segment_filename == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create segment filename.",
+			 function );
+
+			goto on_error;
+		}
+		if( system_string_copy(
+		     segment_filename,
+		     filenames[ image_index ],
+		     filename_length ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy filename.",
+			 function );
+
+			goto on_error;
+		}
+		if( system_string_copy(
+		     &( segment_filename[ filename_length ] ),
+		     _SYSTEM_STRING( ".E01" ),
+		     5 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy extension.",
+			 function );
+
+			goto on_error;
+		}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		if( libewf_glob_wide(
+		     segment_filename,
+		     filename_length + 4,
+		     LIBEWF_FORMAT_UNKNOWN,
+		     &( segment_filenames[ image_index ] ),
+		     &( number_of_segment_filenames[ image_index ] ),
+		     error ) != 1 )
+#else
+		if( libewf_glob(
+		     segment_filename,
+		     filename_length + 4,
+		     LIBEWF_FORMAT_UNKNOWN,
+		     &( segment_filenames[ image_index ] ),
+		     &( number_of_segment_filenames[ image_index ] ),
+		     error ) != 1 )
+#endif
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to glob segment files.",
+			 function );
+
+			goto on_error;
+		}
+		memory_free(
+		 segment_filename );
+
+		segment_filename = NULL;
+	}
+	if( number_of_segment_filenames[ 0 ] != number_of_segment_filenames[ 1 ] )
+	{
+		result = 0;
+	}
+	for( filename_index = 0;
+	     ( result == 1 ) && ( filename_index < number_of_segment_filenames[ 0 ] );
+	     filename_index++ )
+	{
+		result = ewf_test_write_compare_files(
+		          segment_filenames[ 0 ][ filename_index ],
+		          segment_filenames[ 1 ][ filename_index ],
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to compare segment file: %d.",
+			 function,
+			 filename_index );
+
+			goto on_error;
+		}
+	}
+	for( image_index = 0;
+	     image_index < 2;
+	     image_index++ )
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		if( libewf_glob_wide_free(
+		     segment_filenames[ image_index ],
+		     number_of_segment_filenames[ image_index ],
+		     error ) != 1 )
+#else
+		if( libewf_glob_free(
+		     segment_filenames[ image_index ],
+		     number_of_segment_filenames[ image_index ],
+		     error ) != 1 )
+#endif
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free globbed segment filenames.",
+			 function );
+
+			segment_filenames[ image_index ] = NULL;
+
+			goto on_error;
+		}
+		segment_filenames[ image_index ] = NULL;
+	}
+	return( result );
+
+on_error:
+	for( image_index = 0;
+	     image_index < 2;
+	     image_index++ )
+	{
+		if( segment_filenames[ image_index ] != NULL )
+		{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+			libewf_glob_wide_free(
+			 segment_filenames[ image_index ],
+			 number_of_segment_filenames[ image_index ],
+			 NULL );
+#else
+			libewf_glob_free(
+			 segment_filenames[ image_index ],
+			 number_of_segment_filenames[ image_index ],
+			 NULL );
+#endif
+		}
+	}
+	if( segment_filename != NULL )
+	{
+		memory_free(
+		 segment_filename );
+	}
+	return( -1 );
+}
+
 /* The main program
  */
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
@@ -451,18 +832,22 @@ int main( int argc, char * const argv[] )
 	system_character_t *option_compression_level    = NULL;
 	system_character_t *option_maximum_segment_size = NULL;
 	system_character_t *option_media_size           = NULL;
+	system_character_t *option_number_of_threads    = NULL;
+	system_character_t *parallel_filename           = NULL;
 	system_integer_t option                         = 0;
 	size64_t chunk_size                             = 0;
 	size64_t maximum_segment_size                   = 0;
 	size64_t media_size                             = 0;
+	uint64_t number_of_threads                      = 0;
 	size_t string_length                            = 0;
 	uint8_t compression_flags                       = 0;
 	int8_t compression_level                        = LIBEWF_COMPRESSION_NONE;
+	int result                                      = 0;
 
 	while( ( option = ewf_test_getopt(
 	                   argc,
 	                   argv,
-	                   _SYSTEM_STRING( "b:B:c:S:" ) ) ) != (system_integer_t) -1 )
+	                   _SYSTEM_STRING( "b:B:c:S:t:" ) ) ) != (system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -493,6 +878,11 @@ int main( int argc, char * const argv[] )
 			case (system_integer_t) 'S':
 				option_maximum_segment_size = optarg;
 
+				break;
+
+			case (system_integer_t) 't':
+				option_number_of_threads = optarg;
+
 				break;
 		}
 	}
@@ -547,6 +937,11 @@ int main( int argc, char * const argv[] )
 			compression_level = LIBEWF_COMPRESSION_BEST;
 			compression_flags = 0;
 		}
+		else if( option_compression_level[ 0 ] == (system_character_t) 'd' )
+		{
+			compression_level = LIBEWF_COMPRESSION_FAST;
+			compression_flags = LIBEWF_COMPRESS_FLAG_USE_BUILTIN_DEFLATE;
+		}
 		else if( option_compression_level[ 0 ] == (system_character_t) 'e' )
 		{
 			compression_level = LIBEWF_COMPRESSION_NONE;
@@ -607,12 +1002,39 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 	}
+	if( option_number_of_threads != NULL )
+	{
+		string_length = system_string_length(
+				 option_number_of_threads );
+
+		if( ewf_test_system_string_decimal_copy_to_64_bit(
+		     option_number_of_threads,
+		     string_length + 1,
+		     &number_of_threads,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported number of threads.\n" );
+
+			goto on_error;
+		}
+		if( number_of_threads > (uint64_t) INT_MAX )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported number of threads.\n" );
+
+			goto on_error;
+		}
+	}
 	if( ewf_test_write(
 	     argv[ optind ],
 	     media_size,
 	     maximum_segment_size,
 	     compression_level,
 	     compression_flags,
+	     0,
 	     &error ) != 1 )
 	{
 		fprintf(
@@ -621,9 +1043,98 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBEWF )
+	if( number_of_threads > 0 )
+	{
+		/* Write the same data with pack threads, the resulting image must be identical
+		 */
+		string_length = system_string_length(
+				 argv[ optind ] );
+
+		parallel_filename = system_string_allocate(
+		                     string_length + 10 );
+
+		if( parallel_filename == NULL )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to create parallel filename.\n" );
+
+			goto on_error;
+		}
+		if( system_string_copy(
+		     parallel_filename,
+		     argv[ optind ],
+		     string_length ) == NULL )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to copy parallel filename.\n" );
+
+			goto on_error;
+		}
+		if( system_string_copy(
+		     &( parallel_filename[ string_length ] ),
+		     _SYSTEM_STRING( "_parallel" ),
+		     10 ) == NULL )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to copy parallel filename.\n" );
+
+			goto on_error;
+		}
+		if( ewf_test_write(
+		     parallel_filename,
+		     media_size,
+		     maximum_segment_size,
+		     compression_level,
+		     compression_flags,
+		     (int) number_of_threads,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to test write with pack threads.\n" );
+
+			goto on_error;
+		}
+		result = ewf_test_write_compare_images(
+		          argv[ optind ],
+		          parallel_filename,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to compare images.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Image written with pack threads differs.\n" );
+
+			goto on_error;
+		}
+		memory_free(
+		 parallel_filename );
+
+		parallel_filename = NULL;
+	}
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBEWF ) */
+
 	return( EXIT_SUCCESS );
 
 on_error:
+	if( parallel_filename != NULL )
+	{
+		memory_free(
+		 parallel_filename );
+	}
 	if( error != NULL )
 	{
 		libewf_error_backtrace_fprint(
@@ -536,6 +536,11 @@ int main( int argc, char * const argv[] )
 			compression_level = LIBEWF_COMPRESSION_BEST;
 			compression_flags = 0;
 		}
+		else if( option_compression_level[ 0 ] == (system_character_t) 'd' )
+		{
+			compression_level = LIBEWF_COMPRESSION_FAST;
+			compression_flags = LIBEWF_COMPRESS_FLAG_USE_BUILTIN_DEFLATE;
+		}
 		else if( option_compression_level[ 0 ] == (system_character_t) 'e' )
 		{
 			compression_level = LIBEWF_COMPRESSION_NONE;
@@ -58,12 +58,19 @@ test_write()
 	local TEST_PROFILE=$1;
 	local TEST_FUNCTION=$2;
 	local OPTION_SETS=$3;
+	local PACK_THREADS_OPTION="";
 
-	for COMPRESSION_LEVEL in none empty-block fast best;
+	# Compare the image written with pack threads with the sequentially written image
+	if test "${TEST_FUNCTION}" = "write";
+	then
+		PACK_THREADS_OPTION="-t4";
+	fi
+
+	for COMPRESSION_LEVEL in none empty-block fast deflate-builtin best;
 	do
 		COMPRESSION_LEVEL=`echo ${COMPRESSION_LEVEL} | cut -c 1`;
 
-		test_api_write_function "${TEST_FUNCTION}" -B0 -c${COMPRESSION_LEVEL} -S0;
+		test_api_write_function "${TEST_FUNCTION}" ${PACK_THREADS_OPTION} -B0 -c${COMPRESSION_LEVEL} -S0;
 		RESULT=$?;
 
 		if test ${RESULT} -ne ${EXIT_SUCCESS};
@@ -71,7 +78,7 @@ test_write()
 			return ${RESULT};
 		fi
 
-		test_api_write_function "${TEST_FUNCTION}" -B0 -c${COMPRESSION_LEVEL} -S10000;
+		test_api_write_function "${TEST_FUNCTION}" ${PACK_THREADS_OPTION} -B0 -c${COMPRESSION_LEVEL} -S10000;
 		RESULT=$?;
 
 		if test ${RESULT} -ne ${EXIT_SUCCESS};
@@ -79,7 +86,7 @@ test_write()
 			return ${RESULT};
 		fi
 
-		test_api_write_function "${TEST_FUNCTION}" -B100000 -c${COMPRESSION_LEVEL} -S0;
+		test_api_write_function "${TEST_FUNCTION}" ${PACK_THREADS_OPTION} -B100000 -c${COMPRESSION_LEVEL} -S0;
 		RESULT=$?;
 
 		if test ${RESULT} -ne ${EXIT_SUCCESS};
@@ -87,7 +94,7 @@ test_write()
 			return ${RESULT};
 		fi
 
-		test_api_write_function "${TEST_FUNCTION}" -B100000 -c${COMPRESSION_LEVEL} -S10000;
+		test_api_write_function "${TEST_FUNCTION}" ${PACK_THREADS_OPTION} -B100000 -c${COMPRESSION_LEVEL} -S10000;
 		RESULT=$?;
 
 		if test ${RESULT} -ne ${EXIT_SUCCESS};